@@ -19,6 +19,8 @@
 #define UNLOCK() eina_lock_release(&_state.lock)
 #define HISTORY_LOG_CACHE_TTL 10
 #define HISTORY_CONTIGUOUS_GAP 120
+// Snapshots arrive with some jitter, a run this close to its slot counts.
+#define SUBSCRIPTION_SLACK 0.05
 
 typedef struct {
     Eina_Lock lock;
@@ -28,6 +30,8 @@ typedef struct {
     Eina_Bool started;
     pid_t daemon_pid;
     uint64_t snapshot_seq;
+    Eina_List *subscriptions;
+    Eina_List *visible;
 
     Enigmatic_Client *client;
     Enigmatic_Client *history_client;
@@ -46,6 +50,22 @@ typedef struct {
     uint32_t end_time;
 } Evisum_Engine_History_Log;
 
+struct _Evisum_Engine_Subscription {
+    unsigned int families;
+    unsigned int changed;
+    unsigned int running_changed;
+    double period;
+    double next;
+    Evisum_Engine_Subscription_Cb cb;
+    Ecore_Thread_Notify_Cb feedback_cb;
+    Eina_Free_Cb free_cb;
+    const void *data;
+    Ecore_Thread *thread;
+    Eina_Bool expired;
+    Eina_Bool pending;
+    Eina_Bool deleted;
+};
+
 static Evisum_Engine_State _state = {0};
 
 static Eina_Bool
@@ -127,13 +147,114 @@ _cb_snapshot_init(Enigmatic_Client *client EINA_UNUSED, Snapshot *s EINA_UNUSED,
 }
 
 static void
-_cb_snapshot(Enigmatic_Client *client EINA_UNUSED, Snapshot *s EINA_UNUSED, void *data EINA_UNUSED)
+_engine_subscription_run(Evisum_Engine_Subscription *sub, double now);
+
+static void
+_engine_subscription_run_cb(void *data, Ecore_Thread *thread)
+{
+    Evisum_Engine_Subscription *sub = data;
+
+    sub->cb((void *) sub->data, thread, sub->running_changed);
+}
+
+static void
+_engine_subscription_notify_cb(void *data, Ecore_Thread *thread, void *msg)
+{
+    Evisum_Engine_Subscription *sub = data;
+
+    // Queued before the subscription went, its view may be gone too.
+    if (sub->deleted || !sub->feedback_cb) {
+        if (msg && sub->free_cb) sub->free_cb(msg);
+        return;
+    }
+    sub->feedback_cb((void *) sub->data, thread, msg);
+}
+
+static void
+_engine_subscription_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+    Evisum_Engine_Subscription *sub = data;
+
+    sub->thread = NULL;
+    if (sub->deleted) {
+        free(sub);
+        return;
+    }
+    if (!sub->pending) return;
+
+    sub->pending = EINA_FALSE;
+    _engine_subscription_run(sub, ecore_time_get());
+}
+
+static void
+_engine_subscription_run(Evisum_Engine_Subscription *sub, double now)
+{
+    sub->running_changed = sub->changed;
+    sub->changed = 0;
+    sub->expired = EINA_FALSE;
+
+    // Keep to the period's grid so a stream of late snapshots doesn't drift.
+    sub->next += sub->period;
+    if (sub->next < (now - SUBSCRIPTION_SLACK)) sub->next = now + sub->period;
+
+    sub->thread = ecore_thread_feedback_run(_engine_subscription_run_cb, _engine_subscription_notify_cb,
+                                            _engine_subscription_end_cb, _engine_subscription_end_cb, sub, EINA_FALSE);
+}
+
+static void
+_engine_subscriptions_dispatch(unsigned int changed)
+{
+    Evisum_Engine_Subscription *sub;
+    Eina_List *l;
+    double now = ecore_time_get();
+
+    EINA_LIST_FOREACH(_state.subscriptions, l, sub) {
+        sub->changed |= (changed & sub->families);
+        if (!sub->changed && !sub->expired) continue;
+        if (!sub->expired && (now < (sub->next - SUBSCRIPTION_SLACK))) continue;
+
+        if (sub->thread) sub->pending = EINA_TRUE;
+        else _engine_subscription_run(sub, now);
+    }
+}
+
+// Tell the daemon the fastest rate a subscription asks for while a window
+// is on screen, and that recorded history will do while none is.
+static void
+_engine_demand_update(void)
+{
+    Evisum_Engine_Subscription *sub;
+    Eina_List *l;
+    Interval interval = INTERVAL_IDLE;
+    double period = -1.0;
+
+    if (!_state.client) return;
+
+    if (_state.visible) {
+        EINA_LIST_FOREACH(_state.subscriptions, l, sub) {
+            if ((period < 0.0) || (sub->period < period)) period = sub->period;
+        }
+    }
+
+    if (period < 0.0) interval = INTERVAL_IDLE;
+    else if (period <= INTERVAL_NORMAL) interval = INTERVAL_NORMAL;
+    else if (period <= INTERVAL_MEDIUM) interval = INTERVAL_MEDIUM;
+    else interval = INTERVAL_SLOW;
+
+    enigmatic_client_demand_set(_state.client, interval);
+}
+
+static void
+_cb_snapshot(Enigmatic_Client *client EINA_UNUSED, Snapshot *s, void *data EINA_UNUSED)
 {
     if (!_state.lock_init || !_state.cond_init) return;
     LOCK();
     _state.snapshot_seq++;
     eina_condition_broadcast(&_state.cond);
     UNLOCK();
+
+    // Client callbacks come from the main loop.
+    _engine_subscriptions_dispatch(s->families);
 }
 
 static Eina_Bool
@@ -174,6 +295,8 @@ evisum_engine_ensure_started(void)
     ok = _engine_start_locked();
     UNLOCK();
 
+    if (ok) _engine_demand_update();
+
     return ok;
 }
 
@@ -182,6 +305,9 @@ evisum_engine_shutdown(void)
 {
     if (!_state.lock_init) return;
 
+    while (_state.subscriptions)
+        evisum_engine_unsubscribe(eina_list_data_get(_state.subscriptions), EINA_TRUE);
+
     LOCK();
 
     if (_state.client) {
@@ -197,6 +323,7 @@ evisum_engine_shutdown(void)
     _state.history_logs_scan_at = 0;
     _engine_history_logs_free(_state.history_recent_logs);
     _state.history_recent_logs = NULL;
+    _state.visible = eina_list_free(_state.visible);
     _state.history_recent_since = 0;
     _state.history_recent_logs_scan_at = 0;
 
@@ -255,6 +382,91 @@ evisum_engine_update_wait(uint64_t *seq)
     return EINA_FALSE;
 }
 
+Evisum_Engine_Subscription *
+evisum_engine_subscribe(unsigned int families, double period, Evisum_Engine_Subscription_Cb cb,
+                        Ecore_Thread_Notify_Cb feedback_cb, Eina_Free_Cb free_cb, const void *data)
+{
+    Evisum_Engine_Subscription *sub;
+
+    if (!cb || !families) return NULL;
+
+    sub = calloc(1, sizeof(Evisum_Engine_Subscription));
+    if (!sub) return NULL;
+
+    sub->families = families & EVISUM_ENGINE_FAMILY_ALL;
+    sub->period = (period > 0.0) ? period : 0.0;
+    sub->cb = cb;
+    sub->feedback_cb = feedback_cb;
+    sub->free_cb = free_cb;
+    sub->data = data;
+    sub->expired = EINA_TRUE;
+
+    _state.subscriptions = eina_list_append(_state.subscriptions, sub);
+    _engine_demand_update();
+
+    return sub;
+}
+
+void
+evisum_engine_unsubscribe(Evisum_Engine_Subscription *sub, Eina_Bool wait)
+{
+    Ecore_Thread *thread;
+
+    if (!sub) return;
+
+    _state.subscriptions = eina_list_remove(_state.subscriptions, sub);
+    _engine_demand_update();
+    if (!sub->thread) {
+        free(sub);
+        return;
+    }
+
+    // The end callback frees it, possibly before cancel or wait return.
+    sub->deleted = EINA_TRUE;
+    thread = sub->thread;
+    if (ecore_thread_cancel(thread)) return;
+    if (wait) ecore_thread_wait(thread, 0.5);
+}
+
+void
+evisum_engine_subscription_period_set(Evisum_Engine_Subscription *sub, double period)
+{
+    if (!sub) return;
+    if (period < 0.0) period = 0.0;
+    if (EINA_DBL_EQ(sub->period, period)) return;
+
+    sub->next += period - sub->period;
+    sub->period = period;
+    _engine_demand_update();
+}
+
+void
+evisum_engine_visible_set(const void *win, Eina_Bool visible)
+{
+    Eina_Bool was_visible = !!_state.visible;
+
+    _state.visible = eina_list_remove(_state.visible, win);
+    if (visible) _state.visible = eina_list_append(_state.visible, win);
+
+    if (was_visible != !!_state.visible) _engine_demand_update();
+}
+
+void
+evisum_engine_subscription_refresh(Evisum_Engine_Subscription *sub)
+{
+    if (!sub) return;
+
+    if (sub->thread) sub->pending = EINA_TRUE;
+    else _engine_subscription_run(sub, ecore_time_get());
+}
+
+void
+evisum_engine_subscription_expire(Evisum_Engine_Subscription *sub)
+{
+    if (!sub) return;
+    sub->expired = EINA_TRUE;
+}
+
 Eina_Bool
 evisum_engine_daemon_running_get(void)
 {
@@ -292,7 +504,7 @@ evisum_engine_daemon_pid_get(void)
 }
 
 static Enigmatic_Client *
-_engine_history_client_for_path_read(char *path, uint32_t time)
+_engine_history_client_for_path_read(char *path, uint32_t time, unsigned int families)
 {
     Enigmatic_Client *client;
 
@@ -302,6 +514,7 @@ _engine_history_client_for_path_read(char *path, uint32_t time)
         return NULL;
     }
 
+    enigmatic_client_subscribe(client, families);
     enigmatic_client_replay_time_start_set(client, 0);
     if (time) enigmatic_client_replay_time_end_set(client, time);
     enigmatic_client_read(client);
@@ -489,7 +702,8 @@ _engine_history_log_add(Eina_List **logs, char *path, const struct stat *st_in)
     }
 
     if (!_engine_history_log_bounds_cache_get(path, &st, &start_time, &end_time)) {
-        client = _engine_history_client_for_path_read(strdup(path), 0);
+        // Only the time bounds are wanted, step over every section.
+        client = _engine_history_client_for_path_read(strdup(path), 0, FAMILY_NONE);
         if (!client) {
             free(path);
             return EINA_FALSE;
@@ -760,7 +974,7 @@ evisum_engine_history_time_set(uint32_t time)
         }
     }
 
-    client = _engine_history_client_for_path_read(strdup(selected->path), time);
+    client = _engine_history_client_for_path_read(strdup(selected->path), time, FAMILY_ALL);
     _engine_history_logs_free(logs);
     if (!client) return EINA_FALSE;
 
@@ -839,6 +1053,72 @@ evisum_engine_live_time_get(void)
     return time;
 }
 
+typedef struct {
+    Evisum_Engine_History_Sample_Cb cb;
+    void *data;
+    uint32_t step;
+    uint32_t last;
+} Evisum_Engine_History_Walk;
+
+static void
+_engine_history_walk_cb(Enigmatic_Client *client EINA_UNUSED, Snapshot *s, void *data)
+{
+    Evisum_Engine_History_Walk *walk = data;
+    Evisum_Engine_History_Sample sample;
+
+    if (walk->last && (s->time < (walk->last + walk->step))) return;
+    walk->last = s->time;
+
+    sample.time = s->time;
+    sample.memory = &s->meminfo;
+    sample.sensors = s->sensors;
+    sample.network_interfaces = s->network_interfaces;
+    sample.file_systems = s->file_systems;
+    sample.block_devices = s->block_devices;
+
+    walk->cb(&sample, walk->data);
+}
+
+// Replay the recorded window ending at the time on screen. The client only
+// decodes the sections for the families asked for and skips the rest by
+// length, samples closer together than step seconds are dropped.
+Eina_Bool
+evisum_engine_history_samples_get(uint32_t seconds, uint32_t step, unsigned int families,
+                                  Evisum_Engine_History_Sample_Cb cb, void *data)
+{
+    Evisum_Engine_History_Walk walk = { cb, data, step, 0 };
+    Enigmatic_Client *client;
+    unsigned int subscribe = FAMILY_NONE;
+    uint32_t end_time;
+    Eina_Bool ok;
+
+    if (!cb || !seconds || !families) return EINA_FALSE;
+
+    end_time = evisum_engine_history_live_get() ? evisum_engine_live_time_get() : evisum_engine_history_time_get();
+    if (!end_time) end_time = time(NULL);
+    if (end_time <= seconds) return EINA_FALSE;
+
+    if (families & EVISUM_ENGINE_HISTORY_MEMORY) subscribe |= FAMILY_MEMORY;
+    if (families & EVISUM_ENGINE_HISTORY_SENSORS) subscribe |= FAMILY_SENSOR;
+    if (families & EVISUM_ENGINE_HISTORY_NETWORK) subscribe |= FAMILY_NETWORK;
+    if (families & EVISUM_ENGINE_HISTORY_FILE_SYSTEMS) subscribe |= FAMILY_FILE_SYSTEM;
+    if (families & EVISUM_ENGINE_HISTORY_BLOCK_DEVICES) subscribe |= FAMILY_BLOCK_DEVICE;
+
+    client = enigmatic_client_add();
+    if (!client) return EINA_FALSE;
+
+    enigmatic_client_subscribe(client, subscribe);
+    enigmatic_client_replay_time_start_set(client, end_time - seconds);
+    enigmatic_client_replay_time_end_set(client, end_time);
+    enigmatic_client_snapshot_callback_set(client, _engine_history_walk_cb, &walk);
+
+    ok = enigmatic_client_replay(client);
+
+    enigmatic_client_del(client);
+
+    return ok;
+}
+
 static Eina_Bool
 _engine_snapshot_acquire(const Snapshot **out)
 {
@@ -1312,8 +1592,25 @@ proc_info_kthreads_show_get(void)
     return _show_kthreads;
 }
 
-static Proc_Info *
-_proc_from_log(const Proc_Info_Log *src)
+// A system daemon's shared log leaves arguments out, only our own are
+// fetched from the daemon. They show once it has answered.
+static char *
+_proc_arguments_get(const Proc_Info_Log *src)
+{
+    char *arguments;
+    uid_t uid;
+
+    if (src->arguments[0] || !_state.client || !enigmatic_system_mode_get()) return strdup(src->arguments);
+
+    uid = getuid();
+    if (uid && (uid != src->uid)) return strdup("");
+
+    arguments = enigmatic_client_process_arguments_get(_state.client, src->pid, src->start);
+    return arguments ? arguments : strdup("");
+}
+
+Proc_Info *
+proc_info_from_log(const Proc_Info_Log *src)
 {
     Proc_Info *p;
     const char *cmd;
@@ -1344,6 +1641,13 @@ _proc_from_log(const Proc_Info_Log *src)
     p->net_out_raw = src->net_out;
     p->disk_read = src->disk_read;
     p->disk_write = src->disk_write;
+    p->net_in_rate = src->net_in_rate;
+    p->net_out_rate = src->net_out_rate;
+    p->disk_read_rate = src->disk_read_rate;
+    p->disk_write_rate = src->disk_write_rate;
+    p->delay_cpu = src->delay_cpu;
+    p->delay_blkio = src->delay_blkio;
+    p->delay_swap = src->delay_swap;
     p->numfiles = src->numfiles;
     p->was_zero = src->was_zero;
     p->is_kernel = src->is_kernel;
@@ -1354,7 +1658,7 @@ _proc_from_log(const Proc_Info_Log *src)
 
     cmd = src->command[0] ? src->command : (src->path[0] ? src->path : "");
     p->command = strdup(cmd);
-    p->arguments = strdup(src->arguments);
+    p->arguments = _proc_arguments_get(src);
     p->thread_name = strdup(src->thread_name[0] ? src->thread_name : cmd);
 
     return p;
@@ -1389,7 +1693,7 @@ _proc_list_get(void)
     EINA_LIST_FOREACH(snap->processes, l, p) {
         Proc_Info *c;
         if (!_show_kthreads && p->is_kernel) continue;
-        c = _proc_from_log(p);
+        c = proc_info_from_log(p);
         if (!c) continue;
         out = eina_list_append(out, c);
     }
@@ -1408,119 +1712,99 @@ Proc_Info *
 proc_info_by_pid(pid_t pid)
 {
     const Snapshot *snap;
-    Eina_List *l;
     Proc_Info_Log *p;
     Proc_Info *ret = NULL;
 
     if (!_engine_snapshot_acquire(&snap)) return NULL;
 
-    EINA_LIST_FOREACH(snap->processes, l, p) {
-        if (p->pid != pid) continue;
-        ret = _proc_from_log(p);
-        break;
-    }
+    p = enigmatic_client_snapshot_process_get(snap, pid);
+    if (p) ret = proc_info_from_log(p);
 
     _engine_snapshot_release();
     return ret;
 }
 
-Eina_List *
-proc_info_all_children_get(void)
+Proc_Info_Series *
+proc_info_series_get(pid_t pid, int64_t start, uint32_t seconds)
 {
-    Eina_List *procs, *l;
-    Proc_Info *p;
-    Eina_Hash *by_pid;
-    Eina_List *roots = NULL;
-
-    procs = _proc_list_get();
-    if (!procs) return NULL;
-
-    by_pid = eina_hash_int64_new(NULL);
-    if (!by_pid) {
-        EINA_LIST_FREE(procs, p) proc_info_free(p);
-        return NULL;
-    }
+    uint32_t end_time;
 
-    EINA_LIST_FOREACH(procs, l, p) {
-        int64_t k = p->pid;
-        eina_hash_add(by_pid, &k, p);
-    }
+    // Anchor the window on whatever the UI is showing, history or live.
+    end_time = evisum_engine_history_live_get() ? evisum_engine_live_time_get()
+                                                : evisum_engine_history_time_get();
+    if (!end_time) end_time = time(NULL);
+    if (end_time <= seconds) return NULL;
 
-    EINA_LIST_FOREACH(procs, l, p) {
-        int64_t parent_k = p->ppid;
-        Proc_Info *parent = eina_hash_find(by_pid, &parent_k);
-        if (parent && parent != p) parent->children = eina_list_append(parent->children, p);
-        else roots = eina_list_append(roots, p);
-    }
+    return enigmatic_client_process_series_get(pid, start, end_time - seconds, end_time);
+}
 
-    eina_hash_free(by_pid);
-    eina_list_free(procs);
-    return roots;
+void
+proc_info_series_free(Proc_Info_Series *series)
+{
+    enigmatic_client_process_series_free(series);
 }
 
-static Eina_Bool
-_proc_info_child_add(Eina_List *parents, Proc_Info *child)
+// Copy log and everything below it from the snapshot's process tree, so
+// the cost follows the size of the subtree rather than the process list.
+// Each copy is also appended to flat, when given, in pre-order.
+static Proc_Info *
+_proc_tree_copy(const Snapshot *snap, const Proc_Info_Log *log, Eina_List **flat)
 {
-    Eina_List *l;
-    Proc_Info *parent;
+    const Eina_List *l;
+    Proc_Info_Log *child_log;
+    Proc_Info *proc, *child;
 
-    EINA_LIST_FOREACH(parents, l, parent) {
-        if (parent != child && parent->pid == child->ppid) {
-            parent->children = eina_list_append(parent->children, child);
-            return EINA_TRUE;
-        }
+    proc = proc_info_from_log(log);
+    if (!proc) return NULL;
+    if (flat) *flat = eina_list_append(*flat, proc);
+
+    EINA_LIST_FOREACH(enigmatic_client_snapshot_children_get(snap, log->pid), l, child_log) {
+        if (child_log == log) continue;
+        if (!_show_kthreads && child_log->is_kernel) continue;
+        child = _proc_tree_copy(snap, child_log, flat);
+        if (child) proc->children = eina_list_append(proc->children, child);
     }
 
-    return EINA_FALSE;
+    return proc;
 }
 
-static Eina_List *
-_proc_info_children_append(Eina_List *wanted, Eina_List *children)
+Eina_List *
+proc_info_all_children_get(void)
 {
+    const Snapshot *snap;
     Eina_List *l;
-    Proc_Info *child;
+    Proc_Info_Log *p, *parent;
+    Proc_Info *proc;
+    Eina_List *roots = NULL;
 
-    EINA_LIST_FOREACH(children, l, child) {
-        wanted = eina_list_append(wanted, child);
-        if (!wanted) return NULL;
-        if (child->children)
-            wanted = _proc_info_children_append(wanted, child->children);
+    if (!_engine_snapshot_acquire(&snap)) return NULL;
+
+    EINA_LIST_FOREACH(snap->processes, l, p) {
+        if (!_show_kthreads && p->is_kernel) continue;
+        parent = enigmatic_client_snapshot_process_get(snap, p->ppid);
+        if (parent && (parent != p) && (_show_kthreads || !parent->is_kernel)) continue;
+        proc = _proc_tree_copy(snap, p, NULL);
+        if (proc) roots = eina_list_append(roots, proc);
     }
 
-    return wanted;
+    _engine_snapshot_release();
+    return roots;
 }
 
 Eina_List *
 proc_info_pid_children_get(pid_t pid)
 {
-    Eina_List *procs, *l;
-    Proc_Info *proc;
+    const Snapshot *snap;
+    Proc_Info_Log *p;
     Eina_List *wanted = NULL;
 
-    procs = _proc_list_get();
-    if (!procs) return NULL;
-
-    EINA_LIST_FOREACH(procs, l, proc)
-        _proc_info_child_add(procs, proc);
-
-    EINA_LIST_FOREACH(procs, l, proc) {
-        if (proc->pid == pid) {
-            wanted = eina_list_append(wanted, proc);
-            if (wanted && proc->children)
-                wanted = _proc_info_children_append(wanted, proc->children);
-            break;
-        }
-    }
+    if (!_engine_snapshot_acquire(&snap)) return NULL;
 
-    EINA_LIST_FREE(procs, proc) {
-        if (!eina_list_data_find(wanted, proc)) {
-            Eina_List *children = proc->children;
-            proc->children = NULL;
-            proc_info_free(proc);
-            eina_list_free(children);
-        }
-    }
+    p = enigmatic_client_snapshot_process_get(snap, pid);
+    if (p && (_show_kthreads || !p->is_kernel))
+        _proc_tree_copy(snap, p, &wanted);
 
+    _engine_snapshot_release();
     return wanted;
 }
 
@@ -1546,10 +1830,10 @@ int proc_sort_by_size(const void *p1, const void *p2) { const Proc_Info *a=p1,*b
 int proc_sort_by_virt(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,mem_virt); }
 int proc_sort_by_rss(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,mem_rss); }
 int proc_sort_by_shared(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,mem_shared); }
-int proc_sort_by_net_in(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,net_in); }
-int proc_sort_by_net_out(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,net_out); }
-int proc_sort_by_disk_read(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,disk_read); }
-int proc_sort_by_disk_write(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,disk_write); }
+int proc_sort_by_net_in(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,net_in_rate); }
+int proc_sort_by_net_out(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,net_out_rate); }
+int proc_sort_by_disk_read(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,disk_read_rate); }
+int proc_sort_by_disk_write(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,disk_write_rate); }
 int proc_sort_by_time(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,cpu_time); }
 int proc_sort_by_cpu_usage(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return SORT_NUM(a,b,cpu_usage); }
 int proc_sort_by_cmd(const void *p1, const void *p2) { const Proc_Info *a=p1,*b=p2; return strcmp(a->command ? a->command : "", b->command ? b->command : ""); }
@@ -1601,3 +1885,59 @@ file_system_in_use(const char *name)
 
     return mounted;
 }
+
+Eina_List *
+cgroup_info_all_get(void)
+{
+    const Snapshot *snap;
+    Eina_List *l;
+    Cgroup *in;
+    Eina_List *out = NULL;
+
+    if (!_engine_snapshot_acquire(&snap)) return NULL;
+
+    EINA_LIST_FOREACH(snap->cgroups, l, in) {
+        Cgroup *cg = calloc(1, sizeof(Cgroup));
+        if (!cg) continue;
+        memcpy(cg, in, sizeof(*cg));
+        out = eina_list_append(out, cg);
+    }
+
+    _engine_snapshot_release();
+    return out;
+}
+
+void
+cgroup_info_free(Cgroup *cg)
+{
+    if (!cg) return;
+    free(cg);
+}
+
+Eina_List *
+block_device_info_all_get(void)
+{
+    const Snapshot *snap;
+    Eina_List *l;
+    Block_Device *in;
+    Eina_List *out = NULL;
+
+    if (!_engine_snapshot_acquire(&snap)) return NULL;
+
+    EINA_LIST_FOREACH(snap->block_devices, l, in) {
+        Block_Device *dev = calloc(1, sizeof(Block_Device));
+        if (!dev) continue;
+        memcpy(dev, in, sizeof(*dev));
+        out = eina_list_append(out, dev);
+    }
+
+    _engine_snapshot_release();
+    return out;
+}
+
+void
+block_device_info_free(Block_Device *dev)
+{
+    if (!dev) return;
+    free(dev);
+}
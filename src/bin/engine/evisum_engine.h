@@ -2,6 +2,7 @@
 #define EVISUM_ENGINE_H
 
 #include <Eina.h>
+#include <Ecore.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <sys/types.h>
@@ -9,6 +10,8 @@
 #include "enigmatic/system/machine.h"
 #include "enigmatic/system/file_systems.h"
 #include "enigmatic/system/process.h"
+#include "enigmatic/system/cgroups.h"
+#include "enigmatic/system/block_devices.h"
 
 typedef struct {
     pid_t pid;
@@ -22,11 +25,79 @@ typedef struct {
     Eina_Bool zfs_mounted;
 } Evisum_Engine_Status;
 
+typedef enum {
+    EVISUM_ENGINE_HISTORY_MEMORY = 1 << 0,
+    EVISUM_ENGINE_HISTORY_SENSORS = 1 << 1,
+    EVISUM_ENGINE_HISTORY_NETWORK = 1 << 2,
+    EVISUM_ENGINE_HISTORY_FILE_SYSTEMS = 1 << 3,
+    EVISUM_ENGINE_HISTORY_BLOCK_DEVICES = 1 << 4,
+} Evisum_Engine_History_Family;
+
+/* One recorded tick. Only the families asked for are filled in, the rest
+ * are empty. Everything here belongs to the replay and is only valid for
+ * the duration of the callback. */
+typedef struct {
+    uint32_t time;
+    const Meminfo *memory;
+    Eina_List *sensors;
+    Eina_List *network_interfaces;
+    Eina_List *file_systems;
+    Eina_List *block_devices;
+} Evisum_Engine_History_Sample;
+
+typedef void (*Evisum_Engine_History_Sample_Cb)(const Evisum_Engine_History_Sample *sample, void *data);
+
+/* Object families a subscription depends on, one per section of the daemon
+ * log. A family only counts as changed when the daemon wrote records for it. */
+typedef enum {
+    EVISUM_ENGINE_FAMILY_CPU = 1 << 0,
+    EVISUM_ENGINE_FAMILY_MEMORY = 1 << 1,
+    EVISUM_ENGINE_FAMILY_SENSORS = 1 << 2,
+    EVISUM_ENGINE_FAMILY_POWER = 1 << 3,
+    EVISUM_ENGINE_FAMILY_BATTERIES = 1 << 4,
+    EVISUM_ENGINE_FAMILY_NETWORK = 1 << 5,
+    EVISUM_ENGINE_FAMILY_FILE_SYSTEMS = 1 << 6,
+    EVISUM_ENGINE_FAMILY_BLOCK_DEVICES = 1 << 7,
+    EVISUM_ENGINE_FAMILY_PROCESSES = 1 << 8,
+    EVISUM_ENGINE_FAMILY_CGROUPS = 1 << 9,
+    EVISUM_ENGINE_FAMILY_ALL = 0x3ff,
+} Evisum_Engine_Family;
+
+typedef struct _Evisum_Engine_Subscription Evisum_Engine_Subscription;
+
+/* Runs on the shared Ecore thread pool, post results with
+ * ecore_thread_feedback(). changed holds the subscribed families updated
+ * since the previous run. */
+typedef void (*Evisum_Engine_Subscription_Cb)(void *data, Ecore_Thread *thread, unsigned int changed);
+
 Eina_Bool evisum_engine_ensure_started(void);
 void evisum_engine_shutdown(void);
 Eina_Bool evisum_engine_status_get(Evisum_Engine_Status *status);
 uint64_t evisum_engine_update_seq_get(void);
 Eina_Bool evisum_engine_update_wait(uint64_t *seq);
+
+/* Run cb once per period, on the first snapshot in which one of families
+ * changed. Snapshots fan out to every due subscription from the main loop,
+ * nothing wakes in between. A run still in flight when the next one is due
+ * is followed by a single catch-up run. Main loop only, as is the rest of
+ * the subscription API. feedback_cb owns the messages it is handed, those
+ * it never sees are passed to free_cb instead. */
+Evisum_Engine_Subscription *evisum_engine_subscribe(unsigned int families, double period,
+                                                    Evisum_Engine_Subscription_Cb cb,
+                                                    Ecore_Thread_Notify_Cb feedback_cb, Eina_Free_Cb free_cb,
+                                                    const void *data);
+/* Stop dispatching. With wait, block until a run in flight has finished so
+ * data can be freed; feedback still queued from it is freed either way. */
+void evisum_engine_unsubscribe(Evisum_Engine_Subscription *sub, Eina_Bool wait);
+void evisum_engine_subscription_period_set(Evisum_Engine_Subscription *sub, double period);
+/* Run now regardless of period or changes, or straight after the run in flight. */
+void evisum_engine_subscription_refresh(Evisum_Engine_Subscription *sub);
+/* Run on the next snapshot regardless of period or changes. */
+void evisum_engine_subscription_expire(Evisum_Engine_Subscription *sub);
+/* Whether win is on screen. While none is the daemon records history at its
+ * low-power cadence, once one is it samples as often as the subscriptions'
+ * periods ask for. Main loop only. */
+void evisum_engine_visible_set(const void *win, Eina_Bool visible);
 Eina_Bool evisum_engine_daemon_running_get(void);
 pid_t evisum_engine_daemon_pid_get(void);
 Eina_Bool evisum_engine_history_bounds_get(uint32_t *start_time, uint32_t *end_time);
@@ -38,6 +109,8 @@ void evisum_engine_history_live_set(void);
 Eina_Bool evisum_engine_history_live_get(void);
 uint32_t evisum_engine_history_time_get(void);
 uint32_t evisum_engine_live_time_get(void);
+Eina_Bool evisum_engine_history_samples_get(uint32_t seconds, uint32_t step, unsigned int families,
+                                           Evisum_Engine_History_Sample_Cb cb, void *data);
 
 int system_cpu_online_count_get(void);
 int system_cpu_count_get(void);
@@ -60,6 +133,9 @@ void system_network_process_usage_free(Proc_Net **procs, int n);
 Eina_List *proc_info_all_get(void);
 Proc_Info *proc_info_by_pid(pid_t pid);
 void proc_info_free(Proc_Info *proc);
+Proc_Info *proc_info_from_log(const Proc_Info_Log *log);
+Proc_Info_Series *proc_info_series_get(pid_t pid, int64_t start, uint32_t seconds);
+void proc_info_series_free(Proc_Info_Series *series);
 void proc_info_kthreads_show_set(Eina_Bool enabled);
 Eina_Bool proc_info_kthreads_show_get(void);
 Eina_List *proc_info_all_children_get(void);
@@ -91,4 +167,10 @@ Eina_List *file_system_info_all_get(void);
 void file_system_info_free(File_System *fs);
 Eina_Bool file_system_in_use(const char *name);
 
+Eina_List *cgroup_info_all_get(void);
+void cgroup_info_free(Cgroup *cg);
+
+Eina_List *block_device_info_all_get(void);
+void block_device_info_free(Block_Device *dev);
+
 #endif
@@ -24,6 +24,7 @@
 #include "Events.h"
 #include "system/machine.h"
 #include "system/process.h"
+#include "uid.h"
 
 #define LOG_FILE_NAME PACKAGE".log"
 #define LCK_FILE_NAME PACKAGE".lock"
@@ -31,14 +32,23 @@
 
 typedef struct
 {
-   Eina_Hash *cores;
-   Meminfo    meminfo;
-   Eina_Bool  power;
-   Eina_Hash *sensors;
-   Eina_Hash *batteries;
-   Eina_Hash *network_interfaces;
-   Eina_Hash *file_systems;
-   Eina_Hash *processes;
+   Cpu_Core *cores;
+   Cpu_Core *sample;
+   int       count;
+} Cores_Table;
+
+typedef struct
+{
+   Cores_Table cores;
+   Meminfo     meminfo;
+   Eina_Bool   power;
+   Eina_Hash  *sensors;
+   Eina_Hash  *batteries;
+   Eina_Hash  *network_interfaces;
+   Eina_Hash  *file_systems;
+   Eina_Hash  *processes;
+   Eina_Hash  *cgroups;
+   Eina_Hash  *block_devices;
 } System_Info;
 
 #ifndef ENIGMATIC_BUFFER_TYPEDEF
@@ -56,9 +66,11 @@ typedef struct
    int      fd;
    int      flags;
    Buffer   buf;
+   uint32_t section;
 } Log;
 
 typedef struct _Enigmatic Enigmatic;
+typedef struct _Rollup Rollup;
 
 struct _Enigmatic
 {
@@ -68,20 +80,28 @@ struct _Enigmatic
 
    int                  lock_fd;
 
-   Eina_List           *unique_ids;
+   Unique_Ids           unique_ids;
 
    System_Info         *info;
    uint32_t             poll_time;
    uint32_t             poll_count;
    Interval             interval;
    Interval             interval_update;
+   // Without live followers each pass samples once and sleeps the interval.
+   Eina_Bool            idle;
+   Eina_Bool            idle_update;
+   // Monotonic seconds since the previous pass, what rates are taken over.
+   double               elapsed;
    Eina_Bool            broadcast;
+   // A keyframe wanted by a stream follower, applied at the next tick.
+   Eina_Bool            broadcast_update;
    Eina_Bool            close_on_parent_exit;
    int                  device_refresh_interval;
 
    Enigmatic_Config    *config;
 
    Eina_Lock            update_lock;
+   Eina_Condition       update_cond;
 
    pid_t                pid;
    char                *pidfile_path;
@@ -93,8 +113,12 @@ struct _Enigmatic
       char              hour;
       char              min;
       Eina_Thread      *rotate_thread;
+      // Handed each compressed block as it is written.
+      void            (*block_cb)(Enigmatic *enigmatic, const void *data, uint32_t size, Eina_Bool keyframe);
    } log;
 
+   Rollup              *rollup;
+
    Ecore_Thread        *battery_thread;
    Ecore_Thread        *power_thread;
    Ecore_Thread        *sensors_thread;
@@ -5,6 +5,19 @@
 
 #define HEADER_MAGIC 0xf00dcafe
 
+// Raised whenever a logged record changes layout. Every broadcast carries it
+// in place of the last magic word, so readers refuse logs they can't parse.
+// 2: The last magic word of a broadcast became this version.
+//    Cpu_Core gained per-state times and percentages (CPU_CORE_USER to
+//    CPU_CORE_STEAL).
+//    Proc_Info_Log gained the taskstats delays (PROCESS_DELAY_*) and I/O
+//    rates (PROCESS_*_RATE).
+//    New record families: Cgroup (CGROUP*) and Block_Device
+//    (BLOCK_DEVICE*).
+//    New EVENT_SECTION headers, each followed by a Section, wrap every
+//    family's records.
+#define LOG_FORMAT_VERSION 2
+
 typedef enum
 {
    EVENT_ERROR       = 0,
@@ -13,6 +26,7 @@ typedef enum
    EVENT_BLOCK_END   = 3,
    EVENT_LAST_RECORD = 4,
    EVENT_EOF         = 5,
+   EVENT_SECTION     = 6,
 } Event;
 
 typedef enum
@@ -78,10 +92,43 @@ typedef enum
    PROCESS_CHILDREN_COUNT = 59,
    PROCESS_PATH         = 60,
    PROCESS_CPU_USAGE    = 61,
+   PROCESS_DELAY_CPU    = 62,
+   PROCESS_DELAY_BLKIO  = 63,
+   PROCESS_DELAY_SWAP   = 64,
+   CGROUP                 = 65,
+   CGROUP_CPU_USAGE       = 66,
+   CGROUP_CPU_USER        = 67,
+   CGROUP_CPU_SYSTEM      = 68,
+   CGROUP_MEMORY_CURRENT  = 69,
+   CGROUP_IO_READ         = 70,
+   CGROUP_IO_WRITE        = 71,
+   CGROUP_CPU_PRESSURE    = 72,
+   CGROUP_MEMORY_PRESSURE = 73,
+   CGROUP_IO_PRESSURE     = 74,
+   CPU_CORE_USER          = 75,
+   CPU_CORE_NICE          = 76,
+   CPU_CORE_SYSTEM        = 77,
+   CPU_CORE_IDLE          = 78,
+   CPU_CORE_IOWAIT        = 79,
+   CPU_CORE_IRQ           = 80,
+   CPU_CORE_SOFTIRQ       = 81,
+   CPU_CORE_STEAL         = 82,
+   BLOCK_DEVICE             = 83,
+   BLOCK_DEVICE_READS       = 84,
+   BLOCK_DEVICE_WRITES      = 85,
+   BLOCK_DEVICE_READ_BYTES  = 86,
+   BLOCK_DEVICE_WRITE_BYTES = 87,
+   BLOCK_DEVICE_IO_TIME     = 88,
+   BLOCK_DEVICE_QUEUE_TIME  = 89,
+   PROCESS_NET_IN_RATE      = 90,
+   PROCESS_NET_OUT_RATE     = 91,
+   PROCESS_DISK_READ_RATE   = 92,
+   PROCESS_DISK_WRITE_RATE  = 93,
 } Object_Type;
 
 typedef enum
 {
+   INTERVAL_IDLE   = 0, // Only asked for by followers, history is all they need.
    INTERVAL_NORMAL = 1,
    INTERVAL_MEDIUM = 3,
    INTERVAL_SLOW   = 5,
@@ -120,4 +167,76 @@ typedef struct
    uint32_t     time;
 } Header;
 
+// An EVENT_SECTION header is followed by a Section and then length bytes of
+// records which all belong to one object family. Readers not interested in
+// the family can step over the records without parsing them.
+typedef struct
+{
+   Object_Type  family;
+   uint32_t     length;
+} Section;
+
+// A daemon streaming its log serves every block, one LZ4 frame as written to
+// the log, behind a Stream_Record. Blocks are numbered from the daemon's
+// start, its epoch. A follower sends "STREAM epoch seq" to carry on after a
+// block it has, or from the latest keyframe when that block is no longer
+// kept (or "STREAM 0 0" to start afresh). The local socket is the control
+// socket's name on STREAM_PORT_LOCAL.
+#define STREAM_PORT_LOCAL 1
+//
+// Anyone on the machine can reach the TCP port, so there the first command
+// must be "AUTH token". The daemon writes a fresh token to STREAM_TOKEN_FILE
+// beside its pidfile, readable by its own user only. Anything else is told
+// "DENIED" and dropped.
+#define STREAM_TOKEN_FILE "stream.token"
+#define STREAM_TOKEN_SIZE 32
+
+typedef struct
+{
+   uint32_t     size;
+   uint32_t     epoch;
+   uint64_t     seq;
+} Stream_Record;
+
+// Rollup archives hold coarse min/avg/max summaries which outlive the hourly
+// logs. Each archive is a plain sequence of Rollup_Record, one per bucket.
+#define ROLLUP_MAGIC 0x524f4c4c
+
+typedef enum
+{
+   ROLLUP_RESOLUTION_1M  = 60,
+   ROLLUP_RESOLUTION_15M = 900,
+} Rollup_Resolution;
+
+typedef enum
+{
+   ROLLUP_CPU_CORE    = 1,
+   ROLLUP_MEMORY_USED = 2,
+   ROLLUP_SWAP_USED   = 3,
+   ROLLUP_NETWORK_IN  = 4,
+   ROLLUP_NETWORK_OUT = 5,
+   ROLLUP_PROCESS_CPU = 6,
+   ROLLUP_PROCESS_RSS = 7,
+} Rollup_Type;
+
+typedef struct
+{
+   Rollup_Type  type;
+   uint32_t     id;
+   uint32_t     samples;
+   char         name[36];
+   int64_t      min;
+   int64_t      avg;
+   int64_t      max;
+} Rollup_Entry;
+
+typedef struct
+{
+   uint32_t     magic;
+   uint32_t     time;
+   uint32_t     resolution;
+   uint32_t     count;
+   Rollup_Entry entries[];
+} Rollup_Record;
+
 #endif
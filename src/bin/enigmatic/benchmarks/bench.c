@@ -0,0 +1,67 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+double
+bench_time_get(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+uint32_t
+bench_random(uint32_t *state)
+{
+   *state = (*state * 1103515245) + 12345;
+
+   return (*state >> 16) & 0x7fff;
+}
+
+static int
+cb_time_cmp(const void *a, const void *b)
+{
+   double t1 = *(const double *) a, t2 = *(const double *) b;
+
+   return (t1 > t2) - (t1 < t2);
+}
+
+void
+bench_run(const char *name, int rounds, Bench_Prepare_Cb *prepare, Bench_Run_Cb *run, void *data)
+{
+   double *times, t, median;
+   uint64_t bytes = 0;
+
+   if (rounds < 1) rounds = 1;
+
+   times = malloc(rounds * sizeof(double));
+   EINA_SAFETY_ON_NULL_RETURN(times);
+
+   // The first round warms caches and state built on first use, it isn't
+   // counted.
+   for (int i = -1; i < rounds; i++)
+     {
+        if (prepare) prepare(data);
+        t = bench_time_get();
+        bytes = run(data);
+        t = bench_time_get() - t;
+        if (i >= 0) times[i] = t;
+     }
+
+   // The median is what regressions are tracked against, it stays put when
+   // the odd round is disturbed.
+   qsort(times, rounds, sizeof(double), cb_time_cmp);
+   median = times[rounds / 2];
+
+   printf("%-24s median %10.3f ms  min %10.3f ms", name, median * 1000.0, times[0] * 1000.0);
+   if (bytes)
+     printf("  %10.1f MB/s", (bytes / (1024.0 * 1024.0)) / median);
+   printf("\n");
+   fflush(stdout);
+
+   free(times);
+}
@@ -0,0 +1,24 @@
+#ifndef ENIGMATIC_BENCH_H
+#define ENIGMATIC_BENCH_H
+
+#include <Eina.h>
+#include <stdint.h>
+
+// Runs before every round and isn't timed, for undoing what the last round
+// did to its inputs.
+typedef void (Bench_Prepare_Cb)(void *data);
+
+// One timed round, returns the number of bytes it got through or zero when
+// only the time is of interest.
+typedef uint64_t (Bench_Run_Cb)(void *data);
+
+double
+bench_time_get(void);
+
+uint32_t
+bench_random(uint32_t *state);
+
+void
+bench_run(const char *name, int rounds, Bench_Prepare_Cb *prepare, Bench_Run_Cb *run, void *data);
+
+#endif
@@ -0,0 +1,449 @@
+#include "Enigmatic.h"
+#include "enigmatic_log.h"
+#include "monitor/processes.h"
+#include "Enigmatic_Client.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define BENCH_DIFF_VALUES  (1 << 20)
+#define BENCH_LOG_PROCS    2000
+#define BENCH_LOG_TICKS    120
+#define BENCH_START_TIME   1700000000
+
+typedef struct
+{
+   Enigmatic   enigmatic;
+   Eina_Hash  *processes;
+   int         nprocs;
+   uint32_t    tick;
+   int64_t    *values;
+   Buffer      saved;
+   char        path[PATH_MAX];
+   uint64_t    length;
+} Bench;
+
+static void
+bench_log_init(Bench *bench, const char *path)
+{
+   Log *file = calloc(1, sizeof(Log));
+   EINA_SAFETY_ON_NULL_RETURN(file);
+
+   file->fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, 0600);
+   if (file->fd == -1)
+     ERROR("open %s (%s)", path, strerror(errno));
+
+   bench->enigmatic.log.file = file;
+   bench->enigmatic.interval = INTERVAL_NORMAL;
+   bench->enigmatic.poll_time = BENCH_START_TIME;
+}
+
+static void
+bench_log_shutdown(Bench *bench)
+{
+   Log *file = bench->enigmatic.log.file;
+
+   close(file->fd);
+   free(file->buf.data);
+   free(file);
+   bench->enigmatic.log.file = NULL;
+}
+
+static void
+bench_log_buffer_clear(Bench *bench)
+{
+   Log *file = bench->enigmatic.log.file;
+
+   free(file->buf.data);
+   file->buf.data = NULL;
+   file->buf.length = 0;
+}
+
+// The same processes every run. Every slot restarts once every 100 ticks,
+// staggered so 1% of the list turns over each tick, and the counters of the
+// rest move at rates fixed by their slot.
+static Eina_List *
+bench_processes_get(int n, uint32_t tick)
+{
+   Eina_List *processes = NULL;
+   Proc_Info *proc;
+   char buf[256];
+
+   for (int i = 0; i < n; i++)
+     {
+        uint32_t generation = (tick + i) / 100;
+        uint32_t age = (tick + i) % 100;
+
+        proc = calloc(1, sizeof(Proc_Info));
+        EINA_SAFETY_ON_NULL_RETURN_VAL(proc, processes);
+
+        proc->pid = 1000 + i + (generation * n);
+        proc->ppid = i ? 1000 + ((i - 1) / 8) : 1;
+        proc->uid = 1000 + (i % 4);
+        proc->start = BENCH_START_TIME + tick - age;
+        proc->run_time = age;
+        proc->numthreads = 1 + (i % 5);
+        proc->cpu_id = (i + tick) % 8;
+        proc->cpu_time = age * (i % 7);
+        proc->mem_size = proc->mem_virt = (uint64_t) (4096 + (i % 211)) * 4096;
+        proc->mem_rss = (uint64_t) (1024 + (i % 97) + (age * (i % 3))) * 4096;
+        proc->mem_shared = (uint64_t) (256 + (i % 31)) * 4096;
+        if (!(i % 10))
+          {
+             proc->net_in = (uint64_t) age * 1500 * (1 + (i % 13));
+             proc->net_out = (uint64_t) age * 600 * (1 + (i % 11));
+          }
+        if (!(i % 4))
+          proc->disk_read = proc->disk_write = (uint64_t) age * 4096 * (1 + (i % 5));
+        proc->numfiles = 3 + (i % 20);
+        snprintf(proc->state, sizeof(proc->state), "%s", (i + tick) % 50 ? "S" : "R");
+        snprintf(proc->wchan, sizeof(proc->wchan), "%s", "do_select");
+
+        snprintf(buf, sizeof(buf), "worker-%i", i % 64);
+        proc->command = strdup(buf);
+        proc->thread_name = strdup(buf);
+        snprintf(buf, sizeof(buf), "/usr/bin/worker-%i --slot %i --generation %u", i % 64, i, generation);
+        proc->arguments = strdup(buf);
+
+        processes = eina_list_append(processes, proc);
+     }
+
+   return processes;
+}
+
+static void
+bench_processes_tick(Bench *bench, Eina_Bool broadcast)
+{
+   Enigmatic *enigmatic = &bench->enigmatic;
+
+   enigmatic->poll_time = BENCH_START_TIME + bench->tick;
+   enigmatic->broadcast = broadcast;
+
+   if (enigmatic->broadcast)
+     ENIGMATIC_LOG_HEADER(enigmatic, EVENT_BROADCAST);
+
+   enigmatic_log_section_begin(enigmatic, PROCESS);
+   enigmatic_monitor_processes_list(enigmatic, &bench->processes,
+                                    bench_processes_get(bench->nprocs, bench->tick));
+   enigmatic_log_section_end(enigmatic);
+
+   ENIGMATIC_LOG_HEADER(enigmatic, EVENT_BLOCK_END);
+   bench->tick++;
+}
+
+// A log as the daemon writes it, one compressed frame per tick, with the
+// length of what went into the frames kept for throughput.
+static void
+bench_log_generate(Bench *bench)
+{
+   bench_log_init(bench, bench->path);
+
+   bench->nprocs = BENCH_LOG_PROCS;
+   bench->length = 0;
+
+   for (int i = 0; i < BENCH_LOG_TICKS; i++)
+     {
+        bench_processes_tick(bench, !i);
+        bench->length += bench->enigmatic.log.file->buf.length;
+        enigmatic_log_crush(&bench->enigmatic);
+     }
+
+   bench_log_shutdown(bench);
+   eina_hash_free(bench->processes);
+   bench->processes = NULL;
+   bench->tick = 0;
+}
+
+static uint64_t
+bench_log_diff_run(void *data)
+{
+   Bench *bench = data;
+   Message msg;
+
+   msg.type = MESG_MOD;
+   msg.object_type = PROCESS_CPU_TIME;
+
+   for (int i = 0; i < BENCH_DIFF_VALUES; i++)
+     {
+        msg.number = 1000 + (i & 0xfff);
+        enigmatic_log_diff(&bench->enigmatic, msg, bench->values[i]);
+     }
+
+   return bench->enigmatic.log.file->buf.length;
+}
+
+static void
+bench_log_diff_prepare(void *data)
+{
+   bench_log_buffer_clear(data);
+}
+
+static void
+bench_log_crush_prepare(void *data)
+{
+   Bench *bench = data;
+   Buffer *buf = &bench->enigmatic.log.file->buf;
+
+   bench_log_buffer_clear(bench);
+   buf->data = malloc(bench->saved.length);
+   EINA_SAFETY_ON_NULL_RETURN(buf->data);
+   memcpy(buf->data, bench->saved.data, bench->saved.length);
+   buf->length = bench->saved.length;
+}
+
+static uint64_t
+bench_log_crush_run(void *data)
+{
+   Bench *bench = data;
+
+   enigmatic_log_crush(&bench->enigmatic);
+
+   return bench->saved.length;
+}
+
+// Deltas of every width the encoder picks between, mostly small as they
+// are in practice.
+static int64_t *
+bench_values_get(void)
+{
+   uint32_t seed = 1;
+   int64_t *values;
+
+   values = malloc(BENCH_DIFF_VALUES * sizeof(int64_t));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(values, NULL);
+
+   for (int i = 0; i < BENCH_DIFF_VALUES; i++)
+     {
+        int64_t v = (int64_t) bench_random(&seed) - 0x4000;
+        uint32_t width = bench_random(&seed) % 8;
+
+        if (width < 5)
+          v %= 128;
+        else if (width < 7)
+          v *= 256;
+        else
+          v *= 1 << 24;
+        values[i] = v;
+     }
+
+   return values;
+}
+
+static void
+bench_log_diff(Bench *bench, int rounds)
+{
+   bench->values = bench_values_get();
+   EINA_SAFETY_ON_NULL_RETURN(bench->values);
+
+   bench_log_init(bench, "/dev/null");
+   bench_run("log-diff", rounds, bench_log_diff_prepare, bench_log_diff_run, bench);
+   bench_log_shutdown(bench);
+
+   free(bench->values);
+}
+
+static void
+bench_log_crush(Bench *bench, int rounds)
+{
+   bench->values = bench_values_get();
+   EINA_SAFETY_ON_NULL_RETURN(bench->values);
+
+   bench_log_init(bench, "/dev/null");
+   bench_log_diff_run(bench);
+   bench->saved = bench->enigmatic.log.file->buf;
+   bench->enigmatic.log.file->buf.data = NULL;
+   bench->enigmatic.log.file->buf.length = 0;
+
+   bench_run("log-crush", rounds, bench_log_crush_prepare, bench_log_crush_run, bench);
+
+   bench_log_shutdown(bench);
+   free(bench->saved.data);
+   free(bench->values);
+}
+
+static uint64_t
+bench_log_compress_run(void *data)
+{
+   Bench *bench = data;
+   struct stat st;
+
+   if (!enigmatic_log_compress(bench->path, 0))
+     ERROR("compress %s", bench->path);
+   if (stat(bench->path, &st) == -1)
+     ERROR("stat %s", bench->path);
+
+   return st.st_size;
+}
+
+static void
+bench_log_compress(Bench *bench, int rounds)
+{
+   bench_log_generate(bench);
+   bench_run("log-compress", rounds, NULL, bench_log_compress_run, bench);
+}
+
+static uint64_t
+bench_log_decompress_run(void *data)
+{
+   Bench *bench = data;
+   char *blob;
+   uint32_t length;
+
+   blob = enigmatic_log_decompress(eina_slstr_printf("%s.lz4", bench->path), &length);
+   if (!blob)
+     ERROR("decompress %s.lz4", bench->path);
+   free(blob);
+
+   return length;
+}
+
+static void
+bench_log_decompress(Bench *bench, int rounds)
+{
+   bench_log_generate(bench);
+   if (!enigmatic_log_compress(bench->path, 0))
+     ERROR("compress %s", bench->path);
+   bench_run("log-decompress", rounds, NULL, bench_log_decompress_run, bench);
+}
+
+static uint64_t
+bench_client_read_run(void *data)
+{
+   Bench *bench = data;
+   Enigmatic_Client *client;
+
+   client = enigmatic_client_path_open(strdup(bench->path));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(client, 0);
+
+   enigmatic_client_read(client);
+   enigmatic_client_del(client);
+
+   return bench->length;
+}
+
+static void
+bench_client_read(Bench *bench, int rounds)
+{
+   bench_log_generate(bench);
+   bench_run("client-read", rounds, NULL, bench_client_read_run, bench);
+}
+
+static void
+bench_processes_prepare(void *data)
+{
+   Bench *bench = data;
+
+   bench_log_buffer_clear(bench);
+}
+
+static uint64_t
+bench_processes_run(void *data)
+{
+   bench_processes_tick(data, 0);
+
+   return 0;
+}
+
+static void
+bench_processes(Bench *bench, int rounds, int nprocs, const char *name)
+{
+   bench->nprocs = nprocs;
+
+   bench_log_init(bench, "/dev/null");
+   // The first tick only fills the cache.
+   bench_processes_tick(bench, 0);
+   bench_run(name, rounds, bench_processes_prepare, bench_processes_run, bench);
+   bench_log_shutdown(bench);
+
+   eina_hash_free(bench->processes);
+}
+
+static void
+bench_processes_1k(Bench *bench, int rounds)
+{
+   bench_processes(bench, rounds, 1000, "processes-1k");
+}
+
+static void
+bench_processes_10k(Bench *bench, int rounds)
+{
+   bench_processes(bench, rounds, 10000, "processes-10k");
+}
+
+static void
+bench_processes_50k(Bench *bench, int rounds)
+{
+   bench_processes(bench, rounds, 50000, "processes-50k");
+}
+
+typedef struct
+{
+   const char *name;
+   int         rounds;
+   void       (*func)(Bench *bench, int rounds);
+} Bench_Test;
+
+static const Bench_Test tests[] = {
+   { "log-diff",       20, bench_log_diff },
+   { "log-crush",      20, bench_log_crush },
+   { "log-compress",   10, bench_log_compress },
+   { "log-decompress", 10, bench_log_decompress },
+   { "client-read",    5,  bench_client_read },
+   { "processes-1k",   20, bench_processes_1k },
+   { "processes-10k",  10, bench_processes_10k },
+   { "processes-50k",  5,  bench_processes_50k },
+};
+
+static void
+usage(int status)
+{
+   printf("usage: enigmatic_bench [name [rounds]]\n\n");
+   for (int i = 0; i < (int) EINA_C_ARRAY_LENGTH(tests); i++)
+     printf("   %s\n", tests[i].name);
+   exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+   Bench bench;
+   Eina_Tmpstr *dir = NULL;
+   int rounds = 0;
+   Eina_Bool found = 0;
+
+   if ((argc > 1) && ((!strcmp(argv[1], "-h")) || (!strcmp(argv[1], "--help"))))
+     usage(0);
+   if (argc > 2)
+     rounds = atoi(argv[2]);
+
+   ecore_init();
+   ecore_file_init();
+
+   if (!eina_file_mkdtemp("enigmatic_bench_XXXXXX", &dir))
+     ERROR("mkdtemp");
+
+   for (int i = 0; i < (int) EINA_C_ARRAY_LENGTH(tests); i++)
+     {
+        if ((argc > 1) && (strcmp(argv[1], tests[i].name))) continue;
+
+        memset(&bench, 0, sizeof(Bench));
+        snprintf(bench.path, sizeof(bench.path), "%s/%s.log", dir, tests[i].name);
+        tests[i].func(&bench, rounds ? rounds : tests[i].rounds);
+        found = 1;
+     }
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+
+   ecore_file_shutdown();
+   ecore_shutdown();
+
+   if (!found) usage(1);
+
+   return 0;
+}
@@ -0,0 +1,532 @@
+#include "Enigmatic.h"
+#include "enigmatic_log.h"
+#include "monitor/cores.h"
+#include "monitor/sensors.h"
+#include "monitor/network_interfaces.h"
+#include "monitor/processes.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+
+// Writes the logs the daemon would have written over a number of hours for
+// a made up machine. Everything follows from the seed and the start time so
+// the same options always give the same logs, which makes profiling replay
+// at sizes no real machine here has repeatable.
+
+typedef struct
+{
+   pid_t     pid;
+   int64_t   start;
+   int       name;
+   Eina_Bool active;
+   int       cpu_rate;
+   int       rss_pages;
+   int64_t   cpu_time;
+   uint64_t  net_in;
+   uint64_t  net_out;
+   uint64_t  disk_read;
+   uint64_t  disk_write;
+} Synth_Slot;
+
+typedef struct
+{
+   uint32_t      seed;
+   int           nprocs;
+   int           churn;
+   int           active;
+   int           ncores;
+   int           ninterfaces;
+   int           nsensors;
+   int           hours;
+   int           hour_length;
+   int           keyframe;
+   time_t        start;
+   const char   *dir;
+} Synth_Config;
+
+typedef struct
+{
+   Synth_Config  config;
+   Enigmatic     enigmatic;
+   System_Info   info;
+   Synth_Slot   *slots;
+   pid_t         pid_next;
+   Eina_List    *sensors;
+   uint64_t     *interfaces;
+   uint32_t      state;
+   uint64_t      length;
+   char          path[PATH_MAX];
+} Synth;
+
+static const char *names[] = {
+   "bash", "python3", "postgres", "nginx", "java", "node", "chrome", "sshd",
+   "systemd", "Xorg", "firefox", "make", "cc1", "ld", "rsync", "kworker",
+};
+
+// Two draws as the generator only hands out fifteen bits at a time.
+static uint32_t
+synth_random(Synth *synth)
+{
+   return (bench_random(&synth->state) << 15) | bench_random(&synth->state);
+}
+
+static void
+synth_slot_start(Synth *synth, Synth_Slot *slot, int64_t now)
+{
+   memset(slot, 0, sizeof(Synth_Slot));
+   slot->pid = synth->pid_next++;
+   slot->start = now;
+   slot->name = synth_random(synth) % EINA_C_ARRAY_LENGTH(names);
+   slot->active = (synth_random(synth) % 100) < (uint32_t) synth->config.active;
+   slot->cpu_rate = slot->active ? 1 + (synth_random(synth) % 100) : 0;
+   slot->rss_pages = 256 + (synth_random(synth) % 65536);
+}
+
+static Eina_List *
+synth_processes_get(Synth *synth)
+{
+   Eina_List *processes = NULL;
+   Proc_Info *proc;
+   Synth_Slot *slot;
+   int64_t now = synth->enigmatic.poll_time;
+   char buf[256];
+
+   for (int i = 0; i < synth->config.nprocs; i++)
+     {
+        slot = &synth->slots[i];
+        if ((synth_random(synth) % 1000) < (uint32_t) synth->config.churn)
+          synth_slot_start(synth, slot, now);
+        else if (slot->active)
+          {
+             slot->cpu_time += slot->cpu_rate;
+             slot->rss_pages += (int) (synth_random(synth) % 33) - 16;
+             if (slot->rss_pages < 64) slot->rss_pages = 64;
+             if (!(i % 10))
+               {
+                  slot->net_in += synth_random(synth) % 65536;
+                  slot->net_out += synth_random(synth) % 16384;
+               }
+             if (!(i % 4))
+               {
+                  slot->disk_read += (synth_random(synth) % 64) * 4096;
+                  slot->disk_write += (synth_random(synth) % 16) * 4096;
+               }
+          }
+
+        proc = calloc(1, sizeof(Proc_Info));
+        EINA_SAFETY_ON_NULL_RETURN_VAL(proc, processes);
+
+        proc->pid = slot->pid;
+        proc->ppid = i ? synth->slots[(i - 1) / 8].pid : 1;
+        proc->uid = i < 64 ? 0 : 1000 + (i % 4);
+        proc->start = slot->start;
+        proc->run_time = now - slot->start;
+        proc->numthreads = 1 + (slot->name % 5);
+        proc->cpu_id = (i + now) % synth->config.ncores;
+        proc->cpu_time = slot->cpu_time;
+        proc->mem_size = proc->mem_virt = (uint64_t) (slot->rss_pages * 4) * 4096;
+        proc->mem_rss = (uint64_t) slot->rss_pages * 4096;
+        proc->mem_shared = (uint64_t) (slot->rss_pages / 8) * 4096;
+        proc->net_in = slot->net_in;
+        proc->net_out = slot->net_out;
+        proc->disk_read = slot->disk_read;
+        proc->disk_write = slot->disk_write;
+        proc->numfiles = 3 + (i % 20);
+        snprintf(proc->state, sizeof(proc->state), "%s", slot->active ? "R" : "S");
+        snprintf(proc->wchan, sizeof(proc->wchan), "%s", slot->active ? "" : "do_select");
+
+        proc->command = strdup(names[slot->name]);
+        proc->thread_name = strdup(names[slot->name]);
+        snprintf(buf, sizeof(buf), "/usr/bin/%s --slot %i --pid %i", names[slot->name], i, slot->pid);
+        proc->arguments = strdup(buf);
+
+        processes = eina_list_append(processes, proc);
+     }
+
+   return processes;
+}
+
+static void
+synth_cores_sample(Synth *synth)
+{
+   Cores_Table *table = &synth->info.cores;
+   Cpu_Core *core;
+   unsigned long busy;
+
+   for (int i = 0; i < table->count; i++)
+     {
+        core = &table->sample[i];
+        busy = synth_random(synth) % 101;
+        core->total += 100;
+        core->idle += 100 - busy;
+        core->states[CORE_STATE_USER] += (busy * 3) / 4;
+        core->states[CORE_STATE_SYSTEM] += busy - ((busy * 3) / 4);
+        core->states[CORE_STATE_IDLE] += 100 - busy;
+        core->freq = 800 + (busy * 32);
+        core->temp = 35 + (busy / 2);
+     }
+}
+
+static Eina_Bool
+synth_cores_init(Synth *synth)
+{
+   Cores_Table *table = &synth->info.cores;
+
+   table->count = synth->config.ncores;
+   table->cores = calloc(table->count, sizeof(Cpu_Core));
+   table->sample = calloc(table->count, sizeof(Cpu_Core));
+   if ((!table->cores) || (!table->sample)) return 0;
+
+   for (int i = 0; i < table->count; i++)
+     {
+        Cpu_Core *core = &table->cores[i];
+
+        snprintf(core->name, sizeof(core->name), "cpu%i", i);
+        core->id = core->top_id = i;
+        core->unique_id = unique_id_find(&synth->enigmatic.unique_ids);
+     }
+   memcpy(table->sample, table->cores, table->count * sizeof(Cpu_Core));
+
+   return 1;
+}
+
+static Eina_List *
+synth_network_interfaces_get(Synth *synth)
+{
+   Eina_List *interfaces = NULL;
+   Network_Interface *iface;
+
+   for (int i = 0; i < synth->config.ninterfaces; i++)
+     {
+        iface = calloc(1, sizeof(Network_Interface));
+        EINA_SAFETY_ON_NULL_RETURN_VAL(iface, interfaces);
+
+        synth->interfaces[(i * 2)] += synth_random(synth) % (1 << 20);
+        synth->interfaces[(i * 2) + 1] += synth_random(synth) % (1 << 18);
+
+        snprintf(iface->name, sizeof(iface->name), "eth%i", i);
+        iface->total_in = synth->interfaces[(i * 2)];
+        iface->total_out = synth->interfaces[(i * 2) + 1];
+
+        interfaces = eina_list_append(interfaces, iface);
+     }
+
+   return interfaces;
+}
+
+static void
+synth_sensors_update(Synth *synth)
+{
+   Eina_List *l;
+   Sensor *sensor;
+
+   EINA_LIST_FOREACH(synth->sensors, l, sensor)
+     {
+        sensor->value += ((int) (synth_random(synth) % 5) - 2) * 0.5;
+        if (sensor->value < 20.0) sensor->value = 20.0;
+        else if (sensor->value > 95.0) sensor->value = 95.0;
+     }
+}
+
+static void
+synth_sensors_init(Synth *synth)
+{
+   Sensor *sensor;
+
+   for (int i = 0; i < synth->config.nsensors; i++)
+     {
+        sensor = calloc(1, sizeof(Sensor));
+        EINA_SAFETY_ON_NULL_RETURN(sensor);
+
+        snprintf(sensor->name, sizeof(sensor->name), "synth%i", i / 4);
+        snprintf(sensor->child_name, sizeof(sensor->child_name), "temp%i", 1 + (i % 4));
+        sensor->type = THERMAL;
+        sensor->value = 40.0 + (synth_random(synth) % 20);
+        synth->sensors = eina_list_append(synth->sensors, sensor);
+     }
+}
+
+// One poll as the daemon lays it out, everything sampled every second.
+static void
+synth_tick(Synth *synth)
+{
+   Enigmatic *enigmatic = &synth->enigmatic;
+
+   if (enigmatic->broadcast)
+     ENIGMATIC_LOG_HEADER(enigmatic, EVENT_BROADCAST);
+
+   synth_cores_sample(synth);
+   enigmatic_log_section_begin(enigmatic, CPU_CORE);
+   enigmatic_monitor_cores_sample(enigmatic, &synth->info.cores);
+   enigmatic_log_section_end(enigmatic);
+
+   synth_sensors_update(synth);
+   enigmatic_log_section_begin(enigmatic, SENSOR);
+   enigmatic_monitor_sensors_list(enigmatic, &synth->info.sensors, synth->sensors, 0);
+   enigmatic_log_section_end(enigmatic);
+
+   enigmatic_log_section_begin(enigmatic, NETWORK);
+   enigmatic_monitor_network_interfaces_list(enigmatic, &synth->info.network_interfaces,
+                                             synth_network_interfaces_get(synth));
+   enigmatic_log_section_end(enigmatic);
+
+   enigmatic_log_section_begin(enigmatic, PROCESS);
+   enigmatic_monitor_processes_list(enigmatic, &synth->info.processes, synth_processes_get(synth));
+   enigmatic_log_section_end(enigmatic);
+
+   ENIGMATIC_LOG_HEADER(enigmatic, EVENT_BLOCK_END);
+
+   synth->length += enigmatic->log.file->buf.length;
+   enigmatic_log_crush(enigmatic);
+}
+
+static void
+synth_log_open(Synth *synth)
+{
+   Log *file = calloc(1, sizeof(Log));
+   EINA_SAFETY_ON_NULL_RETURN(file);
+
+   snprintf(synth->path, sizeof(synth->path), "%s/%s", synth->config.dir, LOG_FILE_NAME);
+   file->flags = O_CREAT | O_WRONLY | O_TRUNC;
+   file->fd = open(synth->path, file->flags, 0600);
+   if (file->fd == -1)
+     ERROR("open %s (%s)", synth->path, strerror(errno));
+
+   synth->enigmatic.log.file = file;
+   synth->length = 0;
+}
+
+static void
+synth_log_close(Synth *synth)
+{
+   Log *file = synth->enigmatic.log.file;
+
+   close(file->fd);
+   free(file->buf.data);
+   free(file);
+   synth->enigmatic.log.file = NULL;
+}
+
+// Dated as if written at the end of the period so replay, which only trusts
+// today's and yesterday's files, picks them up.
+static void
+synth_file_time_set(const char *path, time_t t)
+{
+   struct utimbuf times;
+
+   times.actime = times.modtime = t;
+   if (utime(path, &times) == -1)
+     ERROR("utime %s (%s)", path, strerror(errno));
+}
+
+// What the daemon does on the hour, finish the log then keep it compressed
+// under the hour (or hour and minute) it covers.
+static void
+synth_log_rotate(Synth *synth, time_t period)
+{
+   Enigmatic *enigmatic = &synth->enigmatic;
+   struct tm *tm_period, tm_buf;
+   char saved[PATH_MAX], path[PATH_MAX + 16];
+
+   ENIGMATIC_LOG_HEADER(enigmatic, EVENT_EOF);
+   ENIGMATIC_LOG_HEADER(enigmatic, EVENT_LAST_RECORD);
+   enigmatic_log_crush(enigmatic);
+   synth_log_close(synth);
+
+   tm_period = localtime_r(&period, &tm_buf);
+   if (synth->config.hour_length == 3600)
+     snprintf(saved, sizeof(saved), "%s/%02i", synth->config.dir, tm_period->tm_hour);
+   else
+     snprintf(saved, sizeof(saved), "%s/%02i-%02i", synth->config.dir, tm_period->tm_hour, tm_period->tm_min);
+
+   if (rename(synth->path, saved) == -1)
+     ERROR("rename %s (%s)", saved, strerror(errno));
+   if (!enigmatic_log_compress(saved, 0))
+     ERROR("compress %s", saved);
+   unlink(saved);
+
+   snprintf(path, sizeof(path), "%s.lz4", saved);
+   synth_file_time_set(path, period + synth->config.hour_length);
+   printf("%s  %.1f MB\n", path, synth->length / (1024.0 * 1024.0));
+   fflush(stdout);
+
+   snprintf(path, sizeof(path), "%s.lz4.size", saved);
+   synth_file_time_set(path, period + synth->config.hour_length);
+
+   synth_log_open(synth);
+}
+
+static void
+synth_run(Synth *synth)
+{
+   Enigmatic *enigmatic = &synth->enigmatic;
+   Synth_Config *config = &synth->config;
+   time_t t, period, end;
+
+   synth->state = config->seed;
+   synth->pid_next = 300;
+   enigmatic->interval = INTERVAL_NORMAL;
+   enigmatic->broadcast = 1;
+
+   synth->slots = calloc(config->nprocs, sizeof(Synth_Slot));
+   synth->interfaces = calloc(config->ninterfaces * 2, sizeof(uint64_t));
+   if ((!synth->slots) || (!synth->interfaces) || (!synth_cores_init(synth)))
+     ERROR("calloc");
+
+   // The machine has been up a while, processes are of every age.
+   for (int i = 0; i < config->nprocs; i++)
+     synth_slot_start(synth, &synth->slots[i], config->start - (synth_random(synth) % 86400));
+   synth_sensors_init(synth);
+
+   synth_log_open(synth);
+
+   period = config->start;
+   end = config->start + ((time_t) config->hours * config->hour_length);
+   for (t = config->start; t < end; t++)
+     {
+        enigmatic->poll_time = t;
+        if ((t - period) >= config->hour_length)
+          {
+             synth_log_rotate(synth, period);
+             period = t;
+             enigmatic->broadcast = 1;
+          }
+        else if (!((t - config->start) % config->keyframe))
+          enigmatic->broadcast = 1;
+
+        synth_tick(synth);
+        enigmatic->broadcast = 0;
+     }
+
+   // The last period is left as the log in progress.
+   synth_log_close(synth);
+   synth_file_time_set(synth->path, end);
+   printf("%s  %.1f MB\n", synth->path, synth->length / (1024.0 * 1024.0));
+
+   free(synth->info.cores.cores);
+   free(synth->info.cores.sample);
+   eina_hash_free(synth->info.sensors);
+   eina_hash_free(synth->info.network_interfaces);
+   eina_hash_free(synth->info.processes);
+   unique_ids_free(&enigmatic->unique_ids);
+
+   Sensor *sensor;
+   EINA_LIST_FREE(synth->sensors, sensor)
+     free(sensor);
+   free(synth->interfaces);
+   free(synth->slots);
+}
+
+static void
+usage(int status)
+{
+   printf("usage: enigmatic_synth [OPTIONS] -o DIR\n\n"
+          "Writes DIR/HH.lz4 for each hour and DIR/" LOG_FILE_NAME " for the last.\n"
+          "Point DIR at ~/.cache/" PACKAGE " (with the daemon stopped) to replay them.\n\n"
+          "   -s SEED            seed (default 1)\n"
+          "   -p COUNT           processes (default 1000)\n"
+          "   -c PERMILLE        processes restarted per thousand per second (default 1)\n"
+          "   -a PERCENT         processes whose counters move (default 10)\n"
+          "   --cores COUNT      cpu cores (default 8)\n"
+          "   --interfaces COUNT network interfaces (default 2)\n"
+          "   --sensors COUNT    thermal sensors (default 4)\n"
+          "   --hours COUNT      log files written (default 1)\n"
+          "   --hour-length SECS seconds in each file, 3600 or a divisor of it in\n"
+          "                      whole minutes, files are then named HH-MM (default 3600)\n"
+          "   --keyframe SECS    seconds between full refreshes (default 900)\n"
+          "   --start TIME       first second as a unix time, without it the files\n"
+          "                      end at the current hour\n");
+   exit(status);
+}
+
+static int
+arg_int(int argc, char **argv, int *i, int min)
+{
+   int value;
+
+   if ((*i + 1) >= argc) usage(1);
+   value = atoi(argv[++(*i)]);
+   if (value < min) usage(1);
+
+   return value;
+}
+
+int
+main(int argc, char **argv)
+{
+   Synth synth;
+   Synth_Config *config = &synth.config;
+   Eina_Bool have_start = 0;
+
+   memset(&synth, 0, sizeof(Synth));
+   config->seed = 1;
+   config->nprocs = 1000;
+   config->churn = 1;
+   config->active = 10;
+   config->ncores = 8;
+   config->ninterfaces = 2;
+   config->nsensors = 4;
+   config->hours = 1;
+   config->hour_length = 3600;
+   config->keyframe = 900;
+
+   for (int i = 1; i < argc; i++)
+     {
+        if ((!strcmp(argv[i], "-h")) || (!strcmp(argv[i], "--help")))
+          usage(0);
+        else if ((!strcmp(argv[i], "-o")) && ((i + 1) < argc))
+          config->dir = argv[++i];
+        else if (!strcmp(argv[i], "-s"))
+          config->seed = arg_int(argc, argv, &i, 0);
+        else if (!strcmp(argv[i], "-p"))
+          config->nprocs = arg_int(argc, argv, &i, 1);
+        else if (!strcmp(argv[i], "-c"))
+          config->churn = arg_int(argc, argv, &i, 0);
+        else if (!strcmp(argv[i], "-a"))
+          config->active = arg_int(argc, argv, &i, 0);
+        else if (!strcmp(argv[i], "--cores"))
+          config->ncores = arg_int(argc, argv, &i, 1);
+        else if (!strcmp(argv[i], "--interfaces"))
+          config->ninterfaces = arg_int(argc, argv, &i, 0);
+        else if (!strcmp(argv[i], "--sensors"))
+          config->nsensors = arg_int(argc, argv, &i, 0);
+        else if (!strcmp(argv[i], "--hours"))
+          config->hours = arg_int(argc, argv, &i, 1);
+        else if (!strcmp(argv[i], "--hour-length"))
+          config->hour_length = arg_int(argc, argv, &i, 60);
+        else if (!strcmp(argv[i], "--keyframe"))
+          config->keyframe = arg_int(argc, argv, &i, 1);
+        else if ((!strcmp(argv[i], "--start")) && ((i + 1) < argc))
+          {
+             config->start = atoll(argv[++i]);
+             have_start = 1;
+          }
+        else usage(1);
+     }
+
+   if ((!config->dir) || (config->hour_length % 60) || (3600 % config->hour_length))
+     usage(1);
+
+   if (!have_start)
+     config->start = time(NULL) - ((time_t) (config->hours - 1) * config->hour_length);
+   config->start -= config->start % config->hour_length;
+
+   ecore_init();
+   ecore_file_init();
+
+   if ((!ecore_file_is_dir(config->dir)) && (!ecore_file_mkpath(config->dir)))
+     ERROR("mkpath %s", config->dir);
+
+   synth_run(&synth);
+
+   ecore_file_shutdown();
+   ecore_shutdown();
+
+   return 0;
+}
@@ -0,0 +1,98 @@
+#include "engine/evisum_engine.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+   Proc_Info_Log  *logs;
+   Proc_Info     **procs;
+   int             n;
+} Bench;
+
+static void
+bench_logs_fill(Bench *bench)
+{
+   for (int i = 0; i < bench->n; i++)
+     {
+        Proc_Info_Log *log = &bench->logs[i];
+
+        log->pid = 1000 + i;
+        log->ppid = i ? 1000 + ((i - 1) / 8) : 1;
+        log->uid = 1000 + (i % 4);
+        log->start = 1700000000 + i;
+        log->cpu_time = i % 7919;
+        log->mem_rss = (uint64_t) (1024 + (i % 97)) * 4096;
+        snprintf(log->state, sizeof(log->state), "%s", "S");
+        snprintf(log->wchan, sizeof(log->wchan), "%s", "do_select");
+        snprintf(log->command, sizeof(log->command), "worker-%i", i % 64);
+        snprintf(log->path, sizeof(log->path), "/usr/bin/worker-%i", i % 64);
+        snprintf(log->arguments, sizeof(log->arguments), "/usr/bin/worker-%i --slot %i", i % 64, i);
+     }
+}
+
+static void
+bench_procs_free(void *data)
+{
+   Bench *bench = data;
+
+   for (int i = 0; i < bench->n; i++)
+     {
+        proc_info_free(bench->procs[i]);
+        bench->procs[i] = NULL;
+     }
+}
+
+static uint64_t
+bench_proc_from_log_run(void *data)
+{
+   Bench *bench = data;
+
+   for (int i = 0; i < bench->n; i++)
+     bench->procs[i] = proc_info_from_log(&bench->logs[i]);
+
+   return (uint64_t) bench->n * sizeof(Proc_Info_Log);
+}
+
+static void
+bench_proc_from_log(int n, int rounds, const char *name)
+{
+   Bench bench;
+
+   bench.n = n;
+   bench.logs = calloc(n, sizeof(Proc_Info_Log));
+   bench.procs = calloc(n, sizeof(Proc_Info *));
+   if ((!bench.logs) || (!bench.procs))
+     {
+        fprintf(stderr, "ERR: out of memory\n");
+        exit(1);
+     }
+
+   bench_logs_fill(&bench);
+   bench_run(name, rounds, bench_procs_free, bench_proc_from_log_run, &bench);
+   bench_procs_free(&bench);
+
+   free(bench.procs);
+   free(bench.logs);
+}
+
+int
+main(int argc, char **argv)
+{
+   int rounds = 20;
+
+   if (argc > 1)
+     rounds = atoi(argv[1]);
+
+   eina_init();
+
+   bench_proc_from_log(1000, rounds, "proc-from-log-1k");
+   bench_proc_from_log(10000, rounds, "proc-from-log-10k");
+   bench_proc_from_log(50000, rounds, "proc-from-log-50k");
+
+   eina_shutdown();
+
+   return 0;
+}
@@ -10,9 +10,12 @@
 #include "system/machine.h"
 #include "system/file_systems.h"
 #include "system/process.h"
+#include "system/cgroups.h"
+#include "system/block_devices.h"
 
 #include <Eina.h>
 #include <Ecore.h>
+#include <Ecore_Con.h>
 #include <Eio.h>
 #include <stdint.h>
 #include <sys/types.h>
@@ -40,6 +43,16 @@ typedef struct
    Eina_List    *network_interfaces;
    Eina_List    *file_systems;
    Eina_List    *processes;
+   Eina_List    *cgroups;
+   Eina_List    *block_devices;
+
+   // Families with records since the previous snapshot callback.
+   unsigned int  families;
+
+   // Processes by pid and, as an Eina_List of Proc_Info_Log, by parent
+   // pid. Kept current from the process records as they are read.
+   Eina_Hash    *process_pids;
+   Eina_Hash    *process_children;
 } Snapshot;
 
 typedef struct _Enigmatic_Client Enigmatic_Client;
@@ -75,6 +88,17 @@ struct _Enigmatic_Client
    uint32_t              file_size;
    Buffer                buf;
    Buffer                zbuf;
+
+   // Kept for the client's lifetime so following the log allocates nothing
+   // per read. The buffers only grow.
+   struct
+   {
+      struct LZ4F_dctx_s *dctx;
+      uint8_t            *block;
+      size_t              block_size;
+      uint32_t            buf_size;
+      uint32_t            zbuf_size;
+   } decode;
    off_t                 offset;
    Eina_Bool             compressed;
 
@@ -85,6 +109,9 @@ struct _Enigmatic_Client
 
    Eina_Bool             follow;
    Eina_Bool             truncated;
+   uint32_t              skip;
+   struct _Client_Query *query;
+   struct _Client_Extract *extract;
 
    Eio_Monitor          *mon;
    Ecore_Thread         *thread;
@@ -106,6 +133,41 @@ struct _Enigmatic_Client
       uint32_t  end_time;
    } bounds;
 
+   struct
+   {
+      Ecore_Con_Server    *srv;
+      Ecore_Event_Handler *handler_add;
+      Ecore_Event_Handler *handler_del;
+      Ecore_Timer         *timer;
+      Interval             interval;
+      Eina_Bool            connected;
+   } demand;
+
+   struct
+   {
+      char                *address;
+      Ecore_Con_Server    *srv;
+      Ecore_Event_Handler *handler_add;
+      Ecore_Event_Handler *handler_del;
+      Ecore_Event_Handler *handler_data;
+      Ecore_Timer         *timer;
+      Eina_Binbuf         *pending;
+      uint32_t             epoch;
+      uint64_t             seq;
+      Eina_Bool            connected;
+      Eina_Bool            follow;
+   } stream;
+
+   struct
+   {
+      Ecore_Event_Handler *handler;
+      Ecore_Pipe          *pipe;
+      Eina_Binbuf         *pending;
+      Eina_Hash           *hash;
+      Eina_Lock            lock;
+      uint64_t             generation;
+   } arguments;
+
    /* Public */
 
    Event_Snapshot_Data   event_snapshot;
@@ -125,6 +187,10 @@ struct _Enigmatic_Client
    Event_Callback_Data   event_file_system_del;
    Event_Callback_Data   event_process_add;
    Event_Callback_Data   event_process_del;
+   Event_Callback_Data   event_cgroup_add;
+   Event_Callback_Data   event_cgroup_del;
+   Event_Callback_Data   event_block_device_add;
+   Event_Callback_Data   event_block_device_del;
 
    Event_Callback_Data   event_record_delay;
 
@@ -150,8 +216,54 @@ typedef enum
    EVENT_PROCESS_DEL       = 14,
 
    EVENT_RECORD_DELAY      = 15,
+
+   EVENT_CGROUP_ADD        = 16,
+   EVENT_CGROUP_DEL        = 17,
+
+   EVENT_BLOCK_DEVICE_ADD  = 18,
+   EVENT_BLOCK_DEVICE_DEL  = 19,
 } Enigmatic_Client_Event_Type;
 
+typedef enum
+{
+   FAMILY_CPU_CORE     = (1 << 0),
+   FAMILY_MEMORY       = (1 << 1),
+   FAMILY_SENSOR       = (1 << 2),
+   FAMILY_POWER        = (1 << 3),
+   FAMILY_BATTERY      = (1 << 4),
+   FAMILY_NETWORK      = (1 << 5),
+   FAMILY_FILE_SYSTEM  = (1 << 6),
+   FAMILY_BLOCK_DEVICE = (1 << 7),
+   FAMILY_PROCESS      = (1 << 8),
+   FAMILY_CGROUP       = (1 << 9),
+
+   FAMILY_NONE         = 0,
+   FAMILY_ALL          = 0x3ff,
+} Enigmatic_Client_Family;
+
+typedef enum
+{
+   TOP_CPU_TIME   = 0,
+   TOP_RSS_PEAK   = 1,
+   TOP_DISK_BYTES = 2,
+   TOP_NET_BYTES  = 3,
+   TOP_METRIC_MAX = 4,
+} Enigmatic_Client_Top_Metric;
+
+typedef struct
+{
+   pid_t     pid;
+   int64_t   start;
+   char      command[PROC_INFO_LOG_COMMAND_SIZE];
+   uint64_t  value;
+} Enigmatic_Client_Top_Entry;
+
+typedef struct
+{
+   int                         count[TOP_METRIC_MAX];
+   Enigmatic_Client_Top_Entry *entries[TOP_METRIC_MAX];
+} Enigmatic_Client_Top;
+
 ENIGMATIC_API Enigmatic_Client *
 enigmatic_client_open(void);
 
@@ -164,9 +276,29 @@ enigmatic_client_event_callback_add(Enigmatic_Client *client, Enigmatic_Client_E
 ENIGMATIC_API void
 enigmatic_client_read(Enigmatic_Client *client);
 
+/* Only decode records for the given families (FAMILY_ALL by default). Other sections
+ * in the log are stepped over unparsed and their snapshot lists stay empty.
+ */
+ENIGMATIC_API void
+enigmatic_client_subscribe(Enigmatic_Client *client, unsigned int families);
+
 ENIGMATIC_API Enigmatic_Client *
 enigmatic_client_path_open(char *filename);
 
+#define STREAM_BUFFER_MAX (32 * 1024 * 1024)
+
+/* Follow a daemon streaming its log (enigmatic --stream) rather than the log file, at
+ * "host:port" over TCP or on the local socket when address is NULL. Blocks are read as
+ * they arrive and the snapshot callbacks given to enigmatic_client_monitor_add fire as when
+ * following a file. Reconnects carry on after the last block read, or from the daemon's
+ * latest keyframe when it no longer has that block. Up to STREAM_BUFFER_MAX bytes wait to
+ * be read, beyond that the connection is dropped and resumed later. Over TCP the daemon
+ * wants its token, taken from ENIGMATIC_STREAM_TOKEN when set, otherwise from the file a
+ * daemon on this machine leaves for its own user.
+ */
+ENIGMATIC_API Enigmatic_Client *
+enigmatic_client_stream_open(const char *address);
+
 ENIGMATIC_API void
 enigmatic_client_del(Enigmatic_Client *client);
 
@@ -176,9 +308,35 @@ enigmatic_client_add(void);
 ENIGMATIC_API void
 enigmatic_client_follow_enabled_set(Enigmatic_Client *client, Eina_Bool enabled);
 
+/* Register with the daemon as a follower wanting samples at interval, INTERVAL_IDLE when
+ * nothing is on screen and recorded history will do. The daemon samples as fast as its
+ * fastest follower and drops to its recording cadence once none want live data. The
+ * client heartbeats from the main loop until deleted, reconnecting if the daemon restarts.
+ */
+ENIGMATIC_API void
+enigmatic_client_demand_set(Enigmatic_Client *client, Interval interval);
+
+/* A system daemon's shared log leaves process arguments out, the daemon hands them only to
+ * the process' owner or root. Ask for those of pid started at start over the connection made
+ * by enigmatic_client_demand_set. Returns a copy to free, NULL while the answer is awaited or
+ * without a connection. Safe from any thread.
+ */
+ENIGMATIC_API char *
+enigmatic_client_process_arguments_get(Enigmatic_Client *client, pid_t pid, int64_t start);
+
 ENIGMATIC_API void
 enigmatic_client_snapshot_callback_set(Enigmatic_Client *client, Snapshot_Callback *cb_event_change, void *data);
 
+/* Look up a process, or the processes whose parent is ppid, in a snapshot without walking
+ * its process list. Both belong to the snapshot and are only valid until the client reads
+ * its next record.
+ */
+ENIGMATIC_API Proc_Info_Log *
+enigmatic_client_snapshot_process_get(const Snapshot *snapshot, pid_t pid);
+
+ENIGMATIC_API const Eina_List *
+enigmatic_client_snapshot_children_get(const Snapshot *snapshot, pid_t ppid);
+
 /* Some events occur multiple times between block end. We can check for a snapshot event to reduce
  * the polling granuality when we don't want sub-second data.
  */
@@ -197,4 +355,36 @@ enigmatic_client_replay(Enigmatic_Client *client);
 ENIGMATIC_API Eina_Bool
 enigmatic_client_time_bounds_get(Enigmatic_Client *client, uint32_t *start_time, uint32_t *end_time);
 
+/* Scan the logs once for a single process, identified by pid and start time (0 matches
+ * any start), and return its samples between start_time and end_time as columns. Only
+ * that process' records are decoded, nothing else is kept in memory.
+ */
+ENIGMATIC_API Proc_Info_Series *
+enigmatic_client_process_series_get(pid_t pid, int64_t start, uint32_t start_time, uint32_t end_time);
+
+ENIGMATIC_API void
+enigmatic_client_process_series_free(Proc_Info_Series *series);
+
+/* Rollup archives keep min/avg/max summaries per core, memory, interface and the busiest
+ * processes long after the hourly logs are gone. Returns a list of Rollup_Record in time
+ * order, an end_time of 0 reads to the end. Records reach the archive when the daemon
+ * rotates its log, the current hour is only in the live log.
+ */
+ENIGMATIC_API Eina_List *
+enigmatic_client_rollup_get(Rollup_Resolution resolution, uint32_t start_time, uint32_t end_time);
+
+ENIGMATIC_API void
+enigmatic_client_rollup_free(Eina_List *records);
+
+/* Stream the logs covering start_time to end_time once and return the top n processes for
+ * each Enigmatic_Client_Top_Metric, highest first. CPU time, disk and network bytes are
+ * what each process used inside the window, RSS is the peak seen. The same 24 hour limit
+ * as enigmatic_client_replay() applies.
+ */
+ENIGMATIC_API Enigmatic_Client_Top *
+enigmatic_client_query_top(uint32_t start_time, uint32_t end_time, int n);
+
+ENIGMATIC_API void
+enigmatic_client_top_free(Enigmatic_Client_Top *top);
+
 #endif
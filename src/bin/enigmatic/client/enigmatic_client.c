@@ -16,7 +16,7 @@
 
 #include "lz4frame.h"
 
-static uint32_t specialfriend[4] = { HEADER_MAGIC, HEADER_MAGIC, HEADER_MAGIC, HEADER_MAGIC };
+static uint32_t specialfriend[4] = { HEADER_MAGIC, HEADER_MAGIC, HEADER_MAGIC, LOG_FORMAT_VERSION };
 
 #define FLOAT_VALID(x) ((x < 0) ? 0 : (x))
 #define BROADCAST_SEEK_MIN_SIZE (8 * 1024 * 1024)
@@ -47,6 +47,31 @@ free_snapshot(Snapshot *s)
    Proc_Info_Log *proc;
    EINA_LIST_FREE(s->processes, proc)
      free(proc);
+
+   if (s->process_children)
+     {
+        Eina_Iterator *it = eina_hash_iterator_data_new(s->process_children);
+        Eina_List *children;
+
+        EINA_ITERATOR_FOREACH(it, children)
+          eina_list_free(children);
+        eina_iterator_free(it);
+        eina_hash_free(s->process_children);
+        s->process_children = NULL;
+     }
+   if (s->process_pids)
+     {
+        eina_hash_free(s->process_pids);
+        s->process_pids = NULL;
+     }
+
+   Cgroup *cg;
+   EINA_LIST_FREE(s->cgroups, cg)
+     free(cg);
+
+   Block_Device *dev;
+   EINA_LIST_FREE(s->block_devices, dev)
+     free(dev);
 }
 
 static off_t
@@ -95,11 +120,62 @@ buffer_clear(Buffer *buf)
    buf->index = 0;
 }
 
+// Make room for wanted bytes, keeping what the buffer holds.
+static Eina_Bool
+buffer_reserve(Buffer *buf, uint32_t *size, size_t wanted)
+{
+   size_t n = *size ? *size : 16384;
+   uint8_t *data;
+
+   if (wanted <= *size) return 1;
+   if (wanted > UINT32_MAX) return 0;
+
+   while (n < wanted)
+     n *= 2;
+   if (n > UINT32_MAX) n = UINT32_MAX;
+
+   data = realloc(buf->data, n);
+   if (!data) return 0;
+
+   buf->data = data;
+   *size = n;
+
+   return 1;
+}
+
+static void
+buffer_rewind(Buffer *buf)
+{
+   buf->length = 0;
+   buf->index = 0;
+}
+
+static LZ4F_dctx *
+client_dctx_get(Enigmatic_Client *client)
+{
+   if ((!client->decode.dctx) &&
+       (LZ4F_isError(LZ4F_createDecompressionContext(&client->decode.dctx, LZ4F_VERSION))))
+     ERROR("create decompress context");
+
+   return client->decode.dctx;
+}
+
 static void
-enigmatic_client_reset(Enigmatic_Client *client)
+client_decode_free(Enigmatic_Client *client)
 {
+   if (client->decode.dctx)
+     LZ4F_freeDecompressionContext(client->decode.dctx);
+   free(client->decode.block);
    buffer_clear(&client->zbuf);
    buffer_clear(&client->buf);
+   memset(&client->decode, 0, sizeof(client->decode));
+}
+
+static void
+enigmatic_client_reset(Enigmatic_Client *client)
+{
+   buffer_rewind(&client->zbuf);
+   buffer_rewind(&client->buf);
    client->offset = 0;
    client->file_size = 0;
    client->truncated = 0;
@@ -233,6 +309,223 @@ buf_string_read(Enigmatic_Client *client)
    return cp;
 }
 
+static void
+proc_log_string_apply(Proc_Info_Log *proc, Object_Type type, const char *cp)
+{
+   if (type == PROCESS_COMMAND)
+     proc_log_string_set(proc->command, sizeof(proc->command), cp);
+   else if (type == PROCESS_ARGUMENTS)
+     proc_log_string_set(proc->arguments, sizeof(proc->arguments), cp);
+   else if (type == PROCESS_STATE)
+     proc_log_string_set(proc->state, sizeof(proc->state), cp);
+   else if (type == PROCESS_WCHAN)
+     proc_log_string_set(proc->wchan, sizeof(proc->wchan), cp);
+   else if (type == PROCESS_THREAD_NAME)
+     proc_log_string_set(proc->thread_name, sizeof(proc->thread_name), cp);
+   else if (type == PROCESS_PATH)
+     proc_log_string_set(proc->path, sizeof(proc->path), cp);
+}
+
+static void
+proc_log_change_apply(Proc_Info_Log *proc, Object_Type type, int64_t change)
+{
+   if (type == PROCESS_PPID)
+     proc->ppid += change;
+   else if (type == PROCESS_UID)
+     proc->uid += change;
+   else if (type == PROCESS_NICE)
+     proc->nice += change;
+   else if (type == PROCESS_PRIORITY)
+     proc->priority += change;
+   else if (type == PROCESS_CPU_ID)
+     proc->cpu_id += change;
+   else if (type == PROCESS_NUM_THREAD)
+     proc->numthreads += change;
+   else if (type == PROCESS_CPU_TIME)
+     proc->cpu_time += change;
+   else if (type == PROCESS_RUN_TIME)
+     proc->run_time += change;
+   else if (type == PROCESS_START)
+     proc->start += change;
+   else if (type == PROCESS_MEM_SIZE)
+     proc->mem_size += (change * 4096);
+   else if (type == PROCESS_MEM_RSS)
+     proc->mem_rss += (change * 4096);
+   else if (type == PROCESS_MEM_SHARED)
+     proc->mem_shared += (change * 4096);
+   else if (type == PROCESS_MEM_VIRT)
+     proc->mem_virt += (change * 4096);
+   else if (type == PROCESS_NET_IN)
+     proc->net_in += change;
+   else if (type == PROCESS_NET_OUT)
+     proc->net_out += change;
+   else if (type == PROCESS_DISK_READ)
+     proc->disk_read += change;
+   else if (type == PROCESS_DISK_WRITE)
+     proc->disk_write += change;
+   else if (type == PROCESS_NET_IN_RATE)
+     proc->net_in_rate += change;
+   else if (type == PROCESS_NET_OUT_RATE)
+     proc->net_out_rate += change;
+   else if (type == PROCESS_DISK_READ_RATE)
+     proc->disk_read_rate += change;
+   else if (type == PROCESS_DISK_WRITE_RATE)
+     proc->disk_write_rate += change;
+   else if (type == PROCESS_DELAY_CPU)
+     proc->delay_cpu += (change * 1000);
+   else if (type == PROCESS_DELAY_BLKIO)
+     proc->delay_blkio += (change * 1000);
+   else if (type == PROCESS_DELAY_SWAP)
+     proc->delay_swap += (change * 1000);
+   else if (type == PROCESS_NUM_FILES)
+     proc->numfiles += change;
+   else if (type == PROCESS_WAS_ZERO)
+     proc->was_zero = !!((int64_t) proc->was_zero + change);
+   else if (type == PROCESS_IS_KERNEL)
+     proc->is_kernel = !!((int64_t) proc->is_kernel + change);
+   else if (type == PROCESS_IS_NEW)
+     proc->is_new = !!((int64_t) proc->is_new + change);
+   else if (type == PROCESS_TID)
+     proc->tid += change;
+   else if (type == PROCESS_FDS_COUNT)
+     proc->fds_count += change;
+   else if (type == PROCESS_THREADS_COUNT)
+     proc->threads_count += change;
+   else if (type == PROCESS_CHILDREN_COUNT)
+     proc->children_count += change;
+   else if (type == PROCESS_CPU_USAGE)
+     proc->cpu_usage += change;
+}
+
+typedef struct _Client_Extract
+{
+   pid_t             pid;
+   int64_t           start;
+   uint32_t          start_time;
+   uint32_t          end_time;
+   Eina_Bool         present;
+   Proc_Info_Log     proc;
+   Proc_Info_Series *series;
+} Client_Extract;
+
+// Extraction keeps a single Proc_Info_Log up to date. Records for other
+// pids are stepped over, their deltas are sized but never applied.
+static void
+message_process_extract(Enigmatic_Client *client)
+{
+   Client_Extract *extract = client->extract;
+   Message *msg = &client->message;
+   const uint8_t *rec;
+   const char *cp;
+   int64_t change, start;
+   pid_t pid;
+
+   switch (msg->type)
+     {
+        case MESG_REFRESH:
+        case MESG_ADD:
+           if (msg->number > ((client->buf.length - client->buf.index) / sizeof(Proc_Info_Log)))
+             ERROR("Corrupt log stream: short process payload");
+           for (int i = 0; i < msg->number; i++)
+             {
+                rec = &client->buf.data[client->buf.index];
+                client->buf.index += sizeof(Proc_Info_Log);
+
+                memcpy(&pid, rec + offsetof(Proc_Info_Log, pid), sizeof(pid_t));
+                if (pid != extract->pid) continue;
+                memcpy(&start, rec + offsetof(Proc_Info_Log, start), sizeof(int64_t));
+                if ((extract->start) && (start != extract->start)) continue;
+
+                memcpy(&extract->proc, rec, sizeof(Proc_Info_Log));
+                extract->present = 1;
+             }
+           break;
+        case MESG_MOD:
+           if (client->change == CHANGE_STRING)
+             {
+                cp = buf_string_read(client);
+                if ((extract->present) && (msg->number == (unsigned int) extract->pid))
+                  proc_log_string_apply(&extract->proc, msg->object_type, cp);
+             }
+           else
+             {
+                change = change_find(client);
+                if ((extract->present) && (msg->number == (unsigned int) extract->pid))
+                  proc_log_change_apply(&extract->proc, msg->object_type, change);
+             }
+           break;
+        case MESG_DEL:
+           if (msg->number == (unsigned int) extract->pid)
+             extract->present = 0;
+           break;
+        default:
+           break;
+     }
+}
+
+// Both indexes hold pointers into the process list, nothing is freed
+// through them.
+static void
+process_index_add(Snapshot *snapshot, Proc_Info_Log *proc)
+{
+   Eina_List *children;
+
+   if (!snapshot->process_pids)
+     snapshot->process_pids = eina_hash_int32_new(NULL);
+   if (!snapshot->process_children)
+     snapshot->process_children = eina_hash_int32_new(NULL);
+   if ((!snapshot->process_pids) || (!snapshot->process_children)) return;
+
+   eina_hash_set(snapshot->process_pids, &proc->pid, proc);
+
+   children = eina_hash_find(snapshot->process_children, &proc->ppid);
+   children = eina_list_append(children, proc);
+   eina_hash_set(snapshot->process_children, &proc->ppid, children);
+}
+
+static void
+process_index_parent_del(Snapshot *snapshot, Proc_Info_Log *proc)
+{
+   Eina_List *children;
+
+   if (!snapshot->process_children) return;
+
+   children = eina_hash_find(snapshot->process_children, &proc->ppid);
+   if (!children) return;
+
+   children = eina_list_remove(children, proc);
+   if (children)
+     eina_hash_modify(snapshot->process_children, &proc->ppid, children);
+   else
+     eina_hash_del_by_key(snapshot->process_children, &proc->ppid);
+}
+
+static void
+process_index_del(Snapshot *snapshot, Proc_Info_Log *proc)
+{
+   process_index_parent_del(snapshot, proc);
+   if (snapshot->process_pids)
+     eina_hash_del(snapshot->process_pids, &proc->pid, proc);
+}
+
+static Proc_Info_Log *
+process_find(Snapshot *snapshot, pid_t pid)
+{
+   if (!snapshot->process_pids) return NULL;
+   return eina_hash_find(snapshot->process_pids, &pid);
+}
+
+// The process is gone, so are the arguments cached for it.
+static void
+arguments_forget(Enigmatic_Client *client, pid_t pid)
+{
+   if (!client->arguments.hash) return;
+
+   eina_lock_take(&client->arguments.lock);
+   eina_hash_del_by_key(client->arguments.hash, &pid);
+   eina_lock_release(&client->arguments.lock);
+}
+
 static void
 message_processes(Enigmatic_Client *client)
 {
@@ -243,6 +536,12 @@ message_processes(Enigmatic_Client *client)
    Snapshot *snapshot;
    Message *msg = &client->message;
 
+   if (client->extract)
+     {
+        message_process_extract(client);
+        return;
+     }
+
    snapshot = &client->snapshot;
 
    switch (msg->type)
@@ -251,32 +550,28 @@ message_processes(Enigmatic_Client *client)
            if (!snapshot->processes) update = 0;
            for (int i = 0; i < msg->number; i++)
              {
-                Eina_Bool found = 0;
+                Proc_Info_Log rec;
 
                 if ((client->buf.index + sizeof(Proc_Info_Log)) > client->buf.length)
                   ERROR("Corrupt log stream: short process refresh payload");
-                proc = malloc(sizeof(Proc_Info_Log));
-                EINA_SAFETY_ON_NULL_RETURN(proc);
 
-                memcpy(proc, &client->buf.data[client->buf.index], sizeof(Proc_Info_Log));
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(Proc_Info_Log));
                 client->buf.index += sizeof(Proc_Info_Log);
 
-                if (!update)
-                  snapshot->processes = eina_list_append(snapshot->processes, proc);
-                else
+                // Known processes are updated in place, only new ones allocate.
+                if ((update) && ((p2 = process_find(snapshot, rec.pid))))
                   {
-                     EINA_LIST_FOREACH(snapshot->processes, l, p2)
-                       {
-                          if (p2->pid == proc->pid)
-                            {
-                               *p2 = *proc;
-                               found = 1;
-                               break;
-                            }
-                       }
-                     if (found) free(proc);
-                     else snapshot->processes = eina_list_append(snapshot->processes, proc);
+                     process_index_del(snapshot, p2);
+                     *p2 = rec;
+                     process_index_add(snapshot, p2);
+                     continue;
                   }
+
+                proc = malloc(sizeof(Proc_Info_Log));
+                EINA_SAFETY_ON_NULL_RETURN(proc);
+                *proc = rec;
+                snapshot->processes = eina_list_append(snapshot->processes, proc);
+                process_index_add(snapshot, proc);
              }
            break;
         case MESG_ADD:
@@ -290,6 +585,7 @@ message_processes(Enigmatic_Client *client)
                 memcpy(proc, &client->buf.data[client->buf.index], sizeof(Proc_Info_Log));
                 client->buf.index += sizeof(Proc_Info_Log);
                 snapshot->processes = eina_list_append(snapshot->processes, proc);
+                process_index_add(snapshot, proc);
                 if ((client->event_process_add.callback) && (callback_fire(client)))
                   {
                      Enigmatic_Client_Event *ev = event_create(client, proc);
@@ -307,86 +603,23 @@ message_processes(Enigmatic_Client *client)
              {
                 const char *cp = buf_string_read(client);
 
-                EINA_LIST_FOREACH(snapshot->processes, l, proc)
-                  {
-                     if (proc->pid != msg->number) continue;
-
-                     if (msg->object_type == PROCESS_COMMAND)
-                       proc_log_string_set(proc->command, sizeof(proc->command), cp);
-                     else if (msg->object_type == PROCESS_ARGUMENTS)
-                       proc_log_string_set(proc->arguments, sizeof(proc->arguments), cp);
-                     else if (msg->object_type == PROCESS_STATE)
-                       proc_log_string_set(proc->state, sizeof(proc->state), cp);
-                     else if (msg->object_type == PROCESS_WCHAN)
-                       proc_log_string_set(proc->wchan, sizeof(proc->wchan), cp);
-                     else if (msg->object_type == PROCESS_THREAD_NAME)
-                       proc_log_string_set(proc->thread_name, sizeof(proc->thread_name), cp);
-                     else if (msg->object_type == PROCESS_PATH)
-                       proc_log_string_set(proc->path, sizeof(proc->path), cp);
-                     break;
-                  }
+                proc = process_find(snapshot, msg->number);
+                if (proc)
+                  proc_log_string_apply(proc, msg->object_type, cp);
              }
            else
              {
                 change = change_find(client);
-                EINA_LIST_FOREACH(snapshot->processes, l, proc)
+                proc = process_find(snapshot, msg->number);
+                // A new parent moves the process between sibling lists.
+                if ((proc) && (msg->object_type == PROCESS_PPID))
                   {
-                     if (proc->pid != msg->number) continue;
-
-                     if (msg->object_type == PROCESS_PPID)
-                       proc->ppid += change;
-                     else if (msg->object_type == PROCESS_UID)
-                       proc->uid += change;
-                     else if (msg->object_type == PROCESS_NICE)
-                       proc->nice += change;
-                     else if (msg->object_type == PROCESS_PRIORITY)
-                       proc->priority += change;
-                     else if (msg->object_type == PROCESS_CPU_ID)
-                       proc->cpu_id += change;
-                     else if (msg->object_type == PROCESS_NUM_THREAD)
-                       proc->numthreads += change;
-                     else if (msg->object_type == PROCESS_CPU_TIME)
-                       proc->cpu_time += change;
-                     else if (msg->object_type == PROCESS_RUN_TIME)
-                       proc->run_time += change;
-                     else if (msg->object_type == PROCESS_START)
-                       proc->start += change;
-                     else if (msg->object_type == PROCESS_MEM_SIZE)
-                       proc->mem_size += (change * 4096);
-                     else if (msg->object_type == PROCESS_MEM_RSS)
-                       proc->mem_rss += (change * 4096);
-                     else if (msg->object_type == PROCESS_MEM_SHARED)
-                       proc->mem_shared += (change * 4096);
-                     else if (msg->object_type == PROCESS_MEM_VIRT)
-                       proc->mem_virt += (change * 4096);
-                     else if (msg->object_type == PROCESS_NET_IN)
-                       proc->net_in += change;
-                     else if (msg->object_type == PROCESS_NET_OUT)
-                       proc->net_out += change;
-                     else if (msg->object_type == PROCESS_DISK_READ)
-                       proc->disk_read += change;
-                     else if (msg->object_type == PROCESS_DISK_WRITE)
-                       proc->disk_write += change;
-                     else if (msg->object_type == PROCESS_NUM_FILES)
-                       proc->numfiles += change;
-                     else if (msg->object_type == PROCESS_WAS_ZERO)
-                       proc->was_zero = !!((int64_t) proc->was_zero + change);
-                     else if (msg->object_type == PROCESS_IS_KERNEL)
-                       proc->is_kernel = !!((int64_t) proc->is_kernel + change);
-                     else if (msg->object_type == PROCESS_IS_NEW)
-                       proc->is_new = !!((int64_t) proc->is_new + change);
-                     else if (msg->object_type == PROCESS_TID)
-                       proc->tid += change;
-                     else if (msg->object_type == PROCESS_FDS_COUNT)
-                       proc->fds_count += change;
-                     else if (msg->object_type == PROCESS_THREADS_COUNT)
-                       proc->threads_count += change;
-                     else if (msg->object_type == PROCESS_CHILDREN_COUNT)
-                       proc->children_count += change;
-                     else if (msg->object_type == PROCESS_CPU_USAGE)
-                       proc->cpu_usage += change;
-                     break;
+                     process_index_parent_del(snapshot, proc);
+                     proc_log_change_apply(proc, msg->object_type, change);
+                     process_index_add(snapshot, proc);
                   }
+                else if (proc)
+                  proc_log_change_apply(proc, msg->object_type, change);
              }
            break;
         case MESG_DEL:
@@ -404,6 +637,8 @@ message_processes(Enigmatic_Client *client)
                                free(ev);
                             }
                        }
+                     arguments_forget(client, proc->pid);
+                     process_index_del(snapshot, proc);
                      free(proc);
                      snapshot->processes = eina_list_remove_list(snapshot->processes, l);
                   }
@@ -434,14 +669,18 @@ message_file_system(Enigmatic_Client *client)
            if (!snapshot->file_systems) update = 0;
            for (int i = 0; i < msg->number; i++)
              {
-                File_System *fs = malloc(sizeof(File_System));
-                EINA_SAFETY_ON_NULL_RETURN(fs);
+                File_System rec, *fs = &rec;
 
-                memcpy(fs, &client->buf.data[client->buf.index], sizeof(File_System));
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(File_System));
                 client->buf.index += sizeof(File_System);
 
                 if (!update)
-                  snapshot->file_systems = eina_list_append(snapshot->file_systems, fs);
+                  {
+                     fs = malloc(sizeof(File_System));
+                     EINA_SAFETY_ON_NULL_RETURN(fs);
+                     memcpy(fs, &rec, sizeof(File_System));
+                     snapshot->file_systems = eina_list_append(snapshot->file_systems, fs);
+                  }
                 else
                   {
                      EINA_LIST_FOREACH(snapshot->file_systems, l, fs2)
@@ -452,7 +691,6 @@ message_file_system(Enigmatic_Client *client)
                                fs2->usage.used = fs->usage.used;
                             }
                        }
-                     free(fs);
                   }
              }
            break;
@@ -518,10 +756,10 @@ message_file_system(Enigmatic_Client *client)
 }
 
 static void
-message_network(Enigmatic_Client *client)
+message_cgroups(Enigmatic_Client *client)
 {
    Eina_List *l, *l2;
-   Network_Interface *iface, *iface2;
+   Cgroup *cg, *cg2;
    Eina_Bool update = 1;
    int64_t change;
    Snapshot *snapshot;
@@ -532,47 +770,50 @@ message_network(Enigmatic_Client *client)
    switch (msg->type)
      {
         case MESG_REFRESH:
-           if (!snapshot->network_interfaces) update = 0;
+           if (!snapshot->cgroups) update = 0;
            for (int i = 0; i < msg->number; i++)
              {
-                Network_Interface *iface = malloc(sizeof(Network_Interface));
-                EINA_SAFETY_ON_NULL_RETURN(iface);
+                Cgroup rec, *cg = &rec;
 
-                memcpy(iface, &client->buf.data[client->buf.index], sizeof(Network_Interface));
-                client->buf.index += sizeof(Network_Interface);
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(Cgroup));
+                client->buf.index += sizeof(Cgroup);
 
                 if (!update)
-                  snapshot->network_interfaces = eina_list_append(snapshot->network_interfaces, iface);
+                  {
+                     cg = malloc(sizeof(Cgroup));
+                     EINA_SAFETY_ON_NULL_RETURN(cg);
+                     memcpy(cg, &rec, sizeof(Cgroup));
+                     snapshot->cgroups = eina_list_append(snapshot->cgroups, cg);
+                  }
                 else
                   {
-                     EINA_LIST_FOREACH(snapshot->network_interfaces, l, iface2)
+                     EINA_LIST_FOREACH(snapshot->cgroups, l, cg2)
                        {
-                          if (iface2->unique_id == iface->unique_id)
+                          if (cg2->unique_id == cg->unique_id)
                             {
-                               iface2->total_in = iface->total_in;
-                               iface2->total_out = iface->total_out;
+                               memcpy(cg2, cg, sizeof(Cgroup));
+                               break;
                             }
                        }
-                     free(iface);
                   }
              }
            break;
         case MESG_ADD:
            for (int i = 0; i < msg->number; i++)
              {
-                Network_Interface *iface = malloc(sizeof(Network_Interface));
-                EINA_SAFETY_ON_NULL_RETURN(iface);
+                Cgroup *cg = malloc(sizeof(Cgroup));
+                EINA_SAFETY_ON_NULL_RETURN(cg);
 
-                memcpy(iface, &client->buf.data[client->buf.index], sizeof(Network_Interface));
-                client->buf.index += sizeof(Network_Interface);
-                snapshot->network_interfaces = eina_list_append(snapshot->network_interfaces, iface);
-                if ((client->event_network_iface_add.callback) && (callback_fire(client)))
+                memcpy(cg, &client->buf.data[client->buf.index], sizeof(Cgroup));
+                client->buf.index += sizeof(Cgroup);
+                snapshot->cgroups = eina_list_append(snapshot->cgroups, cg);
+                if ((client->event_cgroup_add.callback) && (callback_fire(client)))
                   {
-                     Enigmatic_Client_Event *ev = event_create(client, iface);
+                     Enigmatic_Client_Event *ev = event_create(client, cg);
                      if (ev)
                        {
-                          client->event_network_iface_add.callback(client, ev,
-                                                                   client->event_network_iface_add.data);
+                          client->event_cgroup_add.callback(client, ev,
+                                                            client->event_cgroup_add.data);
                           free(ev);
                        }
                   }
@@ -580,105 +821,65 @@ message_network(Enigmatic_Client *client)
            break;
         case MESG_MOD:
            change = change_find(client);
-           EINA_LIST_FOREACH(snapshot->network_interfaces, l, iface)
+           EINA_LIST_FOREACH(snapshot->cgroups, l, cg)
              {
-                if (iface->unique_id == msg->number)
-                  {
-                     if (msg->object_type == NETWORK_INCOMING)
-                       iface->total_in += change;
-                     else if (msg->object_type == NETWORK_OUTGOING)
-                       iface->total_out += change;
-                  }
+                if (cg->unique_id != msg->number) continue;
+
+                if (msg->object_type == CGROUP_CPU_USAGE)
+                  cg->cpu_usage += change;
+                else if (msg->object_type == CGROUP_CPU_USER)
+                  cg->cpu_user += change;
+                else if (msg->object_type == CGROUP_CPU_SYSTEM)
+                  cg->cpu_system += change;
+                else if (msg->object_type == CGROUP_MEMORY_CURRENT)
+                  cg->memory_current += change;
+                else if (msg->object_type == CGROUP_IO_READ)
+                  cg->io_read += change;
+                else if (msg->object_type == CGROUP_IO_WRITE)
+                  cg->io_write += change;
+                else if (msg->object_type == CGROUP_CPU_PRESSURE)
+                  cg->cpu_pressure += change;
+                else if (msg->object_type == CGROUP_MEMORY_PRESSURE)
+                  cg->memory_pressure += change;
+                else if (msg->object_type == CGROUP_IO_PRESSURE)
+                  cg->io_pressure += change;
+                break;
              }
            break;
         case MESG_DEL:
-           EINA_LIST_FOREACH_SAFE(snapshot->network_interfaces, l, l2, iface)
+           EINA_LIST_FOREACH_SAFE(snapshot->cgroups, l, l2, cg)
              {
-                if (iface->unique_id == msg->number)
+                if (cg->unique_id == msg->number)
                   {
-                     if ((client->event_network_iface_del.callback) && (callback_fire(client)))
+                     if ((client->event_cgroup_del.callback) && (callback_fire(client)))
                        {
-                          Enigmatic_Client_Event *ev = event_create(client, iface);
+                          Enigmatic_Client_Event *ev = event_create(client, cg);
                           if (ev)
                             {
-                               client->event_network_iface_del.callback(client, ev,
-                                                                        client->event_network_iface_del.data);
+                               client->event_cgroup_del.callback(client, ev,
+                                                                 client->event_cgroup_del.data);
                                free(ev);
                             }
                        }
-                     free(iface);
-                     snapshot->network_interfaces = eina_list_remove_list(snapshot->network_interfaces, l);
+                     free(cg);
+                     snapshot->cgroups = eina_list_remove_list(snapshot->cgroups, l);
                   }
              }
            break;
         default:
-           fprintf(stderr, "message_network!!!\n");
+           fprintf(stderr, "message_cgroups!!!\n");
            exit(1);
      }
-   client->changes |= NETWORK;
-}
-
-static void
-message_power(Enigmatic_Client *client)
-{
-   Eina_Bool *change;
-   Snapshot *snapshot;
-   Message *msg = &client->message;
-
-   snapshot = &client->snapshot;
-
-   switch (msg->type)
-     {
-        case MESG_REFRESH:
-           memcpy(&snapshot->power, &client->buf.data[client->buf.index], sizeof(Eina_Bool));
-           client->buf.index += sizeof(Eina_Bool);
-           break;
-        case MESG_MOD:
-           change = (Eina_Bool *) &client->buf.data[client->buf.index];
-           switch (msg->object_type)
-             {
-                case POWER_VALUE:
-                   snapshot->power = *change;
-                   if ((snapshot->power) && (client->event_power_supply_add.callback) && (callback_fire(client)))
-                     {
-                        Enigmatic_Client_Event *ev = event_create(client, &snapshot->power);
-                        if (ev)
-                          {
-                             client->event_power_supply_add.callback(client, ev,
-                                                                     client->event_power_supply_add.data);
-                             free(ev);
-                          }
-                     }
-                   else if ((client->event_power_supply_del.callback) && (callback_fire(client)))
-                     {
-                        Enigmatic_Client_Event *ev = event_create(client, &snapshot->power);
-                        if (ev)
-                          {
-                             client->event_power_supply_del.callback(client, ev,
-                                                                     client->event_power_supply_del.data);
-                             free(ev);
-                          }
-                     }
-                   break;
-                default:
-                   fprintf(stderr, "message_power!!!\n");
-                   exit(1);
-             }
-           client->buf.index += 1;
-           break;
-        default:
-           break;
-     }
-   client->changes |= POWER;
+   client->changes |= CGROUP;
 }
 
 static void
-message_sensors(Enigmatic_Client *client)
+message_block_devices(Enigmatic_Client *client)
 {
    Eina_List *l, *l2;
-   Sensor *sensor, *s1;
+   Block_Device *dev, *dev2;
    Eina_Bool update = 1;
-   float change;
+   int64_t change;
    Snapshot *snapshot;
    Message *msg = &client->message;
 
@@ -687,56 +888,329 @@ message_sensors(Enigmatic_Client *client)
    switch (msg->type)
      {
         case MESG_REFRESH:
-           if (!snapshot->sensors) update = 0;
+           if (!snapshot->block_devices) update = 0;
            for (int i = 0; i < msg->number; i++)
              {
-                Sensor *sensor = malloc(sizeof(Sensor));
-                EINA_SAFETY_ON_NULL_RETURN(sensor);
+                Block_Device rec, *dev = &rec;
 
-                memcpy(sensor, &client->buf.data[client->buf.index], sizeof(Sensor));
-                client->buf.index += sizeof(Sensor);
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(Block_Device));
+                client->buf.index += sizeof(Block_Device);
 
                 if (!update)
-                  snapshot->sensors = eina_list_append(snapshot->sensors, sensor);
+                  {
+                     dev = malloc(sizeof(Block_Device));
+                     EINA_SAFETY_ON_NULL_RETURN(dev);
+                     memcpy(dev, &rec, sizeof(Block_Device));
+                     snapshot->block_devices = eina_list_append(snapshot->block_devices, dev);
+                  }
                 else
                   {
-                     EINA_LIST_FOREACH(snapshot->sensors, l, s1)
+                     EINA_LIST_FOREACH(snapshot->block_devices, l, dev2)
                        {
-                          if (s1->unique_id == sensor->unique_id)
-                            sensor->value = s1->value;
+                          if (dev2->unique_id == dev->unique_id)
+                            {
+                               memcpy(dev2, dev, sizeof(Block_Device));
+                               break;
+                            }
                        }
-                     free(sensor);
                   }
              }
            break;
         case MESG_ADD:
            for (int i = 0; i < msg->number; i++)
              {
-                Sensor *sensor = malloc(sizeof(Sensor));
-                EINA_SAFETY_ON_NULL_RETURN(sensor);
+                Block_Device *dev = malloc(sizeof(Block_Device));
+                EINA_SAFETY_ON_NULL_RETURN(dev);
 
-                memcpy(sensor, &client->buf.data[client->buf.index], sizeof(Sensor));
-                client->buf.index += sizeof(Sensor);
-                snapshot->sensors = eina_list_append(snapshot->sensors, sensor);
-                if ((client->event_sensor_add.callback) && (callback_fire(client)))
+                memcpy(dev, &client->buf.data[client->buf.index], sizeof(Block_Device));
+                client->buf.index += sizeof(Block_Device);
+                snapshot->block_devices = eina_list_append(snapshot->block_devices, dev);
+                if ((client->event_block_device_add.callback) && (callback_fire(client)))
                   {
-                     Enigmatic_Client_Event *ev = event_create(client, sensor);
+                     Enigmatic_Client_Event *ev = event_create(client, dev);
                      if (ev)
                        {
-                          client->event_sensor_add.callback(client, ev, client->event_sensor_add.data);
+                          client->event_block_device_add.callback(client, ev,
+                                                                  client->event_block_device_add.data);
                           free(ev);
                        }
                   }
              }
            break;
         case MESG_MOD:
-           change = change_float(client);
-           EINA_LIST_FOREACH(snapshot->sensors, l, sensor)
+           change = change_find(client);
+           EINA_LIST_FOREACH(snapshot->block_devices, l, dev)
              {
-                if (sensor->unique_id == msg->number)
-                  {
-                     if (msg->object_type == SENSOR_VALUE)
-                       sensor->value = FLOAT_VALID(sensor->value + change);
+                if (dev->unique_id != msg->number) continue;
+
+                if (msg->object_type == BLOCK_DEVICE_READS)
+                  dev->reads += change;
+                else if (msg->object_type == BLOCK_DEVICE_WRITES)
+                  dev->writes += change;
+                else if (msg->object_type == BLOCK_DEVICE_READ_BYTES)
+                  dev->read_bytes += change;
+                else if (msg->object_type == BLOCK_DEVICE_WRITE_BYTES)
+                  dev->write_bytes += change;
+                else if (msg->object_type == BLOCK_DEVICE_IO_TIME)
+                  dev->io_time += change;
+                else if (msg->object_type == BLOCK_DEVICE_QUEUE_TIME)
+                  dev->queue_time += change;
+                break;
+             }
+           break;
+        case MESG_DEL:
+           EINA_LIST_FOREACH_SAFE(snapshot->block_devices, l, l2, dev)
+             {
+                if (dev->unique_id == msg->number)
+                  {
+                     if ((client->event_block_device_del.callback) && (callback_fire(client)))
+                       {
+                          Enigmatic_Client_Event *ev = event_create(client, dev);
+                          if (ev)
+                            {
+                               client->event_block_device_del.callback(client, ev,
+                                                                       client->event_block_device_del.data);
+                               free(ev);
+                            }
+                       }
+                     free(dev);
+                     snapshot->block_devices = eina_list_remove_list(snapshot->block_devices, l);
+                  }
+             }
+           break;
+        default:
+           fprintf(stderr, "message_block_devices!!!\n");
+           exit(1);
+     }
+   client->changes |= BLOCK_DEVICE;
+}
+
+static void
+message_network(Enigmatic_Client *client)
+{
+   Eina_List *l, *l2;
+   Network_Interface *iface, *iface2;
+   Eina_Bool update = 1;
+   int64_t change;
+   Snapshot *snapshot;
+   Message *msg = &client->message;
+
+   snapshot = &client->snapshot;
+
+   switch (msg->type)
+     {
+        case MESG_REFRESH:
+           if (!snapshot->network_interfaces) update = 0;
+           for (int i = 0; i < msg->number; i++)
+             {
+                Network_Interface rec, *iface = &rec;
+
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(Network_Interface));
+                client->buf.index += sizeof(Network_Interface);
+
+                if (!update)
+                  {
+                     iface = malloc(sizeof(Network_Interface));
+                     EINA_SAFETY_ON_NULL_RETURN(iface);
+                     memcpy(iface, &rec, sizeof(Network_Interface));
+                     snapshot->network_interfaces = eina_list_append(snapshot->network_interfaces, iface);
+                  }
+                else
+                  {
+                     EINA_LIST_FOREACH(snapshot->network_interfaces, l, iface2)
+                       {
+                          if (iface2->unique_id == iface->unique_id)
+                            {
+                               iface2->total_in = iface->total_in;
+                               iface2->total_out = iface->total_out;
+                            }
+                       }
+                  }
+             }
+           break;
+        case MESG_ADD:
+           for (int i = 0; i < msg->number; i++)
+             {
+                Network_Interface *iface = malloc(sizeof(Network_Interface));
+                EINA_SAFETY_ON_NULL_RETURN(iface);
+
+                memcpy(iface, &client->buf.data[client->buf.index], sizeof(Network_Interface));
+                client->buf.index += sizeof(Network_Interface);
+                snapshot->network_interfaces = eina_list_append(snapshot->network_interfaces, iface);
+                if ((client->event_network_iface_add.callback) && (callback_fire(client)))
+                  {
+                     Enigmatic_Client_Event *ev = event_create(client, iface);
+                     if (ev)
+                       {
+                          client->event_network_iface_add.callback(client, ev,
+                                                                   client->event_network_iface_add.data);
+                          free(ev);
+                       }
+                  }
+             }
+           break;
+        case MESG_MOD:
+           change = change_find(client);
+           EINA_LIST_FOREACH(snapshot->network_interfaces, l, iface)
+             {
+                if (iface->unique_id == msg->number)
+                  {
+                     if (msg->object_type == NETWORK_INCOMING)
+                       iface->total_in += change;
+                     else if (msg->object_type == NETWORK_OUTGOING)
+                       iface->total_out += change;
+                  }
+             }
+           break;
+        case MESG_DEL:
+           EINA_LIST_FOREACH_SAFE(snapshot->network_interfaces, l, l2, iface)
+             {
+                if (iface->unique_id == msg->number)
+                  {
+                     if ((client->event_network_iface_del.callback) && (callback_fire(client)))
+                       {
+                          Enigmatic_Client_Event *ev = event_create(client, iface);
+                          if (ev)
+                            {
+                               client->event_network_iface_del.callback(client, ev,
+                                                                        client->event_network_iface_del.data);
+                               free(ev);
+                            }
+                       }
+                     free(iface);
+                     snapshot->network_interfaces = eina_list_remove_list(snapshot->network_interfaces, l);
+                  }
+             }
+           break;
+        default:
+           fprintf(stderr, "message_network!!!\n");
+           exit(1);
+     }
+   client->changes |= NETWORK;
+}
+
+static void
+message_power(Enigmatic_Client *client)
+{
+   Eina_Bool *change;
+   Snapshot *snapshot;
+   Message *msg = &client->message;
+
+   snapshot = &client->snapshot;
+
+   switch (msg->type)
+     {
+        case MESG_REFRESH:
+           memcpy(&snapshot->power, &client->buf.data[client->buf.index], sizeof(Eina_Bool));
+           client->buf.index += sizeof(Eina_Bool);
+           break;
+        case MESG_MOD:
+           change = (Eina_Bool *) &client->buf.data[client->buf.index];
+           switch (msg->object_type)
+             {
+                case POWER_VALUE:
+                   snapshot->power = *change;
+                   if ((snapshot->power) && (client->event_power_supply_add.callback) && (callback_fire(client)))
+                     {
+                        Enigmatic_Client_Event *ev = event_create(client, &snapshot->power);
+                        if (ev)
+                          {
+                             client->event_power_supply_add.callback(client, ev,
+                                                                     client->event_power_supply_add.data);
+                             free(ev);
+                          }
+                     }
+                   else if ((client->event_power_supply_del.callback) && (callback_fire(client)))
+                     {
+                        Enigmatic_Client_Event *ev = event_create(client, &snapshot->power);
+                        if (ev)
+                          {
+                             client->event_power_supply_del.callback(client, ev,
+                                                                     client->event_power_supply_del.data);
+                             free(ev);
+                          }
+                     }
+                   break;
+                default:
+                   fprintf(stderr, "message_power!!!\n");
+                   exit(1);
+             }
+           client->buf.index += 1;
+           break;
+        default:
+           break;
+     }
+   client->changes |= POWER;
+}
+
+static void
+message_sensors(Enigmatic_Client *client)
+{
+   Eina_List *l, *l2;
+   Sensor *sensor, *s1;
+   Eina_Bool update = 1;
+   float change;
+   Snapshot *snapshot;
+   Message *msg = &client->message;
+
+   snapshot = &client->snapshot;
+
+   switch (msg->type)
+     {
+        case MESG_REFRESH:
+           if (!snapshot->sensors) update = 0;
+           for (int i = 0; i < msg->number; i++)
+             {
+                Sensor rec, *sensor = &rec;
+
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(Sensor));
+                client->buf.index += sizeof(Sensor);
+
+                if (!update)
+                  {
+                     sensor = malloc(sizeof(Sensor));
+                     EINA_SAFETY_ON_NULL_RETURN(sensor);
+                     memcpy(sensor, &rec, sizeof(Sensor));
+                     snapshot->sensors = eina_list_append(snapshot->sensors, sensor);
+                  }
+                else
+                  {
+                     EINA_LIST_FOREACH(snapshot->sensors, l, s1)
+                       {
+                          if (s1->unique_id == sensor->unique_id)
+                            sensor->value = s1->value;
+                       }
+                  }
+             }
+           break;
+        case MESG_ADD:
+           for (int i = 0; i < msg->number; i++)
+             {
+                Sensor *sensor = malloc(sizeof(Sensor));
+                EINA_SAFETY_ON_NULL_RETURN(sensor);
+
+                memcpy(sensor, &client->buf.data[client->buf.index], sizeof(Sensor));
+                client->buf.index += sizeof(Sensor);
+                snapshot->sensors = eina_list_append(snapshot->sensors, sensor);
+                if ((client->event_sensor_add.callback) && (callback_fire(client)))
+                  {
+                     Enigmatic_Client_Event *ev = event_create(client, sensor);
+                     if (ev)
+                       {
+                          client->event_sensor_add.callback(client, ev, client->event_sensor_add.data);
+                          free(ev);
+                       }
+                  }
+             }
+           break;
+        case MESG_MOD:
+           change = change_float(client);
+           EINA_LIST_FOREACH(snapshot->sensors, l, sensor)
+             {
+                if (sensor->unique_id == msg->number)
+                  {
+                     if (msg->object_type == SENSOR_VALUE)
+                       sensor->value = FLOAT_VALID(sensor->value + change);
                   }
              }
            break;
@@ -785,14 +1259,18 @@ message_batteries(Enigmatic_Client *client)
            if (!snapshot->batteries) update = 0;
            for (int i = 0; i < msg->number; i++)
              {
-                Battery *bat = malloc(sizeof(Battery));
-                EINA_SAFETY_ON_NULL_RETURN(bat);
+                Battery rec, *bat = &rec;
 
-                memcpy(bat, &client->buf.data[client->buf.index], sizeof(Battery));
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(Battery));
                 client->buf.index += sizeof(Battery);
 
                 if (!update)
-                  snapshot->batteries = eina_list_append(snapshot->batteries, bat);
+                  {
+                     bat = malloc(sizeof(Battery));
+                     EINA_SAFETY_ON_NULL_RETURN(bat);
+                     memcpy(bat, &rec, sizeof(Battery));
+                     snapshot->batteries = eina_list_append(snapshot->batteries, bat);
+                  }
                 else
                   {
                      EINA_LIST_FOREACH(snapshot->batteries, l, b1)
@@ -804,7 +1282,6 @@ message_batteries(Enigmatic_Client *client)
                                bat->charge_current = b1->charge_current;
                             }
                        }
-                     free(bat);
                   }
              }
            break;
@@ -947,14 +1424,18 @@ message_cores(Enigmatic_Client *client)
            if (!snapshot->cores) update = 0;
            for (int i = 0; i < msg->number; i++)
              {
-                Cpu_Core *core = malloc(sizeof(Cpu_Core));
-                EINA_SAFETY_ON_NULL_RETURN(core);
+                Cpu_Core rec, *core = &rec;
 
-                memcpy(core, &client->buf.data[client->buf.index], sizeof(Cpu_Core));
+                memcpy(&rec, &client->buf.data[client->buf.index], sizeof(Cpu_Core));
                 client->buf.index += sizeof(Cpu_Core);
 
                 if (!update)
-                  snapshot->cores = eina_list_append(snapshot->cores, core);
+                  {
+                     core = malloc(sizeof(Cpu_Core));
+                     EINA_SAFETY_ON_NULL_RETURN(core);
+                     memcpy(core, &rec, sizeof(Cpu_Core));
+                     snapshot->cores = eina_list_append(snapshot->cores, core);
+                  }
                 else
                   {
                      EINA_LIST_FOREACH(snapshot->cores, l, c1)
@@ -966,7 +1447,6 @@ message_cores(Enigmatic_Client *client)
                                core->freq = c1->freq;
                             }
                        }
-                     free(core);
                   }
              }
            break;
@@ -1004,6 +1484,8 @@ message_cores(Enigmatic_Client *client)
                        core->temp += change;
                      else if (msg->object_type == CPU_CORE_FREQ)
                        core->freq += change;
+                     else if ((msg->object_type >= CPU_CORE_USER) && (msg->object_type <= CPU_CORE_STEAL))
+                       core->state_percent[msg->object_type - CPU_CORE_USER] += change;
                   }
              }
            break;
@@ -1064,6 +1546,12 @@ message_refresh(Enigmatic_Client *client)
         case PROCESS:
            message_processes(client);
            break;
+        case CGROUP:
+           message_cgroups(client);
+           break;
+        case BLOCK_DEVICE:
+           message_block_devices(client);
+           break;
         default:
            break;
      }
@@ -1099,6 +1587,12 @@ message_add(Enigmatic_Client *client)
         case PROCESS:
            message_processes(client);
            break;
+        case CGROUP:
+           message_cgroups(client);
+           break;
+        case BLOCK_DEVICE:
+           message_block_devices(client);
+           break;
         default:
            break;
      }
@@ -1120,6 +1614,14 @@ message_mod(Enigmatic_Client *client)
         case CPU_CORE_PERC:
         case CPU_CORE_TEMP:
         case CPU_CORE_FREQ:
+        case CPU_CORE_USER:
+        case CPU_CORE_NICE:
+        case CPU_CORE_SYSTEM:
+        case CPU_CORE_IDLE:
+        case CPU_CORE_IOWAIT:
+        case CPU_CORE_IRQ:
+        case CPU_CORE_SOFTIRQ:
+        case CPU_CORE_STEAL:
            message_cores(client);
            break;
         case MEMORY_TOTAL:
@@ -1184,8 +1686,34 @@ message_mod(Enigmatic_Client *client)
         case PROCESS_CHILDREN_COUNT:
         case PROCESS_PATH:
         case PROCESS_CPU_USAGE:
+        case PROCESS_DELAY_CPU:
+        case PROCESS_DELAY_BLKIO:
+        case PROCESS_DELAY_SWAP:
+        case PROCESS_NET_IN_RATE:
+        case PROCESS_NET_OUT_RATE:
+        case PROCESS_DISK_READ_RATE:
+        case PROCESS_DISK_WRITE_RATE:
            message_processes(client);
            break;
+        case CGROUP_CPU_USAGE:
+        case CGROUP_CPU_USER:
+        case CGROUP_CPU_SYSTEM:
+        case CGROUP_MEMORY_CURRENT:
+        case CGROUP_IO_READ:
+        case CGROUP_IO_WRITE:
+        case CGROUP_CPU_PRESSURE:
+        case CGROUP_MEMORY_PRESSURE:
+        case CGROUP_IO_PRESSURE:
+           message_cgroups(client);
+           break;
+        case BLOCK_DEVICE_READS:
+        case BLOCK_DEVICE_WRITES:
+        case BLOCK_DEVICE_READ_BYTES:
+        case BLOCK_DEVICE_WRITE_BYTES:
+        case BLOCK_DEVICE_IO_TIME:
+        case BLOCK_DEVICE_QUEUE_TIME:
+           message_block_devices(client);
+           break;
         default:
            break;
       }
@@ -1218,6 +1746,12 @@ message_del(Enigmatic_Client *client)
         case PROCESS:
            message_processes(client);
            break;
+        case CGROUP:
+           message_cgroups(client);
+           break;
+        case BLOCK_DEVICE:
+           message_block_devices(client);
+           break;
         default:
            break;
       }
@@ -1250,10 +1784,124 @@ event_message(Enigmatic_Client *client)
      }
 }
 
+typedef struct
+{
+   pid_t     pid;
+   int64_t   start;
+   char      command[PROC_INFO_LOG_COMMAND_SIZE];
+   uint64_t  cpu_time[2];
+   uint64_t  disk[2];
+   uint64_t  net[2];
+   uint64_t  rss_peak;
+} Client_Query_Proc;
+
+typedef struct _Client_Query Client_Query;
+
+struct _Client_Query
+{
+   uint32_t   start_time;
+   uint32_t   end_time;
+   Eina_Hash *procs;
+};
+
+// Fold the current process state into the query totals. Only two samples
+// per process are kept (the first and the latest inside the window) so the
+// cost is one hash lookup per process per block.
 static void
-event_block_end(Enigmatic_Client *client)
+query_block_end(Enigmatic_Client *client)
 {
-   client->snapshot.time = client->header.time;
+   Client_Query *query = client->query;
+   Client_Query_Proc *qp;
+   Proc_Info_Log *proc;
+   Eina_List *l;
+   int64_t key;
+
+   if ((client->header.time < query->start_time) || (client->header.time > query->end_time))
+     return;
+
+   EINA_LIST_FOREACH(client->snapshot.processes, l, proc)
+     {
+        key = (proc->start << 32) | (uint32_t) proc->pid;
+        qp = eina_hash_find(query->procs, &key);
+        if (!qp)
+          {
+             qp = calloc(1, sizeof(Client_Query_Proc));
+             EINA_SAFETY_ON_NULL_RETURN(qp);
+
+             qp->pid = proc->pid;
+             qp->start = proc->start;
+             // A process born inside the window used all of its counters
+             // inside it.
+             if (proc->start < query->start_time)
+               {
+                  qp->cpu_time[0] = proc->cpu_time;
+                  qp->disk[0] = proc->disk_read + proc->disk_write;
+                  qp->net[0] = proc->net_in + proc->net_out;
+               }
+             eina_hash_add(query->procs, &key, qp);
+          }
+
+        snprintf(qp->command, sizeof(qp->command), "%s", proc->command);
+        qp->cpu_time[1] = proc->cpu_time;
+        qp->disk[1] = proc->disk_read + proc->disk_write;
+        qp->net[1] = proc->net_in + proc->net_out;
+        if (proc->mem_rss > qp->rss_peak)
+          qp->rss_peak = proc->mem_rss;
+     }
+}
+
+static void
+extract_block_end(Enigmatic_Client *client)
+{
+   Client_Extract *extract = client->extract;
+   Proc_Info_Series *series = extract->series;
+   Proc_Info_Log *proc = &extract->proc;
+   uint32_t size, i;
+
+   if ((!extract->present) || (!series)) return;
+   if ((client->header.time < extract->start_time) || (client->header.time > extract->end_time))
+     return;
+
+   if (series->count == series->size)
+     {
+        size = series->size ? series->size * 2 : 256;
+#define SERIES_GROW(col) \
+   do { \
+      void *tmp = realloc(series->col, size * sizeof(*series->col)); \
+      if (!tmp) return; \
+      series->col = tmp; \
+   } while (0)
+        SERIES_GROW(time);
+        SERIES_GROW(cpu_usage);
+        SERIES_GROW(mem_rss);
+        SERIES_GROW(numthreads);
+        SERIES_GROW(fds_count);
+        SERIES_GROW(disk_read);
+        SERIES_GROW(disk_write);
+        SERIES_GROW(net_in);
+        SERIES_GROW(net_out);
+#undef SERIES_GROW
+        series->size = size;
+     }
+
+   i = series->count++;
+   series->pid = proc->pid;
+   series->start = proc->start;
+   series->time[i] = client->header.time;
+   series->cpu_usage[i] = proc->cpu_usage;
+   series->mem_rss[i] = proc->mem_rss;
+   series->numthreads[i] = proc->numthreads;
+   series->fds_count[i] = proc->fds_count;
+   series->disk_read[i] = proc->disk_read;
+   series->disk_write[i] = proc->disk_write;
+   series->net_in[i] = proc->net_in;
+   series->net_out[i] = proc->net_out;
+}
+
+static void
+event_block_end(Enigmatic_Client *client)
+{
+   client->snapshot.time = client->header.time;
    if (!client->bounds.valid)
      {
         client->bounds.start_time = client->header.time;
@@ -1261,21 +1909,36 @@ event_block_end(Enigmatic_Client *client)
      }
    client->bounds.end_time = client->header.time;
 
+   if (client->query)
+     query_block_end(client);
+   if (client->extract)
+     extract_block_end(client);
+
    if ((!client->follow) && (client->event_snapshot.callback) && (callback_fire(client)))
      {
         client->event_snapshot.callback(client, &client->snapshot, client->event_snapshot.data);
+        client->snapshot.families = 0;
      }
 }
 
 static void
 event_broadcast(Enigmatic_Client *client)
 {
+   uint32_t friend_buf[4];
+
    if ((client->buf.index + sizeof(Interval) + sizeof(specialfriend)) > client->buf.length)
      ERROR("Corrupt log stream: short broadcast header");
 
    memcpy(&client->interval, &client->buf.data[client->buf.index], sizeof(Interval));
    client->buf.index += sizeof(Interval);
+   memcpy(friend_buf, &client->buf.data[client->buf.index], sizeof(friend_buf));
    client->buf.index += sizeof(specialfriend);
+
+   if (memcmp(friend_buf, specialfriend, 3 * sizeof(uint32_t)))
+     ERROR("Corrupt log stream: bad broadcast magic");
+   if (friend_buf[3] != LOG_FORMAT_VERSION)
+     ERROR("Log format %u is not supported, expected %u", friend_buf[3], LOG_FORMAT_VERSION);
+
    if (client->snapshot.last_record)
      {
         if ((client->event_record_delay.callback) && (callback_fire(client)))
@@ -1297,6 +1960,58 @@ event_broadcast(Enigmatic_Client *client)
      }
 }
 
+static unsigned int
+section_family(Object_Type family)
+{
+   switch (family)
+     {
+        case CPU_CORE:
+          return FAMILY_CPU_CORE;
+        case MEMORY:
+          return FAMILY_MEMORY;
+        case SENSOR:
+          return FAMILY_SENSOR;
+        case POWER:
+          return FAMILY_POWER;
+        case BATTERY:
+          return FAMILY_BATTERY;
+        case NETWORK:
+          return FAMILY_NETWORK;
+        case FILE_SYSTEM:
+          return FAMILY_FILE_SYSTEM;
+        case BLOCK_DEVICE:
+          return FAMILY_BLOCK_DEVICE;
+        case PROCESS:
+          return FAMILY_PROCESS;
+        case CGROUP:
+          return FAMILY_CGROUP;
+        default:
+          break;
+     }
+   return FAMILY_NONE;
+}
+
+static void
+event_section(Enigmatic_Client *client)
+{
+   Section section;
+
+   if ((client->buf.index + sizeof(Section)) > client->buf.length)
+     ERROR("Corrupt log stream: short section header");
+
+   memcpy(&section, &client->buf.data[client->buf.index], sizeof(Section));
+   client->buf.index += sizeof(Section);
+
+   if ((client->buf.index + section.length) > client->buf.length)
+     ERROR("Corrupt log stream: short section payload");
+
+   // Records inside a wanted section are read as usual by the main loop.
+   if (client->skip & section_family(section.family))
+     client->buf.index += section.length;
+   else
+     client->snapshot.families |= section_family(section.family);
+}
+
 static void
 event_last_record(Enigmatic_Client *client)
 {
@@ -1304,85 +2019,743 @@ event_last_record(Enigmatic_Client *client)
    free_snapshot(&client->snapshot);
 }
 
-static void
-event_end_of_file(Enigmatic_Client *client EINA_UNUSED)
+static void
+event_end_of_file(Enigmatic_Client *client EINA_UNUSED)
+{
+
+}
+
+static Eina_Bool
+client_filename_is_compressed(const char *filename)
+{
+   const char *ext;
+
+   if (!filename) return 0;
+
+   ext = strrchr(filename, '.');
+
+   return ((ext) && (!strcmp(ext, ".lz4")));
+}
+
+static Eina_Bool
+client_log_open(Enigmatic_Client *client)
+{
+   if ((!client) || (!client->filename)) return 0;
+   if (client->compressed) return 1;
+   if (client->fd != -1) return 1;
+
+   client->fd = open(client->filename, O_RDONLY);
+   if (client->fd == -1)
+     return 0;
+
+   client->retries = 0;
+
+   return 1;
+}
+
+Enigmatic_Client *
+enigmatic_client_open(void)
+{
+   return enigmatic_client_path_open(enigmatic_log_path());
+}
+
+Enigmatic_Client *
+enigmatic_client_path_open(char *filename)
+{
+   Enigmatic_Client *client = calloc(1, sizeof(Enigmatic_Client));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(client, NULL);
+
+   client->fd = -1;
+   client->directory = enigmatic_log_directory();
+   client->filename = filename;
+   client->compressed = client_filename_is_compressed(filename);
+
+   client_log_open(client);
+
+   return client;
+}
+
+static Eina_Bool
+enigmatic_client_reopen(Enigmatic_Client *client, char *filename)
+{
+   enigmatic_client_reset(client);
+
+   if (client->fd != -1)
+     close(client->fd);
+   if (client->filename)
+     free(client->filename);
+   if (client->directory)
+     free(client->directory);
+   client->fd = -1;
+   client->directory = enigmatic_log_directory();
+   client->filename = filename;
+   client->compressed = client_filename_is_compressed(filename);
+
+   return client_log_open(client);
+}
+
+static size_t
+get_block_size(const LZ4F_frameInfo_t *info)
+{
+   switch (info->blockSizeID)
+     {
+        case LZ4F_default:
+        case LZ4F_max64KB:
+          return 1 << 16;
+        case LZ4F_max256KB:
+          return 1 << 18;
+        case LZ4F_max1MB:
+          return 1 << 20;
+        case LZ4F_max4MB:
+          return 1 << 22;
+        default:
+          ERROR("frame spec");
+     }
+}
+
+// Decompress the LZ4 frames in data onto the end of the client's record
+// buffer. Returns the bytes of data used.
+static size_t
+client_frames_decompress(Enigmatic_Client *client, LZ4F_dctx *dctx, const uint8_t *data, size_t length)
+{
+   LZ4F_frameInfo_t info;
+   size_t status, offset = 0;
+
+   while (offset < length)
+     {
+        const uint8_t *src = data + offset;
+        size_t compressed_size = length - offset;
+        status = LZ4F_getFrameInfo(dctx, &info, src, &compressed_size);
+        if (LZ4F_isError(status))
+          ERROR("getFrameInfo: %s", LZ4F_getErrorName(status));
+        size_t block_size = get_block_size(&info);
+        if (block_size > client->decode.block_size)
+          {
+             uint8_t *block = realloc(client->decode.block, block_size);
+             EINA_SAFETY_ON_NULL_RETURN_VAL(block, offset);
+             client->decode.block = block;
+             client->decode.block_size = block_size;
+          }
+        uint8_t *dst = client->decode.block;
+
+        size_t pos = compressed_size;
+        size_t src_size = 0;
+        size_t next_block = block_size;
+        size_t avail = length - offset;
+
+        for (;next_block; pos += src_size)
+          {
+             const uint8_t *src_ptr = src + pos;
+             size_t dec_size = block_size;
+
+             if (pos >= avail)
+               ERROR("decompress: truncated frame");
+             src_size = avail - pos;
+
+             next_block = LZ4F_decompress(dctx, dst, &dec_size, src_ptr, &src_size, NULL);
+             if (LZ4F_isError(next_block))
+               ERROR("decompress: %s", LZ4F_getErrorName(next_block));
+             if ((!src_size) && (!dec_size) && next_block)
+               ERROR("decompress: stalled frame decode");
+
+             if (!buffer_reserve(&client->buf, &client->decode.buf_size, (size_t) client->buf.length + dec_size))
+               ERROR("decompress: out of memory");
+             memcpy(&client->buf.data[client->buf.length], dst, dec_size);
+             client->buf.length += dec_size;
+          }
+        offset += pos;
+     }
+
+   return offset;
+}
+
+// Dispatch the records decompressed so far. False once a replay passes its
+// end time.
+static Eina_Bool
+client_records_parse(Enigmatic_Client *client)
+{
+   while ((client->buf.length) && (client->buf.index <= (client->buf.length - sizeof(Header))))
+     {
+        memcpy(&client->header, &client->buf.data[client->buf.index], sizeof(Header));
+        client->buf.index += sizeof(Header);
+        if (client->compressed) client->offset = client->buf.index;
+        if ((client->replay.enabled) && (client->replay.end_time) &&
+            (client->header.time > client->replay.end_time))
+          return 0;
+        switch (client->header.event)
+          {
+             case EVENT_ERROR:
+               break;
+             case EVENT_MESSAGE:
+               event_message(client);
+               break;
+             case EVENT_BROADCAST:
+               event_broadcast(client);
+               break;
+             case EVENT_BLOCK_END:
+               event_block_end(client);
+               break;
+             case EVENT_LAST_RECORD:
+               event_last_record(client);
+               break;
+             case EVENT_EOF:
+               event_end_of_file(client);
+               break;
+             case EVENT_SECTION:
+               event_section(client);
+               break;
+             default:
+               ERROR("Broken client ???");
+          }
+     }
+
+   return 1;
+}
+
+static void
+client_snapshot_callbacks_fire(Enigmatic_Client *client)
+{
+   if (client->event_snapshot_init.callback)
+     {
+        client->event_snapshot_init.callback(client, &client->snapshot, client->event_snapshot_init.data);
+        client->event_snapshot_init.callback = NULL;
+     }
+   if (client->event_snapshot.callback)
+     client->event_snapshot.callback(client, &client->snapshot, client->event_snapshot.data);
+   client->snapshot.families = 0;
+}
+
+// Well inside the daemon's FOLLOWER_TIMEOUT.
+#define DEMAND_HEARTBEAT 2.0
+
+static const char *
+demand_resolution(Interval interval)
+{
+   switch (interval)
+     {
+        case INTERVAL_NORMAL:
+          return "normal";
+        case INTERVAL_MEDIUM:
+          return "medium";
+        case INTERVAL_SLOW:
+          return "slow";
+        default:
+          return "idle";
+     }
+}
+
+static void
+demand_send(Enigmatic_Client *client, const char *msg)
+{
+   if (!client->demand.connected) return;
+
+   ecore_con_server_send(client->demand.srv, msg, strlen(msg) + 1);
+   ecore_con_server_flush(client->demand.srv);
+}
+
+static void
+demand_follow_send(Enigmatic_Client *client)
+{
+   demand_send(client, eina_slstr_printf("FOLLOW %s", demand_resolution(client->demand.interval)));
+}
+
+// Entries go with their process, the cap only bounds processes the
+// snapshot never saw leave. Past it the least recently used goes first.
+#define ARGUMENTS_CACHE_MAX 4096
+
+typedef struct
+{
+   int64_t    start;
+   uint64_t   used;
+   char      *arguments;
+   Eina_Bool  known;
+} Client_Arguments;
+
+typedef struct
+{
+   pid_t      pid;
+   uint64_t   used;
+} Client_Arguments_Oldest;
+
+typedef struct
+{
+   pid_t      pid;
+   int64_t    start;
+} Client_Arguments_Request;
+
+static void
+cb_arguments_free(void *data)
+{
+   Client_Arguments *args = data;
+
+   free(args->arguments);
+   free(args);
+}
+
+static Eina_Bool
+cb_arguments_oldest(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data, void *fdata)
+{
+   Client_Arguments *args = data;
+   Client_Arguments_Oldest *oldest = fdata;
+
+   if (args->used < oldest->used)
+     {
+        oldest->used = args->used;
+        oldest->pid = *(const pid_t *) key;
+     }
+
+   return 1;
+}
+
+// Called with the arguments locked.
+static void
+arguments_oldest_del(Enigmatic_Client *client)
+{
+   Client_Arguments_Oldest oldest = { 0, UINT64_MAX };
+
+   eina_hash_foreach(client->arguments.hash, cb_arguments_oldest, &oldest);
+   if (oldest.used != UINT64_MAX)
+     eina_hash_del_by_key(client->arguments.hash, &oldest.pid);
+}
+
+static void
+arguments_reply(Enigmatic_Client *client, const char *msg)
+{
+   Client_Arguments *args;
+   long long start;
+   int pid, n = 0;
+
+   if (sscanf(msg, "ARGS %d %lld %n", &pid, &start, &n) != 2 || !n)
+     return;
+
+   eina_lock_take(&client->arguments.lock);
+   args = eina_hash_find(client->arguments.hash, &pid);
+   if ((args) && (args->start == start) && (!args->known))
+     {
+        args->arguments = strdup(msg + n);
+        args->known = 1;
+     }
+   eina_lock_release(&client->arguments.lock);
+}
+
+static Eina_Bool
+cb_arguments_data(void *data, int type EINA_UNUSED, void *event)
+{
+   Enigmatic_Client *client = data;
+   Ecore_Con_Event_Server_Data *ev = event;
+   const unsigned char *buf, *nul;
+   size_t len, off = 0;
+
+   if (ev->server != client->demand.srv) return ECORE_CALLBACK_RENEW;
+
+   // Replies may be split across reads or arrive several at once.
+   eina_binbuf_append_length(client->arguments.pending, ev->data, ev->size);
+   buf = eina_binbuf_string_get(client->arguments.pending);
+   len = eina_binbuf_length_get(client->arguments.pending);
+
+   while ((nul = memchr(buf + off, '\0', len - off)))
+     {
+        if (!strncmp((const char *) buf + off, "ARGS ", 5))
+          arguments_reply(client, (const char *) buf + off);
+        off = (nul - buf) + 1;
+     }
+   if (off)
+     eina_binbuf_remove(client->arguments.pending, 0, off);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static void
+cb_arguments_request(void *data, void *buffer, unsigned int nbyte)
+{
+   Enigmatic_Client *client = data;
+   Client_Arguments_Request *req = buffer;
+   Client_Arguments *args;
+
+   if (nbyte != sizeof(Client_Arguments_Request)) return;
+
+   if (client->demand.connected)
+     {
+        demand_send(client, eina_slstr_printf("ARGS %d %lld", req->pid, (long long) req->start));
+        return;
+     }
+
+   // Not asked, so ask again next time.
+   eina_lock_take(&client->arguments.lock);
+   args = eina_hash_find(client->arguments.hash, &req->pid);
+   if ((args) && (args->start == req->start) && (!args->known))
+     eina_hash_del_by_key(client->arguments.hash, &req->pid);
+   eina_lock_release(&client->arguments.lock);
+}
+
+char *
+enigmatic_client_process_arguments_get(Enigmatic_Client *client, pid_t pid, int64_t start)
+{
+   Client_Arguments *args;
+   Client_Arguments_Request req;
+   char *arguments = NULL;
+
+   if (!client->arguments.hash) return NULL;
+
+   eina_lock_take(&client->arguments.lock);
+   args = eina_hash_find(client->arguments.hash, &pid);
+   if ((args) && (args->start != start))
+     {
+        eina_hash_del_by_key(client->arguments.hash, &pid);
+        args = NULL;
+     }
+   if (!args)
+     {
+        if (eina_hash_population(client->arguments.hash) >= ARGUMENTS_CACHE_MAX)
+          arguments_oldest_del(client);
+
+        args = calloc(1, sizeof(Client_Arguments));
+        if (args)
+          {
+             args->start = start;
+             args->used = ++client->arguments.generation;
+             eina_hash_add(client->arguments.hash, &pid, args);
+             req.pid = pid;
+             req.start = start;
+             ecore_pipe_write(client->arguments.pipe, &req, sizeof(req));
+          }
+     }
+   else
+     {
+        args->used = ++client->arguments.generation;
+        if (args->known)
+          arguments = strdup(args->arguments ? args->arguments : "");
+     }
+   eina_lock_release(&client->arguments.lock);
+
+   return arguments;
+}
+
+static void
+arguments_init(Enigmatic_Client *client)
+{
+   eina_lock_new(&client->arguments.lock);
+   client->arguments.pending = eina_binbuf_new();
+   client->arguments.pipe = ecore_pipe_add(cb_arguments_request, client);
+   client->arguments.handler = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DATA, cb_arguments_data, client);
+   client->arguments.hash = eina_hash_int32_new(cb_arguments_free);
+}
+
+static void
+arguments_clear(Enigmatic_Client *client)
+{
+   eina_lock_take(&client->arguments.lock);
+   eina_hash_free_buckets(client->arguments.hash);
+   eina_binbuf_reset(client->arguments.pending);
+   eina_lock_release(&client->arguments.lock);
+}
+
+static void
+arguments_shutdown(Enigmatic_Client *client)
+{
+   ecore_event_handler_del(client->arguments.handler);
+   ecore_pipe_del(client->arguments.pipe);
+   eina_binbuf_free(client->arguments.pending);
+   eina_hash_free(client->arguments.hash);
+   eina_lock_free(&client->arguments.lock);
+}
+
+static Eina_Bool
+cb_demand_add(void *data, int type EINA_UNUSED, void *event)
+{
+   Enigmatic_Client *client = data;
+   Ecore_Con_Event_Server_Add *ev = event;
+
+   if (ev->server != client->demand.srv) return ECORE_CALLBACK_RENEW;
+
+   client->demand.connected = 1;
+   demand_follow_send(client);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+cb_demand_del(void *data, int type EINA_UNUSED, void *event)
+{
+   Enigmatic_Client *client = data;
+   Ecore_Con_Event_Server_Del *ev = event;
+
+   if (ev->server != client->demand.srv) return ECORE_CALLBACK_RENEW;
+
+   ecore_con_server_del(client->demand.srv);
+   client->demand.srv = NULL;
+   client->demand.connected = 0;
+   // Answers in flight are lost with the daemon.
+   arguments_clear(client);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+cb_demand_heartbeat(void *data)
+{
+   Enigmatic_Client *client = data;
+
+   if (!client->demand.srv)
+     client->demand.srv = ecore_con_server_connect(enigmatic_control_type_get(), PACKAGE, 0, NULL);
+   else
+     demand_send(client, "HEARTBEAT");
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+stream_send(Enigmatic_Client *client, const char *msg)
+{
+   if (!client->stream.connected) return;
+
+   ecore_con_server_send(client->stream.srv, msg, strlen(msg) + 1);
+   ecore_con_server_flush(client->stream.srv);
+}
+
+static void
+stream_follow_send(Enigmatic_Client *client)
+{
+   if (!client->stream.follow) return;
+
+   stream_send(client, eina_slstr_printf("FOLLOW %s", demand_resolution(client->demand.interval)));
+}
+
+static void
+stream_connect(Enigmatic_Client *client)
+{
+   char host[256];
+   const char *address = client->stream.address;
+   const char *colon = strrchr(address, ':');
+
+   if (!colon)
+     client->stream.srv = ecore_con_server_connect(enigmatic_control_type_get(), PACKAGE, STREAM_PORT_LOCAL, NULL);
+   else
+     {
+        snprintf(host, sizeof(host), "%.*s", (int) (colon - address), address);
+        client->stream.srv = ecore_con_server_connect(ECORE_CON_REMOTE_TCP, host, atoi(colon + 1), NULL);
+     }
+}
+
+static void
+stream_disconnect(Enigmatic_Client *client)
+{
+   if (client->stream.srv)
+     ecore_con_server_del(client->stream.srv);
+   client->stream.srv = NULL;
+   client->stream.connected = 0;
+   eina_binbuf_reset(client->stream.pending);
+}
+
+// Over TCP, ENIGMATIC_STREAM_TOKEN or else the token a daemon on this machine
+// left for its user. Read on every connect, a restarted daemon has a new one.
+static void
+stream_auth_send(Enigmatic_Client *client)
+{
+   char path[PATH_MAX], token[STREAM_TOKEN_SIZE + 1] = { 0 };
+   const char *env = getenv("ENIGMATIC_STREAM_TOKEN");
+   ssize_t n = 0;
+   int fd;
+
+   if (!strchr(client->stream.address, ':')) return;
+
+   if (env)
+     snprintf(token, sizeof(token), "%s", env);
+   else
+     {
+        snprintf(path, sizeof(path), "%s/%s/%s", enigmatic_cache_dir_get(), PACKAGE, STREAM_TOKEN_FILE);
+        fd = open(path, O_RDONLY);
+        if (fd != -1)
+          {
+             n = read(fd, token, STREAM_TOKEN_SIZE);
+             close(fd);
+          }
+        if (n != STREAM_TOKEN_SIZE) token[0] = '\0';
+     }
+
+   stream_send(client, eina_slstr_printf("AUTH %s", token));
+}
+
+static Eina_Bool
+cb_stream_add(void *data, int type EINA_UNUSED, void *event)
 {
+   Enigmatic_Client *client = data;
+   Ecore_Con_Event_Server_Add *ev = event;
+
+   if (ev->server != client->stream.srv) return ECORE_CALLBACK_PASS_ON;
 
+   client->stream.connected = 1;
+   stream_auth_send(client);
+   stream_send(client, eina_slstr_printf("STREAM %u %llu", client->stream.epoch,
+                                         (unsigned long long) client->stream.seq));
+   stream_follow_send(client);
+
+   return ECORE_CALLBACK_DONE;
 }
 
 static Eina_Bool
-client_filename_is_compressed(const char *filename)
+cb_stream_del(void *data, int type EINA_UNUSED, void *event)
 {
-   const char *ext;
+   Enigmatic_Client *client = data;
+   Ecore_Con_Event_Server_Del *ev = event;
 
-   if (!filename) return 0;
+   if (ev->server != client->stream.srv) return ECORE_CALLBACK_PASS_ON;
 
-   ext = strrchr(filename, '.');
+   stream_disconnect(client);
 
-   return ((ext) && (!strcmp(ext, ".lz4")));
+   return ECORE_CALLBACK_DONE;
 }
 
 static Eina_Bool
-client_log_open(Enigmatic_Client *client)
+cb_stream_data(void *data, int type EINA_UNUSED, void *event)
 {
-   if ((!client) || (!client->filename)) return 0;
-   if (client->compressed) return 1;
-   if (client->fd != -1) return 1;
+   Enigmatic_Client *client = data;
+   Ecore_Con_Event_Server_Data *ev = event;
+   Stream_Record record;
+   const unsigned char *buf;
+   size_t len, off = 0;
+   LZ4F_dctx *dctx;
+   int blocks = 0;
 
-   client->fd = open(client->filename, O_RDONLY);
-   if (client->fd == -1)
-     return 0;
+   if (ev->server != client->stream.srv) return ECORE_CALLBACK_PASS_ON;
 
-   client->retries = 0;
+   // Not keeping up, the daemon resumes from the backlog once reconnected.
+   if ((eina_binbuf_length_get(client->stream.pending) + ev->size) > STREAM_BUFFER_MAX)
+     {
+        stream_disconnect(client);
+        return ECORE_CALLBACK_DONE;
+     }
 
-   return 1;
+   eina_binbuf_append_length(client->stream.pending, ev->data, ev->size);
+   buf = eina_binbuf_string_get(client->stream.pending);
+   len = eina_binbuf_length_get(client->stream.pending);
+
+   dctx = client_dctx_get(client);
+
+   while ((len - off) >= sizeof(Stream_Record))
+     {
+        memcpy(&record, buf + off, sizeof(Stream_Record));
+        if ((len - off - sizeof(Stream_Record)) < record.size) break;
+
+        // The daemon restarted or we fell behind, it carries on from a keyframe.
+        if ((record.epoch != client->stream.epoch) || (record.seq != (client->stream.seq + 1)))
+          free_snapshot(&client->snapshot);
+        client->stream.epoch = record.epoch;
+        client->stream.seq = record.seq;
+
+        client_frames_decompress(client, dctx, buf + off + sizeof(Stream_Record), record.size);
+        client_records_parse(client);
+        buffer_rewind(&client->buf);
+
+        off += sizeof(Stream_Record) + record.size;
+        blocks++;
+     }
+
+   if (off)
+     eina_binbuf_remove(client->stream.pending, 0, off);
+   if (blocks)
+     client_snapshot_callbacks_fire(client);
+
+   return ECORE_CALLBACK_DONE;
 }
 
-Enigmatic_Client *
-enigmatic_client_open(void)
+static Eina_Bool
+cb_stream_timer(void *data)
 {
-   return enigmatic_client_path_open(enigmatic_log_path());
+   Enigmatic_Client *client = data;
+
+   if (!client->stream.srv)
+     stream_connect(client);
+   else if (client->stream.follow)
+     stream_send(client, "HEARTBEAT");
+
+   return ECORE_CALLBACK_RENEW;
 }
 
 Enigmatic_Client *
-enigmatic_client_path_open(char *filename)
+enigmatic_client_stream_open(const char *address)
 {
    Enigmatic_Client *client = calloc(1, sizeof(Enigmatic_Client));
    EINA_SAFETY_ON_NULL_RETURN_VAL(client, NULL);
 
-   client->fd = -1;
-   client->directory = enigmatic_log_directory();
-   client->filename = filename;
-   client->compressed = client_filename_is_compressed(filename);
+   ecore_con_init();
 
-   client_log_open(client);
+   client->fd = -1;
+   client->stream.address = strdup(address ? address : "");
+   client->stream.pending = eina_binbuf_new();
+   client->stream.handler_add = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_ADD, cb_stream_add, client);
+   client->stream.handler_del = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DEL, cb_stream_del, client);
+   client->stream.handler_data = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DATA, cb_stream_data, client);
+   client->stream.timer = ecore_timer_add(DEMAND_HEARTBEAT, cb_stream_timer, client);
+   stream_connect(client);
 
    return client;
 }
 
-static Eina_Bool
-enigmatic_client_reopen(Enigmatic_Client *client, char *filename)
+static void
+stream_shutdown(Enigmatic_Client *client)
 {
-   enigmatic_client_reset(client);
+   if (!client->stream.address) return;
+
+   ecore_timer_del(client->stream.timer);
+   ecore_event_handler_del(client->stream.handler_add);
+   ecore_event_handler_del(client->stream.handler_del);
+   ecore_event_handler_del(client->stream.handler_data);
+   stream_disconnect(client);
+   eina_binbuf_free(client->stream.pending);
+   free(client->stream.address);
+   ecore_con_shutdown();
+}
 
-   if (client->fd != -1)
-     close(client->fd);
-   if (client->filename)
-     free(client->filename);
-   if (client->directory)
-     free(client->directory);
-   client->fd = -1;
-   client->directory = enigmatic_log_directory();
-   client->filename = filename;
-   client->compressed = client_filename_is_compressed(filename);
+void
+enigmatic_client_demand_set(Enigmatic_Client *client, Interval interval)
+{
+   // Streaming clients follow over their stream.
+   if (client->stream.address)
+     {
+        client->stream.follow = 1;
+        if (client->demand.interval == interval) return;
+        client->demand.interval = interval;
+        stream_follow_send(client);
+        return;
+     }
 
-   return client_log_open(client);
+   if (!client->demand.timer)
+     {
+        ecore_con_init();
+        client->demand.interval = interval;
+        client->demand.handler_add = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_ADD, cb_demand_add, client);
+        client->demand.handler_del = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DEL, cb_demand_del, client);
+        client->demand.timer = ecore_timer_add(DEMAND_HEARTBEAT, cb_demand_heartbeat, client);
+        arguments_init(client);
+        client->demand.srv = ecore_con_server_connect(enigmatic_control_type_get(), PACKAGE, 0, NULL);
+        return;
+     }
+
+   if (client->demand.interval == interval) return;
+
+   client->demand.interval = interval;
+   demand_follow_send(client);
+}
+
+static void
+demand_shutdown(Enigmatic_Client *client)
+{
+   if (!client->demand.timer) return;
+
+   ecore_timer_del(client->demand.timer);
+   ecore_event_handler_del(client->demand.handler_add);
+   ecore_event_handler_del(client->demand.handler_del);
+   if (client->demand.srv)
+     ecore_con_server_del(client->demand.srv);
+   arguments_shutdown(client);
+   ecore_con_shutdown();
 }
 
 void
 enigmatic_client_del(Enigmatic_Client *client)
 {
-   if (client->follow)
+   if ((client->follow) && (!client->stream.address))
      {
 #if defined(__linux__)
         eio_monitor_del(client->mon);
@@ -1397,7 +2770,10 @@ enigmatic_client_del(Enigmatic_Client *client)
         ecore_thread_wait(client->thread, 1.0);
 #endif
      }
+   demand_shutdown(client);
+   stream_shutdown(client);
    free_snapshot(&client->snapshot);
+   client_decode_free(client);
    if (client->fd != -1)
      close(client->fd);
    free(client->filename);
@@ -1405,25 +2781,6 @@ enigmatic_client_del(Enigmatic_Client *client)
    free(client);
 }
 
-static size_t
-get_block_size(const LZ4F_frameInfo_t *info)
-{
-   switch (info->blockSizeID)
-     {
-        case LZ4F_default:
-        case LZ4F_max64KB:
-          return 1 << 16;
-        case LZ4F_max256KB:
-          return 1 << 18;
-        case LZ4F_max1MB:
-          return 1 << 20;
-        case LZ4F_max4MB:
-          return 1 << 22;
-        default:
-          ERROR("frame spec");
-     }
-}
-
 // WIP
 void
 enigmatic_client_read(Enigmatic_Client *client)
@@ -1432,14 +2789,10 @@ enigmatic_client_read(Enigmatic_Client *client)
    int n;
    Eina_Bool eof = 0;
    Eina_Bool stop = 0;
-   LZ4F_dctx *dctx = NULL;
-
-   size_t status = LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION);
-   if (LZ4F_isError(status))
-     ERROR("create decompress context");
+   LZ4F_dctx *dctx = client_dctx_get(client);
 
    if (!client->compressed && !client_log_open(client))
-     goto done;
+     return;
 
    if (client->truncated)
      {
@@ -1448,7 +2801,7 @@ enigmatic_client_read(Enigmatic_Client *client)
         client->fd = -1;
         enigmatic_client_reset(client);
         if (!client_log_open(client))
-          goto done;
+          return;
      }
 
    if (!client->compressed)
@@ -1470,7 +2823,10 @@ enigmatic_client_read(Enigmatic_Client *client)
      }
    else
      {
+        // An archive is read whole, once, so it isn't kept around.
+        buffer_clear(&client->zbuf);
         client->zbuf.data = (uint8_t *) enigmatic_log_decompress(client->filename, &client->zbuf.length);
+        client->decode.zbuf_size = client->zbuf.length;
         st.st_size = client->zbuf.length;
         client->file_size = st.st_size;
      }
@@ -1483,11 +2839,9 @@ enigmatic_client_read(Enigmatic_Client *client)
         client->zbuf.length = st.st_size - client->offset;
         client->file_size = st.st_size;
 
-        if (!client->compressed)
-          {
-             client->zbuf.data = malloc(client->zbuf.length * sizeof(uint8_t));
-             EINA_SAFETY_ON_NULL_RETURN(client->zbuf.data);
-          }
+        if ((!client->compressed) &&
+            (!buffer_reserve(&client->zbuf, &client->decode.zbuf_size, client->zbuf.length)))
+          ERROR("read: out of memory");
 
         uint32_t bytes = 0;
 
@@ -1509,105 +2863,21 @@ enigmatic_client_read(Enigmatic_Client *client)
              client->offset +=n;
           }
 
-        size_t compressed_size = client->zbuf.length;
+        if (!eof)
+          offset += client_frames_decompress(client, dctx, client->zbuf.data + offset, client->zbuf.length - offset);
 
-        LZ4F_frameInfo_t info;
+        stop = !client_records_parse(client);
 
-        while ((!eof) && (!stop) && (offset < client->zbuf.length))
-          {
-             uint8_t *src = client->zbuf.data + offset;
-             status = LZ4F_getFrameInfo(dctx, &info, src, &compressed_size);
-             if (LZ4F_isError(status))
-               ERROR("getFrameInfo: %s", LZ4F_getErrorName(status));
-             size_t block_size = get_block_size(&info);
-             char *dst = malloc(block_size);
-             EINA_SAFETY_ON_NULL_RETURN(dst);
-
-             size_t pos = compressed_size;
-             size_t src_size = 0;
-             size_t next_block = block_size;
-             size_t avail = client->zbuf.length - offset;
-
-             for (;next_block; pos += src_size)
-               {
-                  uint8_t *src_ptr = src + pos;
-                  size_t dec_size = block_size;
-
-                  if (pos >= avail)
-                    ERROR("decompress: truncated frame");
-                  src_size = avail - pos;
-
-                  next_block = LZ4F_decompress(dctx, dst, &dec_size, src_ptr, &src_size, NULL);
-                  if (LZ4F_isError(next_block))
-                    ERROR("decompress: %s", LZ4F_getErrorName(next_block));
-                  if ((!src_size) && (!dec_size) && next_block)
-                    ERROR("decompress: stalled frame decode");
-
-                  client->buf.length += dec_size;
-                  void *tmp = realloc(client->buf.data, client->buf.length);
-                  EINA_SAFETY_ON_NULL_RETURN(tmp);
-                  client->buf.data = tmp;
-                  memcpy(&client->buf.data[client->buf.length - dec_size], dst, dec_size);
-               }
-             offset += pos;
-             free(dst);
-          }
+        buffer_rewind(&client->buf);
 
-        while ((!stop) && (client->buf.length) && (client->buf.index <= (client->buf.length - sizeof(Header))))
+        if (client->compressed)
           {
-             memcpy(&client->header, &client->buf.data[client->buf.index], sizeof(Header));
-             client->buf.index += sizeof(Header);
-             if (client->compressed) client->offset = client->buf.index;
-             if ((client->replay.enabled) && (client->replay.end_time) &&
-                 (client->header.time > client->replay.end_time))
-               {
-                  stop = 1;
-                  break;
-               }
-             switch (client->header.event)
-               {
-                  case EVENT_ERROR:
-                    break;
-                  case EVENT_MESSAGE:
-                    event_message(client);
-                    break;
-                  case EVENT_BROADCAST:
-                    event_broadcast(client);
-                    break;
-                  case EVENT_BLOCK_END:
-                    event_block_end(client);
-                    break;
-                  case EVENT_LAST_RECORD:
-                    event_last_record(client);
-                    break;
-                  case EVENT_EOF:
-                    event_end_of_file(client);
-                    break;
-                  default:
-                    ERROR("Broken client ???");
-               }
+             buffer_clear(&client->zbuf);
+             client->decode.zbuf_size = 0;
+             break;
           }
-
-        buffer_clear(&client->zbuf);
-        buffer_clear(&client->buf);
-
-        if (client->compressed)
-          break;
-     }
-done:
-   LZ4F_freeDecompressionContext(dctx);
-}
-
-static void
-client_snapshot_callbacks_fire(Enigmatic_Client *client)
-{
-   if (client->event_snapshot_init.callback)
-     {
-        client->event_snapshot_init.callback(client, &client->snapshot, client->event_snapshot_init.data);
-        client->event_snapshot_init.callback = NULL;
+        buffer_rewind(&client->zbuf);
      }
-   if (client->event_snapshot.callback)
-     client->event_snapshot.callback(client, &client->snapshot, client->event_snapshot.data);
 }
 
 static Eina_Bool
@@ -1739,6 +3009,22 @@ enigmatic_client_event_callback_add(Enigmatic_Client *client, Enigmatic_Client_E
            client->event_record_delay.callback = cb_event;
            client->event_record_delay.data = data;
            break;
+        case EVENT_CGROUP_ADD:
+           client->event_cgroup_add.callback = cb_event;
+           client->event_cgroup_add.data = data;
+           break;
+        case EVENT_CGROUP_DEL:
+           client->event_cgroup_del.callback = cb_event;
+           client->event_cgroup_del.data = data;
+           break;
+        case EVENT_BLOCK_DEVICE_ADD:
+           client->event_block_device_add.callback = cb_event;
+           client->event_block_device_add.data = data;
+           break;
+        case EVENT_BLOCK_DEVICE_DEL:
+           client->event_block_device_del.callback = cb_event;
+           client->event_block_device_del.data = data;
+           break;
      }
 }
 
@@ -1750,6 +3036,7 @@ enigmatic_client_monitor_add(Enigmatic_Client *client, Snapshot_Callback *cb_eve
    client->event_snapshot_init.data = data;
    client->event_snapshot.callback = cb_event_change;
    client->event_snapshot.data = data;
+   if (client->stream.address) return;
 #if defined(__linux__)
    client->mon = eio_monitor_add(client->directory);
    client->handler =
@@ -1770,6 +3057,22 @@ enigmatic_client_snapshot_callback_set(Enigmatic_Client *client, Snapshot_Callba
    client->event_snapshot.data = data;
 }
 
+Proc_Info_Log *
+enigmatic_client_snapshot_process_get(const Snapshot *snapshot, pid_t pid)
+{
+   if ((!snapshot) || (!snapshot->process_pids)) return NULL;
+
+   return eina_hash_find(snapshot->process_pids, &pid);
+}
+
+const Eina_List *
+enigmatic_client_snapshot_children_get(const Snapshot *snapshot, pid_t ppid)
+{
+   if ((!snapshot) || (!snapshot->process_children)) return NULL;
+
+   return eina_hash_find(snapshot->process_children, &ppid);
+}
+
 Enigmatic_Client *
 enigmatic_client_add(void)
 {
@@ -1782,6 +3085,12 @@ enigmatic_client_add(void)
    return client;
 }
 
+void
+enigmatic_client_subscribe(Enigmatic_Client *client, unsigned int families)
+{
+   client->skip = FAMILY_ALL & ~families;
+}
+
 void
 enigmatic_client_follow_enabled_set(Enigmatic_Client *client, Eina_Bool enabled)
 {
@@ -1897,6 +3206,242 @@ enigmatic_client_replay(Enigmatic_Client *client)
    return 1;
 }
 
+Proc_Info_Series *
+enigmatic_client_process_series_get(pid_t pid, int64_t start, uint32_t start_time, uint32_t end_time)
+{
+   Enigmatic_Client *client;
+   Client_Extract *extract;
+   Proc_Info_Series *series;
+
+   if ((pid <= 0) || (start_time >= end_time)) return NULL;
+
+   extract = calloc(1, sizeof(Client_Extract));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(extract, NULL);
+
+   series = calloc(1, sizeof(Proc_Info_Series));
+   if (!series)
+     {
+        free(extract);
+        return NULL;
+     }
+
+   client = enigmatic_client_add();
+   if (!client)
+     {
+        free(series);
+        free(extract);
+        return NULL;
+     }
+
+   extract->pid = series->pid = pid;
+   extract->start = series->start = start;
+   extract->start_time = start_time;
+   extract->end_time = end_time;
+   extract->series = series;
+
+   enigmatic_client_subscribe(client, FAMILY_PROCESS);
+   enigmatic_client_replay_time_start_set(client, start_time);
+   enigmatic_client_replay_time_end_set(client, end_time);
+   client->extract = extract;
+
+   enigmatic_client_replay(client);
+
+   client->extract = NULL;
+   enigmatic_client_del(client);
+   free(extract);
+
+   return series;
+}
+
+void
+enigmatic_client_process_series_free(Proc_Info_Series *series)
+{
+   if (!series) return;
+
+   free(series->time);
+   free(series->cpu_usage);
+   free(series->mem_rss);
+   free(series->numthreads);
+   free(series->fds_count);
+   free(series->disk_read);
+   free(series->disk_write);
+   free(series->net_in);
+   free(series->net_out);
+   free(series);
+}
+
+static void
+top_heap_sift(Enigmatic_Client_Top_Entry *heap, int count, int i)
+{
+   Enigmatic_Client_Top_Entry tmp;
+   int smallest, left, right;
+
+   for (;;)
+     {
+        smallest = i;
+        left = (i * 2) + 1;
+        right = left + 1;
+
+        if ((left < count) && (heap[left].value < heap[smallest].value))
+          smallest = left;
+        if ((right < count) && (heap[right].value < heap[smallest].value))
+          smallest = right;
+        if (smallest == i) break;
+
+        tmp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = tmp;
+        i = smallest;
+     }
+}
+
+// Keep the n largest values seen in a min-heap, the root is the one to beat.
+static void
+top_heap_push(Enigmatic_Client_Top *top, Enigmatic_Client_Top_Metric metric, int n,
+              Client_Query_Proc *qp, uint64_t value)
+{
+   Enigmatic_Client_Top_Entry *heap = top->entries[metric];
+   Enigmatic_Client_Top_Entry *entry;
+   int i;
+
+   if (!value) return;
+
+   if (top->count[metric] < n)
+     {
+        i = top->count[metric]++;
+        entry = &heap[i];
+     }
+   else if (value > heap[0].value)
+     {
+        i = -1;
+        entry = &heap[0];
+     }
+   else return;
+
+   entry->pid = qp->pid;
+   entry->start = qp->start;
+   entry->value = value;
+   snprintf(entry->command, sizeof(entry->command), "%s", qp->command);
+
+   if (i == -1)
+     top_heap_sift(heap, top->count[metric], 0);
+   else
+     {
+        Enigmatic_Client_Top_Entry tmp;
+        int parent;
+
+        while (i > 0)
+          {
+             parent = (i - 1) / 2;
+             if (heap[parent].value <= heap[i].value) break;
+             tmp = heap[i];
+             heap[i] = heap[parent];
+             heap[parent] = tmp;
+             i = parent;
+          }
+     }
+}
+
+// Heap sort in place, leaves the entries highest first.
+static void
+top_heap_order(Enigmatic_Client_Top_Entry *heap, int count)
+{
+   Enigmatic_Client_Top_Entry tmp;
+
+   for (int i = count - 1; i > 0; i--)
+     {
+        tmp = heap[0];
+        heap[0] = heap[i];
+        heap[i] = tmp;
+        top_heap_sift(heap, i, 0);
+     }
+}
+
+static uint64_t
+query_delta(const uint64_t *counter)
+{
+   if (counter[1] < counter[0]) return 0;
+
+   return counter[1] - counter[0];
+}
+
+Enigmatic_Client_Top *
+enigmatic_client_query_top(uint32_t start_time, uint32_t end_time, int n)
+{
+   Enigmatic_Client *client;
+   Enigmatic_Client_Top *top;
+   Client_Query query;
+   Client_Query_Proc *qp;
+   Eina_Iterator *it;
+   void *d = NULL;
+
+   if ((n <= 0) || (start_time >= end_time)) return NULL;
+
+   client = enigmatic_client_add();
+   EINA_SAFETY_ON_NULL_RETURN_VAL(client, NULL);
+
+   // Only process records matter, everything else is skipped unparsed.
+   enigmatic_client_subscribe(client, FAMILY_PROCESS);
+   enigmatic_client_replay_time_start_set(client, start_time);
+   enigmatic_client_replay_time_end_set(client, end_time);
+
+   query.start_time = start_time;
+   query.end_time = end_time;
+   query.procs = eina_hash_int64_new(free);
+   client->query = &query;
+
+   enigmatic_client_replay(client);
+
+   client->query = NULL;
+   enigmatic_client_del(client);
+
+   top = calloc(1, sizeof(Enigmatic_Client_Top));
+   if (top)
+     {
+        for (int i = 0; i < TOP_METRIC_MAX; i++)
+          {
+             top->entries[i] = calloc(n, sizeof(Enigmatic_Client_Top_Entry));
+             if (!top->entries[i])
+               {
+                  enigmatic_client_top_free(top);
+                  top = NULL;
+                  break;
+               }
+          }
+     }
+
+   if (top)
+     {
+        it = eina_hash_iterator_data_new(query.procs);
+        while (eina_iterator_next(it, &d))
+          {
+             qp = d;
+             top_heap_push(top, TOP_CPU_TIME, n, qp, query_delta(qp->cpu_time));
+             top_heap_push(top, TOP_RSS_PEAK, n, qp, qp->rss_peak);
+             top_heap_push(top, TOP_DISK_BYTES, n, qp, query_delta(qp->disk));
+             top_heap_push(top, TOP_NET_BYTES, n, qp, query_delta(qp->net));
+          }
+        eina_iterator_free(it);
+
+        for (int i = 0; i < TOP_METRIC_MAX; i++)
+          top_heap_order(top->entries[i], top->count[i]);
+     }
+
+   eina_hash_free(query.procs);
+
+   return top;
+}
+
+void
+enigmatic_client_top_free(Enigmatic_Client_Top *top)
+{
+   if (!top) return;
+
+   for (int i = 0; i < TOP_METRIC_MAX; i++)
+     free(top->entries[i]);
+   free(top);
+}
+
 void
 enigmatic_client_replay_time_start_set(Enigmatic_Client *client, uint32_t secs)
 {
@@ -1922,3 +3467,65 @@ enigmatic_client_time_bounds_get(Enigmatic_Client *client, uint32_t *start_time,
 
    return 1;
 }
+
+Eina_List *
+enigmatic_client_rollup_get(Rollup_Resolution resolution, uint32_t start_time, uint32_t end_time)
+{
+   Eina_List *records = NULL;
+   Rollup_Record *rec, *copy;
+   struct stat st;
+   uint8_t *map;
+   size_t off = 0, size, len;
+   char *path;
+   int fd;
+
+   path = enigmatic_rollup_path(resolution);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(path, NULL);
+
+   fd = open(path, O_RDONLY);
+   free(path);
+   if (fd == -1) return NULL;
+
+   if ((fstat(fd, &st) == -1) || (st.st_size < (off_t) sizeof(Rollup_Record)))
+     {
+        close(fd);
+        return NULL;
+     }
+
+   size = st.st_size;
+   map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED) return NULL;
+
+   // The daemon may be appending, stop at the first short or broken record.
+   while ((size - off) >= sizeof(Rollup_Record))
+     {
+        rec = (Rollup_Record *) (map + off);
+        if (rec->magic != ROLLUP_MAGIC) break;
+        if (rec->count > ((size - off - sizeof(Rollup_Record)) / sizeof(Rollup_Entry))) break;
+
+        len = sizeof(Rollup_Record) + (rec->count * sizeof(Rollup_Entry));
+        off += len;
+
+        if (rec->time < start_time) continue;
+        if ((end_time) && (rec->time > end_time)) break;
+
+        copy = malloc(len);
+        if (!copy) break;
+        memcpy(copy, rec, len);
+        records = eina_list_append(records, copy);
+     }
+
+   munmap(map, size);
+
+   return records;
+}
+
+void
+enigmatic_client_rollup_free(Eina_List *records)
+{
+   Rollup_Record *rec;
+
+   EINA_LIST_FREE(records, rec)
+     free(rec);
+}
@@ -4,4 +4,8 @@
 #define PACKAGE "enigmatic"
 #define PACKAGE_VERSION "0.1.2"
 
+// Where a daemon started with --system keeps the shared log, in place of
+// the user's ~/.cache.
+#define ENIGMATIC_SYSTEM_DIR "/var/cache/enigmatic"
+
 #endif
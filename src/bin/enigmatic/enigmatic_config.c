@@ -41,6 +41,11 @@ enigmatic_config_init(void)
    EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "log.save_history", log.save_history, EET_T_UCHAR);
    EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "log.rotate_every_hour", log.rotate_every_hour, EET_T_UCHAR);
    EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "log.rotate_every_minute", log.rotate_every_minute, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "log.rollup_max_size", log.rollup_max_size, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "sample.on_demand", sample.on_demand, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "sample.idle_interval", sample.idle_interval, EET_T_INT);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "stream.enabled", stream.enabled, EET_T_UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_BASIC(_enigmatic_conf_desc, Enigmatic_Config, "stream.port", stream.port, EET_T_INT);
 }
 
 void
@@ -59,6 +64,11 @@ _config_defaults(void)
   config->log.save_history = 1;
   config->log.rotate_every_minute = 0;
   config->log.rotate_every_hour = 1;
+  config->log.rollup_max_size = 64;
+  config->sample.on_demand = 1;
+  config->sample.idle_interval = INTERVAL_NORMAL;
+  config->stream.enabled = 0;
+  config->stream.port = 0;
 
   return config;
 }
@@ -2,7 +2,7 @@
 #define ENIGMATIC_CONFIG_H
 
 #define ENIGMATIC_CONFIG_VERSION_MAJOR 0x0001
-#define ENIGMATIC_CONFIG_VERSION_MINOR 0x0003
+#define ENIGMATIC_CONFIG_VERSION_MINOR 0x0006
 
 #define ENIGMATIC_CONFIG_VERSION ((ENIGMATIC_CONFIG_VERSION_MAJOR << 16) | ENIGMATIC_CONFIG_VERSION_MINOR)
 
@@ -14,7 +14,19 @@ typedef struct _Enigmatic_Config
       Eina_Bool rotate_every_minute;
       Eina_Bool rotate_every_hour;
       Eina_Bool save_history;
+      int       rollup_max_size; // MB across all rollup archives, 0 disables.
    } log;
+   struct
+   {
+      Eina_Bool on_demand;     // Sample as fast as followers ask and no faster.
+      int       idle_interval; // Recording cadence while nobody follows live,
+                               // slower ones trade history resolution for load.
+   } sample;
+   struct
+   {
+      Eina_Bool enabled;       // Serve the log's blocks as they are written.
+      int       port;          // TCP on the loopback, 0 for a local socket.
+   } stream;
 } Enigmatic_Config;
 
 void
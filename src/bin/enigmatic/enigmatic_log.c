@@ -33,7 +33,7 @@ enigmatic_log_header(Enigmatic *enigmatic, Event event, Message mesg)
    if (event == EVENT_BROADCAST)
      {
         enigmatic_log_write(enigmatic, (char *) &interval, sizeof(Interval));
-        static uint32_t specialfriend[4] = { HEADER_MAGIC, HEADER_MAGIC, HEADER_MAGIC, HEADER_MAGIC };
+        static uint32_t specialfriend[4] = { HEADER_MAGIC, HEADER_MAGIC, HEADER_MAGIC, LOG_FORMAT_VERSION };
         enigmatic_log_write(enigmatic, (char *) &specialfriend, sizeof(specialfriend));
      }
    switch (mesg.type)
@@ -50,6 +50,40 @@ enigmatic_log_header(Enigmatic *enigmatic, Event event, Message mesg)
      }
 }
 
+void
+enigmatic_log_section_begin(Enigmatic *enigmatic, Object_Type family)
+{
+   Section section;
+   Log *file = enigmatic->log.file;
+
+   section.family = family;
+   section.length = 0;
+
+   ENIGMATIC_LOG_HEADER(enigmatic, EVENT_SECTION);
+   file->section = file->buf.length;
+   enigmatic_log_write(enigmatic, (char *) &section, sizeof(Section));
+}
+
+void
+enigmatic_log_section_end(Enigmatic *enigmatic)
+{
+   Section *section;
+   Log *file = enigmatic->log.file;
+   uint32_t start = file->section + sizeof(Section);
+
+   if (file->buf.length < start) return;
+
+   // Nothing changed, drop the section header altogether.
+   if (file->buf.length == start)
+     {
+        file->buf.length = file->section - sizeof(Header);
+        return;
+     }
+
+   section = (Section *) &file->buf.data[file->section];
+   section->length = file->buf.length - start;
+}
+
 static char *
 lockfile_path(void)
 {
@@ -57,7 +91,7 @@ lockfile_path(void)
 
    snprintf(path, sizeof(path), "%s/%s", enigmatic_cache_dir_get(), PACKAGE);
    if (!ecore_file_exists(path))
-     ecore_file_mkdir(path);
+     ecore_file_mkpath(path);
 
    snprintf(path, sizeof(path), "%s/%s/%s", enigmatic_cache_dir_get(), PACKAGE, LCK_FILE_NAME);
 
@@ -218,6 +252,13 @@ enigmatic_log_crush(Enigmatic *enigmatic)
    sz = LZ4F_compressFrame(out, outlen, buffer->data, buffer->length, &prefs);
    if ((nw = write(file->fd, out, sz)) == 0 || nw == -1 || nw != sz)
      ERROR("write () %s", strerror(errno));
+   if ((enigmatic->log.block_cb) && (buffer->length >= sizeof(Header)))
+     {
+        Header hdr;
+
+        memcpy(&hdr, buffer->data, sizeof(Header));
+        enigmatic->log.block_cb(enigmatic, out, sz, hdr.event == EVENT_BROADCAST);
+     }
    free(out);
 
    free(buffer->data);
@@ -259,7 +300,7 @@ enigmatic_log_open(Enigmatic *enigmatic)
    if (!file) return NULL;
 
    flags = O_CREAT | O_WRONLY | O_TRUNC;
-   fd = open(enigmatic->log.path, flags, 0600);
+   fd = open(enigmatic->log.path, flags, enigmatic_file_mode_get());
    if (fd == -1)
      {
         free(file);
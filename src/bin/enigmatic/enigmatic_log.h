@@ -31,6 +31,12 @@ enigmatic_log_list_write(Enigmatic *enigmatic, Event event, Message mesg, Eina_L
 void
 enigmatic_log_obj_write(Enigmatic *enigmatic, Event event, Message mesg, void *obj, size_t size);
 
+void
+enigmatic_log_section_begin(Enigmatic *enigmatic, Object_Type family);
+
+void
+enigmatic_log_section_end(Enigmatic *enigmatic);
+
 void
 enigmatic_log_diff(Enigmatic *enigmatic, Message msg, int64_t change);
 
@@ -2,22 +2,30 @@
 #include "enigmatic_config.h"
 #include "monitor/monitor.h"
 #include "enigmatic_server.h"
+#include "enigmatic_stream.h"
 #include "enigmatic_query.h"
 #include "enigmatic_log.h"
+#include "enigmatic_rollup.h"
+#include <sys/stat.h>
+#include <ctype.h>
 
 static int lock_fd = -1;
+static int stream_port = -1;
 
 #define DEBUGTIME 0
 
 static void
 system_info_free(System_Info *info)
 {
-   eina_hash_free(info->cores);
+   free(info->cores.cores);
+   free(info->cores.sample);
    eina_hash_free(info->sensors);
    eina_hash_free(info->batteries);
    eina_hash_free(info->network_interfaces);
    eina_hash_free(info->file_systems);
    eina_hash_free(info->processes);
+   eina_hash_free(info->cgroups);
+   eina_hash_free(info->block_devices);
 }
 
 static Eina_Bool
@@ -32,6 +40,10 @@ cb_shutdown(void *data, int type EINA_UNUSED, void *event)
    if (enigmatic->thread)
      {
         ecore_thread_cancel(enigmatic->thread);
+        // An idle pass may be sleeping out a whole interval.
+        eina_lock_take(&enigmatic->update_lock);
+        eina_condition_signal(&enigmatic->update_cond);
+        eina_lock_release(&enigmatic->update_lock);
         ecore_thread_wait(enigmatic->thread, 0.5);
      }
 
@@ -55,6 +67,9 @@ enigmatic_system_monitor(void *data, Ecore_Thread *thread)
 {
    System_Info *info;
    struct timespec ts;
+   double now, pass_last = 0.0, wait;
+   uint32_t broadcast_time = 0;
+   Eina_Bool changed, full;
    Enigmatic *enigmatic = data;
 
    enigmatic->info = info = calloc(1, sizeof(System_Info));
@@ -71,50 +86,120 @@ enigmatic_system_monitor(void *data, Ecore_Thread *thread)
 
         int64_t tdiff = ts.tv_nsec + (ts.tv_sec * 1000000000);
 
+        // What followers ask for applies straight away, a window coming
+        // into view gets a full pass on this very tick.
+        eina_lock_take(&enigmatic->update_lock);
+        changed = (enigmatic->interval != enigmatic->interval_update) || (enigmatic->idle != enigmatic->idle_update);
+        enigmatic->interval = enigmatic->interval_update;
+        enigmatic->idle = enigmatic->idle_update;
+        if (enigmatic->broadcast_update)
+          enigmatic->broadcast = 1;
+        enigmatic->broadcast_update = 0;
+        eina_lock_release(&enigmatic->update_lock);
+        if (changed)
+          enigmatic->poll_count = 0;
+
         if (enigmatic_log_rotate(enigmatic))
+          {
+             enigmatic->broadcast = 1;
+             enigmatic_rollup_flush(enigmatic);
+          }
+
+        // Polls are not evenly spaced any more, keyframes go by the clock.
+        if ((enigmatic->poll_time - broadcast_time) >= (uint32_t) (enigmatic->device_refresh_interval / 10))
           enigmatic->broadcast = 1;
 
         if (enigmatic->broadcast)
-          ENIGMATIC_LOG_HEADER(enigmatic, EVENT_BROADCAST);
-
-        if (enigmatic->interval == INTERVAL_NORMAL)
-          enigmatic_monitor_cores(enigmatic, &info->cores);
+          {
+             broadcast_time = enigmatic->poll_time;
+             ENIGMATIC_LOG_HEADER(enigmatic, EVENT_BROADCAST);
+          }
 
-        if ((enigmatic->broadcast) || (!(enigmatic->poll_count % 10)))
+        // Live followers see the cores every tenth of a pass, idle passes
+        // only sample once.
+        if ((!enigmatic->idle) && (enigmatic->interval == INTERVAL_NORMAL))
           {
-             if (enigmatic->interval != INTERVAL_NORMAL)
-               enigmatic_monitor_cores(enigmatic, &info->cores);
+             enigmatic_log_section_begin(enigmatic, CPU_CORE);
+             enigmatic_monitor_cores(enigmatic, &info->cores);
+             enigmatic_log_section_end(enigmatic);
+          }
 
+        full = (enigmatic->idle) || (enigmatic->broadcast) || (!(enigmatic->poll_count % 10));
+        if (full)
+          {
+             clock_gettime(CLOCK_MONOTONIC, &ts);
+             now = ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+             enigmatic->elapsed = pass_last > 0.0 ? now - pass_last : (double) enigmatic->interval;
+             pass_last = now;
+
+             if ((enigmatic->idle) || (enigmatic->interval != INTERVAL_NORMAL))
+               {
+                  enigmatic_log_section_begin(enigmatic, CPU_CORE);
+                  enigmatic_monitor_cores(enigmatic, &info->cores);
+                  enigmatic_log_section_end(enigmatic);
+               }
+
+             // Each collector's records go in their own section so clients
+             // can skip the families they don't use.
+             enigmatic_log_section_begin(enigmatic, MEMORY);
              enigmatic_monitor_memory(enigmatic, &info->meminfo);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, SENSOR);
              enigmatic_monitor_sensors(enigmatic, &info->sensors);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, POWER);
              enigmatic_monitor_power(enigmatic, &info->power);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, BATTERY);
              enigmatic_monitor_batteries(enigmatic, &info->batteries);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, NETWORK);
              enigmatic_monitor_network_interfaces(enigmatic, &info->network_interfaces);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, FILE_SYSTEM);
              enigmatic_monitor_file_systems(enigmatic, &info->file_systems);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, BLOCK_DEVICE);
+             enigmatic_monitor_block_devices(enigmatic, &info->block_devices);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, PROCESS);
              enigmatic_monitor_processes(enigmatic, &info->processes);
+             enigmatic_log_section_end(enigmatic);
+
+             enigmatic_log_section_begin(enigmatic, CGROUP);
+             enigmatic_monitor_cgroups(enigmatic, &info->cgroups);
+             enigmatic_log_section_end(enigmatic);
 
              ENIGMATIC_LOG_HEADER(enigmatic, EVENT_BLOCK_END);
 
-             eina_lock_take(&enigmatic->update_lock);
-             if (enigmatic->interval != enigmatic->interval_update)
-               enigmatic->interval = enigmatic->interval_update;
-             eina_lock_release(&enigmatic->update_lock);
+             enigmatic_rollup_sample(enigmatic, info);
           }
 
         // flush to disk.
         enigmatic_log_crush(enigmatic);
 
         enigmatic->broadcast = 0;
-        if ((enigmatic->poll_count) && (!(enigmatic->poll_count % (enigmatic->device_refresh_interval / enigmatic->interval))))
-          enigmatic->broadcast = 1;
-
         enigmatic->poll_count++;
 
         clock_gettime(CLOCK_REALTIME, &ts);
         int usecs = (((ts.tv_sec * 1000000000) + ts.tv_nsec) - tdiff) / 1000;
-        if (usecs > 100000) usecs = 100000;
 
-        usleep(((enigmatic->interval * 1000000) / 10) - usecs);
+        // Sleep out the pass, or a tenth of it for live followers, unless
+        // a follower wants more in the meantime.
+        wait = enigmatic->idle ? enigmatic->interval : enigmatic->interval / 10.0;
+        wait -= usecs / 1000000.0;
+        eina_lock_take(&enigmatic->update_lock);
+        if ((wait > 0.0) && (enigmatic->interval_update >= enigmatic->interval) &&
+            ((!enigmatic->idle) || (enigmatic->idle_update)) && (!enigmatic->broadcast_update))
+          eina_condition_timedwait(&enigmatic->update_cond, wait);
+        eina_lock_release(&enigmatic->update_lock);
 #if DEBUGTIME
         printf("usecs is %i\n", usecs);
         clock_gettime(CLOCK_REALTIME, &ts);
@@ -122,6 +207,7 @@ enigmatic_system_monitor(void *data, Ecore_Thread *thread)
 #endif
      }
 
+   enigmatic_rollup_shutdown(enigmatic);
    system_info_free(info);
    free(info);
 }
@@ -130,6 +216,7 @@ static void
 enigmatic_init(Enigmatic *enigmatic)
 {
    eina_lock_new(&enigmatic->update_lock);
+   eina_condition_new(&enigmatic->update_cond, &enigmatic->update_lock);
    enigmatic->pid = getpid();
    enigmatic_pidfile_create(enigmatic);
 
@@ -143,6 +230,10 @@ enigmatic_init(Enigmatic *enigmatic)
 
    enigmatic_server_init(enigmatic);
 
+   if (stream_port == -1)
+     stream_port = enigmatic->config->stream.enabled ? enigmatic->config->stream.port : -1;
+   enigmatic_stream_init(enigmatic, stream_port);
+
    enigmatic_log_open(enigmatic);
 
    enigmatic_monitor_batteries_init();
@@ -153,23 +244,22 @@ enigmatic_init(Enigmatic *enigmatic)
 static void
 enigmatic_shutdown(Enigmatic *enigmatic)
 {
-   void *id;
-
    enigmatic_log_close(enigmatic);
 
-   EINA_LIST_FREE(enigmatic->unique_ids, id)
-     free(id);
+   unique_ids_free(&enigmatic->unique_ids);
 
    enigmatic_monitor_batteries_shutdown();
    enigmatic_monitor_sensors_shutdown();
    enigmatic_monitor_power_shutdown();
 
+   enigmatic_stream_shutdown(enigmatic);
    enigmatic_server_shutdown(enigmatic);
 
    enigmatic_config_save(enigmatic->config);
    enigmatic_config_shutdown();
 
    enigmatic_pidfile_delete(enigmatic);
+   eina_condition_free(&enigmatic->update_cond);
    eina_lock_free(&enigmatic->update_lock);
 }
 
@@ -185,10 +275,12 @@ usage(void)
    printf("%s [OPTIONS]\n"
           "Where OPTIONS can be one of: \n"
           "   -s                 Stop enigmatic daemon.\n"
+          "   --system           Run as the one daemon shared by all users.\n"
+          "   --stream [PORT]    Stream the log on a local socket, or loopback TCP PORT.\n"
           "   -p                 Ping enigmatic daemon.\n"
-          "   --interval-normal  Set enigmatic daemon poll interval (normal).\n"
-          "   --interval-medium  Set enigmatic daemon poll interval (medium).\n"
-          "   --interval-slow    Set enigmatic daemon poll interval (slow).\n"
+          "   --interval-normal  Set enigmatic daemon recording interval (normal).\n"
+          "   --interval-medium  Set enigmatic daemon recording interval (medium).\n"
+          "   --interval-slow    Set enigmatic daemon recording interval (slow).\n"
           "   -v | --version     Enigmatic version.\n"
           "   -h | --help        This menu.\n",
           PACKAGE);
@@ -211,6 +303,14 @@ int main(int argc, char **argv)
           exit(!enigmatic_query_send("interval-medium"));
         else if (!strcmp(argv[i], "--interval-slow"))
           exit(!enigmatic_query_send("interval-slow"));
+        else if (!strcmp(argv[i], "--system"))
+          enigmatic_system_mode_set(1);
+        else if (!strcmp(argv[i], "--stream"))
+          {
+             stream_port = 0;
+             if ((i + 1 < argc) && (isdigit((unsigned char) argv[i + 1][0])))
+               stream_port = atoi(argv[++i]);
+          }
         else if (!strcmp(argv[i], "-s"))
           {
              if (enigmatic_query_send("STOP"))
@@ -219,6 +319,10 @@ int main(int argc, char **argv)
           }
      }
 
+   // Clients of a system daemon read as themselves.
+   if (enigmatic_system_mode_get())
+     umask(022);
+
    lock_fd = enigmatic_log_lock();
    atexit(cb_exit);
 
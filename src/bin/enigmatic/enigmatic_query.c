@@ -97,7 +97,7 @@ enigmatic_query_send(const char *command)
    query = calloc(1, sizeof(Enigmatic_Query));
    EINA_SAFETY_ON_NULL_RETURN_VAL(query, 0);
 
-   query->srv = ecore_con_server_connect(ECORE_CON_LOCAL_USER, PACKAGE, 0, NULL);
+   query->srv = ecore_con_server_connect(enigmatic_control_type_get(), PACKAGE, 0, NULL);
    if (!query->srv) return 0;
 
    query->command = command;
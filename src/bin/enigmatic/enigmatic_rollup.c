@@ -0,0 +1,472 @@
+#include "config.h"
+#include "Enigmatic.h"
+#include "Events.h"
+#include "enigmatic_rollup.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+// The rollups are built as we sample rather than by re-reading the hourly
+// logs. Every slow tick folds the collectors' state into the open minute,
+// each finished minute is folded into the open quarter hour. Finished
+// records wait in memory and are appended to the archives when the log
+// rotates.
+
+// Processes kept per bucket, ranked by their average CPU usage.
+#define ROLLUP_PROCESS_MAX 10
+
+typedef struct
+{
+   Rollup_Entry entry;
+   int64_t      sum;
+} Rollup_Acc;
+
+typedef struct
+{
+   uint64_t total_in;
+   uint64_t total_out;
+   uint32_t time;
+} Rollup_Counter;
+
+typedef struct
+{
+   Rollup_Resolution resolution;
+   uint32_t          start;
+   Eina_Hash        *accs;
+   Buffer            pending;
+} Rollup_Bucket;
+
+struct _Rollup
+{
+   Rollup_Bucket minute;
+   Rollup_Bucket quarter;
+   Eina_Hash    *counters;
+};
+
+static int64_t
+rollup_key(Rollup_Type type, uint32_t id)
+{
+   return ((int64_t) type << 32) | id;
+}
+
+static void
+rollup_pending_write(Buffer *buffer, const void *data, size_t len)
+{
+   void *tmp = realloc(buffer->data, buffer->length + len);
+   EINA_SAFETY_ON_NULL_RETURN(tmp);
+
+   buffer->data = tmp;
+   memcpy(&buffer->data[buffer->length], data, len);
+   buffer->length += len;
+}
+
+static void
+rollup_acc_merge(Rollup_Bucket *bucket, const Rollup_Entry *entry)
+{
+   Rollup_Acc *acc;
+   int64_t key = rollup_key(entry->type, entry->id);
+
+   acc = eina_hash_find(bucket->accs, &key);
+   if (!acc)
+     {
+        acc = malloc(sizeof(Rollup_Acc));
+        EINA_SAFETY_ON_NULL_RETURN(acc);
+
+        acc->entry = *entry;
+        acc->sum = entry->avg * entry->samples;
+        eina_hash_add(bucket->accs, &key, acc);
+        return;
+     }
+
+   if (entry->min < acc->entry.min) acc->entry.min = entry->min;
+   if (entry->max > acc->entry.max) acc->entry.max = entry->max;
+   acc->sum += entry->avg * entry->samples;
+   acc->entry.samples += entry->samples;
+}
+
+static void
+rollup_sample_add(Rollup_Bucket *bucket, Rollup_Type type, uint32_t id, const char *name, int64_t value)
+{
+   Rollup_Entry entry;
+
+   memset(&entry, 0, sizeof(Rollup_Entry));
+   entry.type = type;
+   entry.id = id;
+   entry.samples = 1;
+   entry.min = entry.avg = entry.max = value;
+   if (name)
+     snprintf(entry.name, sizeof(entry.name), "%s", name);
+
+   rollup_acc_merge(bucket, &entry);
+}
+
+static int
+cb_rollup_process_cmp(const void *a, const void *b)
+{
+   const Rollup_Acc *acc1 = a, *acc2 = b;
+
+   if (acc1->entry.avg == acc2->entry.avg) return 0;
+
+   return acc1->entry.avg < acc2->entry.avg ? 1 : -1;
+}
+
+static void
+rollup_bucket_close(Rollup_Bucket *bucket, Rollup_Bucket *next)
+{
+   Eina_List *entries = NULL, *procs = NULL, *l;
+   Eina_Iterator *it;
+   Rollup_Acc *acc, *rss;
+   Rollup_Record rec;
+   void *d = NULL;
+   int64_t key;
+   int n = 0;
+
+   if (!eina_hash_population(bucket->accs)) return;
+
+   it = eina_hash_iterator_data_new(bucket->accs);
+   while (eina_iterator_next(it, &d))
+     {
+        acc = d;
+        acc->entry.avg = acc->sum / acc->entry.samples;
+        if (acc->entry.type == ROLLUP_PROCESS_CPU)
+          procs = eina_list_append(procs, acc);
+        else if (acc->entry.type != ROLLUP_PROCESS_RSS)
+          entries = eina_list_append(entries, acc);
+     }
+   eina_iterator_free(it);
+
+   procs = eina_list_sort(procs, eina_list_count(procs), cb_rollup_process_cmp);
+   EINA_LIST_FOREACH(procs, l, acc)
+     {
+        if (n++ == ROLLUP_PROCESS_MAX) break;
+        entries = eina_list_append(entries, acc);
+        key = rollup_key(ROLLUP_PROCESS_RSS, acc->entry.id);
+        rss = eina_hash_find(bucket->accs, &key);
+        if (rss)
+          entries = eina_list_append(entries, rss);
+     }
+   eina_list_free(procs);
+
+   rec.magic = ROLLUP_MAGIC;
+   rec.time = bucket->start;
+   rec.resolution = bucket->resolution;
+   rec.count = eina_list_count(entries);
+   rollup_pending_write(&bucket->pending, &rec, sizeof(Rollup_Record));
+
+   EINA_LIST_FREE(entries, acc)
+     {
+        rollup_pending_write(&bucket->pending, &acc->entry, sizeof(Rollup_Entry));
+        if (next)
+          rollup_acc_merge(next, &acc->entry);
+     }
+
+   eina_hash_free_buckets(bucket->accs);
+}
+
+static void
+rollup_bucket_roll(Rollup_Bucket *bucket, uint32_t now, Rollup_Bucket *next)
+{
+   uint32_t start = now - (now % bucket->resolution);
+
+   if ((bucket->start) && (bucket->start != start))
+     rollup_bucket_close(bucket, next);
+
+   bucket->start = start;
+}
+
+static Rollup *
+rollup_new(void)
+{
+   Rollup *rollup = calloc(1, sizeof(Rollup));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(rollup, NULL);
+
+   rollup->minute.resolution = ROLLUP_RESOLUTION_1M;
+   rollup->minute.accs = eina_hash_int64_new(free);
+   rollup->quarter.resolution = ROLLUP_RESOLUTION_15M;
+   rollup->quarter.accs = eina_hash_int64_new(free);
+   rollup->counters = eina_hash_string_superfast_new(free);
+
+   return rollup;
+}
+
+static void
+rollup_network_sample(Rollup *rollup, Network_Interface *iface, uint32_t now)
+{
+   Rollup_Counter *counter;
+   uint32_t secs;
+
+   counter = eina_hash_find(rollup->counters, iface->name);
+   if (!counter)
+     {
+        counter = malloc(sizeof(Rollup_Counter));
+        EINA_SAFETY_ON_NULL_RETURN(counter);
+        eina_hash_add(rollup->counters, iface->name, counter);
+     }
+   else if ((now > counter->time) && (iface->total_in >= counter->total_in) &&
+            (iface->total_out >= counter->total_out))
+     {
+        secs = now - counter->time;
+        rollup_sample_add(&rollup->minute, ROLLUP_NETWORK_IN, iface->unique_id, iface->name,
+                          (iface->total_in - counter->total_in) / secs);
+        rollup_sample_add(&rollup->minute, ROLLUP_NETWORK_OUT, iface->unique_id, iface->name,
+                          (iface->total_out - counter->total_out) / secs);
+     }
+
+   counter->total_in = iface->total_in;
+   counter->total_out = iface->total_out;
+   counter->time = now;
+}
+
+void
+enigmatic_rollup_sample(Enigmatic *enigmatic, System_Info *info)
+{
+   Eina_Iterator *it;
+   Cpu_Core *core;
+   Proc_Info *proc;
+   Rollup *rollup;
+   void *d = NULL;
+   uint32_t now = enigmatic->poll_time;
+
+   if ((!enigmatic->config->log.save_history) || (enigmatic->config->log.rollup_max_size <= 0))
+     return;
+
+   if (!enigmatic->rollup)
+     enigmatic->rollup = rollup_new();
+   if (!(rollup = enigmatic->rollup)) return;
+
+   // Close the minute first, it belongs to the quarter which may be
+   // closing on this same tick.
+   rollup_bucket_roll(&rollup->minute, now, &rollup->quarter);
+   rollup_bucket_roll(&rollup->quarter, now, NULL);
+
+   for (int i = 0; i < info->cores.count; i++)
+     {
+        core = &info->cores.cores[i];
+        rollup_sample_add(&rollup->minute, ROLLUP_CPU_CORE, core->id, core->name, core->percent);
+     }
+
+   rollup_sample_add(&rollup->minute, ROLLUP_MEMORY_USED, 0, NULL, info->meminfo.used);
+   rollup_sample_add(&rollup->minute, ROLLUP_SWAP_USED, 0, NULL, info->meminfo.swap_used);
+
+   if (info->network_interfaces)
+     {
+        it = eina_hash_iterator_data_new(info->network_interfaces);
+        while (eina_iterator_next(it, &d))
+          rollup_network_sample(rollup, d, now);
+        eina_iterator_free(it);
+     }
+
+   if (info->processes)
+     {
+        it = eina_hash_iterator_data_new(info->processes);
+        while (eina_iterator_next(it, &d))
+          {
+             proc = d;
+             rollup_sample_add(&rollup->minute, ROLLUP_PROCESS_CPU, proc->pid, proc->command, proc->cpu_usage);
+             rollup_sample_add(&rollup->minute, ROLLUP_PROCESS_RSS, proc->pid, proc->command, proc->mem_rss);
+          }
+        eina_iterator_free(it);
+     }
+}
+
+// Drop the oldest records once an archive outgrows its share of the cap.
+// We cut back to three quarters of the limit so the rewrite is rare.
+static void
+rollup_archive_trim(const char *path, size_t max)
+{
+   struct stat st;
+   Rollup_Record *rec;
+   uint8_t *map;
+   size_t off = 0, size, target = (max / 4) * 3;
+   char tmp[PATH_MAX];
+   int fd, fd2;
+
+   if (stat(path, &st) == -1) return;
+   if ((size_t) st.st_size <= max) return;
+
+   fd = open(path, O_RDONLY);
+   if (fd == -1) return;
+
+   size = st.st_size;
+   map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED) return;
+
+   while ((size - off) > target)
+     {
+        rec = (Rollup_Record *) (map + off);
+        if (((size - off) < sizeof(Rollup_Record)) || (rec->magic != ROLLUP_MAGIC) ||
+            (rec->count > ((size - off - sizeof(Rollup_Record)) / sizeof(Rollup_Entry))))
+          {
+             off = size;
+             break;
+          }
+        off += sizeof(Rollup_Record) + (rec->count * sizeof(Rollup_Entry));
+     }
+
+   snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+   fd2 = open(tmp, O_CREAT | O_WRONLY | O_TRUNC, enigmatic_file_mode_get());
+   if (fd2 != -1)
+     {
+        if (write(fd2, map + off, size - off) == (ssize_t) (size - off))
+          rename(tmp, path);
+        else
+          unlink(tmp);
+        close(fd2);
+     }
+
+   munmap(map, size);
+}
+
+// A bucket still open at shutdown is archived as it stands. Restarted inside
+// that same bucket we close it again, so fold the new record into the one
+// already archived rather than append a second for the same time.
+static void
+rollup_archive_merge(const char *path, Buffer *buffer)
+{
+   Rollup_Bucket merged;
+   Rollup_Record *rec, *first = (Rollup_Record *) buffer->data;
+   struct stat st;
+   uint8_t *map;
+   size_t off = 0, last = 0, size, len;
+   void *tmp;
+   int fd;
+
+   if (buffer->length < sizeof(Rollup_Record)) return;
+   len = sizeof(Rollup_Record) + (first->count * sizeof(Rollup_Entry));
+   if (len > buffer->length) return;
+
+   fd = open(path, O_RDWR);
+   if (fd == -1) return;
+   if ((fstat(fd, &st) == -1) || ((size_t) st.st_size < sizeof(Rollup_Record)))
+     {
+        close(fd);
+        return;
+     }
+
+   size = st.st_size;
+   map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   if (map == MAP_FAILED)
+     {
+        close(fd);
+        return;
+     }
+
+   while ((size - off) >= sizeof(Rollup_Record))
+     {
+        rec = (Rollup_Record *) (map + off);
+        if ((rec->magic != ROLLUP_MAGIC) ||
+            (rec->count > ((size - off - sizeof(Rollup_Record)) / sizeof(Rollup_Entry))))
+          break;
+        last = off;
+        off += sizeof(Rollup_Record) + (rec->count * sizeof(Rollup_Entry));
+     }
+
+   rec = (Rollup_Record *) (map + last);
+   if ((off != size) || (rec->magic != ROLLUP_MAGIC) || (rec->time != first->time) ||
+       (rec->resolution != first->resolution))
+     {
+        munmap(map, size);
+        close(fd);
+        return;
+     }
+
+   memset(&merged, 0, sizeof(Rollup_Bucket));
+   merged.resolution = rec->resolution;
+   merged.start = rec->time;
+   merged.accs = eina_hash_int64_new(free);
+   for (uint32_t i = 0; i < rec->count; i++)
+     rollup_acc_merge(&merged, &rec->entries[i]);
+   for (uint32_t i = 0; i < first->count; i++)
+     rollup_acc_merge(&merged, &first->entries[i]);
+   rollup_bucket_close(&merged, NULL);
+   eina_hash_free(merged.accs);
+   munmap(map, size);
+
+   // The merged record replaces both, the archived one is cut off here and
+   // written again with the rest of what is pending.
+   tmp = realloc(merged.pending.data, merged.pending.length + (buffer->length - len));
+   if (tmp)
+     {
+        merged.pending.data = tmp;
+        memcpy(merged.pending.data + merged.pending.length, buffer->data + len, buffer->length - len);
+        merged.pending.length += buffer->length - len;
+        if (!ftruncate(fd, last))
+          {
+             free(buffer->data);
+             *buffer = merged.pending;
+             merged.pending.data = NULL;
+          }
+     }
+   free(merged.pending.data);
+   close(fd);
+}
+
+static void
+rollup_archive_append(Rollup_Bucket *bucket, size_t max)
+{
+   Buffer *buffer = &bucket->pending;
+   char *path;
+   int fd;
+
+   path = enigmatic_rollup_path(bucket->resolution);
+   EINA_SAFETY_ON_NULL_RETURN(path);
+
+   if (buffer->length)
+     {
+        rollup_archive_merge(path, buffer);
+        fd = open(path, O_CREAT | O_WRONLY | O_APPEND, enigmatic_file_mode_get());
+        if (fd != -1)
+          {
+             if (write(fd, buffer->data, buffer->length) != (ssize_t) buffer->length)
+               fprintf(stderr, "ERR: write() %s: %s\n", path, strerror(errno));
+             close(fd);
+          }
+        free(buffer->data);
+        buffer->data = NULL;
+        buffer->length = 0;
+     }
+
+   rollup_archive_trim(path, max);
+
+   free(path);
+}
+
+void
+enigmatic_rollup_flush(Enigmatic *enigmatic)
+{
+   Rollup *rollup = enigmatic->rollup;
+   size_t max;
+
+   if (!rollup) return;
+
+   // Three quarters of the cap go to the minute archive, the rest to the
+   // quarter hour one which covers far longer.
+   max = (size_t) enigmatic->config->log.rollup_max_size * 1024 * 1024;
+   rollup_archive_append(&rollup->minute, (max / 4) * 3);
+   rollup_archive_append(&rollup->quarter, max / 4);
+}
+
+void
+enigmatic_rollup_shutdown(Enigmatic *enigmatic)
+{
+   Rollup *rollup = enigmatic->rollup;
+
+   if (!rollup) return;
+
+   rollup_bucket_close(&rollup->minute, &rollup->quarter);
+   rollup_bucket_close(&rollup->quarter, NULL);
+   enigmatic_rollup_flush(enigmatic);
+
+   eina_hash_free(rollup->minute.accs);
+   eina_hash_free(rollup->quarter.accs);
+   eina_hash_free(rollup->counters);
+   free(rollup);
+   enigmatic->rollup = NULL;
+}
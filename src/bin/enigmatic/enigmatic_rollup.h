@@ -0,0 +1,15 @@
+#ifndef ENIGMATIC_ROLLUP_H
+#define ENIGMATIC_ROLLUP_H
+
+#include "Enigmatic.h"
+
+void
+enigmatic_rollup_sample(Enigmatic *enigmatic, System_Info *info);
+
+void
+enigmatic_rollup_flush(Enigmatic *enigmatic);
+
+void
+enigmatic_rollup_shutdown(Enigmatic *enigmatic);
+
+#endif
@@ -1,28 +1,224 @@
+#if defined(__linux__)
+# define _GNU_SOURCE
+#endif
 #include "config.h"
 #include "enigmatic_server.h"
 #include "Enigmatic.h"
 #include <signal.h>
+#include <sys/types.h>
+#include <sys/socket.h>
 
 static Enigmatic_Server *server = NULL;
 
+static Enigmatic_Follower *
+_enigmatic_server_follower_find(Enigmatic_Server *server, Ecore_Con_Client *client)
+{
+   Eina_List *l;
+   Enigmatic_Follower *follower;
+
+   EINA_LIST_FOREACH(server->followers, l, follower)
+     {
+        if (follower->client == client) return follower;
+     }
+
+   return NULL;
+}
+
+// The fastest rate any visible follower asks for, never slower than the
+// recording cadence. With none the daemon idles at the recording cadence.
+static void
+_enigmatic_server_demand_update(Enigmatic_Server *server)
+{
+   Eina_List *l;
+   Enigmatic_Follower *follower;
+   Enigmatic *enigmatic = server->enigmatic;
+   Interval interval = server->interval_idle;
+   Eina_Bool idle = 1, wake;
+
+   if (!enigmatic->config->sample.on_demand)
+     idle = 0;
+   else
+     {
+        EINA_LIST_FOREACH(server->followers, l, follower)
+          {
+             if (follower->interval == INTERVAL_IDLE) continue;
+             if (follower->interval < interval)
+               interval = follower->interval;
+             idle = 0;
+          }
+     }
+
+   eina_lock_take(&enigmatic->update_lock);
+   // Only speeding up is urgent, slowing down waits for the next pass.
+   wake = (interval < enigmatic->interval_update) || ((!idle) && (enigmatic->idle_update));
+   enigmatic->interval_update = interval;
+   enigmatic->idle_update = idle;
+   if (wake)
+     eina_condition_signal(&enigmatic->update_cond);
+   eina_lock_release(&enigmatic->update_lock);
+}
+
 static Eina_Bool
-_enigmatic_server_client_data_cb(void *data, int type, void *event)
+_enigmatic_server_follow(Enigmatic_Server *server, Ecore_Con_Client *client, const char *resolution)
+{
+   Enigmatic_Follower *follower;
+   Interval interval;
+
+   if (!strcmp(resolution, "normal"))
+     interval = INTERVAL_NORMAL;
+   else if (!strcmp(resolution, "medium"))
+     interval = INTERVAL_MEDIUM;
+   else if (!strcmp(resolution, "slow"))
+     interval = INTERVAL_SLOW;
+   else if (!strcmp(resolution, "idle"))
+     interval = INTERVAL_IDLE;
+   else return 0;
+
+   follower = _enigmatic_server_follower_find(server, client);
+   if (!follower)
+     {
+        follower = calloc(1, sizeof(Enigmatic_Follower));
+        EINA_SAFETY_ON_NULL_RETURN_VAL(follower, 0);
+        follower->client = client;
+        server->followers = eina_list_append(server->followers, follower);
+     }
+   follower->seen = ecore_time_get();
+   if (follower->interval != interval)
+     {
+        follower->interval = interval;
+        _enigmatic_server_demand_update(server);
+     }
+
+   return 1;
+}
+
+static void
+_enigmatic_server_follower_del(Enigmatic_Server *server, Enigmatic_Follower *follower)
+{
+   server->followers = eina_list_remove(server->followers, follower);
+   free(follower);
+   _enigmatic_server_demand_update(server);
+}
+
+static Eina_Bool
+_enigmatic_server_followers_expire_cb(void *data)
+{
+   Eina_List *l, *l_next;
+   Enigmatic_Follower *follower;
+   Enigmatic_Server *server = data;
+   double now = ecore_time_get();
+
+   EINA_LIST_FOREACH_SAFE(server->followers, l, l_next, follower)
+     {
+        if ((now - follower->seen) > FOLLOWER_TIMEOUT)
+          _enigmatic_server_follower_del(server, follower);
+     }
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_enigmatic_server_client_del_cb(void *data, int type, void *event)
+{
+   Enigmatic_Follower *follower;
+   Enigmatic_Server *server = data;
+   Ecore_Con_Event_Client_Del *ev = event;
+
+   if (ecore_con_client_server_get(ev->client) != server->srv) return ECORE_CALLBACK_PASS_ON;
+
+   follower = _enigmatic_server_follower_find(server, ev->client);
+   if (follower)
+     _enigmatic_server_follower_del(server, follower);
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_enigmatic_server_client_uid_get(Ecore_Con_Client *client, uid_t *uid)
+{
+   int fd = ecore_con_client_fd_get(client);
+#if defined(__linux__)
+   struct ucred cred;
+   socklen_t len = sizeof(cred);
+
+   if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == -1)
+     return 0;
+   *uid = cred.uid;
+#else
+   gid_t gid;
+
+   if (getpeereid(fd, uid, &gid) == -1)
+     return 0;
+#endif
+   return 1;
+}
+
+// Anyone can follow a system daemon, only its owner or root can steer it.
+static Eina_Bool
+_enigmatic_server_client_privileged(Ecore_Con_Client *client)
+{
+   uid_t uid;
+
+   if (!enigmatic_system_mode_get()) return 1;
+   if (!_enigmatic_server_client_uid_get(client, &uid)) return 0;
+
+   return ((uid == 0) || (uid == geteuid()));
+}
+
+// "ARGS pid start", answered with "ARGS pid start arguments" where the
+// arguments are left empty unless the asking user owns that process.
+static int
+_enigmatic_server_arguments_send(Ecore_Con_Client *client, const char *msg)
+{
+   Proc_Info *proc;
+   uid_t uid;
+   long long start;
+   int pid;
+   const char *arguments = "";
+
+   if (sscanf(msg, "%d %lld", &pid, &start) != 2)
+     return ecore_con_client_send(client, "ERR", 4);
+
+   proc = proc_info_by_pid(pid);
+   if ((proc) && (proc->start == start) && (proc->arguments) &&
+       (_enigmatic_server_client_uid_get(client, &uid)) && ((uid == 0) || (uid == proc->uid)))
+     arguments = proc->arguments;
+
+   msg = eina_slstr_printf("ARGS %d %lld %s", pid, start, arguments);
+   if (proc) proc_info_free(proc);
+
+   return ecore_con_client_send(client, msg, strlen(msg) + 1);
+}
+
+static void
+_enigmatic_server_command(Enigmatic_Server *server, Ecore_Con_Client *client, const char *msg)
 {
-   char *msg;
-   Enigmatic_Server *server;
-   Enigmatic *enigmatic;
    Interval interval;
    int sent = 0;
    Eina_Bool contentious_update = 0;
    Eina_Bool stop = 0;
-   Ecore_Con_Event_Client_Data *ev = event;
 
-   msg = ev->data;
-   server = data;
-   enigmatic = server->enigmatic;
+   if ((!strncmp(msg, "interval-", 9)) || (!strcmp(msg, "STOP")))
+     {
+        if (!_enigmatic_server_client_privileged(client))
+          {
+             if (ecore_con_client_send(client, "DENIED", 7))
+               ecore_con_client_flush(client);
+             return;
+          }
+     }
 
    if (!strcmp(msg, "PING"))
-     sent = ecore_con_client_send(ev->client, "PONG", 5);
+     sent = ecore_con_client_send(client, "PONG", 5);
+   else if (!strncmp(msg, "FOLLOW ", 7))
+     {
+        if (!_enigmatic_server_follow(server, client, msg + 7))
+          sent = ecore_con_client_send(client, "ERR", 4);
+     }
+   else if (!strncmp(msg, "ARGS ", 5))
+     sent = _enigmatic_server_arguments_send(client, msg + 5);
+   else if (!strcmp(msg, "HEARTBEAT"))
+     enigmatic_server_heartbeat(client);
    else if (!strcmp(msg, "interval-slow"))
      {
         contentious_update = 1;
@@ -41,26 +237,78 @@ _enigmatic_server_client_data_cb(void *data, int type, void *event)
    else if (!strcmp(msg, "STOP"))
      {
         stop = 1;
-        sent = ecore_con_client_send(ev->client, "STOPPING", 9);
+        sent = ecore_con_client_send(client, "STOPPING", 9);
      }
 
+   // Sets the recording cadence, followers can still ask for more.
    if (contentious_update)
      {
-        eina_lock_take(&enigmatic->update_lock);
-        enigmatic->interval_update = interval;
-        eina_lock_release(&enigmatic->update_lock);
-        sent = ecore_con_client_send(ev->client, "OK", 3);
+        server->interval_idle = interval;
+        _enigmatic_server_demand_update(server);
+        sent = ecore_con_client_send(client, "OK", 3);
      }
 
    if (sent)
-     ecore_con_client_flush(ev->client);
+     ecore_con_client_flush(client);
 
    if (stop)
      raise(SIGTERM);
+}
+
+static Eina_Bool
+_enigmatic_server_client_data_cb(void *data, int type, void *event)
+{
+   const char *msg;
+   size_t len;
+   Ecore_Con_Event_Client_Data *ev = event;
+   Enigmatic_Server *server = data;
+
+   if (ecore_con_client_server_get(ev->client) != server->srv) return ECORE_CALLBACK_PASS_ON;
+
+   // Followers keep their connection, commands may arrive back to back.
+   for (int off = 0; off < ev->size; off += len + 1)
+     {
+        msg = (const char *) ev->data + off;
+        len = strnlen(msg, ev->size - off);
+        if (len == (size_t) (ev->size - off)) break;
+        if (len) _enigmatic_server_command(server, ev->client, msg);
+     }
 
    return ECORE_CALLBACK_RENEW;
 }
 
+Eina_Bool
+enigmatic_server_follow(Ecore_Con_Client *client, const char *resolution)
+{
+   if (!server) return 0;
+
+   return _enigmatic_server_follow(server, client, resolution);
+}
+
+void
+enigmatic_server_heartbeat(Ecore_Con_Client *client)
+{
+   Enigmatic_Follower *follower;
+
+   if (!server) return;
+
+   follower = _enigmatic_server_follower_find(server, client);
+   if (follower)
+     follower->seen = ecore_time_get();
+}
+
+void
+enigmatic_server_unfollow(Ecore_Con_Client *client)
+{
+   Enigmatic_Follower *follower;
+
+   if (!server) return;
+
+   follower = _enigmatic_server_follower_find(server, client);
+   if (follower)
+     _enigmatic_server_follower_del(server, follower);
+}
+
 void
 enigmatic_server_init(Enigmatic *enigmatic)
 {
@@ -68,21 +316,34 @@ enigmatic_server_init(Enigmatic *enigmatic)
    EINA_SAFETY_ON_NULL_RETURN(server);
 
    server->enigmatic = enigmatic;
+   server->interval_idle = enigmatic->config->sample.idle_interval;
+   if ((server->interval_idle != INTERVAL_MEDIUM) && (server->interval_idle != INTERVAL_SLOW))
+     server->interval_idle = INTERVAL_NORMAL;
 
    ecore_con_init();
 
-   server->srv = ecore_con_server_add(ECORE_CON_LOCAL_USER, PACKAGE, 0, NULL);
+   server->srv = ecore_con_server_add(enigmatic_control_type_get(), PACKAGE, 0, NULL);
    if (!server->srv)
      ERROR("ecore_con_server_add");
 
    server->handler = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA, _enigmatic_server_client_data_cb, server);
+   server->handler_del = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DEL, _enigmatic_server_client_del_cb, server);
+   server->timer = ecore_timer_add(FOLLOWER_TIMEOUT / 2, _enigmatic_server_followers_expire_cb, server);
+
+   _enigmatic_server_demand_update(server);
 }
 
 void
 enigmatic_server_shutdown(Enigmatic *enigmatic)
 {
+   Enigmatic_Follower *follower;
+
+   ecore_timer_del(server->timer);
    ecore_event_handler_del(server->handler);
+   ecore_event_handler_del(server->handler_del);
    ecore_con_server_del(server->srv);
+   EINA_LIST_FREE(server->followers, follower)
+     free(follower);
    free(server);
 
    ecore_con_shutdown();
@@ -4,11 +4,30 @@
 #include <Ecore.h>
 #include <Ecore_Con.h>
 
+// "ARGS pid start" asks for the arguments of a process, withheld from a
+// system daemon's shared log. Only its owner or root gets them back.
+
+// Followers register with "FOLLOW normal|medium|slow|idle" and repeat it or
+// send "HEARTBEAT" at least every FOLLOWER_TIMEOUT seconds. Those gone quiet
+// or disconnected no longer count towards the sampling rate.
+#define FOLLOWER_TIMEOUT 10.0
+
+typedef struct
+{
+   Ecore_Con_Client    *client;
+   Interval             interval;
+   double               seen;
+} Enigmatic_Follower;
+
 typedef struct
 {
    Ecore_Event_Handler *handler;
+   Ecore_Event_Handler *handler_del;
    Ecore_Con_Server    *srv;
+   Ecore_Timer         *timer;
    Enigmatic           *enigmatic;
+   Eina_List           *followers;
+   Interval             interval_idle;
 } Enigmatic_Server;
 
 void
@@ -17,4 +36,14 @@ enigmatic_server_init(Enigmatic *enigmatic);
 void
 enigmatic_server_shutdown(Enigmatic *enigmatic);
 
+// Followers connected elsewhere, over the stream, count towards demand too.
+Eina_Bool
+enigmatic_server_follow(Ecore_Con_Client *client, const char *resolution);
+
+void
+enigmatic_server_heartbeat(Ecore_Con_Client *client);
+
+void
+enigmatic_server_unfollow(Ecore_Con_Client *client);
+
 #endif
@@ -0,0 +1,461 @@
+#include "config.h"
+#include "enigmatic_stream.h"
+#include "enigmatic_server.h"
+#include "Enigmatic.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+static Enigmatic_Stream *stream = NULL;
+
+static Enigmatic_Stream_Block *
+_enigmatic_stream_block_get(Enigmatic_Stream *stream, uint64_t seq)
+{
+   return stream->blocks[(stream->head + (seq - stream->first)) % stream->size];
+}
+
+static void
+_enigmatic_stream_block_drop(Enigmatic_Stream *stream)
+{
+   Enigmatic_Stream_Block *block = stream->blocks[stream->head];
+
+   stream->bytes -= block->record.size;
+   free(block);
+   stream->blocks[stream->head] = NULL;
+   stream->head = (stream->head + 1) % stream->size;
+   stream->count--;
+   stream->first++;
+   if ((stream->has_keyframe) && (stream->keyframe < stream->first))
+     stream->has_keyframe = 0;
+}
+
+static Eina_Bool
+_enigmatic_stream_grow(Enigmatic_Stream *stream)
+{
+   Enigmatic_Stream_Block **blocks;
+   unsigned int size = stream->size ? stream->size * 2 : 256;
+
+   blocks = calloc(size, sizeof(Enigmatic_Stream_Block *));
+   if (!blocks) return 0;
+
+   for (unsigned int i = 0; i < stream->count; i++)
+     blocks[i] = stream->blocks[(stream->head + i) % stream->size];
+
+   free(stream->blocks);
+   stream->blocks = blocks;
+   stream->size = size;
+   stream->head = 0;
+
+   return 1;
+}
+
+// Runs wherever the log is written, usually the monitor thread.
+static void
+_enigmatic_stream_block_cb(Enigmatic *enigmatic EINA_UNUSED, const void *data, uint32_t size, Eina_Bool keyframe)
+{
+   Enigmatic_Stream_Block *block;
+   Eina_Bool wake;
+
+   block = malloc(sizeof(Enigmatic_Stream_Block) + size);
+   EINA_SAFETY_ON_NULL_RETURN(block);
+
+   block->record.size = size;
+   block->record.epoch = stream->epoch;
+   memcpy(block->data, data, size);
+
+   eina_lock_take(&stream->lock);
+   if ((stream->count == stream->size) && (!_enigmatic_stream_grow(stream)))
+     {
+        eina_lock_release(&stream->lock);
+        free(block);
+        return;
+     }
+
+   block->record.seq = stream->first + stream->count;
+   stream->blocks[(stream->head + stream->count) % stream->size] = block;
+   stream->count++;
+   stream->bytes += size;
+   if (keyframe)
+     {
+        stream->keyframe = block->record.seq;
+        stream->has_keyframe = 1;
+     }
+
+   while ((stream->bytes > STREAM_BACKLOG_MAX) && (stream->count > 1))
+     _enigmatic_stream_block_drop(stream);
+
+   wake = !stream->woken;
+   stream->woken = 1;
+   eina_lock_release(&stream->lock);
+
+   if (wake)
+     ecore_pipe_write(stream->pipe, &wake, sizeof(wake));
+}
+
+static void
+_enigmatic_stream_keyframe_request(Enigmatic_Stream *stream)
+{
+   Enigmatic *enigmatic = stream->enigmatic;
+
+   eina_lock_take(&enigmatic->update_lock);
+   if (!enigmatic->broadcast_update)
+     {
+        enigmatic->broadcast_update = 1;
+        eina_condition_signal(&enigmatic->update_cond);
+     }
+   eina_lock_release(&enigmatic->update_lock);
+}
+
+// Called with the stream locked. A follower who is new, or has fallen out
+// of the backlog, starts again from the latest keyframe.
+static void
+_enigmatic_stream_follower_flush(Enigmatic_Stream *stream, Enigmatic_Stream_Follower *follower)
+{
+   Enigmatic_Stream_Block *block;
+   size_t len;
+
+   if (!follower->streaming) return;
+
+   if ((follower->synced) && (follower->next < stream->first))
+     follower->synced = 0;
+
+   if (!follower->synced)
+     {
+        if (!stream->has_keyframe)
+          {
+             _enigmatic_stream_keyframe_request(stream);
+             return;
+          }
+        follower->next = stream->keyframe;
+        follower->synced = 1;
+     }
+
+   while ((follower->queued < STREAM_QUEUE_MAX) && (follower->next < (stream->first + stream->count)))
+     {
+        block = _enigmatic_stream_block_get(stream, follower->next);
+        len = sizeof(Stream_Record) + block->record.size;
+        if (ecore_con_client_send(follower->client, &block->record, len) != (int) len)
+          break;
+        follower->queued += len;
+        follower->next++;
+     }
+}
+
+static void
+_enigmatic_stream_flush(Enigmatic_Stream *stream)
+{
+   Eina_List *l;
+   Enigmatic_Stream_Follower *follower;
+
+   eina_lock_take(&stream->lock);
+   stream->woken = 0;
+   EINA_LIST_FOREACH(stream->followers, l, follower)
+     _enigmatic_stream_follower_flush(stream, follower);
+   eina_lock_release(&stream->lock);
+}
+
+static void
+_enigmatic_stream_wake_cb(void *data, void *buffer EINA_UNUSED, unsigned int nbyte EINA_UNUSED)
+{
+   _enigmatic_stream_flush(data);
+}
+
+static Enigmatic_Stream_Follower *
+_enigmatic_stream_follower_find(Enigmatic_Stream *stream, Ecore_Con_Client *client)
+{
+   Eina_List *l;
+   Enigmatic_Stream_Follower *follower;
+
+   EINA_LIST_FOREACH(stream->followers, l, follower)
+     {
+        if (follower->client == client) return follower;
+     }
+
+   return NULL;
+}
+
+// The local socket is its user's alone (or, for a system daemon, carries
+// no arguments), TCP peers prove themselves with the token first.
+static Enigmatic_Stream_Follower *
+_enigmatic_stream_follower_get(Enigmatic_Stream *stream, Ecore_Con_Client *client)
+{
+   Enigmatic_Stream_Follower *follower = _enigmatic_stream_follower_find(stream, client);
+
+   if (follower) return follower;
+
+   follower = calloc(1, sizeof(Enigmatic_Stream_Follower));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(follower, NULL);
+   follower->client = client;
+   follower->authenticated = !stream->token_path;
+   follower->pending = eina_binbuf_new();
+   if (!follower->pending)
+     {
+        free(follower);
+        return NULL;
+     }
+   stream->followers = eina_list_append(stream->followers, follower);
+
+   return follower;
+}
+
+static void
+_enigmatic_stream_follower_del(Enigmatic_Stream *stream, Enigmatic_Stream_Follower *follower)
+{
+   enigmatic_server_unfollow(follower->client);
+   stream->followers = eina_list_remove(stream->followers, follower);
+   eina_binbuf_free(follower->pending);
+   free(follower);
+}
+
+static void
+_enigmatic_stream_follower_stream(Enigmatic_Stream *stream, Enigmatic_Stream_Follower *follower, const char *msg)
+{
+   unsigned long long seq;
+   unsigned int epoch;
+
+   if (sscanf(msg, "%u %llu", &epoch, &seq) != 2)
+     {
+        if (ecore_con_client_send(follower->client, "ERR", 4))
+          ecore_con_client_flush(follower->client);
+        return;
+     }
+
+   eina_lock_take(&stream->lock);
+   follower->streaming = 1;
+   follower->synced = ((epoch == stream->epoch) && (seq + 1 >= stream->first) &&
+                       (seq + 1 <= stream->first + stream->count));
+   if (follower->synced)
+     follower->next = seq + 1;
+   _enigmatic_stream_follower_flush(stream, follower);
+   eina_lock_release(&stream->lock);
+}
+
+static Eina_Bool
+_enigmatic_stream_token_check(Enigmatic_Stream *stream, const char *token)
+{
+   unsigned char diff = 0;
+
+   if (strlen(token) != STREAM_TOKEN_SIZE) return 0;
+
+   for (int i = 0; i < STREAM_TOKEN_SIZE; i++)
+     diff |= token[i] ^ stream->token[i];
+
+   return !diff;
+}
+
+// Returns 0 for a peer to be dropped.
+static Eina_Bool
+_enigmatic_stream_command(Enigmatic_Stream *stream, Enigmatic_Stream_Follower *follower, const char *msg)
+{
+   if (!follower->authenticated)
+     {
+        if ((!strncmp(msg, "AUTH ", 5)) && (_enigmatic_stream_token_check(stream, msg + 5)))
+          {
+             follower->authenticated = 1;
+             return 1;
+          }
+        return 0;
+     }
+
+   if (!strncmp(msg, "STREAM ", 7))
+     _enigmatic_stream_follower_stream(stream, follower, msg + 7);
+   else if (!strncmp(msg, "FOLLOW ", 7))
+     enigmatic_server_follow(follower->client, msg + 7);
+   else if (!strcmp(msg, "HEARTBEAT"))
+     enigmatic_server_heartbeat(follower->client);
+
+   return 1;
+}
+
+static void
+_enigmatic_stream_follower_deny(Enigmatic_Stream *stream, Enigmatic_Stream_Follower *follower)
+{
+   Ecore_Con_Client *client = follower->client;
+
+   if (ecore_con_client_send(client, "DENIED", 7))
+     ecore_con_client_flush(client);
+   _enigmatic_stream_follower_del(stream, follower);
+   ecore_con_client_del(client);
+}
+
+// A read may end part way through a command, what follows its last
+// terminator waits for the next read.
+static Eina_Bool
+_enigmatic_stream_client_data_cb(void *data, int type EINA_UNUSED, void *event)
+{
+   const char *buf, *msg;
+   size_t len, size, off;
+   Enigmatic_Stream_Follower *follower;
+   Enigmatic_Stream *stream = data;
+   Ecore_Con_Event_Client_Data *ev = event;
+
+   if (ecore_con_client_server_get(ev->client) != stream->srv) return ECORE_CALLBACK_PASS_ON;
+
+   follower = _enigmatic_stream_follower_get(stream, ev->client);
+   if (!follower) return ECORE_CALLBACK_DONE;
+
+   eina_binbuf_append_length(follower->pending, ev->data, ev->size);
+   buf = (const char *) eina_binbuf_string_get(follower->pending);
+   size = eina_binbuf_length_get(follower->pending);
+
+   for (off = 0; off < size; off += len + 1)
+     {
+        msg = buf + off;
+        len = strnlen(msg, size - off);
+        if (len == (size - off)) break;
+        if ((len) && (!_enigmatic_stream_command(stream, follower, msg)))
+          {
+             _enigmatic_stream_follower_deny(stream, follower);
+             return ECORE_CALLBACK_DONE;
+          }
+     }
+
+   if (off)
+     eina_binbuf_remove(follower->pending, 0, off > size ? size : off);
+
+   if (eina_binbuf_length_get(follower->pending) > STREAM_COMMAND_MAX)
+     _enigmatic_stream_follower_deny(stream, follower);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+// Backpressure, a follower gets more as what it was sent is written out.
+static Eina_Bool
+_enigmatic_stream_client_write_cb(void *data, int type EINA_UNUSED, void *event)
+{
+   Enigmatic_Stream_Follower *follower;
+   Enigmatic_Stream *stream = data;
+   Ecore_Con_Event_Client_Write *ev = event;
+
+   if (ecore_con_client_server_get(ev->client) != stream->srv) return ECORE_CALLBACK_PASS_ON;
+
+   follower = _enigmatic_stream_follower_find(stream, ev->client);
+   if (!follower) return ECORE_CALLBACK_DONE;
+
+   follower->queued -= ((size_t) ev->size > follower->queued) ? follower->queued : (size_t) ev->size;
+
+   eina_lock_take(&stream->lock);
+   _enigmatic_stream_follower_flush(stream, follower);
+   eina_lock_release(&stream->lock);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_enigmatic_stream_client_del_cb(void *data, int type EINA_UNUSED, void *event)
+{
+   Enigmatic_Stream_Follower *follower;
+   Enigmatic_Stream *stream = data;
+   Ecore_Con_Event_Client_Del *ev = event;
+
+   if (ecore_con_client_server_get(ev->client) != stream->srv) return ECORE_CALLBACK_PASS_ON;
+
+   follower = _enigmatic_stream_follower_find(stream, ev->client);
+   if (follower)
+     _enigmatic_stream_follower_del(stream, follower);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_enigmatic_stream_token_create(Enigmatic_Stream *stream)
+{
+   unsigned char bytes[STREAM_TOKEN_SIZE / 2];
+   char path[PATH_MAX];
+   ssize_t n;
+   int fd;
+
+   fd = open("/dev/urandom", O_RDONLY);
+   if (fd == -1) return 0;
+   n = read(fd, bytes, sizeof(bytes));
+   close(fd);
+   if (n != sizeof(bytes)) return 0;
+
+   for (unsigned int i = 0; i < sizeof(bytes); i++)
+     snprintf(stream->token + (i * 2), 3, "%02x", bytes[i]);
+
+   // Never through whatever may have been left in its place.
+   snprintf(path, sizeof(path), "%s/%s/%s", enigmatic_cache_dir_get(), PACKAGE, STREAM_TOKEN_FILE);
+   unlink(path);
+   fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+   if (fd == -1) return 0;
+   n = write(fd, stream->token, STREAM_TOKEN_SIZE);
+   close(fd);
+   if (n != STREAM_TOKEN_SIZE)
+     {
+        unlink(path);
+        return 0;
+     }
+
+   stream->token_path = strdup(path);
+
+   return !!stream->token_path;
+}
+
+void
+enigmatic_stream_init(Enigmatic *enigmatic, int port)
+{
+   if (port < 0) return;
+
+   stream = calloc(1, sizeof(Enigmatic_Stream));
+   EINA_SAFETY_ON_NULL_RETURN(stream);
+
+   stream->enigmatic = enigmatic;
+   stream->epoch = time(NULL);
+   eina_lock_new(&stream->lock);
+
+   // Only the loopback, tunnel it to watch from elsewhere.
+   if (port > 0)
+     {
+        if (!_enigmatic_stream_token_create(stream))
+          ERROR("stream token");
+        stream->srv = ecore_con_server_add(ECORE_CON_REMOTE_TCP, "127.0.0.1", port, NULL);
+     }
+   else
+     stream->srv = ecore_con_server_add(enigmatic_control_type_get(), PACKAGE, STREAM_PORT_LOCAL, NULL);
+   if (!stream->srv)
+     ERROR("ecore_con_server_add (stream)");
+
+   stream->pipe = ecore_pipe_add(_enigmatic_stream_wake_cb, stream);
+   stream->handler = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA, _enigmatic_stream_client_data_cb, stream);
+   stream->handler_del = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DEL, _enigmatic_stream_client_del_cb, stream);
+   stream->handler_write = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_WRITE, _enigmatic_stream_client_write_cb, stream);
+
+   enigmatic->log.block_cb = _enigmatic_stream_block_cb;
+}
+
+void
+enigmatic_stream_shutdown(Enigmatic *enigmatic)
+{
+   Eina_List *l;
+   Enigmatic_Stream_Follower *follower;
+
+   if (!stream) return;
+
+   enigmatic->log.block_cb = NULL;
+
+   // Whatever was written last, the final record included, goes out.
+   _enigmatic_stream_flush(stream);
+   EINA_LIST_FOREACH(stream->followers, l, follower)
+     ecore_con_client_flush(follower->client);
+
+   ecore_event_handler_del(stream->handler);
+   ecore_event_handler_del(stream->handler_del);
+   ecore_event_handler_del(stream->handler_write);
+   ecore_pipe_del(stream->pipe);
+   ecore_con_server_del(stream->srv);
+   EINA_LIST_FREE(stream->followers, follower)
+     free(follower);
+
+   if (stream->token_path)
+     {
+        unlink(stream->token_path);
+        free(stream->token_path);
+     }
+
+   while (stream->count)
+     _enigmatic_stream_block_drop(stream);
+   free(stream->blocks);
+   eina_lock_free(&stream->lock);
+   free(stream);
+   stream = NULL;
+}
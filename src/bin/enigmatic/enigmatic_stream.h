@@ -0,0 +1,67 @@
+#ifndef ENIGMATIC_STREAM_H
+#define ENIGMATIC_STREAM_H
+#include "Enigmatic.h"
+#include <Ecore.h>
+#include <Ecore_Con.h>
+
+// Bytes of blocks kept for followers to resume from, never less than the
+// latest block, and bytes queued to one follower before it is left to
+// catch up from the backlog as its socket drains.
+#define STREAM_BACKLOG_MAX (16 * 1024 * 1024)
+#define STREAM_QUEUE_MAX   (1024 * 1024)
+
+// Longest command a follower may have pending before its terminator.
+#define STREAM_COMMAND_MAX 256
+
+typedef struct
+{
+   Stream_Record        record;
+   uint8_t              data[];
+} Enigmatic_Stream_Block;
+
+typedef struct
+{
+   Ecore_Con_Client    *client;
+   uint64_t             next;
+   size_t               queued;
+   Eina_Bool            synced;
+   Eina_Bool            authenticated;
+   Eina_Bool            streaming;
+   Eina_Binbuf         *pending; // Command bytes still waiting on their '\0'.
+} Enigmatic_Stream_Follower;
+
+typedef struct
+{
+   Ecore_Event_Handler *handler;
+   Ecore_Event_Handler *handler_del;
+   Ecore_Event_Handler *handler_write;
+   Ecore_Con_Server    *srv;
+   Ecore_Pipe          *pipe;
+   Enigmatic           *enigmatic;
+   Eina_List           *followers;
+   char                *token_path;
+   char                 token[STREAM_TOKEN_SIZE + 1];
+
+   // Written by the monitor thread, read by the main loop.
+   Eina_Lock            lock;
+   Enigmatic_Stream_Block **blocks;
+   unsigned int         head;
+   unsigned int         count;
+   unsigned int         size;
+   uint64_t             first;
+   uint64_t             keyframe;
+   Eina_Bool            has_keyframe;
+   size_t               bytes;
+   uint32_t             epoch;
+   Eina_Bool            woken;
+} Enigmatic_Stream;
+
+// Serve the log over TCP on the loopback at port, or the local socket when
+// port is 0. Nothing is served when port is negative.
+void
+enigmatic_stream_init(Enigmatic *enigmatic, int port);
+
+void
+enigmatic_stream_shutdown(Enigmatic *enigmatic);
+
+#endif
@@ -6,6 +6,8 @@
 #include <unistd.h>
 #include <sys/wait.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
 
 static char *
 _tool_path_find(const char *tool)
@@ -89,7 +91,7 @@ enigmatic_pidfile_create(Enigmatic *enigmatic)
 
    snprintf(path, sizeof(path), "%s/%s", enigmatic_cache_dir_get(), PACKAGE);
    if (!ecore_file_exists(path))
-     ecore_file_mkdir(path);
+     ecore_file_mkpath(path);
 
    tmp = _pidfile_path();
    f = fopen(tmp, "w");
@@ -107,6 +109,58 @@ enigmatic_pidfile_create(Enigmatic *enigmatic)
    return 1;
 }
 
+static int _system_mode = -1;
+
+void
+enigmatic_system_mode_set(Eina_Bool enabled)
+{
+   _system_mode = enabled;
+}
+
+// A system daemon holds its lock file for as long as it runs. A pid file
+// can outlive it and its pid be reused, so probe the lock instead.
+Eina_Bool
+enigmatic_system_mode_get(void)
+{
+   char path[PATH_MAX];
+   int fd;
+
+   if (_system_mode != -1)
+     return _system_mode;
+
+   _system_mode = 0;
+
+   snprintf(path, sizeof(path), "%s/%s/%s", ENIGMATIC_SYSTEM_DIR, PACKAGE, LCK_FILE_NAME);
+   fd = open(path, O_RDONLY | O_CLOEXEC);
+   if (fd == -1)
+     return _system_mode;
+
+   if (flock(fd, LOCK_SH | LOCK_NB) == -1)
+     _system_mode = (errno == EWOULDBLOCK);
+   else
+     flock(fd, LOCK_UN);
+   close(fd);
+
+   return _system_mode;
+}
+
+Ecore_Con_Type
+enigmatic_control_type_get(void)
+{
+   if (enigmatic_system_mode_get())
+     return ECORE_CON_LOCAL_SYSTEM;
+   return ECORE_CON_LOCAL_USER;
+}
+
+// Everyone reads a system daemon's log.
+int
+enigmatic_file_mode_get(void)
+{
+   if (enigmatic_system_mode_get())
+     return 0644;
+   return 0600;
+}
+
 const char *
 enigmatic_cache_dir_get(void)
 {
@@ -116,6 +170,11 @@ enigmatic_cache_dir_get(void)
 
    if (found)
      return dir;
+   else if (enigmatic_system_mode_get())
+     {
+        snprintf(dir, sizeof(dir), "%s", ENIGMATIC_SYSTEM_DIR);
+        found = 1;
+     }
    else
      {
         homedir = getenv("HOME");
@@ -254,7 +313,7 @@ enigmatic_log_path(void)
 
    snprintf(path, sizeof(path), "%s/%s", enigmatic_cache_dir_get(), PACKAGE);
    if (!ecore_file_exists(path))
-     ecore_file_mkdir(path);
+     ecore_file_mkpath(path);
 
    snprintf(path, sizeof(path), "%s/%s/%s", enigmatic_cache_dir_get(), PACKAGE, LOG_FILE_NAME);
 
@@ -271,6 +330,16 @@ enigmatic_log_directory(void)
    return strdup(path);
 }
 
+char *
+enigmatic_rollup_path(int resolution)
+{
+   char path[PATH_MAX * 2 + 1];
+
+   snprintf(path, sizeof(path), "%s/%s/rollup-%i", enigmatic_cache_dir_get(), PACKAGE, resolution);
+
+   return strdup(path);
+}
+
 void
 enigmatic_about(void)
 {
@@ -2,6 +2,7 @@
 #define ENIGMATIC_UTIL_H
 
 #include <Eina.h>
+#include <Ecore_Con.h>
 #include <stdint.h>
 #include "enigmatic_visibility.h"
 
@@ -16,6 +17,22 @@ enigmatic_pidfile_path(void);
 ENIGMATIC_API const char *
 enigmatic_cache_dir_get(void);
 
+/* A system daemon (enigmatic --system) is shared by every user and writes under
+ * ENIGMATIC_SYSTEM_DIR. Unless set, system mode is on when one is running. Decided once,
+ * before the cache directory is first used.
+ */
+ENIGMATIC_API void
+enigmatic_system_mode_set(Eina_Bool enabled);
+
+ENIGMATIC_API Eina_Bool
+enigmatic_system_mode_get(void);
+
+ENIGMATIC_API Ecore_Con_Type
+enigmatic_control_type_get(void);
+
+ENIGMATIC_API int
+enigmatic_file_mode_get(void);
+
 ENIGMATIC_API void
 enigmatic_pidfile_delete(Enigmatic *enigmatic);
 
@@ -37,6 +54,9 @@ enigmatic_log_path(void);
 ENIGMATIC_API char *
 enigmatic_log_directory(void);
 
+ENIGMATIC_API char *
+enigmatic_rollup_path(int resolution);
+
 ENIGMATIC_API void
 enigmatic_about(void);
 
@@ -197,6 +197,21 @@ follow(void)
    enigmatic_client_del(client);
 }
 
+// Against a daemon started with --stream, or --stream PORT for "localhost:PORT".
+static void
+stream(const char *address)
+{
+   Enigmatic_Client *client = enigmatic_client_stream_open(address);
+   EINA_SAFETY_ON_NULL_RETURN(client);
+
+   enigmatic_client_monitor_add(client, cb_event_change_init, cb_event_change, NULL);
+   enigmatic_client_demand_set(client, INTERVAL_NORMAL);
+
+   ecore_main_loop_begin();
+
+   enigmatic_client_del(client);
+}
+
 static void
 history(void)
 {
@@ -217,6 +232,8 @@ elm_main(int argc, char **argv)
 {
    if ((argc == 2) && (!strcasecmp(argv[1], "-F")))
      follow();
+   else if ((argc >= 2) && (!strcasecmp(argv[1], "-S")))
+     stream(argc == 3 ? argv[2] : NULL);
    else
      history();
    return 0;
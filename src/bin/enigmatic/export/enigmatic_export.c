@@ -0,0 +1,768 @@
+#include "Enigmatic_Client.h"
+#include <Ecore.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdarg.h>
+#include <signal.h>
+#include <unistd.h>
+
+// Output is formatted in place into one fixed buffer and written out at the
+// end of each export, or sooner when it fills. Nothing is allocated here once
+// running and the client reuses its decode buffers, so only objects that
+// first appear in the log allocate.
+#define EXPORT_BUFFER_SIZE (64 * 1024)
+
+// Binary output starts with EXPORT_MAGIC and the family and metric name
+// tables, then per export a 0 byte and the uint32_t time, followed by its
+// objects. An object is its family, a uint16_t name length and the name, then
+// fields of a metric byte and 8 bytes of int64_t or double as the table says,
+// closed by a 0 byte. All in host byte order, as the magic shows.
+#define EXPORT_MAGIC 0xf00dd00d
+
+typedef enum
+{
+   FORMAT_NDJSON = 0,
+   FORMAT_CSV    = 1,
+   FORMAT_BINARY = 2,
+} Export_Format;
+
+typedef enum
+{
+   METRIC_NONE = 0,
+   METRIC_PERCENT,
+   METRIC_FREQ,
+   METRIC_TEMP,
+   METRIC_TOTAL,
+   METRIC_USED,
+   METRIC_CACHED,
+   METRIC_BUFFERED,
+   METRIC_SHARED,
+   METRIC_SWAP_TOTAL,
+   METRIC_SWAP_USED,
+   METRIC_VALUE,
+   METRIC_CHARGE_FULL,
+   METRIC_CHARGE_CURRENT,
+   METRIC_TOTAL_IN,
+   METRIC_TOTAL_OUT,
+   METRIC_IN,
+   METRIC_OUT,
+   METRIC_READS,
+   METRIC_WRITES,
+   METRIC_READ_BYTES,
+   METRIC_WRITE_BYTES,
+   METRIC_IO_TIME,
+   METRIC_QUEUE_TIME,
+   METRIC_PID,
+   METRIC_PPID,
+   METRIC_UID,
+   METRIC_CPU_USAGE,
+   METRIC_CPU_TIME,
+   METRIC_MEM_RSS,
+   METRIC_MEM_SIZE,
+   METRIC_THREADS,
+   METRIC_NET_IN_RATE,
+   METRIC_NET_OUT_RATE,
+   METRIC_DISK_READ_RATE,
+   METRIC_DISK_WRITE_RATE,
+   METRIC_CPU_USER,
+   METRIC_CPU_SYSTEM,
+   METRIC_MEMORY_CURRENT,
+   METRIC_IO_READ,
+   METRIC_IO_WRITE,
+   METRIC_CPU_PRESSURE,
+   METRIC_MEMORY_PRESSURE,
+   METRIC_IO_PRESSURE,
+   METRIC_MAX,
+} Export_Metric;
+
+typedef struct
+{
+   const char *name;
+   char        type;
+} Export_Metric_Info;
+
+// Indexed by Export_Metric, 'i' for int64_t and 'd' for double values.
+static const Export_Metric_Info metrics[METRIC_MAX] = {
+   [METRIC_NONE]             = { "", 'i' },
+   [METRIC_PERCENT]          = { "percent", 'd' },
+   [METRIC_FREQ]             = { "freq", 'i' },
+   [METRIC_TEMP]             = { "temp", 'i' },
+   [METRIC_TOTAL]            = { "total", 'i' },
+   [METRIC_USED]             = { "used", 'i' },
+   [METRIC_CACHED]           = { "cached", 'i' },
+   [METRIC_BUFFERED]         = { "buffered", 'i' },
+   [METRIC_SHARED]           = { "shared", 'i' },
+   [METRIC_SWAP_TOTAL]       = { "swap_total", 'i' },
+   [METRIC_SWAP_USED]        = { "swap_used", 'i' },
+   [METRIC_VALUE]            = { "value", 'd' },
+   [METRIC_CHARGE_FULL]      = { "charge_full", 'i' },
+   [METRIC_CHARGE_CURRENT]   = { "charge_current", 'i' },
+   [METRIC_TOTAL_IN]         = { "total_in", 'i' },
+   [METRIC_TOTAL_OUT]        = { "total_out", 'i' },
+   [METRIC_IN]               = { "in", 'i' },
+   [METRIC_OUT]              = { "out", 'i' },
+   [METRIC_READS]            = { "reads", 'i' },
+   [METRIC_WRITES]           = { "writes", 'i' },
+   [METRIC_READ_BYTES]       = { "read_bytes", 'i' },
+   [METRIC_WRITE_BYTES]      = { "write_bytes", 'i' },
+   [METRIC_IO_TIME]          = { "io_time", 'i' },
+   [METRIC_QUEUE_TIME]       = { "queue_time", 'i' },
+   [METRIC_PID]              = { "pid", 'i' },
+   [METRIC_PPID]             = { "ppid", 'i' },
+   [METRIC_UID]              = { "uid", 'i' },
+   [METRIC_CPU_USAGE]        = { "cpu_usage", 'd' },
+   [METRIC_CPU_TIME]         = { "cpu_time", 'i' },
+   [METRIC_MEM_RSS]          = { "mem_rss", 'i' },
+   [METRIC_MEM_SIZE]         = { "mem_size", 'i' },
+   [METRIC_THREADS]          = { "threads", 'i' },
+   [METRIC_NET_IN_RATE]      = { "net_in_rate", 'i' },
+   [METRIC_NET_OUT_RATE]     = { "net_out_rate", 'i' },
+   [METRIC_DISK_READ_RATE]   = { "disk_read_rate", 'i' },
+   [METRIC_DISK_WRITE_RATE]  = { "disk_write_rate", 'i' },
+   [METRIC_CPU_USER]         = { "cpu_user", 'i' },
+   [METRIC_CPU_SYSTEM]       = { "cpu_system", 'i' },
+   [METRIC_MEMORY_CURRENT]   = { "memory_current", 'i' },
+   [METRIC_IO_READ]          = { "io_read", 'i' },
+   [METRIC_IO_WRITE]         = { "io_write", 'i' },
+   [METRIC_CPU_PRESSURE]     = { "cpu_pressure", 'i' },
+   [METRIC_MEMORY_PRESSURE]  = { "memory_pressure", 'i' },
+   [METRIC_IO_PRESSURE]      = { "io_pressure", 'i' },
+};
+
+// Indexed by the bit of each Enigmatic_Client_Family, offset by one in the
+// binary format so that 0 can mark a new export.
+#define FAMILY_COUNT 10
+
+static const char *families[FAMILY_COUNT] = {
+   "cpu", "memory", "sensor", "power", "battery",
+   "network", "file_system", "block_device", "process", "cgroup",
+};
+
+typedef struct
+{
+   int            fd;
+   Export_Format  format;
+   unsigned int   interval;
+   unsigned int   families;
+   unsigned int   changed;
+   Eina_Bool      delta;
+   Eina_Bool      failed;
+   Eina_Bool      started;
+   uint32_t       time;
+   uint32_t       last;
+
+   // The object being written, for formats repeating it on every line.
+   int            family;
+   const char    *name;
+
+   size_t         length;
+   char           buf[EXPORT_BUFFER_SIZE];
+} Export;
+
+static Export export;
+
+static void
+export_flush(Export *exp)
+{
+   ssize_t n;
+   size_t off = 0;
+
+   while ((!exp->failed) && (off < exp->length))
+     {
+        n = write(exp->fd, exp->buf + off, exp->length - off);
+        if (n > 0)
+          off += n;
+        else if ((n == -1) && (errno == EINTR))
+          continue;
+        else
+          {
+             // Whoever was reading has gone.
+             exp->failed = 1;
+             ecore_main_loop_quit();
+          }
+     }
+   exp->length = 0;
+}
+
+static char *
+export_reserve(Export *exp, size_t size)
+{
+   if ((EXPORT_BUFFER_SIZE - exp->length) < size)
+     export_flush(exp);
+
+   return exp->buf + exp->length;
+}
+
+static void
+export_write(Export *exp, const void *data, size_t size)
+{
+   const char *p = data;
+   size_t n;
+
+   while (size)
+     {
+        n = size < 4096 ? size : 4096;
+        memcpy(export_reserve(exp, n), p, n);
+        exp->length += n;
+        p += n;
+        size -= n;
+     }
+}
+
+static void
+export_string(Export *exp, const char *s)
+{
+   export_write(exp, s, strlen(s));
+}
+
+static void
+export_printf(Export *exp, const char *fmt, ...)
+{
+   va_list ap;
+   char *p = export_reserve(exp, 64);
+   int n;
+
+   va_start(ap, fmt);
+   n = vsnprintf(p, 64, fmt, ap);
+   va_end(ap);
+
+   if ((n > 0) && (n < 64))
+     exp->length += n;
+}
+
+static void
+export_json_string(Export *exp, const char *s)
+{
+   char *p;
+
+   export_write(exp, "\"", 1);
+   for (; *s; s++)
+     {
+        unsigned char c = *s;
+
+        p = export_reserve(exp, 7);
+        if ((c == '"') || (c == '\\'))
+          {
+             p[0] = '\\';
+             p[1] = c;
+             exp->length += 2;
+          }
+        else if (c < 0x20)
+          exp->length += snprintf(p, 7, "\\u%04x", c);
+        else
+          {
+             p[0] = c;
+             exp->length++;
+          }
+     }
+   export_write(exp, "\"", 1);
+}
+
+static void
+export_csv_string(Export *exp, const char *s)
+{
+   char *p;
+
+   export_write(exp, "\"", 1);
+   for (; *s; s++)
+     {
+        p = export_reserve(exp, 2);
+        if (*s == '"')
+          {
+             *p++ = '"';
+             exp->length++;
+          }
+        *p = *s;
+        exp->length++;
+     }
+   export_write(exp, "\"", 1);
+}
+
+static void
+export_header(Export *exp)
+{
+   uint32_t magic = EXPORT_MAGIC;
+   uint8_t len, count;
+
+   if (exp->format == FORMAT_CSV)
+     export_string(exp, "time,family,name,metric,value\n");
+   else if (exp->format == FORMAT_BINARY)
+     {
+        export_write(exp, &magic, sizeof(magic));
+        count = FAMILY_COUNT;
+        export_write(exp, &count, sizeof(count));
+        for (int i = 0; i < FAMILY_COUNT; i++)
+          {
+             len = strlen(families[i]);
+             export_write(exp, &len, sizeof(len));
+             export_write(exp, families[i], len);
+          }
+        count = METRIC_MAX - 1;
+        export_write(exp, &count, sizeof(count));
+        for (int i = 1; i < METRIC_MAX; i++)
+          {
+             len = strlen(metrics[i].name);
+             export_write(exp, &len, sizeof(len));
+             export_write(exp, metrics[i].name, len);
+             export_write(exp, &metrics[i].type, 1);
+          }
+     }
+}
+
+static void
+export_begin(Export *exp, uint32_t time)
+{
+   uint8_t tag = 0;
+
+   exp->time = time;
+   if (exp->format == FORMAT_BINARY)
+     {
+        export_write(exp, &tag, sizeof(tag));
+        export_write(exp, &time, sizeof(time));
+     }
+}
+
+static void
+export_object(Export *exp, int family, const char *name)
+{
+   uint8_t f = family + 1;
+   uint16_t len;
+
+   exp->family = family;
+   exp->name = name;
+
+   if (exp->format == FORMAT_NDJSON)
+     {
+        export_printf(exp, "{\"time\":%u,\"family\":\"%s\",\"name\":", exp->time, families[family]);
+        export_json_string(exp, name);
+     }
+   else if (exp->format == FORMAT_BINARY)
+     {
+        len = strnlen(name, UINT16_MAX);
+        export_write(exp, &f, sizeof(f));
+        export_write(exp, &len, sizeof(len));
+        export_write(exp, name, len);
+     }
+}
+
+static void
+export_field_begin(Export *exp, Export_Metric metric)
+{
+   uint8_t m = metric;
+
+   if (exp->format == FORMAT_NDJSON)
+     export_printf(exp, ",\"%s\":", metrics[metric].name);
+   else if (exp->format == FORMAT_CSV)
+     {
+        export_printf(exp, "%u,%s,", exp->time, families[exp->family]);
+        export_csv_string(exp, exp->name);
+        export_printf(exp, ",%s,", metrics[metric].name);
+     }
+   else
+     export_write(exp, &m, sizeof(m));
+}
+
+static void
+export_int(Export *exp, Export_Metric metric, int64_t value)
+{
+   export_field_begin(exp, metric);
+   if (exp->format == FORMAT_BINARY)
+     export_write(exp, &value, sizeof(value));
+   else
+     export_printf(exp, "%" PRId64 "%s", value, exp->format == FORMAT_CSV ? "\n" : "");
+}
+
+static void
+export_double(Export *exp, Export_Metric metric, double value)
+{
+   export_field_begin(exp, metric);
+   if (exp->format == FORMAT_BINARY)
+     export_write(exp, &value, sizeof(value));
+   else if (!isfinite(value))
+     export_string(exp, exp->format == FORMAT_CSV ? "\n" : "null");
+   else
+     export_printf(exp, "%.6g%s", value, exp->format == FORMAT_CSV ? "\n" : "");
+}
+
+static void
+export_object_end(Export *exp)
+{
+   uint8_t end = METRIC_NONE;
+
+   if (exp->format == FORMAT_NDJSON)
+     export_string(exp, "}\n");
+   else if (exp->format == FORMAT_BINARY)
+     export_write(exp, &end, sizeof(end));
+}
+
+static int
+family_index(unsigned int family)
+{
+   int i = 0;
+
+   while ((family >>= 1)) i++;
+
+   return i;
+}
+
+static void
+export_snapshot(Export *exp, Snapshot *s, unsigned int wanted)
+{
+   Eina_List *l;
+   Cpu_Core *core;
+   Sensor *sensor;
+   Battery *battery;
+   Network_Interface *iface;
+   File_System *fs;
+   Block_Device *dev;
+   Cgroup *cg;
+   Proc_Info_Log *proc;
+   char name[512];
+
+   export_begin(exp, s->time);
+
+   if (wanted & FAMILY_CPU_CORE)
+     {
+        EINA_LIST_FOREACH(s->cores, l, core)
+          {
+             export_object(exp, family_index(FAMILY_CPU_CORE), core->name);
+             export_double(exp, METRIC_PERCENT, core->percent);
+             export_int(exp, METRIC_FREQ, core->freq);
+             export_int(exp, METRIC_TEMP, core->temp);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_MEMORY)
+     {
+        export_object(exp, family_index(FAMILY_MEMORY), "memory");
+        export_int(exp, METRIC_TOTAL, s->meminfo.total);
+        export_int(exp, METRIC_USED, s->meminfo.used);
+        export_int(exp, METRIC_CACHED, s->meminfo.cached);
+        export_int(exp, METRIC_BUFFERED, s->meminfo.buffered);
+        export_int(exp, METRIC_SHARED, s->meminfo.shared);
+        export_int(exp, METRIC_SWAP_TOTAL, s->meminfo.swap_total);
+        export_int(exp, METRIC_SWAP_USED, s->meminfo.swap_used);
+        export_object_end(exp);
+        for (uint64_t i = 0; (i < s->meminfo.video_count) && (i < MEM_VIDEO_CARD_MAX); i++)
+          {
+             snprintf(name, sizeof(name), "video%" PRIu64, i);
+             export_object(exp, family_index(FAMILY_MEMORY), name);
+             export_int(exp, METRIC_TOTAL, s->meminfo.video[i].total);
+             export_int(exp, METRIC_USED, s->meminfo.video[i].used);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_SENSOR)
+     {
+        EINA_LIST_FOREACH(s->sensors, l, sensor)
+          {
+             if (sensor->child_name[0])
+               snprintf(name, sizeof(name), "%s.%s", sensor->name, sensor->child_name);
+             else
+               snprintf(name, sizeof(name), "%s", sensor->name);
+             export_object(exp, family_index(FAMILY_SENSOR), name);
+             export_double(exp, METRIC_VALUE, sensor->value);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_POWER)
+     {
+        export_object(exp, family_index(FAMILY_POWER), "ac");
+        export_int(exp, METRIC_VALUE, s->power);
+        export_object_end(exp);
+     }
+
+   if (wanted & FAMILY_BATTERY)
+     {
+        EINA_LIST_FOREACH(s->batteries, l, battery)
+          {
+             export_object(exp, family_index(FAMILY_BATTERY), battery->name);
+             export_double(exp, METRIC_PERCENT, battery->percent);
+             export_int(exp, METRIC_CHARGE_FULL, battery->charge_full);
+             export_int(exp, METRIC_CHARGE_CURRENT, battery->charge_current);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_NETWORK)
+     {
+        EINA_LIST_FOREACH(s->network_interfaces, l, iface)
+          {
+             export_object(exp, family_index(FAMILY_NETWORK), iface->name);
+             export_int(exp, METRIC_TOTAL_IN, iface->total_in);
+             export_int(exp, METRIC_TOTAL_OUT, iface->total_out);
+             export_int(exp, METRIC_IN, iface->in);
+             export_int(exp, METRIC_OUT, iface->out);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_FILE_SYSTEM)
+     {
+        EINA_LIST_FOREACH(s->file_systems, l, fs)
+          {
+             export_object(exp, family_index(FAMILY_FILE_SYSTEM), fs->mount);
+             export_int(exp, METRIC_TOTAL, fs->usage.total);
+             export_int(exp, METRIC_USED, fs->usage.used);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_BLOCK_DEVICE)
+     {
+        EINA_LIST_FOREACH(s->block_devices, l, dev)
+          {
+             export_object(exp, family_index(FAMILY_BLOCK_DEVICE), dev->name);
+             export_int(exp, METRIC_READS, dev->reads);
+             export_int(exp, METRIC_WRITES, dev->writes);
+             export_int(exp, METRIC_READ_BYTES, dev->read_bytes);
+             export_int(exp, METRIC_WRITE_BYTES, dev->write_bytes);
+             export_int(exp, METRIC_IO_TIME, dev->io_time);
+             export_int(exp, METRIC_QUEUE_TIME, dev->queue_time);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_PROCESS)
+     {
+        EINA_LIST_FOREACH(s->processes, l, proc)
+          {
+             export_object(exp, family_index(FAMILY_PROCESS), proc->command);
+             export_int(exp, METRIC_PID, proc->pid);
+             export_int(exp, METRIC_PPID, proc->ppid);
+             export_int(exp, METRIC_UID, proc->uid);
+             export_double(exp, METRIC_CPU_USAGE, proc->cpu_usage);
+             export_int(exp, METRIC_CPU_TIME, proc->cpu_time);
+             export_int(exp, METRIC_MEM_RSS, proc->mem_rss);
+             export_int(exp, METRIC_MEM_SIZE, proc->mem_size);
+             export_int(exp, METRIC_THREADS, proc->numthreads);
+             export_int(exp, METRIC_NET_IN_RATE, proc->net_in_rate);
+             export_int(exp, METRIC_NET_OUT_RATE, proc->net_out_rate);
+             export_int(exp, METRIC_DISK_READ_RATE, proc->disk_read_rate);
+             export_int(exp, METRIC_DISK_WRITE_RATE, proc->disk_write_rate);
+             export_object_end(exp);
+          }
+     }
+
+   if (wanted & FAMILY_CGROUP)
+     {
+        EINA_LIST_FOREACH(s->cgroups, l, cg)
+          {
+             export_object(exp, family_index(FAMILY_CGROUP), cg->path);
+             export_int(exp, METRIC_CPU_USER, cg->cpu_user);
+             export_int(exp, METRIC_CPU_SYSTEM, cg->cpu_system);
+             export_int(exp, METRIC_MEMORY_CURRENT, cg->memory_current);
+             export_int(exp, METRIC_IO_READ, cg->io_read);
+             export_int(exp, METRIC_IO_WRITE, cg->io_write);
+             export_int(exp, METRIC_CPU_PRESSURE, cg->cpu_pressure);
+             export_int(exp, METRIC_MEMORY_PRESSURE, cg->memory_pressure);
+             export_int(exp, METRIC_IO_PRESSURE, cg->io_pressure);
+             export_object_end(exp);
+          }
+     }
+
+   export_flush(exp);
+}
+
+static void
+cb_snapshot(Enigmatic_Client *client EINA_UNUSED, Snapshot *s, void *data)
+{
+   Export *exp = data;
+   unsigned int wanted;
+
+   if (exp->failed) return;
+
+   // Families can change between exports, carry them over to the next.
+   exp->changed |= s->families;
+
+   if ((exp->started) && (s->time < (exp->last + exp->interval))) return;
+
+   wanted = exp->families;
+   if ((exp->delta) && (exp->started))
+     wanted &= exp->changed;
+
+   export_snapshot(exp, s, wanted);
+
+   exp->started = 1;
+   exp->last = s->time;
+   exp->changed = 0;
+}
+
+static Eina_Bool
+cb_shutdown(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static unsigned int
+families_parse(const char *list)
+{
+   unsigned int mask = 0;
+   const char *p = list;
+   size_t len;
+   int i;
+
+   while (*p)
+     {
+        len = strcspn(p, ",");
+        for (i = 0; i < FAMILY_COUNT; i++)
+          {
+             if ((strlen(families[i]) == len) && (!strncmp(p, families[i], len)))
+               {
+                  mask |= (1 << i);
+                  break;
+               }
+          }
+        if ((len == 3) && (!strncmp(p, "all", len)))
+          mask = FAMILY_ALL;
+        else if (i == FAMILY_COUNT)
+          {
+             fprintf(stderr, "Unknown family: %.*s\n", (int) len, p);
+             exit(1);
+          }
+        p += len;
+        if (*p == ',') p++;
+     }
+
+   return mask;
+}
+
+static Interval
+interval_demand(unsigned int interval)
+{
+   if (interval >= INTERVAL_SLOW)
+     return INTERVAL_SLOW;
+   else if (interval >= INTERVAL_MEDIUM)
+     return INTERVAL_MEDIUM;
+
+   return INTERVAL_NORMAL;
+}
+
+static void
+usage(void)
+{
+   printf("enigmatic_export [OPTIONS]\n"
+          "Where OPTIONS can be one of: \n"
+          "   -f ndjson|csv|binary  Output format (ndjson).\n"
+          "   -i SECS               Seconds between exports (1).\n"
+          "   -d                    Only families that changed since the last export.\n"
+          "   -F LIST               Families to export, comma separated, or all:\n"
+          "                         cpu,memory,sensor,power,battery,network,\n"
+          "                         file_system,block_device,process,cgroup\n"
+          "                         (all but process).\n"
+          "   -o FILE               Append to FILE rather than standard output.\n"
+          "   -S [HOST:PORT]        Follow a daemon's stream (enigmatic --stream).\n"
+          "   -h | --help           This menu.\n");
+   exit(0);
+}
+
+int main(int argc, char **argv)
+{
+   Enigmatic_Client *client;
+   Ecore_Event_Handler *handler;
+   const char *output = NULL, *address = NULL;
+   Eina_Bool stream = 0;
+   Export *exp = &export;
+
+   exp->fd = STDOUT_FILENO;
+   exp->format = FORMAT_NDJSON;
+   exp->interval = 1;
+   exp->families = FAMILY_ALL & ~FAMILY_PROCESS;
+
+   for (int i = 1; i < argc; i++)
+     {
+        if ((!strcasecmp(argv[i], "-h")) || (!strcasecmp(argv[i], "--help")))
+          usage();
+        else if ((!strcmp(argv[i], "-f")) && (i + 1 < argc))
+          {
+             i++;
+             if (!strcmp(argv[i], "ndjson"))
+               exp->format = FORMAT_NDJSON;
+             else if (!strcmp(argv[i], "csv"))
+               exp->format = FORMAT_CSV;
+             else if (!strcmp(argv[i], "binary"))
+               exp->format = FORMAT_BINARY;
+             else usage();
+          }
+        else if ((!strcmp(argv[i], "-i")) && (i + 1 < argc))
+          {
+             exp->interval = atoi(argv[++i]);
+             if (exp->interval < 1) exp->interval = 1;
+          }
+        else if (!strcmp(argv[i], "-d"))
+          exp->delta = 1;
+        else if ((!strcmp(argv[i], "-F")) && (i + 1 < argc))
+          exp->families = families_parse(argv[++i]);
+        else if ((!strcmp(argv[i], "-o")) && (i + 1 < argc))
+          output = argv[++i];
+        else if (!strcmp(argv[i], "-S"))
+          {
+             stream = 1;
+             if ((i + 1 < argc) && (argv[i + 1][0] != '-'))
+               address = argv[++i];
+          }
+        else usage();
+     }
+
+   if (output)
+     {
+        exp->fd = open(output, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (exp->fd == -1)
+          {
+             fprintf(stderr, "open: %s: %s\n", output, strerror(errno));
+             return 1;
+          }
+     }
+
+   // A reader going away shows as a failed write, not a signal.
+   signal(SIGPIPE, SIG_IGN);
+
+   ecore_init();
+   ecore_con_init();
+   eio_init();
+
+   if (stream)
+     client = enigmatic_client_stream_open(address);
+   else
+     {
+        if (!enigmatic_running())
+          enigmatic_launch();
+        client = enigmatic_client_open();
+     }
+
+   if (!client)
+     {
+        fprintf(stderr, "Unable to follow enigmatic.\n");
+        return 1;
+     }
+
+   enigmatic_client_subscribe(client, exp->families);
+   enigmatic_client_monitor_add(client, NULL, cb_snapshot, exp);
+   enigmatic_client_demand_set(client, interval_demand(exp->interval));
+
+   export_header(exp);
+   export_flush(exp);
+
+   handler = ecore_event_handler_add(ECORE_EVENT_SIGNAL_EXIT, cb_shutdown, NULL);
+
+   ecore_main_loop_begin();
+
+   ecore_event_handler_del(handler);
+   enigmatic_client_del(client);
+
+   if (output)
+     close(exp->fd);
+
+   eio_shutdown();
+   ecore_con_shutdown();
+   ecore_shutdown();
+
+   return exp->failed;
+}
@@ -1,11 +1,15 @@
 #include "system/machine.h"
 #include "batteries.h"
 #include "uid.h"
+#include "hotplug.h"
 #include "enigmatic_log.h"
 
 static Eina_List *batteries = NULL;
 static Eina_Lock batteries_lock;
 static Ecore_Thread *thread = NULL;
+static Hotplug *hotplug = NULL;
+static unsigned int batteries_generation = 0;
+static unsigned int batteries_generation_seen = 0;
 
 static void
 cb_battery_free(void *data)
@@ -62,6 +66,7 @@ battery_thread(void *data EINA_UNUSED, Ecore_Thread *thread)
 {
    Battery *bat;
    uint32_t it = 0;
+   Eina_Bool rediscover = 0;
 
 #if (EFL_VERSION_MAJOR >= 1 && EFL_VERSION_MINOR >= 26)
    ecore_thread_name_set(thread, "batmon");
@@ -70,11 +75,14 @@ battery_thread(void *data EINA_UNUSED, Ecore_Thread *thread)
    while (!ecore_thread_check(thread))
      {
         eina_lock_take(&batteries_lock);
-        if ((it) && (!(it % 2)))
+        // Without hotplug events look for new batteries every second pass.
+        if ((rediscover) || ((!hotplug) && (it) && (!(it % 2))))
           {
              EINA_LIST_FREE(batteries, bat)
                free(bat);
              batteries = batteries_find();
+             batteries_generation++;
+             rediscover = 0;
           }
         batteries_update(batteries);
         eina_lock_release(&batteries_lock);
@@ -82,7 +90,7 @@ battery_thread(void *data EINA_UNUSED, Ecore_Thread *thread)
         for (int i = 0; i < 20; i++)
           {
              if (ecore_thread_check(thread)) break;
-             usleep(50000);
+             if (hotplug_wait(hotplug, 50)) rediscover = 1;
           }
         it++;
      }
@@ -95,6 +103,8 @@ enigmatic_monitor_batteries_init(void)
 {
    eina_lock_new(&batteries_lock);
 
+   // A battery's presence changes with a change event, not add or remove.
+   hotplug = hotplug_new("power_supply");
    batteries = batteries_find();
    batteries_update(batteries);
 }
@@ -103,10 +113,49 @@ void
 enigmatic_monitor_batteries_shutdown(void)
 {
    eina_lock_take(&batteries_lock);
+   hotplug_free(hotplug);
+   hotplug = NULL;
    eina_lock_release(&batteries_lock);
    eina_lock_free(&batteries_lock);
 }
 
+static void
+batteries_purge(Enigmatic *enigmatic, Eina_Hash *cache_hash)
+{
+   Eina_List *l, *purge = NULL;
+   Eina_Iterator *it;
+   Eina_Hash *present;
+   Battery *bat;
+   void *d = NULL;
+
+   present = eina_hash_string_superfast_new(NULL);
+   EINA_LIST_FOREACH(batteries, l, bat)
+     eina_hash_add(present, bat->name, bat);
+
+   it = eina_hash_iterator_data_new(cache_hash);
+   while (eina_iterator_next(it, &d))
+     {
+        bat = d;
+        if (!eina_hash_find(present, bat->name))
+          purge = eina_list_prepend(purge, bat);
+     }
+   eina_iterator_free(it);
+   eina_hash_free(present);
+
+   EINA_LIST_FREE(purge, bat)
+     {
+        Message msg;
+        msg.type = MESG_DEL;
+        msg.object_type = BATTERY;
+        msg.number = bat->unique_id;
+        enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
+
+        battery_release(bat);
+        unique_id_release(&enigmatic->unique_ids, bat->unique_id);
+        eina_hash_del(cache_hash, bat->name, NULL);
+     }
+}
+
 Eina_Bool
 enigmatic_monitor_batteries(Enigmatic *enigmatic, Eina_Hash **cache_hash)
 {
@@ -131,6 +180,7 @@ enigmatic_monitor_batteries(Enigmatic *enigmatic, Eina_Hash **cache_hash)
                   eina_hash_add(*cache_hash, b->name, b);
                }
           }
+        batteries_generation_seen = batteries_generation;
         enigmatic->battery_thread = thread = ecore_thread_run(battery_thread, NULL, NULL, NULL);
      }
 
@@ -139,38 +189,13 @@ enigmatic_monitor_batteries(Enigmatic *enigmatic, Eina_Hash **cache_hash)
         batteries_refresh(enigmatic, cache_hash);
      }
 
-   void *d = NULL;
-   Eina_List *purge = NULL;
-
-   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
-   while (eina_iterator_next(it, &d))
+   // The set of batteries only changes when the thread rediscovered them.
+   if (batteries_generation_seen != batteries_generation)
      {
-        Battery *b = d;
-        Eina_Bool found = 0;
-        EINA_LIST_FOREACH(batteries, l, bat)
-          {
-             if (!strcmp(b->name, bat->name))
-               {
-                  found = 1;
-                  break;
-               }
-          }
-        if (!found)
-          purge = eina_list_prepend(purge, b);
+        batteries_purge(enigmatic, *cache_hash);
+        batteries_generation_seen = batteries_generation;
      }
-   eina_iterator_free(it);
 
-   EINA_LIST_FREE(purge, bat)
-     {
-        Message msg;
-        msg.type = MESG_DEL;
-        msg.object_type = BATTERY;
-        msg.number = bat->unique_id;
-        enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
-
-        unique_id_release(&enigmatic->unique_ids, bat->unique_id);
-        eina_hash_del(*cache_hash, bat->name, NULL);
-     }
    EINA_LIST_FOREACH(batteries, l, bat)
      {
         b = eina_hash_find(*cache_hash, bat->name);
@@ -0,0 +1,170 @@
+#include "system/block_devices.h"
+#include "block_devices.h"
+#include "uid.h"
+#include "enigmatic_log.h"
+
+static void
+cb_block_device_free(void *data)
+{
+   Block_Device *dev = data;
+
+   DEBUG("del %s", dev->name);
+
+   free(dev);
+}
+
+static int
+cb_block_device_cmp(const void *a, const void *b)
+{
+   Block_Device *dev1, *dev2;
+
+   dev1 = (Block_Device *) a;
+   dev2 = (Block_Device *) b;
+
+   return strcmp(dev1->name, dev2->name);
+}
+
+static void
+block_devices_refresh(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+{
+   Eina_List *ordered = NULL;
+   void *d = NULL;
+   Block_Device *dev;
+   int n;
+   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
+
+   while (eina_iterator_next(it, &d))
+     {
+        dev = d;
+        ordered = eina_list_append(ordered, dev);
+     }
+   eina_iterator_free(it);
+
+   n = eina_list_count(ordered);
+   if (!n) return;
+
+   ordered = eina_list_sort(ordered, n, cb_block_device_cmp);
+
+   Message msg;
+   msg.type = MESG_REFRESH;
+   msg.object_type = BLOCK_DEVICE;
+   msg.number = n;
+   enigmatic_log_list_write(enigmatic, EVENT_MESSAGE, msg, ordered, sizeof(Block_Device));
+   eina_list_free(ordered);
+}
+
+static void
+block_device_log_delta(Enigmatic *enigmatic, Block_Device *dev, Object_Type object_type, int64_t delta, Eina_Bool *changed)
+{
+   Message msg;
+
+   if (!delta) return;
+
+   msg.type = MESG_MOD;
+   msg.object_type = object_type;
+   msg.number = dev->unique_id;
+   enigmatic_log_diff(enigmatic, msg, delta);
+
+   DEBUG("%s %i :%i", dev->name, object_type, (int) delta);
+   *changed = 1;
+}
+
+Eina_Bool
+enigmatic_monitor_block_devices(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+{
+   Eina_List *l, *devices;
+   Block_Device *dev, *dev2;
+   Eina_Bool changed = 0;
+
+   devices = block_devices_find();
+   if (!*cache_hash)
+     {
+        *cache_hash = eina_hash_string_superfast_new(cb_block_device_free);
+        EINA_LIST_FOREACH(devices, l, dev)
+          {
+             dev2 = malloc(sizeof(Block_Device));
+             if (dev2)
+               {
+                  memcpy(dev2, dev, sizeof(Block_Device));
+                  DEBUG("block device add: %s", dev->name);
+
+                  dev2->unique_id = unique_id_find(&enigmatic->unique_ids);
+                  eina_hash_add(*cache_hash, dev2->name, dev2);
+               }
+          }
+     }
+
+   if (enigmatic->broadcast)
+     {
+        block_devices_refresh(enigmatic, cache_hash);
+     }
+
+   void *d = NULL;
+   Eina_List *purge = NULL;
+
+   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
+   while (eina_iterator_next(it, &d))
+     {
+        Eina_Bool found = 0;
+
+        dev2 = d;
+        EINA_LIST_FOREACH(devices, l, dev)
+          {
+             if (!strcmp(dev2->name, dev->name))
+               {
+                  found = 1;
+                  break;
+               }
+          }
+        if (!found)
+          purge = eina_list_prepend(purge, dev2);
+     }
+   eina_iterator_free(it);
+
+   EINA_LIST_FREE(purge, dev)
+     {
+        Message msg;
+        msg.type = MESG_DEL;
+        msg.object_type = BLOCK_DEVICE;
+        msg.number = dev->unique_id;
+        enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
+
+        unique_id_release(&enigmatic->unique_ids, dev->unique_id);
+        eina_hash_del(*cache_hash, dev->name, NULL);
+        changed = 1;
+     }
+
+   EINA_LIST_FREE(devices, dev)
+     {
+        dev2 = eina_hash_find(*cache_hash, dev->name);
+        if (!dev2)
+          {
+             dev->unique_id = unique_id_find(&enigmatic->unique_ids);
+
+             Message msg;
+             msg.type = MESG_ADD;
+             msg.object_type = BLOCK_DEVICE;
+             msg.number = 1;
+             enigmatic_log_obj_write(enigmatic, EVENT_MESSAGE, msg, dev, sizeof(Block_Device));
+
+             DEBUG("block device add: %s", dev->name);
+
+             eina_hash_add(*cache_hash, dev->name, dev);
+             changed = 1;
+             continue;
+          }
+
+        block_device_log_delta(enigmatic, dev2, BLOCK_DEVICE_READS, (int64_t) dev->reads - (int64_t) dev2->reads, &changed);
+        block_device_log_delta(enigmatic, dev2, BLOCK_DEVICE_WRITES, (int64_t) dev->writes - (int64_t) dev2->writes, &changed);
+        block_device_log_delta(enigmatic, dev2, BLOCK_DEVICE_READ_BYTES, (int64_t) dev->read_bytes - (int64_t) dev2->read_bytes, &changed);
+        block_device_log_delta(enigmatic, dev2, BLOCK_DEVICE_WRITE_BYTES, (int64_t) dev->write_bytes - (int64_t) dev2->write_bytes, &changed);
+        block_device_log_delta(enigmatic, dev2, BLOCK_DEVICE_IO_TIME, (int64_t) dev->io_time - (int64_t) dev2->io_time, &changed);
+        block_device_log_delta(enigmatic, dev2, BLOCK_DEVICE_QUEUE_TIME, (int64_t) dev->queue_time - (int64_t) dev2->queue_time, &changed);
+
+        dev->unique_id = dev2->unique_id;
+        memcpy(dev2, dev, sizeof(Block_Device));
+        free(dev);
+     }
+
+   return changed;
+}
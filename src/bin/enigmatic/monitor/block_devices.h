@@ -0,0 +1,9 @@
+#ifndef ENIGMATIC_MONITOR_BLOCK_DEVICES_H
+#define ENIGMATIC_MONITOR_BLOCK_DEVICES_H
+
+#include "Enigmatic.h"
+
+Eina_Bool
+enigmatic_monitor_block_devices(Enigmatic *enigmatic, Eina_Hash **cache_hash);
+
+#endif
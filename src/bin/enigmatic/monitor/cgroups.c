@@ -0,0 +1,168 @@
+#include "system/cgroups.h"
+#include "cgroups.h"
+#include "uid.h"
+#include "enigmatic_log.h"
+
+static void
+cb_cgroup_free(void *data)
+{
+   Cgroup *cg = data;
+
+   DEBUG("del %s", cg->path);
+
+   free(cg);
+}
+
+static int
+cb_cgroup_cmp(const void *a, const void *b)
+{
+   Cgroup *cg1, *cg2;
+
+   cg1 = (Cgroup *) a;
+   cg2 = (Cgroup *) b;
+
+   return strcmp(cg1->path, cg2->path);
+}
+
+static void
+cgroups_refresh(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+{
+   Eina_List *ordered = NULL;
+   void *d = NULL;
+   Cgroup *cg;
+   int n;
+   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
+
+   while (eina_iterator_next(it, &d))
+     {
+        cg = d;
+        ordered = eina_list_append(ordered, cg);
+     }
+   eina_iterator_free(it);
+
+   n = eina_list_count(ordered);
+   if (!n) return;
+
+   ordered = eina_list_sort(ordered, n, cb_cgroup_cmp);
+
+   Message msg;
+   msg.type = MESG_REFRESH;
+   msg.object_type = CGROUP;
+   msg.number = n;
+   enigmatic_log_list_write(enigmatic, EVENT_MESSAGE, msg, ordered, sizeof(Cgroup));
+   eina_list_free(ordered);
+}
+
+static void
+cgroup_log_delta(Enigmatic *enigmatic, Cgroup *cg, Object_Type object_type, int64_t delta, Eina_Bool *changed)
+{
+   Message msg;
+
+   if (!delta) return;
+
+   msg.type = MESG_MOD;
+   msg.object_type = object_type;
+   msg.number = cg->unique_id;
+   enigmatic_log_diff(enigmatic, msg, delta);
+
+   DEBUG("%s %i :%i", cg->path, object_type, (int) delta);
+   *changed = 1;
+}
+
+Eina_Bool
+enigmatic_monitor_cgroups(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+{
+   Eina_List *l, *cgroups;
+   Eina_Hash *seen;
+   Cgroup *cg, *cg2;
+   Eina_Bool changed = 0;
+
+   cgroups = cgroups_find();
+   if (!*cache_hash)
+     {
+        *cache_hash = eina_hash_string_superfast_new(cb_cgroup_free);
+        EINA_LIST_FOREACH(cgroups, l, cg)
+          {
+             cg2 = malloc(sizeof(Cgroup));
+             if (cg2)
+               {
+                  memcpy(cg2, cg, sizeof(Cgroup));
+                  DEBUG("cgroup add: %s", cg->path);
+
+                  cg2->unique_id = unique_id_find(&enigmatic->unique_ids);
+                  eina_hash_add(*cache_hash, cg2->path, cg2);
+               }
+          }
+     }
+
+   if (enigmatic->broadcast)
+     {
+        cgroups_refresh(enigmatic, cache_hash);
+     }
+
+   // Container hosts churn through many cgroups, avoid matching pairwise.
+   seen = eina_hash_string_superfast_new(NULL);
+   EINA_LIST_FOREACH(cgroups, l, cg)
+     eina_hash_add(seen, cg->path, cg);
+
+   void *d = NULL;
+   Eina_List *purge = NULL;
+
+   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
+   while (eina_iterator_next(it, &d))
+     {
+        cg2 = d;
+        if (!eina_hash_find(seen, cg2->path))
+          purge = eina_list_prepend(purge, cg2);
+     }
+   eina_iterator_free(it);
+   eina_hash_free(seen);
+
+   EINA_LIST_FREE(purge, cg)
+     {
+        Message msg;
+        msg.type = MESG_DEL;
+        msg.object_type = CGROUP;
+        msg.number = cg->unique_id;
+        enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
+
+        unique_id_release(&enigmatic->unique_ids, cg->unique_id);
+        eina_hash_del(*cache_hash, cg->path, NULL);
+     }
+
+   EINA_LIST_FREE(cgroups, cg)
+     {
+        cg2 = eina_hash_find(*cache_hash, cg->path);
+        if (!cg2)
+          {
+             cg->unique_id = unique_id_find(&enigmatic->unique_ids);
+
+             Message msg;
+             msg.type = MESG_ADD;
+             msg.object_type = CGROUP;
+             msg.number = 1;
+             enigmatic_log_obj_write(enigmatic, EVENT_MESSAGE, msg, cg, sizeof(Cgroup));
+
+             DEBUG("cgroup add: %s", cg->path);
+
+             eina_hash_add(*cache_hash, cg->path, cg);
+             continue;
+          }
+
+        cgroup_log_delta(enigmatic, cg2, CGROUP_CPU_USAGE, (int64_t) cg->cpu_usage - (int64_t) cg2->cpu_usage, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_CPU_USER, (int64_t) cg->cpu_user - (int64_t) cg2->cpu_user, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_CPU_SYSTEM, (int64_t) cg->cpu_system - (int64_t) cg2->cpu_system, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_MEMORY_CURRENT, (int64_t) cg->memory_current - (int64_t) cg2->memory_current, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_IO_READ, (int64_t) cg->io_read - (int64_t) cg2->io_read, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_IO_WRITE, (int64_t) cg->io_write - (int64_t) cg2->io_write, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_CPU_PRESSURE, (int64_t) cg->cpu_pressure - (int64_t) cg2->cpu_pressure, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_MEMORY_PRESSURE, (int64_t) cg->memory_pressure - (int64_t) cg2->memory_pressure, &changed);
+        cgroup_log_delta(enigmatic, cg2, CGROUP_IO_PRESSURE, (int64_t) cg->io_pressure - (int64_t) cg2->io_pressure, &changed);
+
+        cg->unique_id = cg2->unique_id;
+        memcpy(cg2, cg, sizeof(Cgroup));
+        free(cg);
+     }
+
+   return changed;
+}
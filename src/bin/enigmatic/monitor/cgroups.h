@@ -0,0 +1,9 @@
+#ifndef ENIGMATIC_MONITOR_CGROUPS_H
+#define ENIGMATIC_MONITOR_CGROUPS_H
+
+#include "Enigmatic.h"
+
+Eina_Bool
+enigmatic_monitor_cgroups(Enigmatic *enigmatic, Eina_Hash **cache_hash);
+
+#endif
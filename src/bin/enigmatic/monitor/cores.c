@@ -4,202 +4,219 @@
 #include "enigmatic_log.h"
 
 static void
-cb_core_free(void *data)
+cores_refresh(Enigmatic *enigmatic, Cores_Table *table)
 {
-   Cpu_Core *core = data;
-
-   DEBUG("del %s", core->name);
+   Message msg;
+   int i, n = 0;
 
-   free(core);
-}
+   for (i = 0; i < table->count; i++)
+     {
+        if (table->cores[i].unique_id >= 0) n++;
+     }
 
-static int
-cb_core_cmp(const void *a, const void *b)
-{
-   Cpu_Core *c1, *c2;
+   msg.type = MESG_REFRESH;
+   msg.object_type = CPU_CORE;
+   msg.number = n;
+   enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
 
-   c1 = (Cpu_Core *) a;
-   c2 = (Cpu_Core *) b;
+   if (n == table->count)
+     {
+        enigmatic_log_write(enigmatic, (char *) table->cores, table->count * sizeof(Cpu_Core));
+        return;
+     }
 
-   return c1->id - c2->id;
+   for (i = 0; i < table->count; i++)
+     {
+        if (table->cores[i].unique_id >= 0)
+          enigmatic_log_write(enigmatic, (char *) &table->cores[i], sizeof(Cpu_Core));
+     }
 }
 
 static void
-cores_refresh(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+core_add(Enigmatic *enigmatic, Cpu_Core *c, Cpu_Core *core)
 {
-   Eina_List *ordered = NULL;
-   void *d = NULL;
-   Cpu_Core *core;
-   int n;
-   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
+   Message msg;
 
-   while (eina_iterator_next(it, &d))
-     {
-        core = d;
-        ordered = eina_list_append(ordered, core);
-     }
-   eina_iterator_free(it);
+   memcpy(c->states, core->states, sizeof(c->states));
+   c->idle = core->idle;
+   c->total = core->total;
+   c->freq = core->freq;
+   c->temp = core->temp;
+   c->percent = 0;
+   memset(c->state_percent, 0, sizeof(c->state_percent));
+   c->unique_id = unique_id_find(&enigmatic->unique_ids);
 
-   n = eina_list_count(ordered);
+   msg.type = MESG_ADD;
+   msg.object_type = CPU_CORE;
+   msg.number = 1;
+   enigmatic_log_obj_write(enigmatic, EVENT_MESSAGE, msg, c, sizeof(Cpu_Core));
 
-   ordered = eina_list_sort(ordered, n, cb_core_cmp);
+   DEBUG("core %s added", c->name);
+}
 
+static void
+core_del(Enigmatic *enigmatic, Cpu_Core *c)
+{
    Message msg;
-   msg.type = MESG_REFRESH;
+
+   msg.type = MESG_DEL;
    msg.object_type = CPU_CORE;
-   msg.number = n;
-   enigmatic_log_list_write(enigmatic, EVENT_MESSAGE, msg, ordered, sizeof(Cpu_Core));
-   eina_list_free(ordered);
+   msg.number = c->unique_id;
+   enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
+
+   unique_id_release(&enigmatic->unique_ids, c->unique_id);
+   c->unique_id = -1;
+
+   DEBUG("core %s removed", c->name);
 }
 
-Eina_Bool
-enigmatic_monitor_cores(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+static void
+core_log_delta(Enigmatic *enigmatic, Cpu_Core *core, Object_Type object_type, int64_t delta, Eina_Bool *changed)
 {
-   Eina_List *l;
-   Cpu_Core *c, *core;
-   Eina_Bool changed = 0;
-   Eina_List *cores;
+   Message msg;
 
-   cores = cores_find();
-   cores_update(cores);
+   if (!delta) return;
 
-   if (!*cache_hash)
-     {
-        *cache_hash = eina_hash_string_superfast_new(cb_core_free);
+   msg.type = MESG_MOD;
+   msg.object_type = object_type;
+   msg.number = core->unique_id;
+   enigmatic_log_diff(enigmatic, msg, delta);
 
-        EINA_LIST_FOREACH(cores, l, core)
-          {
-             c = malloc(sizeof(Cpu_Core));
-             if (c)
-               {
-                  memcpy(c, core, sizeof(Cpu_Core));
-                  c->unique_id = unique_id_find(&enigmatic->unique_ids);
-                  DEBUG("core %s added", c->name);
-                  eina_hash_add(*cache_hash, c->name, c);
-               }
-          }
-     }
+   *changed = 1;
+}
 
-   if (enigmatic->broadcast)
+static Eina_Bool
+cores_table_init(Enigmatic *enigmatic, Cores_Table *table)
+{
+   int i;
+
+   table->cores = cores_array_find(&table->count);
+   if (!table->cores) return 0;
+
+   table->sample = malloc(table->count * sizeof(Cpu_Core));
+   if (!table->sample)
      {
-        cores_refresh(enigmatic, cache_hash);
+        free(table->cores);
+        table->cores = NULL;
+        table->count = 0;
+        return 0;
      }
 
-   void *d = NULL;
-   Eina_List *purge = NULL;
+   cores_array_update(table->cores, table->count);
 
-   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
-   while (eina_iterator_next(it, &d))
+   // Cores that are offline keep no id until they come up.
+   for (i = 0; i < table->count; i++)
      {
-        Cpu_Core *c = d;
-        Eina_Bool found = 0;
-        EINA_LIST_FOREACH(cores, l, core)
+        if (!table->cores[i].total)
           {
-             if (!strcmp(c->name, core->name))
-               {
-                  found = 1;
-                  break;
-               }
+             table->cores[i].unique_id = -1;
+             continue;
           }
-        if (!found)
-          purge = eina_list_prepend(purge, c);
+        table->cores[i].unique_id = unique_id_find(&enigmatic->unique_ids);
+        DEBUG("core %s added", table->cores[i].name);
      }
-   eina_iterator_free(it);
 
-   if (purge) changed = 1;
+   memcpy(table->sample, table->cores, table->count * sizeof(Cpu_Core));
 
-   EINA_LIST_FREE(purge, core)
-     {
-        Message msg;
-        msg.type = MESG_DEL;
-        msg.object_type = CPU_CORE;
-        msg.number = core->unique_id;
-        enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
-
-        unique_id_release(&enigmatic->unique_ids, core->unique_id);
-        eina_hash_del(*cache_hash, core->name, NULL);
-     }
+   return 1;
+}
 
-   double ratio;
-   int diff_total, diff_idle;
+static int
+core_percent(long long used, long long total)
+{
    int percent;
-   unsigned long used;
 
-   EINA_LIST_FREE(cores, core)
-     {
-        c = eina_hash_find(*cache_hash, core->name);
-        if (!c)
-          {
-             core->unique_id = unique_id_find(&enigmatic->unique_ids);
+   if (total <= 0) return 0;
 
-             Message msg;
-             msg.type = MESG_ADD;
-             msg.object_type = CPU_CORE;
-             msg.number = 1;
-             enigmatic_log_obj_write(enigmatic, EVENT_MESSAGE, msg, core, sizeof(Cpu_Core));
+   percent = (used * 100) / total;
+   if (percent > 100) percent = 100;
+   else if (percent < 0)
+     percent = 0;
 
-             DEBUG("core %s added", core->name);
+   return percent;
+}
 
-             eina_hash_add(*cache_hash, core->name, core);
-             changed = 1;
-             continue;
-          }
-        diff_total = (core->total - c->total) / enigmatic->interval;
-        diff_idle = (core->idle - c->idle) / enigmatic->interval;
-        ratio = diff_total / 100.0;
-        used = diff_total - diff_idle;
-        percent = used / ratio;
+Eina_Bool
+enigmatic_monitor_cores_sample(Enigmatic *enigmatic, Cores_Table *table)
+{
+   Cpu_Core *c, *core;
+   Eina_Bool changed = 0;
+   long long diff_total, diff_idle, diff_iowait;
+   int i, j, percent;
 
-        if (percent > 100) percent = 100;
-        else if (percent < 0)
-          percent = 0;
+   if (enigmatic->broadcast)
+     {
+        cores_refresh(enigmatic, table);
+     }
 
-        core->percent = percent;
+   for (i = 0; i < table->count; i++)
+     {
+        c = &table->cores[i];
+        core = &table->sample[i];
 
-        if (c->percent != core->percent)
+        // A zero total is a core that went offline, bring it back when it
+        // is counted again.
+        if (c->unique_id < 0)
           {
-             Message msg;
-             msg.type = MESG_MOD;
-             msg.object_type = CPU_CORE_PERC;
-             msg.number = c->unique_id;
-
-             enigmatic_log_diff(enigmatic, msg, core->percent - c->percent);
-
-             c->percent = core->percent;
+             if (!core->total) continue;
+             core_add(enigmatic, c, core);
+             changed = 1;
+             continue;
           }
-
-        if (c->temp != core->temp)
+        else if (!core->total)
           {
-             Message msg;
-             msg.type = MESG_MOD;
-             msg.object_type = CPU_CORE_TEMP;
-             msg.number = c->unique_id;
-
-             enigmatic_log_diff(enigmatic, msg, core->temp - c->temp);
-
-             c->temp = core->temp;
+             core_del(enigmatic, c);
+             changed = 1;
+             continue;
           }
 
-        if (c->freq != core->freq)
-          {
-             Message msg;
-             msg.type = MESG_MOD;
-             msg.object_type = CPU_CORE_FREQ;
-             msg.number = c->unique_id;
+        diff_total = (long long) core->total - (long long) c->total;
+        diff_idle = (long long) core->idle - (long long) c->idle;
+        diff_iowait = (long long) core->states[CORE_STATE_IOWAIT] - (long long) c->states[CORE_STATE_IOWAIT];
 
-             enigmatic_log_diff(enigmatic, msg, core->freq - c->freq);
+        if (diff_total > 0)
+          {
+             // Waiting on I/O is neither busy nor idle, as it always was.
+             // It is still reported on its own below.
+             percent = core_percent(diff_total - diff_iowait - diff_idle, diff_total - diff_iowait);
+             core_log_delta(enigmatic, c, CPU_CORE_PERC, percent - c->percent, &changed);
+             c->percent = percent;
 
-             c->freq = core->freq;
+             for (j = 0; j < CORE_STATE_MAX; j++)
+               {
+                  percent = core_percent((long long) core->states[j] - (long long) c->states[j], diff_total);
+                  core_log_delta(enigmatic, c, CPU_CORE_USER + j, percent - c->state_percent[j], &changed);
+                  c->state_percent[j] = percent;
+               }
           }
 
+        core_log_delta(enigmatic, c, CPU_CORE_TEMP, core->temp - c->temp, &changed);
+        c->temp = core->temp;
+
+        core_log_delta(enigmatic, c, CPU_CORE_FREQ, core->freq - c->freq, &changed);
+        c->freq = core->freq;
+
+        memcpy(c->states, core->states, sizeof(c->states));
         c->idle = core->idle;
         c->total = core->total;
 
-        DEBUG("%s (%i) => %i%% => %i => %iC", c->name, c->unique_id, c->percent, c->freq, c->temp);
-
-        free(core);
+        DEBUG("%s (%i) => %i%% => %i => %iC (steal %i%%)", c->name, c->unique_id, c->percent, c->freq, c->temp,
+              c->state_percent[CORE_STATE_STEAL]);
      }
 
    return changed;
 }
 
+Eina_Bool
+enigmatic_monitor_cores(Enigmatic *enigmatic, Cores_Table *table)
+{
+   // The table and topology are built once, each poll only refreshes the
+   // counters in place. Cores going offline or online are added and removed
+   // as the sample shows them.
+   if ((!table->cores) && (!cores_table_init(enigmatic, table)))
+     return 0;
+
+   cores_array_update(table->sample, table->count);
+
+   return enigmatic_monitor_cores_sample(enigmatic, table);
+}
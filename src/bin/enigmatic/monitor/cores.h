@@ -4,6 +4,10 @@
 #include "Enigmatic.h"
 
 Eina_Bool
-enigmatic_monitor_cores(Enigmatic *enigmatic, Eina_Hash **cache_hash);
+enigmatic_monitor_cores(Enigmatic *enigmatic, Cores_Table *table);
+
+// Diff the counters the caller already sampled into the table.
+Eina_Bool
+enigmatic_monitor_cores_sample(Enigmatic *enigmatic, Cores_Table *table);
 
 #endif
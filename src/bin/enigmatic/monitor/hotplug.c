@@ -0,0 +1,140 @@
+#include <Ecore.h>
+#include <unistd.h>
+#include <errno.h>
+
+#if defined(__linux__)
+# include <poll.h>
+# include <sys/socket.h>
+# include <linux/netlink.h>
+#endif
+
+#include "hotplug.h"
+
+struct _Hotplug
+{
+   int  fd;
+   char match[128];
+};
+
+Hotplug *
+hotplug_new(const char *subsystem)
+{
+#if defined(__linux__)
+   struct sockaddr_nl addr;
+   Hotplug *hotplug;
+   int fd;
+
+   fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+   if (fd == -1) return NULL;
+
+   memset(&addr, 0, sizeof(addr));
+   addr.nl_family = AF_NETLINK;
+   addr.nl_groups = 1;
+
+   if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) == -1)
+     {
+        close(fd);
+        return NULL;
+     }
+
+   hotplug = calloc(1, sizeof(Hotplug));
+   if (!hotplug)
+     {
+        close(fd);
+        return NULL;
+     }
+
+   hotplug->fd = fd;
+   snprintf(hotplug->match, sizeof(hotplug->match), "SUBSYSTEM=%s", subsystem);
+
+   return hotplug;
+#else
+   (void) subsystem;
+   return NULL;
+#endif
+}
+
+void
+hotplug_free(Hotplug *hotplug)
+{
+   if (!hotplug) return;
+
+   close(hotplug->fd);
+   free(hotplug);
+}
+
+#if defined(__linux__)
+static Eina_Bool
+hotplug_read(Hotplug *hotplug)
+{
+   struct sockaddr_nl addr;
+   socklen_t addrlen;
+   char buf[8192];
+   ssize_t len;
+   Eina_Bool found = 0;
+
+   while (1)
+     {
+        addrlen = sizeof(addr);
+        len = recvfrom(hotplug->fd, buf, sizeof(buf) - 1, 0, (struct sockaddr *) &addr, &addrlen);
+        if (len == -1)
+          {
+             // The queue overflowed and events were lost.
+             if (errno == ENOBUFS) found = 1;
+             else if (errno == EINTR) continue;
+             break;
+          }
+        if ((!len) || (addr.nl_pid)) continue;
+        buf[len] = '\0';
+
+        // ACTION@DEVPATH followed by NUL separated KEY=VALUE pairs.
+        for (ssize_t i = 0; i < len; i += strlen(buf + i) + 1)
+          {
+             if (!strcmp(buf + i, hotplug->match))
+               {
+                  found = 1;
+                  break;
+               }
+          }
+     }
+
+   return found;
+}
+#endif
+
+Eina_Bool
+hotplug_wait(Hotplug *hotplug, int msecs)
+{
+   if (!hotplug)
+     {
+        usleep(msecs * 1000);
+        return 0;
+     }
+#if defined(__linux__)
+   struct pollfd pfd;
+   double end = ecore_time_get() + (msecs / 1000.0);
+   Eina_Bool found = 0;
+   int remain, ret;
+
+   pfd.fd = hotplug->fd;
+   pfd.events = POLLIN;
+
+   while ((remain = (end - ecore_time_get()) * 1000) > 0)
+     {
+        ret = poll(&pfd, 1, remain);
+        if (ret > 0)
+          {
+             if (hotplug_read(hotplug)) found = 1;
+          }
+        else if ((ret == -1) && (errno != EINTR))
+          {
+             usleep(remain * 1000);
+             break;
+          }
+     }
+
+   return found;
+#else
+   return 0;
+#endif
+}
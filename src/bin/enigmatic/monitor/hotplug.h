@@ -0,0 +1,21 @@
+#ifndef ENIGMATIC_MONITOR_HOTPLUG_H
+#define ENIGMATIC_MONITOR_HOTPLUG_H
+
+#include <Eina.h>
+
+typedef struct _Hotplug Hotplug;
+
+// Watch the kernel's uevents for devices of one subsystem coming and going.
+// Returns NULL where there are none to watch, callers then rediscover
+// devices periodically instead.
+Hotplug *
+hotplug_new(const char *subsystem);
+
+void
+hotplug_free(Hotplug *hotplug);
+
+// Sleep for msecs and return whether the subsystem had an event meanwhile.
+Eina_Bool
+hotplug_wait(Hotplug *hotplug, int msecs);
+
+#endif
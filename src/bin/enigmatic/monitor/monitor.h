@@ -10,5 +10,7 @@
 #include "file_systems.h"
 #include "network_interfaces.h"
 #include "processes.h"
+#include "cgroups.h"
+#include "block_devices.h"
 
 #endif
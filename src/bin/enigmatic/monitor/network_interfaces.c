@@ -54,14 +54,12 @@ network_interfaces_refresh(Enigmatic *enigmatic, Eina_Hash **cache_hash)
 }
 
 Eina_Bool
-enigmatic_monitor_network_interfaces(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+enigmatic_monitor_network_interfaces_list(Enigmatic *enigmatic, Eina_Hash **cache_hash, Eina_List *network_interfaces)
 {
-   Eina_List *l, *network_interfaces;
+   Eina_List *l;
    Network_Interface *iface, *iface2;
    Eina_Bool changed = 0;
 
-   network_interfaces = network_interfaces_find();
-
    if (!*cache_hash)
      {
         *cache_hash = eina_hash_string_superfast_new(cb_network_interface_free);
@@ -164,3 +162,8 @@ enigmatic_monitor_network_interfaces(Enigmatic *enigmatic, Eina_Hash **cache_has
    return changed;
 }
 
+Eina_Bool
+enigmatic_monitor_network_interfaces(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+{
+   return enigmatic_monitor_network_interfaces_list(enigmatic, cache_hash, network_interfaces_find());
+}
@@ -6,4 +6,8 @@
 Eina_Bool
 enigmatic_monitor_network_interfaces(Enigmatic *enigmatic, Eina_Hash **cache_hash);
 
+// Diff a collected list of interfaces against the cache, taking the list.
+Eina_Bool
+enigmatic_monitor_network_interfaces_list(Enigmatic *enigmatic, Eina_Hash **cache_hash, Eina_List *network_interfaces);
+
 #endif
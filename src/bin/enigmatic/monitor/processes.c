@@ -54,6 +54,13 @@ proc_info_log_fill(const Proc_Info *proc, Proc_Info_Log *out)
    out->net_out = proc->net_out;
    out->disk_read = proc->disk_read;
    out->disk_write = proc->disk_write;
+   out->net_in_rate = proc->net_in_rate;
+   out->net_out_rate = proc->net_out_rate;
+   out->disk_read_rate = proc->disk_read_rate;
+   out->disk_write_rate = proc->disk_write_rate;
+   out->delay_cpu = proc->delay_cpu;
+   out->delay_blkio = proc->delay_blkio;
+   out->delay_swap = proc->delay_swap;
    out->numfiles = proc->numfiles;
    out->was_zero = proc->was_zero;
    out->is_kernel = proc->is_kernel;
@@ -65,7 +72,8 @@ proc_info_log_fill(const Proc_Info *proc, Proc_Info_Log *out)
 
    if (proc->command)
      snprintf(out->command, sizeof(out->command), "%s", proc->command);
-   if (proc->arguments)
+   // A shared log is readable by everyone, owners ask the daemon instead.
+   if ((proc->arguments) && (!enigmatic_system_mode_get()))
      snprintf(out->arguments, sizeof(out->arguments), "%s", proc->arguments);
    snprintf(out->state, sizeof(out->state), "%s", proc->state);
    snprintf(out->wchan, sizeof(out->wchan), "%s", proc->wchan);
@@ -210,6 +218,22 @@ _process_network_totals_update(Proc_Info *proc, const Proc_Info *prev)
      proc->net_out += raw_out - prev->net_out_raw;
 }
 
+static uint64_t
+_process_rate(uint64_t now, uint64_t prev, double seconds)
+{
+   if ((now < prev) || (seconds <= 0.0)) return 0;
+
+   return (uint64_t) ((now - prev) / seconds);
+}
+
+// Passes are an interval apart unless the rate changed in between, or
+// the pass ran late, so take the measured time rather than the nominal.
+static double
+_process_elapsed(const Enigmatic *enigmatic)
+{
+   return enigmatic->elapsed > 0.0 ? enigmatic->elapsed : (double) enigmatic->interval;
+}
+
 static void
 processes_refresh(Enigmatic *enigmatic, Eina_Hash **cache_hash)
 {
@@ -242,13 +266,13 @@ processes_refresh(Enigmatic *enigmatic, Eina_Hash **cache_hash)
 }
 
 Eina_Bool
-enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+enigmatic_monitor_processes_list(Enigmatic *enigmatic, Eina_Hash **cache_hash, Eina_List *processes)
 {
-   Eina_List *l, *processes;
+   Eina_List *l;
    Proc_Info *proc, *p1;
    Eina_Bool changed = 0;
+   double elapsed = _process_elapsed(enigmatic);
 
-   processes = proc_info_all_get();
    if (!*cache_hash)
      {
         *cache_hash = eina_hash_int32_new(cb_process_free);
@@ -270,23 +294,25 @@ enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash)
    void *d = NULL;
    Eina_List *purge = NULL;
 
+   // Index this pass by pid so finding the exited processes stays linear.
+   Eina_Hash *present = eina_hash_int32_new(NULL);
+   EINA_LIST_FOREACH(processes, l, p1)
+     {
+        int32_t pid = p1->pid;
+        eina_hash_add(present, &pid, p1);
+     }
+
    Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
    while (eina_iterator_next(it, &d))
      {
         Proc_Info *p2 = d;
-        Eina_Bool found = 0;
-        EINA_LIST_FOREACH(processes, l, p1)
-          {
-             if ((p1->pid == p2->pid) && (p1->start == p2->start))
-               {
-                  found = 1;
-                  break;
-               }
-          }
-        if (!found)
+        int32_t pid = p2->pid;
+        p1 = eina_hash_find(present, &pid);
+        if ((!p1) || (p1->start != p2->start))
           purge = eina_list_prepend(purge, p2);
      }
    eina_iterator_free(it);
+   eina_hash_free(present);
 
    EINA_LIST_FREE(purge, proc)
      {
@@ -329,7 +355,7 @@ enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash)
 
         cpu_time_delta = new_log.cpu_time - old_log.cpu_time;
         cpu_usage_prev = (int64_t) old_log.cpu_usage;
-        cpu_usage_now = cpu_time_delta / enigmatic->interval;
+        cpu_usage_now = (int64_t) (cpu_time_delta / elapsed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_PPID, (int64_t) new_log.ppid - (int64_t) old_log.ppid, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_UID, (int64_t) new_log.uid - (int64_t) old_log.uid, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_NICE, new_log.nice - old_log.nice, &changed);
@@ -343,6 +369,13 @@ enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash)
         proc->cpu_usage = cpu_usage_now;
         proc->was_zero = new_log.was_zero;
 
+        // Rates ride along with the counters so every reader, live or at
+        // any point in the history, has them without a previous sample.
+        proc->net_in_rate = new_log.net_in_rate = _process_rate(new_log.net_in, old_log.net_in, elapsed);
+        proc->net_out_rate = new_log.net_out_rate = _process_rate(new_log.net_out, old_log.net_out, elapsed);
+        proc->disk_read_rate = new_log.disk_read_rate = _process_rate(new_log.disk_read, old_log.disk_read, elapsed);
+        proc->disk_write_rate = new_log.disk_write_rate = _process_rate(new_log.disk_write, old_log.disk_write, elapsed);
+
         _process_log_delta(enigmatic, proc->pid, PROCESS_RUN_TIME, new_log.run_time - old_log.run_time, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_START, new_log.start - old_log.start, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_MEM_SIZE, ((int64_t) (new_log.mem_size / 4096)) - ((int64_t) (old_log.mem_size / 4096)), &changed);
@@ -353,6 +386,13 @@ enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash)
         _process_log_delta(enigmatic, proc->pid, PROCESS_NET_OUT, (int64_t) new_log.net_out - (int64_t) old_log.net_out, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_DISK_READ, (int64_t) new_log.disk_read - (int64_t) old_log.disk_read, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_DISK_WRITE, (int64_t) new_log.disk_write - (int64_t) old_log.disk_write, &changed);
+        _process_log_delta(enigmatic, proc->pid, PROCESS_NET_IN_RATE, (int64_t) new_log.net_in_rate - (int64_t) old_log.net_in_rate, &changed);
+        _process_log_delta(enigmatic, proc->pid, PROCESS_NET_OUT_RATE, (int64_t) new_log.net_out_rate - (int64_t) old_log.net_out_rate, &changed);
+        _process_log_delta(enigmatic, proc->pid, PROCESS_DISK_READ_RATE, (int64_t) new_log.disk_read_rate - (int64_t) old_log.disk_read_rate, &changed);
+        _process_log_delta(enigmatic, proc->pid, PROCESS_DISK_WRITE_RATE, (int64_t) new_log.disk_write_rate - (int64_t) old_log.disk_write_rate, &changed);
+        _process_log_delta(enigmatic, proc->pid, PROCESS_DELAY_CPU, ((int64_t) (new_log.delay_cpu / 1000)) - ((int64_t) (old_log.delay_cpu / 1000)), &changed);
+        _process_log_delta(enigmatic, proc->pid, PROCESS_DELAY_BLKIO, ((int64_t) (new_log.delay_blkio / 1000)) - ((int64_t) (old_log.delay_blkio / 1000)), &changed);
+        _process_log_delta(enigmatic, proc->pid, PROCESS_DELAY_SWAP, ((int64_t) (new_log.delay_swap / 1000)) - ((int64_t) (old_log.delay_swap / 1000)), &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_NUM_FILES, new_log.numfiles - old_log.numfiles, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_WAS_ZERO, new_log.was_zero - old_log.was_zero, &changed);
         _process_log_delta(enigmatic, proc->pid, PROCESS_IS_KERNEL, new_log.is_kernel - old_log.is_kernel, &changed);
@@ -387,3 +427,9 @@ enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash)
 
    return changed;
 }
+
+Eina_Bool
+enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+{
+   return enigmatic_monitor_processes_list(enigmatic, cache_hash, proc_info_all_get());
+}
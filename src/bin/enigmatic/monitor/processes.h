@@ -6,4 +6,8 @@
 Eina_Bool
 enigmatic_monitor_processes(Enigmatic *enigmatic, Eina_Hash **cache_hash);
 
+// Diff a collected list of processes against the cache, taking the list.
+Eina_Bool
+enigmatic_monitor_processes_list(Enigmatic *enigmatic, Eina_Hash **cache_hash, Eina_List *processes);
+
 #endif
@@ -1,11 +1,15 @@
 #include "system/machine.h"
 #include "sensors.h"
 #include "uid.h"
+#include "hotplug.h"
 #include "enigmatic_log.h"
 
 static Eina_List     *sensors = NULL;
 static Ecore_Thread  *thread = NULL;
 static Eina_Lock      sensors_lock;
+static Hotplug       *hotplug = NULL;
+static unsigned int   sensors_generation = 0;
+static unsigned int   sensors_generation_seen = 0;
 
 void
 sensor_key(char *buf, size_t len, Sensor *sensor)
@@ -74,6 +78,7 @@ sensors_thread(void *data EINA_UNUSED, Ecore_Thread *thread)
 {
    Sensor *sensor;
    uint32_t it = 0;
+   Eina_Bool rediscover = 0;
 
 #if (EFL_VERSION_MAJOR >= 1 && EFL_VERSION_MINOR >= 26)
    ecore_thread_name_set(thread, "sensemon");
@@ -82,11 +87,14 @@ sensors_thread(void *data EINA_UNUSED, Ecore_Thread *thread)
    while (!ecore_thread_check(thread))
      {
         eina_lock_take(&sensors_lock);
-        if ((it) && (!(it % 3)))
+        // Without hotplug events look for new sensors every third pass.
+        if ((rediscover) || ((!hotplug) && (it) && (!(it % 3))))
           {
              EINA_LIST_FREE(sensors, sensor)
                free(sensor);
              sensors = sensors_find();
+             sensors_generation++;
+             rediscover = 0;
           }
         sensors_update(sensors);
         eina_lock_release(&sensors_lock);
@@ -94,7 +102,7 @@ sensors_thread(void *data EINA_UNUSED, Ecore_Thread *thread)
         for (int i = 0; i < 20; i++)
           {
              if (ecore_thread_check(thread)) break;
-             usleep(50000);
+             if (hotplug_wait(hotplug, 50)) rediscover = 1;
           }
         it++;
      }
@@ -107,6 +115,8 @@ enigmatic_monitor_sensors_init(void)
 {
    eina_lock_new(&sensors_lock);
 
+   // Listen before the first walk so no device slips in between.
+   hotplug = hotplug_new("hwmon");
    sensors = sensors_find();
    sensors_update(sensors);
 }
@@ -115,24 +125,65 @@ void
 enigmatic_monitor_sensors_shutdown(void)
 {
    eina_lock_take(&sensors_lock);
+   hotplug_free(hotplug);
+   hotplug = NULL;
    eina_lock_release(&sensors_lock);
    eina_lock_free(&sensors_lock);
 }
 
+static void
+sensors_purge(Enigmatic *enigmatic, Eina_Hash *cache_hash, Eina_List *list)
+{
+   Eina_List *l, *purge = NULL;
+   Eina_Iterator *it;
+   Eina_Hash_Tuple *t;
+   Eina_Hash *present;
+   Sensor *sensor;
+   char key[1024];
+
+   present = eina_hash_string_superfast_new(NULL);
+   EINA_LIST_FOREACH(list, l, sensor)
+     {
+        sensor_key(key, sizeof(key), sensor);
+        eina_hash_add(present, key, sensor);
+     }
+
+   it = eina_hash_iterator_tuple_new(cache_hash);
+   EINA_ITERATOR_FOREACH(it, t)
+     {
+        if (!eina_hash_find(present, t->key))
+          purge = eina_list_prepend(purge, t->data);
+     }
+   eina_iterator_free(it);
+   eina_hash_free(present);
+
+   EINA_LIST_FREE(purge, sensor)
+     {
+        Message msg;
+        msg.type = MESG_DEL;
+        msg.object_type = SENSOR;
+        msg.number = sensor->unique_id;
+        enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
+
+        sensor_key(key, sizeof(key), sensor);
+        sensor_release(sensor);
+        unique_id_release(&enigmatic->unique_ids, sensor->unique_id);
+        eina_hash_del(cache_hash, key, NULL);
+     }
+}
+
 Eina_Bool
-enigmatic_monitor_sensors(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+enigmatic_monitor_sensors_list(Enigmatic *enigmatic, Eina_Hash **cache_hash, Eina_List *list, Eina_Bool rediscovered)
 {
    Eina_List *l;
    Sensor *sensor, *s;
    char key[1024];
    Eina_Bool changed = 0;
 
-   if (eina_lock_take_try(&sensors_lock) != EINA_LOCK_SUCCEED) return 0;
-
    if (!*cache_hash)
      {
         *cache_hash = eina_hash_string_superfast_new(cb_sensor_free);
-        EINA_LIST_FOREACH(sensors, l, sensor)
+        EINA_LIST_FOREACH(list, l, sensor)
           {
              s = malloc(sizeof(Sensor));
              if (s)
@@ -144,7 +195,6 @@ enigmatic_monitor_sensors(Enigmatic *enigmatic, Eina_Hash **cache_hash)
                   eina_hash_add(*cache_hash, key, s);
                }
           }
-        enigmatic->sensors_thread = thread = ecore_thread_run(sensors_thread, NULL, NULL, NULL);
      }
 
    if (enigmatic->broadcast)
@@ -152,44 +202,10 @@ enigmatic_monitor_sensors(Enigmatic *enigmatic, Eina_Hash **cache_hash)
         sensors_refresh(enigmatic, cache_hash);
      }
 
-   void *d = NULL;
-   Eina_List *purge = NULL;
-
-   Eina_Iterator *it = eina_hash_iterator_data_new(*cache_hash);
-   while (eina_iterator_next(it, &d))
-     {
-        Sensor *s = d;
-        Eina_Bool found = 0;
-        char key2[1024];
-        EINA_LIST_FOREACH(sensors, l, sensor)
-          {
-             sensor_key(key, sizeof(key), sensor);
-             sensor_key(key2, sizeof(key2), s);
-             if (!strcmp(key2, key))
-               {
-                  found = 1;
-                  break;
-               }
-          }
-        if (!found)
-          purge = eina_list_prepend(purge, s);
-     }
-   eina_iterator_free(it);
-
-   EINA_LIST_FREE(purge, sensor)
-     {
-        Message msg;
-        msg.type = MESG_DEL;
-        msg.object_type = SENSOR;
-        msg.number = sensor->unique_id;
-        enigmatic_log_header(enigmatic, EVENT_MESSAGE, msg);
-
-        sensor_key(key, sizeof(key), sensor);
-        unique_id_release(&enigmatic->unique_ids, sensor->unique_id);
-        eina_hash_del(*cache_hash, key, NULL);
-     }
+   if (rediscovered)
+     sensors_purge(enigmatic, *cache_hash, list);
 
-   EINA_LIST_FOREACH(sensors, l, sensor)
+   EINA_LIST_FOREACH(list, l, sensor)
      {
         sensor_key(key, sizeof(key), sensor);
         s = eina_hash_find(*cache_hash, key);
@@ -231,6 +247,26 @@ enigmatic_monitor_sensors(Enigmatic *enigmatic, Eina_Hash **cache_hash)
         s->value = sensor->value;
      }
 
+   return changed;
+}
+
+Eina_Bool
+enigmatic_monitor_sensors(Enigmatic *enigmatic, Eina_Hash **cache_hash)
+{
+   Eina_Bool changed;
+
+   if (eina_lock_take_try(&sensors_lock) != EINA_LOCK_SUCCEED) return 0;
+
+   if (!*cache_hash)
+     {
+        sensors_generation_seen = sensors_generation;
+        enigmatic->sensors_thread = thread = ecore_thread_run(sensors_thread, NULL, NULL, NULL);
+     }
+
+   // The set of sensors only changes when the thread rediscovered them.
+   changed = enigmatic_monitor_sensors_list(enigmatic, cache_hash, sensors, sensors_generation_seen != sensors_generation);
+   sensors_generation_seen = sensors_generation;
+
    eina_lock_release(&sensors_lock);
 
    return changed;
@@ -6,6 +6,11 @@
 Eina_Bool
 enigmatic_monitor_sensors(Enigmatic *enigmatic, Eina_Hash **cache_hash);
 
+// Diff a list of sensors against the cache, the list stays the caller's.
+// Sensors missing from it are only dropped when it was rediscovered.
+Eina_Bool
+enigmatic_monitor_sensors_list(Enigmatic *enigmatic, Eina_Hash **cache_hash, Eina_List *list, Eina_Bool rediscovered);
+
 void
 enigmatic_monitor_sensors_init(void);
 
@@ -0,0 +1,172 @@
+#include "block_devices.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+#if defined(__linux__)
+
+#define DISKSTATS_SECTOR_SIZE 512
+
+// Fields are scanned in place, nothing is copied out of the read buffer
+// except the name of a device we keep.
+static const char *
+diskstats_space_skip(const char *p, const char *end)
+{
+   while ((p < end) && ((*p == ' ') || (*p == '\t')))
+     p++;
+
+   return p;
+}
+
+static const char *
+diskstats_field_skip(const char *p, const char *end)
+{
+   p = diskstats_space_skip(p, end);
+   while ((p < end) && (*p != ' ') && (*p != '\t') && (*p != '\n'))
+     p++;
+
+   return p;
+}
+
+static uint64_t
+diskstats_u64(const char **pp, const char *end)
+{
+   const char *p = diskstats_space_skip(*pp, end);
+   uint64_t value = 0;
+
+   while ((p < end) && (*p >= '0') && (*p <= '9'))
+     value = (value * 10) + (*p++ - '0');
+
+   *pp = p;
+
+   return value;
+}
+
+// The kernel names partitions after their disk, with a 'p' in between
+// when the disk name ends in a digit (sda1, nvme0n1p1, mmcblk0p2). Disks
+// are listed before their partitions.
+static Eina_Bool
+diskstats_partition(const char *disk, size_t disk_len, const char *name, size_t len)
+{
+   size_t i;
+
+   if ((!disk) || (len <= disk_len) || (strncmp(disk, name, disk_len)))
+     return 0;
+
+   i = disk_len;
+   if ((disk[disk_len - 1] >= '0') && (disk[disk_len - 1] <= '9'))
+     {
+        if (name[i++] != 'p') return 0;
+        if (i == len) return 0;
+     }
+
+   for (; i < len; i++)
+     {
+        if ((name[i] < '0') || (name[i] > '9'))
+          return 0;
+     }
+
+   return 1;
+}
+
+static Eina_List *
+diskstats_parse(const char *buf, size_t size)
+{
+   Eina_List *list = NULL;
+   const char *p, *end, *eol, *name, *disk = NULL;
+   size_t len, disk_len = 0;
+   Block_Device *dev;
+   uint64_t reads, read_sectors, writes, write_sectors, io_time, queue_time;
+
+   end = buf + size;
+
+   for (p = buf; p < end; p = eol + 1)
+     {
+        eol = memchr(p, '\n', end - p);
+        if (!eol) eol = end;
+
+        // major, minor.
+        p = diskstats_field_skip(p, eol);
+        p = diskstats_field_skip(p, eol);
+
+        name = diskstats_space_skip(p, eol);
+        p = diskstats_field_skip(name, eol);
+        len = p - name;
+        if ((!len) || (len >= BLOCK_DEVICE_NAME_SIZE)) continue;
+
+        if (diskstats_partition(disk, disk_len, name, len)) continue;
+
+        disk = name;
+        disk_len = len;
+
+        if ((!strncmp(name, "loop", 4)) || (!strncmp(name, "ram", 3)))
+          continue;
+
+        reads = diskstats_u64(&p, eol);
+        diskstats_u64(&p, eol);
+        read_sectors = diskstats_u64(&p, eol);
+        diskstats_u64(&p, eol);
+        writes = diskstats_u64(&p, eol);
+        diskstats_u64(&p, eol);
+        write_sectors = diskstats_u64(&p, eol);
+        diskstats_u64(&p, eol);
+        diskstats_u64(&p, eol);
+        io_time = diskstats_u64(&p, eol);
+        queue_time = diskstats_u64(&p, eol);
+
+        // Never used, an empty card reader or optical drive.
+        if ((!reads) && (!writes)) continue;
+
+        dev = calloc(1, sizeof(Block_Device));
+        if (!dev) break;
+
+        memcpy(dev->name, name, len);
+        dev->reads = reads;
+        dev->writes = writes;
+        dev->read_bytes = read_sectors * DISKSTATS_SECTOR_SIZE;
+        dev->write_bytes = write_sectors * DISKSTATS_SECTOR_SIZE;
+        dev->io_time = io_time;
+        dev->queue_time = queue_time;
+
+        list = eina_list_append(list, dev);
+     }
+
+   return list;
+}
+
+#endif
+
+Eina_List *
+block_devices_find(void)
+{
+   Eina_List *list = NULL;
+#if defined(__linux__)
+   char buf[65536];
+   ssize_t n;
+   size_t len = 0;
+   int fd;
+
+   fd = open("/proc/diskstats", O_RDONLY | O_CLOEXEC);
+   if (fd == -1) return NULL;
+
+   while ((len < sizeof(buf)) && ((n = read(fd, buf + len, sizeof(buf) - len)) > 0))
+     len += n;
+
+   close(fd);
+
+   list = diskstats_parse(buf, len);
+#endif
+   return list;
+}
+
+void
+block_device_info_free(Block_Device *dev)
+{
+   free(dev);
+}
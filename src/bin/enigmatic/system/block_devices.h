@@ -0,0 +1,31 @@
+#ifndef __BLOCK_DEVICES_H__
+#define __BLOCK_DEVICES_H__
+
+#include <Eina.h>
+#include <stdint.h>
+#include "enigmatic_visibility.h"
+
+#define BLOCK_DEVICE_NAME_SIZE 32
+
+typedef struct _Block_Device {
+   char         name[BLOCK_DEVICE_NAME_SIZE];
+
+   uint64_t     reads;
+   uint64_t     writes;
+   uint64_t     read_bytes;
+   uint64_t     write_bytes;
+
+   // Milliseconds spent doing I/O, and that weighted by queue depth.
+   uint64_t     io_time;
+   uint64_t     queue_time;
+
+   int          unique_id;
+} Block_Device;
+
+ENIGMATIC_API Eina_List *
+block_devices_find(void);
+
+ENIGMATIC_API void
+block_device_info_free(Block_Device *dev);
+
+#endif
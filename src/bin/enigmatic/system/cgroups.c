@@ -0,0 +1,182 @@
+#include "cgroups.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#if defined(__linux__)
+# include <dirent.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/vfs.h>
+# include <linux/magic.h>
+#endif
+
+#if defined(__linux__)
+
+static const char *cgroup_roots[] = {
+   "/sys/fs/cgroup",
+   "/sys/fs/cgroup/unified",
+};
+
+#define CGROUP_DEPTH_MAX 8
+
+#ifndef CGROUP2_SUPER_MAGIC
+# define CGROUP2_SUPER_MAGIC 0x63677270
+#endif
+
+static int
+cgroup_file_read(int dirfd, const char *name, char *buf, size_t len)
+{
+   ssize_t n;
+   int fd;
+
+   fd = openat(dirfd, name, O_RDONLY | O_CLOEXEC);
+   if (fd == -1) return 0;
+
+   n = read(fd, buf, len - 1);
+   close(fd);
+   if (n <= 0) return 0;
+
+   buf[n] = '\0';
+
+   return 1;
+}
+
+static void
+cgroup_cpu_stat(int dirfd, Cgroup *cg)
+{
+   char buf[1024], *line, *save = NULL;
+   unsigned long long value;
+
+   if (!cgroup_file_read(dirfd, "cpu.stat", buf, sizeof(buf))) return;
+
+   for (line = strtok_r(buf, "\n", &save); line; line = strtok_r(NULL, "\n", &save))
+     {
+        if (sscanf(line, "usage_usec %llu", &value) == 1)
+          cg->cpu_usage = value;
+        else if (sscanf(line, "user_usec %llu", &value) == 1)
+          cg->cpu_user = value;
+        else if (sscanf(line, "system_usec %llu", &value) == 1)
+          cg->cpu_system = value;
+     }
+}
+
+static void
+cgroup_io_stat(int dirfd, Cgroup *cg)
+{
+   char buf[8192], *line, *save = NULL, *tok;
+   unsigned long long value;
+
+   if (!cgroup_file_read(dirfd, "io.stat", buf, sizeof(buf))) return;
+
+   // One line per device: "MAJ:MIN rbytes=N wbytes=N rios=N ...".
+   for (line = strtok_r(buf, "\n", &save); line; line = strtok_r(NULL, "\n", &save))
+     {
+        if ((tok = strstr(line, " rbytes=")) && (sscanf(tok, " rbytes=%llu", &value) == 1))
+          cg->io_read += value;
+        if ((tok = strstr(line, " wbytes=")) && (sscanf(tok, " wbytes=%llu", &value) == 1))
+          cg->io_write += value;
+     }
+}
+
+static uint32_t
+cgroup_pressure(int dirfd, const char *name)
+{
+   char buf[256];
+   double avg10 = 0.0;
+
+   if (!cgroup_file_read(dirfd, name, buf, sizeof(buf))) return 0;
+   if (sscanf(buf, "some avg10=%lf", &avg10) != 1) return 0;
+
+   return (uint32_t) (avg10 * 100.0);
+}
+
+static void
+cgroup_walk(Eina_List **list, int dirfd, const char *path, int depth)
+{
+   DIR *dir;
+   struct dirent *dh;
+   char buf[64];
+   int fd;
+
+   Cgroup *cg = calloc(1, sizeof(Cgroup));
+   if (cg)
+     {
+        snprintf(cg->path, sizeof(cg->path), "%s", path[0] ? path : "/");
+        cgroup_cpu_stat(dirfd, cg);
+        cgroup_io_stat(dirfd, cg);
+        if (cgroup_file_read(dirfd, "memory.current", buf, sizeof(buf)))
+          cg->memory_current = strtoull(buf, NULL, 10);
+        cg->cpu_pressure = cgroup_pressure(dirfd, "cpu.pressure");
+        cg->memory_pressure = cgroup_pressure(dirfd, "memory.pressure");
+        cg->io_pressure = cgroup_pressure(dirfd, "io.pressure");
+        *list = eina_list_append(*list, cg);
+     }
+
+   if (depth >= CGROUP_DEPTH_MAX) return;
+
+   fd = dup(dirfd);
+   if (fd == -1) return;
+   dir = fdopendir(fd);
+   if (!dir)
+     {
+        close(fd);
+        return;
+     }
+
+   while ((dh = readdir(dir)) != NULL)
+     {
+        char child[CGROUP_PATH_SIZE];
+        int cfd;
+
+        if (dh->d_type != DT_DIR) continue;
+        if (dh->d_name[0] == '.') continue;
+
+        if (snprintf(child, sizeof(child), "%s/%s", path, dh->d_name) >= (int) sizeof(child))
+          continue;
+
+        cfd = openat(dirfd, dh->d_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (cfd == -1) continue;
+
+        cgroup_walk(list, cfd, child, depth + 1);
+        close(cfd);
+     }
+
+   closedir(dir);
+}
+
+#endif
+
+Eina_List *
+cgroups_find(void)
+{
+   Eina_List *list = NULL;
+#if defined(__linux__)
+   struct statfs st;
+   int fd;
+
+   // Unified hierarchy only, v1 controllers are spread over many mounts.
+   // Hybrid setups mount it below the v1 tmpfs.
+   for (unsigned int i = 0; i < sizeof(cgroup_roots) / sizeof(cgroup_roots[0]); i++)
+     {
+        if ((statfs(cgroup_roots[i], &st) == -1) || (st.f_type != CGROUP2_SUPER_MAGIC))
+          continue;
+
+        fd = open(cgroup_roots[i], O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd == -1) continue;
+
+        cgroup_walk(&list, fd, "", 0);
+        close(fd);
+        break;
+     }
+#endif
+   return list;
+}
+
+void
+cgroup_info_free(Cgroup *cg)
+{
+   free(cg);
+}
@@ -0,0 +1,34 @@
+#ifndef __CGROUPS_H__
+#define __CGROUPS_H__
+
+#include <Eina.h>
+#include <stdint.h>
+#include "enigmatic_visibility.h"
+
+#define CGROUP_PATH_SIZE 1024
+
+typedef struct _Cgroup {
+   char         path[CGROUP_PATH_SIZE];
+
+   uint64_t     cpu_usage;
+   uint64_t     cpu_user;
+   uint64_t     cpu_system;
+   uint64_t     memory_current;
+   uint64_t     io_read;
+   uint64_t     io_write;
+
+   // "some" avg10 stall, in hundredths of a percent.
+   uint32_t     cpu_pressure;
+   uint32_t     memory_pressure;
+   uint32_t     io_pressure;
+
+   int          unique_id;
+} Cgroup;
+
+ENIGMATIC_API Eina_List *
+cgroups_find(void);
+
+ENIGMATIC_API void
+cgroup_info_free(Cgroup *cg);
+
+#endif
@@ -26,6 +26,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <math.h>
+#include <time.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/param.h>
@@ -69,6 +70,7 @@
 #include "macros.h"
 #include "machine.h"
 #include "machine/machine.x"
+#include "machine/sysfs.x"
 #include "machine/cpu.x"
 #include "machine/memory.x"
 #include "machine/sensors.x"
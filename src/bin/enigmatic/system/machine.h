@@ -13,6 +13,19 @@
 
 #define CPUFREQ_INVALID -1
 
+typedef enum
+{
+   CORE_STATE_USER    = 0,
+   CORE_STATE_NICE    = 1,
+   CORE_STATE_SYSTEM  = 2,
+   CORE_STATE_IDLE    = 3,
+   CORE_STATE_IOWAIT  = 4,
+   CORE_STATE_IRQ     = 5,
+   CORE_STATE_SOFTIRQ = 6,
+   CORE_STATE_STEAL   = 7,
+   CORE_STATE_MAX     = 8,
+} Core_State;
+
 typedef struct
 {
    char          name[16];
@@ -24,6 +37,8 @@ typedef struct
    int           freq;
    int           temp;
    int           unique_id;
+   unsigned long states[CORE_STATE_MAX];
+   int8_t        state_percent[CORE_STATE_MAX];
 } Cpu_Core;
 
 #define MEM_VIDEO_CARD_MAX 8
@@ -120,6 +135,10 @@ batteries_update(Eina_List *batteries);
 ENIGMATIC_API void
 battery_update(Battery *bat);
 
+// Close what was kept open to read a battery or sensor no longer there.
+ENIGMATIC_API void
+battery_release(Battery *bat);
+
 // Sensors
 
 ENIGMATIC_API Eina_List *
@@ -131,6 +150,9 @@ sensors_update(Eina_List *sensors);
 ENIGMATIC_API Eina_Bool
 sensor_update(Sensor *sensor);
 
+ENIGMATIC_API void
+sensor_release(Sensor *sensor);
+
 // Network
 
 ENIGMATIC_API Eina_List *
@@ -149,6 +171,15 @@ cores_find(void);
 ENIGMATIC_API void
 cores_update(Eina_List *cores);
 
+ENIGMATIC_API Cpu_Core *
+cores_array_find(int *ncpu);
+
+ENIGMATIC_API void
+cores_array_update(Cpu_Core *cores, int ncpu);
+
+ENIGMATIC_API void
+cores_array_topology(Cpu_Core *cores, int ncpu);
+
 ENIGMATIC_API int
 cores_count(void);
 
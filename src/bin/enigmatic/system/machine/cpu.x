@@ -17,6 +17,12 @@ cores_count(void)
    FILE *f;
    int line = 0;
 
+   // Offline cores are missing from /proc/stat, count every configured one.
+   cores = sysconf(_SC_NPROCESSORS_CONF);
+   if (cores > 0)
+     return cores;
+   cores = 0;
+
    f = fopen("/proc/stat", "r");
    if (!f) return 0;
 
@@ -62,17 +68,120 @@ cores_online_count(void)
 #endif
 }
 
+static int _core_id_frequency(int id, uint32_t tick);
+static int _core_id_temperature(int id, uint32_t tick);
+
+static void
+_core_states_sum(Cpu_Core *core)
+{
+   unsigned long total = 0;
+
+   for (int i = 0; i < CORE_STATE_MAX; i++)
+     total += core->states[i];
+
+   // The total covers every state so each state's share adds up. Usage
+   // leaves iowait out of it (see monitor/cores.c).
+   core->total = total;
+   core->idle = core->states[CORE_STATE_IDLE];
+}
+
+#if defined(__linux__)
+
+static int
+_proc_stat_line_parse(Cpu_Core *cores, int ncpu, const char *s)
+{
+   Cpu_Core *core;
+   unsigned long id;
+   char *e;
+   int i;
+
+   id = strtoul(s, &e, 10);
+   if ((e == s) || (id >= (unsigned long) ncpu))
+     return 0;
+
+   core = &cores[id];
+
+   // Older kernels have fewer columns, those missing are left zero.
+   // guest and guest_nice are already accounted in user and nice.
+   for (i = 0; i < CORE_STATE_MAX; i++)
+     {
+        s = e;
+        core->states[i] = strtoul(s, &e, 10);
+        if (e == s) break;
+     }
+   for (; i < CORE_STATE_MAX; i++)
+     core->states[i] = 0;
+
+   _core_states_sum(core);
+
+   return 1;
+}
+
+// Stream /proc/stat through a fixed buffer. Lines are parsed in place and
+// any partial line is moved to the front for the next read. We stop at the
+// first line that isn't a cpu line, so the rest of the file is never read.
+static int
+_proc_stat_cores_read(Cpu_Core *cores, int ncpu)
+{
+   char buf[16384];
+   char *p, *end, *eol;
+   size_t have = 0;
+   ssize_t n;
+   int fd, found = 0;
+   Eina_Bool done = 0;
+
+   fd = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+   if (fd == -1) return 0;
+
+   // A core left without a line is offline and reads as a zero total.
+   for (int i = 0; i < ncpu; i++)
+     cores[i].total = 0;
+
+   while (!done)
+     {
+        n = read(fd, buf + have, sizeof(buf) - have - 1);
+        if (n <= 0) break;
+
+        have += n;
+        end = buf + have;
+        p = buf;
+
+        while ((eol = memchr(p, '\n', end - p)) != NULL)
+          {
+             *eol = '\0';
+             if (strncmp(p, "cpu", 3))
+               {
+                  done = 1;
+                  break;
+               }
+             if (isdigit((unsigned char) p[3]))
+               found += _proc_stat_line_parse(cores, ncpu, p + 3);
+             p = eol + 1;
+          }
+
+        have = end - p;
+        if (have >= sizeof(buf) - 1) break;
+        memmove(buf, p, have);
+     }
+
+   close(fd);
+
+   return found;
+}
+
+#endif
+
 void
-cores_update(Eina_List *cores)
+cores_array_update(Cpu_Core *cores, int ncpu)
 {
-   unsigned long total, idle;
+   static uint32_t tick = 0;
    Cpu_Core *core;
-   int ncpu = eina_list_count(cores);
-   if (!ncpu) return;
+   int i;
+
+   if ((!cores) || (ncpu <= 0)) return;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__)
    size_t size;
-   int i, j;
 
    size = sizeof(unsigned long) * (CPU_STATES * ncpu);
    unsigned long cpu_times[ncpu][CPU_STATES];
@@ -82,86 +191,47 @@ cores_update(Eina_List *cores)
 
    for (i = 0; i < ncpu; i++)
      {
-        core = eina_list_nth(cores, i);
         unsigned long *cpu = cpu_times[i];
 
-        total = 0;
-        for (j = CP_USER; j <= CP_IDLE; j++)
-          total += cpu[j];
-
-        idle = cpu[CP_IDLE];
-
-        core->total = total;
-        core->idle = idle;
-        core->freq = core_id_frequency(core->id);
-        core->temp = core_id_temperature(core->id);
+        core = &cores[i];
+        memset(core->states, 0, sizeof(core->states));
+        core->states[CORE_STATE_USER] = cpu[CP_USER];
+        core->states[CORE_STATE_NICE] = cpu[CP_NICE];
+        core->states[CORE_STATE_SYSTEM] = cpu[CP_SYS];
+        core->states[CORE_STATE_IRQ] = cpu[CP_INTR];
+        core->states[CORE_STATE_IDLE] = cpu[CP_IDLE];
+        _core_states_sum(core);
      }
 #elif defined(__OpenBSD__)
-   static struct cpustats cpu_times[CPU_STATES];
+   struct cpustats cpu_stats;
    static int cpu_time_mib[] = { CTL_KERN, KERN_CPUSTATS, 0 };
    size_t size;
-   int i, j;
-
-   memset(&cpu_times, 0, CPU_STATES * sizeof(struct cpustats));
 
    for (i = 0; i < ncpu; i++)
      {
-        core = eina_list_nth(cores, i);
+        core = &cores[i];
         size = sizeof(struct cpustats);
         cpu_time_mib[2] = i;
-        if (sysctl(cpu_time_mib, 3, &cpu_times[i], &size, NULL, 0) < 0)
+        memset(&cpu_stats, 0, sizeof(struct cpustats));
+        if (sysctl(cpu_time_mib, 3, &cpu_stats, &size, NULL, 0) < 0)
           return;
 
-        total = 0;
-        for (j = 0; j < CPU_STATES; j++)
-          total += cpu_times[i].cs_time[j];
-
-        idle = cpu_times[i].cs_time[CP_IDLE];
-
-        core->total = total;
-        core->idle = idle;
-        core->freq = core_id_frequency(core->id);
-        core->temp = core_id_temperature(core->id);
+        memset(core->states, 0, sizeof(core->states));
+        core->states[CORE_STATE_USER] = cpu_stats.cs_time[CP_USER];
+        core->states[CORE_STATE_NICE] = cpu_stats.cs_time[CP_NICE];
+        core->states[CORE_STATE_SYSTEM] = cpu_stats.cs_time[CP_SYS] + cpu_stats.cs_time[CP_SPIN];
+        core->states[CORE_STATE_IRQ] = cpu_stats.cs_time[CP_INTR];
+        core->states[CORE_STATE_IDLE] = cpu_stats.cs_time[CP_IDLE];
+        _core_states_sum(core);
      }
 #elif defined(__linux__)
-   char *buf, name[128];
-   int i;
-
-   buf = file_contents("/proc/stat");
-   if (!buf) return;
-
-   for (i = 0; i < ncpu; i++)
-     {
-        core = eina_list_nth(cores, i);
-        snprintf(name, sizeof(name), "cpu%d", i);
-        char *line = strstr(buf, name);
-        if (line)
-          {
-             line = strchr(line, ' ') + 1;
-             unsigned long cpu_times[4] = { 0 };
-
-             if (4 != sscanf(line, "%lu %lu %lu %lu", &cpu_times[0],
-                   &cpu_times[1], &cpu_times[2], &cpu_times[3]))
-               return;
-
-             total = cpu_times[0] + cpu_times[1] + cpu_times[2] + cpu_times[3];
-             idle = cpu_times[3];
-
-             core->total = total;
-             core->idle = idle;
-             core->freq = core_id_frequency(core->id);
-             core->temp = core_id_temperature(core->id);
-          }
-     }
-   free(buf);
+   if (!_proc_stat_cores_read(cores, ncpu))
+     return;
 #elif defined(__MacOS__)
    mach_msg_type_number_t count;
    processor_cpu_load_info_t load;
    mach_port_t mach_port;
    unsigned int cores_count;
-   int i;
-
-   cores_count = eina_list_count(cores);
 
    count = HOST_CPU_LOAD_INFO_COUNT;
    mach_port = mach_host_self();
@@ -169,38 +239,108 @@ cores_update(Eina_List *cores)
                 (processor_info_array_t *)&load, &count) != KERN_SUCCESS)
      exit(-1);
 
+   for (i = 0; (i < ncpu) && (i < (int) cores_count); i++)
+     {
+        core = &cores[i];
+        memset(core->states, 0, sizeof(core->states));
+        core->states[CORE_STATE_USER] = load[i].cpu_ticks[CPU_STATE_USER];
+        core->states[CORE_STATE_NICE] = load[i].cpu_ticks[CPU_STATE_NICE];
+        core->states[CORE_STATE_SYSTEM] = load[i].cpu_ticks[CPU_STATE_SYSTEM];
+        core->states[CORE_STATE_IDLE] = load[i].cpu_ticks[CPU_STATE_IDLE];
+        _core_states_sum(core);
+     }
+   return;
+#endif
+
+   // One tick per pass, cores sharing a sensor input only read it once.
+   if (!++tick) tick = 1;
+
    for (i = 0; i < ncpu; i++)
      {
-        core = eina_list_nth(cores, i);
+        core = &cores[i];
+        // Offline, its cpufreq and topology entries are gone.
+        if (!core->total) continue;
+        core->freq = _core_id_frequency(core->id, tick);
+        core->temp = _core_id_temperature(core->id, tick);
+     }
+}
+
+Cpu_Core *
+cores_array_find(int *ncpu)
+{
+   Cpu_Core *cores;
+   int i, n;
+
+   *ncpu = 0;
+
+   n = cores_count();
+   if (n <= 0) return NULL;
 
-        total = load[i].cpu_ticks[CPU_STATE_USER] +
-           load[i].cpu_ticks[CPU_STATE_SYSTEM] +
-           load[i].cpu_ticks[CPU_STATE_IDLE] +
-           load[i].cpu_ticks[CPU_STATE_NICE];
-        idle = load[i].cpu_ticks[CPU_STATE_IDLE];
+   cores = calloc(n, sizeof(Cpu_Core));
+   if (!cores) return NULL;
 
-        core->total = total;
-        core->idle = idle;
+   for (i = 0; i < n; i++)
+     {
+        cores[i].id = i;
+        snprintf(cores[i].name, sizeof(cores[i].name), "cpu%i", i);
      }
-#endif
+   cores_array_topology(cores, n);
+
+   *ncpu = n;
+
+   return cores;
+}
+
+// The list interface is kept for existing callers. Copy through an array
+// rather than walking the list with eina_list_nth() per core.
+static void
+_cores_list_apply(Eina_List *cores, void (*func)(Cpu_Core *, int))
+{
+   Eina_List *l;
+   Cpu_Core *core, *array;
+   int i, ncpu = eina_list_count(cores);
+
+   if (!ncpu) return;
+
+   array = malloc(ncpu * sizeof(Cpu_Core));
+   if (!array) return;
+
+   i = 0;
+   EINA_LIST_FOREACH(cores, l, core)
+     memcpy(&array[i++], core, sizeof(Cpu_Core));
+
+   func(array, ncpu);
+
+   i = 0;
+   EINA_LIST_FOREACH(cores, l, core)
+     memcpy(core, &array[i++], sizeof(Cpu_Core));
+
+   free(array);
+}
+
+void
+cores_update(Eina_List *cores)
+{
+   _cores_list_apply(cores, cores_array_update);
 }
 
 Eina_List *
 cores_find(void)
 {
    Eina_List *cores = NULL;
-   Cpu_Core *core;
+   Cpu_Core *array, *core;
    int i, ncpu;
 
-   ncpu = cores_count();
+   array = cores_array_find(&ncpu);
    for (i = 0; i < ncpu; i++)
      {
-        core = calloc(1, sizeof(Cpu_Core));
-        core->id = i;
-        snprintf(core->name, sizeof(core->name), "cpu%i", i);
+        core = malloc(sizeof(Cpu_Core));
+        if (!core) break;
+        memcpy(core, &array[i], sizeof(Cpu_Core));
         cores = eina_list_append(cores, core);
      }
-   cores_topology(cores);
+   free(array);
+
    return cores;
 }
 
@@ -208,19 +348,25 @@ static int  _cpu_temp_min = 0;
 static int  _cpu_temp_max = 100;
 static char _core_temps[256][512];
 static char _hwmon_path[256];
+#if defined(__linux__)
+static Sysfs_Attr *_core_temp_attrs[256];
+#endif
 
-int
-_core_n_temperature_read(int n)
+static int
+_core_n_temperature_read(int n, uint32_t tick)
 {
    int temp = THERMAL_INVALID;
 #if defined(__linux__)
+   long value;
 
-   char *b = file_contents(_core_temps[n]);
-   if (b)
-     {
-        temp = atoi(b) / 1000;
-        free(b);
-     }
+   if ((n < 0) || (n >= 256) || (!_core_temps[n][0]))
+     return temp;
+
+   if (!_core_temp_attrs[n])
+     _core_temp_attrs[n] = sysfs_attr_get(_core_temps[n]);
+
+   if (sysfs_attr_long(_core_temp_attrs[n], tick, &value))
+     temp = value / 1000;
 #elif defined(__FreeBSD__) || defined(__DragonFly__)
     int value;
     size_t len = sizeof(value);
@@ -253,6 +399,9 @@ _coretemp_init(void)
    char buf[4096];
    int count = cores_count();
 
+   if (count > 256) count = 256;
+
+   // A core offline now has no topology and is left without a sensor.
    for (int j = 0; j < count; j++)
      {
         snprintf(buf, sizeof(buf), "/sys/devices/system/cpu/cpu%i/topology/core_id", j);
@@ -271,14 +420,16 @@ _generic_init(void)
 {
    int i, count = cores_count();
 
+   if (count > 256) count = 256;
+
    for (i = 0; i < count; i++)
      snprintf(_core_temps[i], sizeof(_core_temps[i]), "%s/temp1_input", _hwmon_path);
 }
 
 #endif
 
-int
-core_id_temperature(int id)
+static int
+_core_id_temperature(int id, uint32_t tick)
 {
 #if defined(__linux__)
    static int init = 0;
@@ -343,7 +494,7 @@ core_id_temperature(int id)
 
    if (!_hwmon_path[0]) return THERMAL_INVALID;
 
-   return _core_n_temperature_read(id);
+   return _core_n_temperature_read(id, tick);
 #elif defined(__FreeBSD__) || defined(__DragonFly__)
    static int init = 0;
 
@@ -353,11 +504,18 @@ core_id_temperature(int id)
         init = 1;
      }
 
-    return _core_n_temperature_read(id);
+    return _core_n_temperature_read(id, tick);
 #endif
+   (void) tick;
    return THERMAL_INVALID;
 }
 
+int
+core_id_temperature(int id)
+{
+   return _core_id_temperature(id, 0);
+}
+
 int
 cores_temperature_min_max(int *min, int *max)
 {
@@ -368,37 +526,60 @@ cores_temperature_min_max(int *min, int *max)
    return 0;
 }
 
-int
-core_id_frequency(int id)
-{
 #if defined(__linux__)
-   int freq = CPUFREQ_INVALID;
-   FILE *f;
-   char buf[4096];
-   int tmp;
 
-   snprintf(buf, sizeof(buf), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", id);
-   f = fopen(buf, "r");
-   if (f)
+static Sysfs_Attr *
+_core_frequency_attr(int id)
+{
+   static Sysfs_Attr **attrs = NULL;
+   static int count = 0;
+   char buf[128];
+
+   if (!attrs)
      {
-        if (fgets(buf, sizeof(buf), f))
-          {
-             tmp = strtol(buf, NULL, 10);
-             if (!((tmp == LONG_MIN || tmp == LONG_MAX) && errno == ERANGE))
-               freq = tmp;
-          }
-        fclose(f);
-        if (freq != CPUFREQ_INVALID) return freq;
+        count = cores_count();
+        if (count <= 0) return NULL;
+        attrs = calloc(count, sizeof(Sysfs_Attr *));
+        if (!attrs) return NULL;
      }
 
-   return freq;
+   if ((id < 0) || (id >= count)) return NULL;
+
+   if (!attrs[id])
+     {
+        snprintf(buf, sizeof(buf), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", id);
+        attrs[id] = sysfs_attr_get(buf);
+     }
+
+   return attrs[id];
+}
+
+#endif
+
+static int
+_core_id_frequency(int id, uint32_t tick)
+{
+#if defined(__linux__)
+   long freq;
+
+   if ((sysfs_attr_long(_core_frequency_attr(id), tick, &freq)) && (freq <= INT_MAX))
+     return freq;
+
+   return CPUFREQ_INVALID;
 #elif defined(__FreeBSD__) || defined(__DragonFly__) || defined(__OpenBSD__)
+   (void) id; (void) tick;
    return cores_frequency();
 #endif
-
+   (void) id; (void) tick;
    return CPUFREQ_INVALID;
 }
 
+int
+core_id_frequency(int id)
+{
+   return _core_id_frequency(id, 0);
+}
+
 int
 cores_frequency_min_max(int *min, int *max)
 {
@@ -502,18 +683,8 @@ cores_frequency(void)
    char buf[4096];
    int tmp;
 
-   f = fopen("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", "r");
-   if (f)
-     {
-        if (fgets(buf, sizeof(buf), f))
-          {
-             tmp = strtol(buf, NULL, 10);
-             if (!((tmp == LONG_MIN || tmp == LONG_MAX) && errno == ERANGE))
-               freq = tmp;
-          }
-        fclose(f);
-        if (freq != CPUFREQ_INVALID) return freq;
-     }
+   freq = core_id_frequency(0);
+   if (freq != CPUFREQ_INVALID) return freq;
 
    f = fopen("/proc/cpuinfo", "r");
    if (!f) return freq;
@@ -559,13 +730,14 @@ _cmp(const void *a, const void *b)
 #endif
 
 void
-cores_topology(Eina_List *cores)
+cores_array_topology(Cpu_Core *cores, int ncpu)
 {
 #if defined(__linux__)
    char buf[4096];
-   int ncpu = eina_list_count(cores);
    core_top_t *cores_top = malloc(ncpu * sizeof(core_top_t));
 
+   if (!cores_top) return;
+
    for (int i = 0; i < ncpu; i++)
      {
         cores_top[i].id = i;
@@ -582,17 +754,17 @@ cores_topology(Eina_List *cores)
    qsort(cores_top, ncpu, sizeof(core_top_t), _cmp);
 
    for (int i = 0; i < ncpu; i++)
-     {
-        Cpu_Core *core = eina_list_nth(cores, i);
-        core->top_id = cores_top[i].id;
-     }
+     cores[i].top_id = cores_top[i].id;
+
    free(cores_top);
 #else
-   Cpu_Core *core;
-   Eina_List *l;
-
-   EINA_LIST_FOREACH(cores, l, core)
-     core->top_id = core->id;
+   for (int i = 0; i < ncpu; i++)
+     cores[i].top_id = cores[i].id;
 #endif
+}
 
+void
+cores_topology(Eina_List *cores)
+{
+   _cores_list_apply(cores, cores_array_topology);
 }
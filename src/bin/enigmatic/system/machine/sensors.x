@@ -2,15 +2,14 @@ Eina_Bool
 sensor_update(Sensor *sensor)
 {
 #if defined(__linux__)
-   char *d = file_contents(sensor->path);
-   if (d)
+   long val;
+
+   if (sysfs_attr_long(sysfs_attr_get(sensor->path), 0, &val))
      {
-        double val = atof(d);
         if (sensor->type == THERMAL)
-          sensor->value = val /= 1000;
+          sensor->value = val / 1000.0;
         else if (sensor->type == FANRPM)
           sensor->value = val;
-        free(d);
         return 1;
      }
    return 0;
@@ -44,6 +43,16 @@ sensor_update(Sensor *sensor)
    return 0;
 }
 
+void
+sensor_release(Sensor *sensor)
+{
+#if defined(__linux__)
+   sysfs_attr_drop(sensor->path);
+#else
+   (void) sensor;
+#endif
+}
+
 Eina_List *
 sensors_find(void)
 {
@@ -395,6 +404,128 @@ batteries_find(void)
    return list;
 }
 
+#if defined(__linux__)
+
+// Which attributes a supply exposes is found once per battery, after that
+// an update is just a pread() of each.
+typedef struct
+{
+   Sysfs_Attr *full;
+   Sysfs_Attr *now;
+   Sysfs_Attr *level;
+   Sysfs_Attr *capacity;
+} Battery_Attrs;
+
+static pthread_mutex_t _battery_lock = PTHREAD_MUTEX_INITIALIZER;
+static Eina_Hash      *_battery_attrs = NULL;
+
+static Battery_Attrs *
+_battery_attrs_find(const char *name)
+{
+   Battery_Attrs *attrs;
+   char path[PATH_MAX];
+   struct dirent *dh;
+   struct stat st;
+   DIR *dir;
+   char *link, *naming = NULL;
+
+   snprintf(path, sizeof(path), "/sys/class/power_supply/%s", name);
+
+   if ((stat(path, &st) < 0) || (!S_ISDIR(st.st_mode)))
+     return NULL;
+
+   link = realpath(path, NULL);
+   if (!link) return NULL;
+
+   attrs = calloc(1, sizeof(Battery_Attrs));
+   if (!attrs)
+     {
+        free(link);
+        return NULL;
+     }
+
+   dir = opendir(link);
+   if (dir)
+     {
+        while ((dh = readdir(dir)) != NULL)
+          {
+             char *e;
+             if (dh->d_name[0] == '.') continue;
+
+             if ((e = strstr(dh->d_name, "_full\0")))
+               {
+                  naming = strndup(dh->d_name, e - dh->d_name);
+                  break;
+               }
+          }
+        closedir(dir);
+     }
+
+   if (naming)
+     {
+        snprintf(path, sizeof(path), "%s/%s_full", link, naming);
+        attrs->full = sysfs_attr_get(path);
+        snprintf(path, sizeof(path), "%s/%s_now", link, naming);
+        attrs->now = sysfs_attr_get(path);
+        free(naming);
+     }
+   else
+     {
+        snprintf(path, sizeof(path), "%s/capacity_level", link);
+        attrs->level = sysfs_attr_get(path);
+        snprintf(path, sizeof(path), "%s/capacity", link);
+        attrs->capacity = sysfs_attr_get(path);
+     }
+
+   free(link);
+
+   return attrs;
+}
+
+static Battery_Attrs *
+_battery_attrs_get(const char *name)
+{
+   Battery_Attrs *attrs;
+
+   pthread_mutex_lock(&_battery_lock);
+
+   if (!_battery_attrs)
+     _battery_attrs = eina_hash_string_superfast_new(free);
+
+   attrs = eina_hash_find(_battery_attrs, name);
+   if (!attrs)
+     {
+        attrs = _battery_attrs_find(name);
+        if (attrs)
+          eina_hash_add(_battery_attrs, name, attrs);
+     }
+
+   pthread_mutex_unlock(&_battery_lock);
+
+   return attrs;
+}
+
+static void
+_battery_attrs_del(const char *name)
+{
+   Battery_Attrs *attrs = NULL;
+
+   pthread_mutex_lock(&_battery_lock);
+   if (_battery_attrs)
+     attrs = eina_hash_find(_battery_attrs, name);
+   if (attrs)
+     {
+        sysfs_attr_close(attrs->full);
+        sysfs_attr_close(attrs->now);
+        sysfs_attr_close(attrs->level);
+        sysfs_attr_close(attrs->capacity);
+        eina_hash_del(_battery_attrs, name, NULL);
+     }
+   pthread_mutex_unlock(&_battery_lock);
+}
+
+#endif
+
 void
 battery_update(Battery *bat)
 {
@@ -452,62 +583,23 @@ battery_update(Battery *bat)
 
    close(fd);
 #elif defined(__linux__)
-   char path[PATH_MAX];
-   struct dirent *dh;
-   struct stat st;
-   DIR *dir;
-   char *buf, *link = NULL, *naming = NULL;
-
-   naming = NULL;
-
-   snprintf(path, sizeof(path), "/sys/class/power_supply/%s", bat->name);
-
-   if ((stat(path, &st) < 0) || (!S_ISDIR(st.st_mode)))
-     return;
-
-   link = realpath(path, NULL);
-   if (!link) return;
+   Battery_Attrs *attrs;
+   char buf[64];
+   long value;
 
-   dir = opendir(path);
-   if (!dir)
-     goto done;
+   attrs = _battery_attrs_get(bat->name);
+   if (!attrs) return;
 
-   while ((dh = readdir(dir)) != NULL)
+   if (attrs->full)
      {
-        char *e;
-        if (dh->d_name[0] == '.') continue;
-
-        if ((e = strstr(dh->d_name, "_full\0")))
-         {
-            naming = strndup(dh->d_name, e - dh->d_name);
-            break;
-         }
-     }
-   closedir(dir);
-
-   if (naming)
-     {
-        snprintf(path, sizeof(path), "%s/%s_full", link, naming);
-        buf = file_contents(path);
-        if (buf)
-          {
-             charge_full = atol(buf);
-             free(buf);
-          }
-        snprintf(path, sizeof(path), "%s/%s_now", link, naming);
-        buf = file_contents(path);
-        if (buf)
-          {
-             charge_current = atol(buf);
-             free(buf);
-          }
-        free(naming);
+        if ((sysfs_attr_long(attrs->full, 0, &value)) && (value > 0))
+          charge_full = value;
+        if (sysfs_attr_long(attrs->now, 0, &value))
+          charge_current = value;
      }
    else
      {
-        snprintf(path, sizeof(path), "%s/capacity_level", link);
-        buf = file_contents(path);
-        if (buf)
+        if (sysfs_attr_read(attrs->level, buf, sizeof(buf)) > 0)
           {
              charge_full = 100;
              if (buf[0] == 'F')
@@ -520,19 +612,17 @@ battery_update(Battery *bat)
                charge_current = 25;
              else if (buf[0] == 'C')
                charge_current = 5;
-             free(buf);
           }
-        snprintf(path, sizeof(path), "%s/capacity", link);
-        buf = file_contents(path);
-        if (buf)
+        if (sysfs_attr_long(attrs->capacity, 0, &value))
           {
              charge_full = 100;
-             charge_current = atoi(buf);
-             free(buf);
+             charge_current = value;
           }
      }
-done:
-   if (link) free(link);
+
+   // Nothing readable, the supply went away. Look it up again next time.
+   if (!charge_full)
+     _battery_attrs_del(bat->name);
 
 #else
 #endif
@@ -546,6 +636,16 @@ done:
       bat->percent = 0;
 }
 
+void
+battery_release(Battery *bat)
+{
+#if defined(__linux__)
+   _battery_attrs_del(bat->name);
+#else
+   (void) bat;
+#endif
+}
+
 Eina_Bool
 power_ac_present(void)
 {
@@ -607,12 +707,10 @@ power_ac_present(void)
 
    if (found)
      {
-        char *buf = file_contents(found);
-        if (buf)
-          {
-             have_ac = atoi(buf);
-             free(buf);
-          }
+        long value;
+
+        if (sysfs_attr_long(sysfs_attr_get(found), 0, &value))
+          have_ac = value;
      }
 #endif
 
@@ -0,0 +1,195 @@
+#if defined(__linux__)
+
+// Open sysfs attributes are kept for the life of the process. Each one is
+// opened once and re-read with pread() at offset zero, so sampling a clock
+// or a sensor costs a single syscall. If the device goes away the read
+// fails (ENODEV or a stale fd) and we reopen by path; paths which can't be
+// opened are only retried every SYSFS_RETRY_SECS.
+
+#define SYSFS_RETRY_SECS 5
+
+typedef struct
+{
+   pthread_mutex_t lock;
+   int             fd;
+   time_t          failed;
+   uint32_t        tick;
+   long            value;
+   char            path[];
+} Sysfs_Attr;
+
+static pthread_mutex_t _sysfs_lock = PTHREAD_MUTEX_INITIALIZER;
+static Eina_Hash      *_sysfs_attrs = NULL;
+
+static time_t
+_sysfs_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ts.tv_sec;
+}
+
+static void
+_sysfs_attr_open(Sysfs_Attr *attr)
+{
+   attr->fd = open(attr->path, O_RDONLY | O_CLOEXEC);
+   if (attr->fd == -1)
+     attr->failed = _sysfs_now();
+}
+
+static void
+_sysfs_attr_free(void *data)
+{
+   Sysfs_Attr *attr = data;
+
+   if (attr->fd != -1)
+     close(attr->fd);
+   pthread_mutex_destroy(&attr->lock);
+   free(attr);
+}
+
+static Sysfs_Attr *
+sysfs_attr_get(const char *path)
+{
+   Sysfs_Attr *attr;
+   size_t len;
+
+   pthread_mutex_lock(&_sysfs_lock);
+
+   if (!_sysfs_attrs)
+     _sysfs_attrs = eina_hash_string_superfast_new(_sysfs_attr_free);
+
+   attr = eina_hash_find(_sysfs_attrs, path);
+   if (!attr)
+     {
+        len = strlen(path) + 1;
+        attr = calloc(1, sizeof(Sysfs_Attr) + len);
+        if (attr)
+          {
+             memcpy(attr->path, path, len);
+             pthread_mutex_init(&attr->lock, NULL);
+             _sysfs_attr_open(attr);
+             eina_hash_add(_sysfs_attrs, attr->path, attr);
+          }
+     }
+
+   pthread_mutex_unlock(&_sysfs_lock);
+
+   return attr;
+}
+
+// Called with attr->lock held.
+static ssize_t
+_sysfs_attr_read(Sysfs_Attr *attr, char *buf, size_t size)
+{
+   ssize_t n = -1;
+
+   if ((attr->fd == -1) && ((_sysfs_now() - attr->failed) >= SYSFS_RETRY_SECS))
+     _sysfs_attr_open(attr);
+
+   if (attr->fd != -1)
+     {
+        n = pread(attr->fd, buf, size - 1, 0);
+        if ((n < 0) && ((errno == ENODEV) || (errno == ESTALE) || (errno == EBADF)))
+          {
+             close(attr->fd);
+             _sysfs_attr_open(attr);
+             if (attr->fd != -1)
+               n = pread(attr->fd, buf, size - 1, 0);
+          }
+     }
+
+   if (n < 0) return -1;
+
+   if ((n > 0) && (buf[n - 1] == '\n'))
+     n--;
+   buf[n] = '\0';
+
+   return n;
+}
+
+static ssize_t
+sysfs_attr_read(Sysfs_Attr *attr, char *buf, size_t size)
+{
+   ssize_t n;
+
+   if ((!attr) || (size < 2)) return -1;
+
+   pthread_mutex_lock(&attr->lock);
+   n = _sysfs_attr_read(attr, buf, size);
+   pthread_mutex_unlock(&attr->lock);
+
+   return n;
+}
+
+// Read an integer attribute. Callers sampling many attributes in one pass
+// can pass a non-zero tick, an attribute shared by several readers (one
+// hwmon input for all cores, say) is then read once for that tick. The
+// sensor, battery and core threads share attributes, the cached value is
+// only touched under the attribute's lock.
+static Eina_Bool
+sysfs_attr_long(Sysfs_Attr *attr, uint32_t tick, long *value)
+{
+   char buf[64];
+   char *end;
+   long v;
+   Eina_Bool ok = 0;
+
+   if (!attr) return 0;
+
+   pthread_mutex_lock(&attr->lock);
+
+   if ((tick) && (attr->tick == tick))
+     {
+        *value = attr->value;
+        ok = 1;
+     }
+   else if (_sysfs_attr_read(attr, buf, sizeof(buf)) > 0)
+     {
+        errno = 0;
+        v = strtol(buf, &end, 10);
+        if ((end != buf) && (errno != ERANGE))
+          {
+             attr->value = *value = v;
+             attr->tick = tick;
+             ok = 1;
+          }
+     }
+
+   pthread_mutex_unlock(&attr->lock);
+
+   return ok;
+}
+
+// A device went away, give up its descriptor. The attribute itself stays,
+// others may still hold it, and is reopened by path should it come back.
+static void
+sysfs_attr_close(Sysfs_Attr *attr)
+{
+   if (!attr) return;
+
+   pthread_mutex_lock(&attr->lock);
+   if (attr->fd != -1)
+     close(attr->fd);
+   attr->fd = -1;
+   attr->failed = _sysfs_now();
+   attr->tick = 0;
+   pthread_mutex_unlock(&attr->lock);
+}
+
+static void
+sysfs_attr_drop(const char *path)
+{
+   Sysfs_Attr *attr = NULL;
+
+   pthread_mutex_lock(&_sysfs_lock);
+   if (_sysfs_attrs)
+     attr = eina_hash_find(_sysfs_attrs, path);
+   pthread_mutex_unlock(&_sysfs_lock);
+
+   sysfs_attr_close(attr);
+}
+
+#endif
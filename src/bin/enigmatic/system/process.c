@@ -54,12 +54,16 @@
 #if defined(__linux__)
 #include <stddef.h>
 #include <dirent.h>
+#include <errno.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <linux/inet_diag.h>
 #include <linux/sock_diag.h>
 #include <linux/tcp.h>
 #include <linux/rtnetlink.h>
+#include <linux/genetlink.h>
+#include <linux/taskstats.h>
 #endif
 
 #include "macros.h"
@@ -282,6 +286,7 @@ typedef struct {
     char state;
     unsigned int mem_rss, flags;
     unsigned long mem_virt;
+    unsigned long long delay_blkio;
     char name[1024];
 } Stat;
 
@@ -313,12 +318,12 @@ _stat(const char *path, Stat *st) {
         len = sscanf(state,
                      "%c %d %d %d %d %d %u %u %u %u %u %d %d %d"
                      " %d %d %d %u %u %lld %lu %u %u %u %u %u %u %u %d %d %d %d %u"
-                     " %d %d %d %d %d %d %d %d %d",
+                     " %d %d %d %d %d %d %llu %d %d",
                      &st->state, &st->ppid, &dummy, &dummy, &dummy, &dummy, &st->flags, &dummy, &dummy, &dummy, &dummy,
                      &st->utime, &st->stime, &st->cutime, &st->cstime, &st->pri, &st->nice, &st->numthreads, &dummy,
                      &st->start_time, &st->mem_virt, &st->mem_rss, &dummy, &dummy, &dummy, &dummy, &dummy, &dummy,
-                     &dummy, &dummy, &dummy, &dummy, &dummy, &dummy, &dummy, &dummy, &st->psr, &dummy, &dummy, &dummy,
-                     &dummy, &dummy);
+                     &dummy, &dummy, &dummy, &dummy, &dummy, &dummy, &dummy, &dummy, &st->psr, &dummy, &dummy,
+                     &st->delay_blkio, &dummy, &dummy);
 
         snprintf(st->name, sizeof(st->name), "%.*s", (int) (rparen - lparen - 1), lparen + 1);
     }
@@ -331,6 +336,8 @@ _stat(const char *path, Stat *st) {
     st->start_time /= tck;
     st->start_time += boot_time;
     st->run_time = (st->utime + st->stime) / tck;
+    // delayacct_blkio_ticks, kept in nanoseconds like taskstats.
+    st->delay_blkio = (st->delay_blkio * 1000000000ULL) / tck;
 
     return 1;
 }
@@ -687,54 +694,257 @@ _linux_process_network_usage_apply(Proc_Info *p, Eina_Hash *by_pid)
     p->net_in = stat->in;
     p->net_out = stat->out;
 }
-#endif
 
-static uint64_t
-_disk_write_get(pid_t pid) {
-    FILE *f;
-    char path[PATH_MAX];
+// Optional taskstats (generic netlink) backend. Delay accounting is only
+// exposed here and per thread I/O is not in procfs without a walk of every
+// task's io file. Requests are pipelined in batches on one socket per scan.
+// Querying requires CAP_NET_ADMIN, without it we stay on procfs for good.
+
+#define TASKSTATS_BATCH 64
+
+static int _taskstats_family = 0;
+
+static void *
+_linux_nla_find(void *data, int len, uint16_t type, int *payload_len) {
+    struct nlattr *na = data;
+
+    while ((len >= NLA_HDRLEN) && (na->nla_len >= NLA_HDRLEN) && (na->nla_len <= len)) {
+        if ((na->nla_type & NLA_TYPE_MASK) == type) {
+            *payload_len = na->nla_len - NLA_HDRLEN;
+            return (char *) na + NLA_HDRLEN;
+        }
+        len -= NLA_ALIGN(na->nla_len);
+        na = (struct nlattr *) ((char *) na + NLA_ALIGN(na->nla_len));
+    }
+
+    return NULL;
+}
+
+static Eina_Bool
+_linux_taskstats_send(int fd, uint16_t type, uint8_t cmd, uint16_t attr, const void *data, int data_len,
+                      uint32_t seq) {
+    struct {
+        struct nlmsghdr n;
+        struct genlmsghdr g;
+        char buf[64];
+    } req;
+    struct nlattr *na;
+    struct sockaddr_nl addr;
+    ssize_t sent;
+
+    if (data_len > (int) (sizeof(req.buf) - NLA_HDRLEN)) return 0;
+
+    memset(&req, 0, sizeof(req));
+    req.n.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+    req.n.nlmsg_type = type;
+    req.n.nlmsg_flags = NLM_F_REQUEST;
+    req.n.nlmsg_seq = seq;
+    req.g.cmd = cmd;
+    req.g.version = 1;
+
+    na = (struct nlattr *) ((char *) &req + NLMSG_ALIGN(req.n.nlmsg_len));
+    na->nla_type = attr;
+    na->nla_len = NLA_HDRLEN + data_len;
+    memcpy((char *) na + NLA_HDRLEN, data, data_len);
+    req.n.nlmsg_len = NLMSG_ALIGN(req.n.nlmsg_len) + NLA_ALIGN(na->nla_len);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+
+    sent = sendto(fd, &req, req.n.nlmsg_len, 0, (struct sockaddr *) &addr, sizeof(addr));
+
+    return sent == (ssize_t) req.n.nlmsg_len;
+}
+
+static int
+_linux_taskstats_family_get(int fd) {
+    struct nlmsghdr *nlh;
     char buf[4096];
-    uint64_t write_bytes = 0;
+    uint16_t *id;
+    ssize_t len;
+    int id_len;
 
-    snprintf(path, sizeof(path), "/proc/%d/io", pid);
-    f = fopen(path, "r");
-    if (!f) return 0;
+    if (!_linux_taskstats_send(fd, GENL_ID_CTRL, CTRL_CMD_GETFAMILY, CTRL_ATTR_FAMILY_NAME, TASKSTATS_GENL_NAME,
+                               sizeof(TASKSTATS_GENL_NAME), 0))
+        return -1;
 
-    while (fgets(buf, sizeof(buf), f)) {
-        unsigned long long value = 0;
-        if (sscanf(buf, "write_bytes: %llu", &value) == 1) {
-            write_bytes = value;
-            break;
+    len = recv(fd, buf, sizeof(buf), 0);
+    if (len <= 0) return -1;
+
+    nlh = (struct nlmsghdr *) buf;
+    if (!NLMSG_OK(nlh, len) || (nlh->nlmsg_type == NLMSG_ERROR)) return -1;
+    if (nlh->nlmsg_len < NLMSG_LENGTH(GENL_HDRLEN)) return -1;
+
+    id = _linux_nla_find((char *) NLMSG_DATA(nlh) + GENL_HDRLEN, nlh->nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN),
+                         CTRL_ATTR_FAMILY_ID, &id_len);
+    if (!id || (id_len < (int) sizeof(uint16_t))) return -1;
+
+    return *id;
+}
+
+static int
+_linux_taskstats_open(void) {
+    struct sockaddr_nl addr;
+    struct timeval tv = { 1, 0 };
+    int fd;
+
+    if (_taskstats_family < 0) return -1;
+
+    fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC);
+    if (fd < 0) return -1;
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    if (!_taskstats_family) {
+        _taskstats_family = _linux_taskstats_family_get(fd);
+        if (_taskstats_family <= 0) {
+            _taskstats_family = -1;
+            close(fd);
+            return -1;
         }
     }
 
-    fclose(f);
+    return fd;
+}
+
+static Eina_Bool
+_linux_taskstats_reply_parse(struct nlmsghdr *nlh, struct taskstats *out) {
+    void *aggr, *stats;
+    int len, aggr_len, stats_len;
+
+    if (nlh->nlmsg_len < NLMSG_LENGTH(GENL_HDRLEN)) return 0;
+
+    len = nlh->nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN);
+    aggr = _linux_nla_find((char *) NLMSG_DATA(nlh) + GENL_HDRLEN, len, TASKSTATS_TYPE_AGGR_TGID, &aggr_len);
+    if (!aggr) aggr = _linux_nla_find((char *) NLMSG_DATA(nlh) + GENL_HDRLEN, len, TASKSTATS_TYPE_AGGR_PID, &aggr_len);
+    if (!aggr) return 0;
+
+    stats = _linux_nla_find(aggr, aggr_len, TASKSTATS_TYPE_STATS, &stats_len);
+    if (!stats) return 0;
 
-    return write_bytes;
+    // Kernel and header struct versions may differ, copy what overlaps.
+    memset(out, 0, sizeof(*out));
+    memcpy(out, stats, stats_len < (int) sizeof(*out) ? stats_len : (int) sizeof(*out));
+
+    return 1;
+}
+
+static void
+_linux_taskstats_apply(Proc_Info **procs, int n, Eina_Bool threads) {
+    char buf[16384];
+    struct nlmsghdr *nlh;
+    struct taskstats stats;
+    uint16_t attr;
+    ssize_t len;
+    int fd;
+
+    if ((!procs) || (n <= 0)) return;
+
+    fd = _linux_taskstats_open();
+    if (fd < 0) return;
+
+    attr = threads ? TASKSTATS_CMD_ATTR_PID : TASKSTATS_CMD_ATTR_TGID;
+
+    for (int base = 0; base < n; base += TASKSTATS_BATCH) {
+        int count = (n - base) < TASKSTATS_BATCH ? (n - base) : TASKSTATS_BATCH;
+        int pending = 0;
+
+        for (int i = 0; i < count; i++) {
+            uint32_t id = threads ? procs[base + i]->tid : procs[base + i]->pid;
+            // Sequence numbers map replies back to their slot, 0 is the family lookup.
+            if (_linux_taskstats_send(fd, _taskstats_family, TASKSTATS_CMD_GET, attr, &id, sizeof(id), base + i + 1))
+                pending++;
+        }
+
+        while (pending > 0) {
+            len = recv(fd, buf, sizeof(buf), 0);
+            if (len <= 0) goto done;
+
+            for (nlh = (struct nlmsghdr *) buf; NLMSG_OK(nlh, len); nlh = NLMSG_NEXT(nlh, len)) {
+                Proc_Info *p;
+                uint32_t seq = nlh->nlmsg_seq;
+
+                if ((seq <= (uint32_t) base) || (seq > (uint32_t) (base + count))) continue;
+                pending--;
+
+                if (nlh->nlmsg_type == NLMSG_ERROR) {
+                    struct nlmsgerr *err = NLMSG_DATA(nlh);
+                    // Exited tasks give ESRCH, anything else means no access.
+                    if (err->error != -ESRCH) {
+                        _taskstats_family = -1;
+                        goto done;
+                    }
+                    continue;
+                }
+
+                if (!_linux_taskstats_reply_parse(nlh, &stats)) continue;
+
+                p = procs[seq - 1];
+                p->delay_cpu = stats.cpu_delay_total;
+                p->delay_blkio = stats.blkio_delay_total;
+                p->delay_swap = stats.swapin_delay_total;
+                // Per tgid replies do not sum I/O over live threads, procfs does.
+                if (threads) {
+                    p->disk_read = stats.read_bytes;
+                    p->disk_write = stats.write_bytes;
+                }
+            }
+        }
+    }
+done:
+    close(fd);
+}
+
+static void
+_linux_taskstats_list_apply(Eina_List *list, Eina_Bool threads) {
+    Proc_Info **procs, *p;
+    Eina_List *l;
+    int n, i = 0;
+
+    if (_taskstats_family < 0) return;
+
+    n = eina_list_count(list);
+    if (!n) return;
+
+    procs = malloc(n * sizeof(Proc_Info *));
+    if (!procs) return;
+
+    EINA_LIST_FOREACH(list, l, p) procs[i++] = p;
+    _linux_taskstats_apply(procs, n, threads);
+
+    free(procs);
 }
+#endif
 
-static uint64_t
-_disk_read_get(pid_t pid) {
+static void
+_disk_io_get(Proc_Info *p) {
     FILE *f;
-    char path[PATH_MAX];
     char buf[4096];
-    uint64_t read_bytes = 0;
+    int found = 0;
 
-    snprintf(path, sizeof(path), "/proc/%d/io", pid);
-    f = fopen(path, "r");
-    if (!f) return 0;
+    snprintf(buf, sizeof(buf), "/proc/%d/io", p->pid);
+    f = fopen(buf, "r");
+    if (!f) return;
 
-    while (fgets(buf, sizeof(buf), f)) {
+    while ((found < 2) && (fgets(buf, sizeof(buf), f))) {
         unsigned long long value = 0;
         if (sscanf(buf, "read_bytes: %llu", &value) == 1) {
-            read_bytes = value;
-            break;
+            p->disk_read = value;
+            found++;
+        } else if (sscanf(buf, "write_bytes: %llu", &value) == 1) {
+            p->disk_write = value;
+            found++;
         }
     }
 
     fclose(f);
-
-    return read_bytes;
 }
 
 static Eina_List *
@@ -797,8 +1007,8 @@ _process_list_linux_get(void) {
         _mem_size(p);
         _cmd_args(p, st.name, sizeof(st.name));
         _linux_process_network_usage_apply(p, proc_net_hash);
-        p->disk_read = _disk_read_get(pid);
-        p->disk_write = _disk_write_get(pid);
+        _disk_io_get(p);
+        p->delay_blkio = st.delay_blkio;
 
         Eina_List *next = eina_list_append(list, p);
         if (!next) {
@@ -811,6 +1021,7 @@ _process_list_linux_get(void) {
 #if defined(__linux__)
     if (proc_net_hash) eina_hash_free(proc_net_hash);
     _linux_process_network_usage_free(proc_net, proc_net_count);
+    _linux_taskstats_list_apply(list, 0);
 #endif
 
     return list;
@@ -847,6 +1058,7 @@ _proc_thread_info(Proc_Info *p) {
         t->net_out = 0;
         t->disk_read = 0;
         t->disk_write = 0;
+        t->delay_blkio = st.delay_blkio;
 
         t->tid = tid;
         t->thread_name = strdup(st.name);
@@ -862,6 +1074,8 @@ _proc_thread_info(Proc_Info *p) {
         }
         p->threads = next;
     }
+
+    _linux_taskstats_list_apply(p->threads, 1);
 }
 
 Proc_Info *
@@ -906,8 +1120,9 @@ proc_info_by_pid(pid_t pid) {
         }
         _linux_process_network_usage_free(proc_net, proc_net_count);
     }
-    p->disk_read = _disk_read_get(pid);
-    p->disk_write = _disk_write_get(pid);
+    _disk_io_get(p);
+    p->delay_blkio = st.delay_blkio;
+    _linux_taskstats_apply(&p, 1, 0);
 
     _proc_thread_info(p);
 
@@ -33,6 +33,14 @@ typedef struct _Proc_Info
    uint64_t    net_out_raw;
    uint64_t    disk_read;
    uint64_t    disk_write;
+   // Bytes per second over the daemon's last poll interval.
+   uint64_t    net_in_rate;
+   uint64_t    net_out_rate;
+   uint64_t    disk_read_rate;
+   uint64_t    disk_write_rate;
+   uint64_t    delay_cpu;
+   uint64_t    delay_blkio;
+   uint64_t    delay_swap;
 
    char       *command;
    char       *arguments;
@@ -81,6 +89,14 @@ typedef struct _Proc_Info_Log
    uint64_t    net_out;
    uint64_t    disk_read;
    uint64_t    disk_write;
+   // Bytes per second over the daemon's last poll interval.
+   uint64_t    net_in_rate;
+   uint64_t    net_out_rate;
+   uint64_t    disk_read_rate;
+   uint64_t    disk_write_rate;
+   uint64_t    delay_cpu;
+   uint64_t    delay_blkio;
+   uint64_t    delay_swap;
 
    char        command[PROC_INFO_LOG_COMMAND_SIZE];
    char        arguments[PROC_INFO_LOG_ARGUMENTS_SIZE];
@@ -101,6 +117,26 @@ typedef struct _Proc_Info_Log
    char        path[PROC_INFO_LOG_PATH_SIZE];
 } Proc_Info_Log;
 
+// One process' history as parallel arrays, one entry per recorded block.
+// I/O columns are the raw cumulative counters.
+typedef struct _Proc_Info_Series
+{
+   pid_t       pid;
+   int64_t     start;
+   uint32_t    count;
+   uint32_t    size;
+
+   uint32_t   *time;
+   double     *cpu_usage;
+   uint64_t   *mem_rss;
+   int32_t    *numthreads;
+   int32_t    *fds_count;
+   uint64_t   *disk_read;
+   uint64_t   *disk_write;
+   uint64_t   *net_in;
+   uint64_t   *net_out;
+} Proc_Info_Series;
+
 Eina_List *
 proc_info_all_get(void);
 
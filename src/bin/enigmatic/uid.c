@@ -1,48 +1,64 @@
 #include "uid.h"
 
 int
-unique_id_find(Eina_List **list)
+unique_id_find(Unique_Ids *ids)
 {
-   Eina_List *l;
-   uid *id;
-   int next_available = 0;
+   int id;
 
-   EINA_LIST_FOREACH(*list, l, id)
+   if (ids->released_count)
      {
-        if (id->available)
-          {
-             id->available = 0;
-             return id->id;
-          }
-        next_available = id->id + 1;
+        id = ids->released[--ids->released_count];
+        ids->used[id] = 1;
+        return id;
      }
 
-   id = malloc(sizeof(uid));
-   EINA_SAFETY_ON_NULL_RETURN_VAL(id, -1);
+   if (ids->next == ids->size)
+     {
+        Eina_Bool *used;
+        int size = ids->size ? ids->size * 2 : 64;
+
+        used = realloc(ids->used, size * sizeof(Eina_Bool));
+        EINA_SAFETY_ON_NULL_RETURN_VAL(used, -1);
+        memset(used + ids->size, 0, (size - ids->size) * sizeof(Eina_Bool));
+        ids->used = used;
+        ids->size = size;
+     }
 
-   id->id = next_available;
-   id->available = 0;
-   *list = eina_list_append(*list, id);
+   id = ids->next++;
+   ids->used[id] = 1;
 
-   return id->id;
+   return id;
 }
 
 void
-unique_id_release(Eina_List **list, int id)
+unique_id_release(Unique_Ids *ids, int id)
 {
-   Eina_List *l;
-   uid *eid;
+   if ((id < 0) || (id >= ids->next))
+     {
+        fprintf(stderr, "AINT NOBODY GOT TIME FOR THAT!\n");
+        exit(2);
+     }
 
-   EINA_LIST_FOREACH(*list, l, eid)
+   // Releasing twice is harmless, but must not stack the id twice.
+   if (!ids->used[id]) return;
+
+   // Every id below next fits on the stack, so it only grows with size.
+   if (ids->released_size < ids->size)
      {
-        if (eid->id == id)
-          {
-             eid->available = 1;
-             return;
-          }
+        int *released = realloc(ids->released, ids->size * sizeof(int));
+        EINA_SAFETY_ON_NULL_RETURN(released);
+        ids->released = released;
+        ids->released_size = ids->size;
      }
 
-   fprintf(stderr, "AINT NOBODY GOT TIME FOR THAT!\n");
-   exit(2);
+   ids->used[id] = 0;
+   ids->released[ids->released_count++] = id;
 }
 
+void
+unique_ids_free(Unique_Ids *ids)
+{
+   free(ids->released);
+   free(ids->used);
+   memset(ids, 0, sizeof(Unique_Ids));
+}
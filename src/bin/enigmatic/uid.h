@@ -3,16 +3,25 @@
 
 #include <Eina.h>
 
+// Released ids are kept on a stack and handed out again before new ones,
+// so finding and releasing an id are both constant time.
 typedef struct
 {
-   int       id;
-   Eina_Bool available;
-} uid;
+   int       *released;
+   int        released_count;
+   int        released_size;
+   Eina_Bool *used;
+   int        size;
+   int        next;
+} Unique_Ids;
 
 int
-unique_id_find(Eina_List **list);
+unique_id_find(Unique_Ids *ids);
 
 void
-unique_id_release(Eina_List **list, int id);
+unique_id_release(Unique_Ids *ids, int id);
+
+void
+unique_ids_free(Unique_Ids *ids);
 
 #endif
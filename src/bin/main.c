@@ -93,7 +93,6 @@ elm_main(int argc, char **argv) {
 
     evisum_server_init(ui);
     evisum_background_init(ui);
-    ui->background_poll_thread = ecore_thread_run(evisum_background_poller, NULL, NULL, ui);
     evisum_ui_activate(ui, action, pid);
 
     ecore_main_loop_begin();
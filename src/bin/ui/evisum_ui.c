@@ -814,8 +814,6 @@ void
 evisum_ui_shutdown(Evisum_Ui *ui) {
     evisum_ui_config_save(ui);
 
-    ecore_thread_cancel(ui->background_poll_thread);
-    ecore_thread_wait(ui->background_poll_thread, 0.5);
     evisum_background_shutdown(ui);
     evisum_engine_shutdown();
 
@@ -73,8 +73,7 @@ _evisum_ui_cpu_win_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA
     Evisum_Ui *ui = pd->ui;
 
     evisum_ui_config_save(ui);
-    ecore_thread_cancel(pd->thread);
-    ecore_thread_wait(pd->thread, 0.5);
+    evisum_engine_unsubscribe(pd->sub, EINA_TRUE);
 
     if (pd->ext_free_cb) pd->ext_free_cb(pd->ext);
 
@@ -125,6 +124,7 @@ evisum_ui_cpu_win_add(Evisum_Ui *ui) {
 
     ui->cpu.win = win = elm_win_util_standard_add("evisum", _("CPU Activity"));
     elm_win_autodel_set(win, 1);
+    evisum_ui_win_visibility_track(win);
     evas_object_size_hint_weight_set(win, EXPAND, EXPAND);
     evas_object_size_hint_align_set(win, FILL, FILL);
 
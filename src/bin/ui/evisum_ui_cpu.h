@@ -14,7 +14,7 @@ typedef struct {
 
 typedef struct {
     Evisum_Ui *ui;
-    Ecore_Thread *thread;
+    Evisum_Engine_Subscription *sub;
 
     Evas_Object *menu;
     Evas_Object *win;
@@ -1,7 +1,7 @@
 #include "evisum_ui_disk.h"
 #include "evisum_ui_graph.h"
+#include "evisum_ui_graph_lod.h"
 #include "../engine/evisum_engine.h"
-#include "../background/evisum_background.h"
 #include "config.h"
 #include "evisum_ui_colors.h"
 
@@ -12,9 +12,12 @@ typedef struct {
     Evas_Object *graph_bg;
     Evas_Object *graph_img;
     Evas_Object *legend_tb;
-    Ecore_Thread *thread;
-    Eina_Bool skip_wait;
+    Evas_Object *device_tb;
+    Evisum_Engine_Subscription *sub;
     Eina_List *history;
+    Eina_List *devices;
+    Evisum_Ui_Graph_Backfill *backfill;
+    int mode;
     Eina_Bool btn_visible;
 
     Evisum_Ui *ui;
@@ -30,8 +33,7 @@ typedef struct {
     uint8_t color_r;
     uint8_t color_g;
     uint8_t color_b;
-    double history[DISK_GRAPH_SAMPLES];
-    int history_count;
+    Evisum_Ui_Graph_Lod *lod;
     Eina_Bool seen;
     Eina_Bool enabled;
     Evisum_Ui_Disk_View *view;
@@ -42,6 +44,47 @@ typedef struct {
     Evas_Object *legend_pb;
 } Disk_History;
 
+typedef enum {
+    DISK_GRAPH_USAGE = 0,
+    DISK_GRAPH_THROUGHPUT = 1,
+    DISK_GRAPH_IOPS = 2,
+    DISK_GRAPH_UTILISATION = 3,
+} Disk_Graph_Mode;
+
+// Rates are taken between samples, over the time between them as recorded.
+typedef struct {
+    char name[BLOCK_DEVICE_NAME_SIZE];
+    uint8_t color_r;
+    uint8_t color_g;
+    uint8_t color_b;
+    Block_Device last;
+    uint32_t last_time;
+    Eina_Bool have_last;
+    Evisum_Ui_Graph_Lod *bytes;
+    Evisum_Ui_Graph_Lod *iops;
+    Evisum_Ui_Graph_Lod *util;
+    Eina_Bool seen;
+    Eina_Bool enabled;
+    Evisum_Ui_Disk_View *view;
+    Evas_Object *legend_row;
+    Evas_Object *legend_btn;
+    Evas_Object *legend_swatch;
+    Evas_Object *legend_label;
+    Evas_Object *legend_stats;
+} Disk_Device_History;
+
+typedef struct {
+    Eina_List *mounted;
+    Eina_List *devices;
+    uint32_t time;
+} Disk_Update;
+
+typedef struct {
+    Evisum_Ui_Graph_Backfill *backfill;
+    Eina_Hash *last;
+    uint32_t last_time;
+} Disk_Backfill;
+
 static void _evisum_ui_disk_graph_redraw(Evisum_Ui_Disk_View *view);
 static const Evisum_Ui_Graph_Layer _disk_layers[] = {
     { -0.6, 0.24 },
@@ -99,12 +142,31 @@ _evisum_ui_disk_history_legend_repack(Evisum_Ui_Disk_View *view) {
 }
 
 static void
-_evisum_ui_disk_history_add_sample(Disk_History *entry, double value) {
-    if (entry->history_count < DISK_GRAPH_SAMPLES) entry->history[entry->history_count++] = value;
-    else {
-        memmove(&entry->history[0], &entry->history[1], sizeof(double) * (DISK_GRAPH_SAMPLES - 1));
-        entry->history[DISK_GRAPH_SAMPLES - 1] = value;
-    }
+_evisum_ui_disk_samples_push(Evisum_Ui_Disk_View *view, Evisum_Ui_Graph_Lod **lod, const char *key, double value) {
+    if (!*lod) *lod = evisum_ui_graph_backfill_lod_new(view->backfill, key, NULL);
+    evisum_ui_graph_lod_push(*lod, value);
+}
+
+static void
+_evisum_ui_disk_history_add_sample(Evisum_Ui_Disk_View *view, Disk_History *entry, double value) {
+    _evisum_ui_disk_samples_push(view, &entry->lod, entry->key, value);
+}
+
+static const char *
+_evisum_ui_disk_device_key(char *buf, size_t size, const char *name, const char *what) {
+    snprintf(buf, size, "%s:%s", name, what);
+    return buf;
+}
+
+static double
+_evisum_ui_disk_used_percent(const File_System *fs) {
+    double used_percent = 0.0;
+
+    if (fs->usage.total) used_percent = ((double) fs->usage.used / (double) fs->usage.total) * 100.0;
+    if (used_percent < 0.0) used_percent = 0.0;
+    if (used_percent > 100.0) used_percent = 100.0;
+
+    return used_percent;
 }
 
 static void
@@ -174,6 +236,15 @@ _evisum_ui_disk_history_legend_del(Disk_History *entry) {
     entry->legend_pb = NULL;
 }
 
+static void
+_evisum_ui_disk_history_free(Disk_History *entry) {
+    _evisum_ui_disk_history_legend_del(entry);
+    evisum_ui_graph_lod_free(entry->lod);
+    free(entry->name);
+    free(entry->key);
+    free(entry);
+}
+
 static void
 _evisum_ui_disk_history_legend_update(Disk_History *entry, double used_percent, int64_t used, int64_t total) {
     if (!entry->legend_pb || !entry->legend_label) return;
@@ -245,10 +316,7 @@ _evisum_ui_disk_history_compact(Evisum_Ui_Disk_View *view) {
     EINA_LIST_FOREACH_SAFE(view->history, l, l2, entry) {
         if (entry->seen) continue;
         view->history = eina_list_remove_list(view->history, l);
-        _evisum_ui_disk_history_legend_del(entry);
-        free(entry->name);
-        free(entry->key);
-        free(entry);
+        _evisum_ui_disk_history_free(entry);
     }
 
     _evisum_ui_disk_history_legend_repack(view);
@@ -259,42 +327,277 @@ _evisum_ui_disk_history_reset(Evisum_Ui_Disk_View *view) {
     Eina_List *l;
     Disk_History *entry;
 
-    EINA_LIST_FOREACH(view->history, l, entry) {
-        entry->history_count = 0;
-        memset(entry->history, 0, sizeof(entry->history));
+    EINA_LIST_FOREACH(view->history, l, entry)
+    evisum_ui_graph_lod_clear(entry->lod);
+}
+
+static void
+_evisum_ui_disk_device_toggle_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED) {
+    Disk_Device_History *dev = data;
+
+    if (!dev || !dev->view || !dev->legend_swatch) return;
+    if (!_evisum_ui_disk_graph_objects_valid(dev->view)) return;
+
+    dev->enabled = !dev->enabled;
+    if (dev->enabled) evas_object_show(dev->legend_swatch);
+    else evas_object_hide(dev->legend_swatch);
+    _evisum_ui_disk_graph_redraw(dev->view);
+}
+
+static void
+_evisum_ui_disk_device_legend_repack(Evisum_Ui_Disk_View *view) {
+    Eina_List *l;
+    Disk_Device_History *dev;
+    int row = 0;
+
+    if (!view->device_tb) return;
+
+    elm_table_clear(view->device_tb, 0);
+
+    EINA_LIST_FOREACH(view->devices, l, dev) {
+        if (!dev->legend_row || !dev->legend_stats) continue;
+        elm_table_pack(view->device_tb, dev->legend_row, 0, row, 1, 1);
+        elm_table_pack(view->device_tb, dev->legend_stats, 1, row, 1, 1);
+        evas_object_show(dev->legend_row);
+        evas_object_show(dev->legend_stats);
+        row++;
+    }
+}
+
+static void
+_evisum_ui_disk_device_legend_add(Evisum_Ui_Disk_View *view, Disk_Device_History *dev) {
+    Evas_Object *left, *swatch, *lb, *btn;
+
+    if (!view->device_tb || dev->legend_row) return;
+
+    left = elm_box_add(view->device_tb);
+    elm_box_horizontal_set(left, EINA_TRUE);
+    elm_box_padding_set(left, 4 * elm_config_scale_get(), 0);
+    evas_object_size_hint_weight_set(left, EVAS_HINT_EXPAND, 0.0);
+    evas_object_size_hint_align_set(left, EVAS_HINT_FILL, 0.5);
+    evas_object_show(left);
+
+    btn = elm_button_add(left);
+    evas_object_size_hint_min_set(btn, 16 * elm_config_scale_get(), 16 * elm_config_scale_get());
+    evas_object_size_hint_max_set(btn, 16 * elm_config_scale_get(), 16 * elm_config_scale_get());
+    evas_object_size_hint_align_set(btn, 0.0, 0.5);
+    evas_object_show(btn);
+    evas_object_smart_callback_add(btn, "clicked", _evisum_ui_disk_device_toggle_cb, dev);
+    elm_box_pack_end(left, btn);
+
+    swatch = evas_object_rectangle_add(evas_object_evas_get(left));
+    evas_object_color_set(swatch, dev->color_r, dev->color_g, dev->color_b, 255);
+    evas_object_size_hint_min_set(swatch, 12 * elm_config_scale_get(), 12 * elm_config_scale_get());
+    evas_object_size_hint_max_set(swatch, 12 * elm_config_scale_get(), 12 * elm_config_scale_get());
+    evas_object_size_hint_align_set(swatch, 0.0, 0.5);
+    elm_object_content_set(btn, swatch);
+    evas_object_show(swatch);
+
+    lb = elm_label_add(left);
+    evas_object_size_hint_weight_set(lb, EVAS_HINT_EXPAND, 0.0);
+    evas_object_size_hint_align_set(lb, 0.0, 0.5);
+    elm_object_text_set(lb, dev->name);
+    elm_box_pack_end(left, lb);
+    evas_object_show(lb);
+
+    dev->legend_stats = elm_label_add(view->device_tb);
+    evas_object_size_hint_weight_set(dev->legend_stats, EVAS_HINT_EXPAND, 0.0);
+    evas_object_size_hint_align_set(dev->legend_stats, 1.0, 0.5);
+    evas_object_show(dev->legend_stats);
+
+    dev->legend_row = left;
+    dev->legend_btn = btn;
+    dev->legend_swatch = swatch;
+    dev->legend_label = lb;
+    _evisum_ui_disk_device_legend_repack(view);
+}
+
+static void
+_evisum_ui_disk_device_free(Disk_Device_History *dev) {
+    if (dev->legend_stats) evas_object_del(dev->legend_stats);
+    if (dev->legend_row) evas_object_del(dev->legend_row);
+    evisum_ui_graph_lod_free(dev->bytes);
+    evisum_ui_graph_lod_free(dev->iops);
+    evisum_ui_graph_lod_free(dev->util);
+    free(dev);
+}
+
+static Disk_Device_History *
+_evisum_ui_disk_device_find(Evisum_Ui_Disk_View *view, const char *name) {
+    Eina_List *l;
+    Disk_Device_History *dev;
+
+    EINA_LIST_FOREACH(view->devices, l, dev) {
+        if (!strcmp(dev->name, name)) return dev;
+    }
+    return NULL;
+}
+
+static uint64_t
+_evisum_ui_disk_counter_delta(uint64_t now, uint64_t last) {
+    return (now < last) ? 0 : now - last;
+}
+
+static void
+_evisum_ui_disk_device_rates(const Block_Device *bd, const Block_Device *last, uint32_t elapsed, double *bytes,
+                             double *iops, double *util) {
+    if (!elapsed) elapsed = 1;
+
+    *bytes = (double) (_evisum_ui_disk_counter_delta(bd->read_bytes, last->read_bytes)
+                       + _evisum_ui_disk_counter_delta(bd->write_bytes, last->write_bytes))
+             / elapsed;
+    *iops = (double) (_evisum_ui_disk_counter_delta(bd->reads, last->reads)
+                      + _evisum_ui_disk_counter_delta(bd->writes, last->writes))
+            / elapsed;
+    *util = _evisum_ui_disk_counter_delta(bd->io_time, last->io_time) / (10.0 * elapsed);
+    if (*util > 100.0) *util = 100.0;
+}
+
+static void
+_evisum_ui_disk_device_sample(Disk_Device_History *dev, const Block_Device *bd, uint32_t time) {
+    double bytes, iops, util;
+    uint32_t elapsed;
+    char key[BLOCK_DEVICE_NAME_SIZE + 16];
+
+    if (!dev->have_last || (time < dev->last_time)) {
+        dev->last = *bd;
+        dev->last_time = time;
+        dev->have_last = EINA_TRUE;
+        return;
+    }
+
+    // Nothing new was sampled since the last poll.
+    elapsed = time - dev->last_time;
+    if (!elapsed) return;
+
+    _evisum_ui_disk_device_rates(bd, &dev->last, elapsed, &bytes, &iops, &util);
+
+    _evisum_ui_disk_samples_push(dev->view, &dev->bytes, _evisum_ui_disk_device_key(key, sizeof(key), dev->name, "bytes"),
+                                 bytes);
+    _evisum_ui_disk_samples_push(dev->view, &dev->iops, _evisum_ui_disk_device_key(key, sizeof(key), dev->name, "iops"),
+                                 iops);
+    _evisum_ui_disk_samples_push(dev->view, &dev->util, _evisum_ui_disk_device_key(key, sizeof(key), dev->name, "util"),
+                                 util);
+
+    if (dev->legend_stats) {
+        elm_object_text_set(
+                dev->legend_stats,
+                eina_slstr_printf(_("R %s/s  W %s/s  %.0f IOPS  %.0f%%"),
+                                  evisum_size_format(_evisum_ui_disk_counter_delta(bd->read_bytes, dev->last.read_bytes) / elapsed, 0),
+                                  evisum_size_format(_evisum_ui_disk_counter_delta(bd->write_bytes, dev->last.write_bytes) / elapsed, 0),
+                                  iops, util));
     }
+
+    dev->last = *bd;
+    dev->last_time = time;
+}
+
+static void
+_evisum_ui_disk_devices_update(Evisum_Ui_Disk_View *view, Eina_List *devices, uint32_t time) {
+    Eina_List *l, *l2;
+    Disk_Device_History *dev;
+    Block_Device *bd;
+
+    EINA_LIST_FOREACH(view->devices, l, dev)
+    dev->seen = EINA_FALSE;
+
+    EINA_LIST_FOREACH(devices, l, bd) {
+        dev = _evisum_ui_disk_device_find(view, bd->name);
+        if (!dev) {
+            dev = calloc(1, sizeof(Disk_Device_History));
+            if (!dev) continue;
+            snprintf(dev->name, sizeof(dev->name), "%s", bd->name);
+            dev->enabled = EINA_TRUE;
+            dev->view = view;
+            evisum_graph_color_get(dev->name, &dev->color_r, &dev->color_g, &dev->color_b);
+            view->devices = eina_list_append(view->devices, dev);
+            _evisum_ui_disk_device_legend_add(view, dev);
+        }
+        _evisum_ui_disk_device_sample(dev, bd, time);
+        dev->seen = EINA_TRUE;
+    }
+
+    EINA_LIST_FOREACH_SAFE(view->devices, l, l2, dev) {
+        if (dev->seen) continue;
+        view->devices = eina_list_remove_list(view->devices, l);
+        _evisum_ui_disk_device_free(dev);
+    }
+    _evisum_ui_disk_device_legend_repack(view);
+}
+
+static Evisum_Ui_Graph_Lod *
+_evisum_ui_disk_device_history_get(Disk_Device_History *dev, int mode) {
+    if (mode == DISK_GRAPH_THROUGHPUT) return dev->bytes;
+    if (mode == DISK_GRAPH_IOPS) return dev->iops;
+    return dev->util;
 }
 
 static void
 _evisum_ui_disk_graph_redraw(Evisum_Ui_Disk_View *view) {
     Eina_List *l;
     Disk_History *entry;
-    int total, nseries;
+    Disk_Device_History *dev;
+    int total, nseries, w;
+    double y_max = 100.0;
     Evisum_Ui_Graph_Series *series;
 
     if (!_evisum_ui_disk_graph_objects_valid(view)) return;
 
-    total = eina_list_count(view->history);
+    evas_object_geometry_get(view->graph_bg, NULL, NULL, &w, NULL);
+
+    if (view->mode == DISK_GRAPH_USAGE) total = eina_list_count(view->history);
+    else total = eina_list_count(view->devices);
     nseries = 0;
     series = calloc(total, sizeof(Evisum_Ui_Graph_Series));
     if ((total > 0) && (!series)) return;
 
-    EINA_LIST_FOREACH(view->history, l, entry) {
-        if (!entry->enabled || (entry->history_count < 2)) continue;
-        series[nseries].history = entry->history;
-        series[nseries].history_count = entry->history_count;
-        series[nseries].color_r = entry->color_r;
-        series[nseries].color_g = entry->color_g;
-        series[nseries].color_b = entry->color_b;
-        nseries++;
+    if (view->mode == DISK_GRAPH_USAGE) {
+        EINA_LIST_FOREACH(view->history, l, entry) {
+            if (!entry->enabled) continue;
+            if (evisum_ui_graph_lod_series_get(entry->lod, DISK_GRAPH_SAMPLES, w, &series[nseries]) < 2) continue;
+            series[nseries].color_r = entry->color_r;
+            series[nseries].color_g = entry->color_g;
+            series[nseries].color_b = entry->color_b;
+            nseries++;
+        }
+    } else {
+        double peak = 0.0;
+
+        EINA_LIST_FOREACH(view->devices, l, dev) {
+            Evisum_Ui_Graph_Series *line = &series[nseries];
+            const double *values;
+
+            if (!dev->enabled) continue;
+            if (evisum_ui_graph_lod_series_get(_evisum_ui_disk_device_history_get(dev, view->mode), DISK_GRAPH_SAMPLES,
+                                               w, line)
+                < 2)
+                continue;
+            values = line->history_max ? line->history_max : line->history;
+            for (int i = 0; i < line->history_count; i++)
+                if (values[i] > peak) peak = values[i];
+            series[nseries].color_r = dev->color_r;
+            series[nseries].color_g = dev->color_g;
+            series[nseries].color_b = dev->color_b;
+            nseries++;
+        }
+        if (view->mode != DISK_GRAPH_UTILISATION) y_max = (peak > 0.0) ? peak * 1.1 : 1.0;
     }
 
     evisum_ui_graph_draw(view->graph_bg, view->graph_img, DISK_GRAPH_SAMPLES, DISK_GRID_X_STEP_SAMPLES,
-                         DISK_GRID_Y_STEP_PERCENT, 100.0, series, nseries, _disk_layers,
+                         DISK_GRID_Y_STEP_PERCENT, y_max, series, nseries, _disk_layers,
                          EINA_C_ARRAY_LENGTH(_disk_layers));
     free(series);
 }
 
+static void
+_evisum_ui_disk_mode_changed_cb(void *data, Evas_Object *obj, void *event_info EINA_UNUSED) {
+    Evisum_Ui_Disk_View *view = data;
+
+    view->mode = elm_radio_value_get(obj);
+    evisum_ui_graph_reset(view->graph_img);
+    _evisum_ui_disk_graph_redraw(view);
+}
+
 static void
 _evisum_ui_disk_graph_bg_resize_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                                    void *event_info EINA_UNUSED) {
@@ -304,24 +607,97 @@ _evisum_ui_disk_graph_bg_resize_cb(void *data, Evas *e EINA_UNUSED, Evas_Object
 }
 
 static void
-_evisum_ui_disk_disks_poll(void *data, Ecore_Thread *thread) {
+_evisum_ui_disk_backfill_cb(const Evisum_Engine_History_Sample *sample, void *data) {
+    Disk_Backfill *db = data;
+    File_System *fs;
+    Block_Device *bd, *last;
+    Eina_List *l;
+    char key[BLOCK_DEVICE_NAME_SIZE + 16];
+    Eina_Strbuf *buf;
+    uint32_t elapsed = 0;
+
+    // Same key as the live entries, see _evisum_ui_disk_history_find_or_create().
+    buf = eina_strbuf_new();
+    EINA_LIST_FOREACH(sample->file_systems, l, fs) {
+        if (!buf) break;
+        eina_strbuf_reset(buf);
+        eina_strbuf_append_printf(buf, "%s|%s", fs->path, fs->mount);
+        evisum_ui_graph_backfill_add(db->backfill, eina_strbuf_string_get(buf), _evisum_ui_disk_used_percent(fs));
+    }
+    if (buf) eina_strbuf_free(buf);
+
+    if (db->last_time && (sample->time > db->last_time)) elapsed = sample->time - db->last_time;
+    db->last_time = sample->time;
+
+    EINA_LIST_FOREACH(sample->block_devices, l, bd) {
+        last = eina_hash_find(db->last, bd->name);
+        if (!last) {
+            last = malloc(sizeof(Block_Device));
+            if (!last) continue;
+            *last = *bd;
+            if (!eina_hash_add(db->last, last->name, last)) free(last);
+            continue;
+        }
+        if (elapsed) {
+            double bytes, iops, util;
+
+            _evisum_ui_disk_device_rates(bd, last, elapsed, &bytes, &iops, &util);
+            evisum_ui_graph_backfill_add(db->backfill, _evisum_ui_disk_device_key(key, sizeof(key), bd->name, "bytes"),
+                                         bytes);
+            evisum_ui_graph_backfill_add(db->backfill, _evisum_ui_disk_device_key(key, sizeof(key), bd->name, "iops"),
+                                         iops);
+            evisum_ui_graph_backfill_add(db->backfill, _evisum_ui_disk_device_key(key, sizeof(key), bd->name, "util"),
+                                         util);
+        }
+        *last = *bd;
+    }
+}
+
+static Evisum_Ui_Graph_Backfill *
+_evisum_ui_disk_backfill(void) {
+    Disk_Backfill db = { 0 };
+
+    db.backfill = evisum_ui_graph_backfill_new();
+    db.last = eina_hash_string_superfast_new(free);
+    if (db.backfill && db.last)
+        evisum_engine_history_samples_get(DISK_GRAPH_SAMPLES + 1, 1,
+                                          EVISUM_ENGINE_HISTORY_FILE_SYSTEMS | EVISUM_ENGINE_HISTORY_BLOCK_DEVICES,
+                                          _evisum_ui_disk_backfill_cb, &db);
+    if (db.last) eina_hash_free(db.last);
+
+    return db.backfill;
+}
+
+static void
+_evisum_ui_disk_update_free(void *data) {
+    Disk_Update *update = data;
+    File_System *fs;
+    Block_Device *bd;
+
+    EINA_LIST_FREE(update->mounted, fs) { file_system_info_free(fs); }
+    EINA_LIST_FREE(update->devices, bd) { block_device_info_free(bd); }
+    free(update);
+}
+
+static void
+_evisum_ui_disk_disks_poll(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
     Evisum_Ui_Disk_View *view = data;
-    uint64_t seq = 0;
-    int ticks = 9;
-
-    while (!ecore_thread_check(thread)) {
-        Eina_List *mounted;
-        if (view->skip_wait) {
-            view->skip_wait = 0;
-            ticks = 9;
-        } else if (!evisum_background_update_wait(&seq)) continue;
-        ticks++;
-        if (ticks < 10) continue;
-        ticks = 0;
-        mounted = file_system_info_all_get();
-        if (!mounted) continue;
-        ecore_thread_feedback(thread, mounted);
+    Disk_Update *update;
+
+    // Recorded usage and rates for the window, ready before the first live
+    // sample is posted.
+    if (!view->backfill) view->backfill = _evisum_ui_disk_backfill();
+
+    update = calloc(1, sizeof(Disk_Update));
+    if (!update) return;
+    update->mounted = file_system_info_all_get();
+    update->devices = block_device_info_all_get();
+    update->time = evisum_engine_history_live_get() ? evisum_engine_live_time_get() : evisum_engine_history_time_get();
+    if (!update->mounted && !update->devices) {
+        free(update);
+        return;
     }
+    ecore_thread_feedback(thread, update);
 }
 
 static void
@@ -330,11 +706,13 @@ _evisum_ui_disk_disks_poll_feedback_cb(void *data, Ecore_Thread *thread EINA_UNU
     Evisum_Ui_Disk_View *view;
     Eina_List *l;
     Eina_List *mounted;
+    Disk_Update *update;
     Disk_History *entry;
     Eina_Bool graph_reset_needed = EINA_FALSE;
 
     view = data;
-    mounted = msgdata;
+    update = msgdata;
+    mounted = update->mounted;
 
     EINA_LIST_FOREACH(view->history, l, entry)
     entry->seen = EINA_FALSE;
@@ -353,24 +731,23 @@ _evisum_ui_disk_disks_poll_feedback_cb(void *data, Ecore_Thread *thread EINA_UNU
     }
 
     EINA_LIST_FOREACH(mounted, l, fs) {
-        double used_percent = 0.0;
+        double used_percent;
 
         entry = _evisum_ui_disk_history_find_or_create(view, fs, NULL);
         if (!entry) continue;
         if (entry->seen) continue;
 
-        if (fs->usage.total) used_percent = ((double) fs->usage.used / (double) fs->usage.total) * 100.0;
-        if (used_percent < 0.0) used_percent = 0.0;
-        if (used_percent > 100.0) used_percent = 100.0;
-
-        _evisum_ui_disk_history_add_sample(entry, used_percent);
+        used_percent = _evisum_ui_disk_used_percent(fs);
+        _evisum_ui_disk_history_add_sample(view, entry, used_percent);
         _evisum_ui_disk_history_legend_add(view, entry);
         _evisum_ui_disk_history_legend_update(entry, used_percent, fs->usage.used, fs->usage.total);
         entry->seen = EINA_TRUE;
     }
     _evisum_ui_disk_history_compact(view);
 
-    EINA_LIST_FREE(mounted, fs) { file_system_info_free(fs); }
+    _evisum_ui_disk_devices_update(view, update->devices, update->time);
+
+    _evisum_ui_disk_update_free(update);
     _evisum_ui_disk_graph_redraw(view);
 }
 
@@ -403,21 +780,21 @@ _evisum_ui_disk_win_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EIN
     Evisum_Ui_Disk_View *view;
     Evisum_Ui *ui;
     Disk_History *entry;
+    Disk_Device_History *dev;
 
     view = data;
     ui = view->ui;
 
     evisum_ui_config_save(ui);
-    ecore_thread_cancel(view->thread);
-    ecore_thread_wait(view->thread, 0.5);
+    evisum_engine_unsubscribe(view->sub, EINA_TRUE);
+    view->sub = NULL;
     if (view->main_menu) evas_object_del(view->main_menu);
 
-    EINA_LIST_FREE(view->history, entry) {
-        _evisum_ui_disk_history_legend_del(entry);
-        free(entry->name);
-        free(entry->key);
-        free(entry);
-    }
+    EINA_LIST_FREE(view->history, entry) { _evisum_ui_disk_history_free(entry); }
+
+    EINA_LIST_FREE(view->devices, dev) { _evisum_ui_disk_device_free(dev); }
+
+    evisum_ui_graph_backfill_free(view->backfill);
 
     free(view);
 
@@ -480,7 +857,7 @@ _evisum_ui_disk_btn_menu_clicked_cb(void *data, Evas_Object *obj, void *event_in
 
 void
 evisum_ui_disk_win_add(Evisum_Ui *ui) {
-    Evas_Object *win, *tb, *graph_tb, *legend_fr;
+    Evas_Object *win, *tb, *graph_tb, *legend_fr, *device_fr, *hbx, *radio, *radio_group;
     Evas_Object *btn, *ic;
     Elm_Layout *lay;
     Evas *evas;
@@ -492,6 +869,7 @@ evisum_ui_disk_win_add(Evisum_Ui *ui) {
 
     ui->disk.win = win = elm_win_util_standard_add("evisum", _("Storage"));
     elm_win_autodel_set(win, 1);
+    evisum_ui_win_visibility_track(win);
     evas_object_size_hint_weight_set(win, EXPAND, EXPAND);
     evas_object_size_hint_align_set(win, FILL, FILL);
     evas = evas_object_evas_get(win);
@@ -499,7 +877,6 @@ evisum_ui_disk_win_add(Evisum_Ui *ui) {
     Evisum_Ui_Disk_View *view = calloc(1, sizeof(Evisum_Ui_Disk_View));
     view->win = win;
     view->ui = ui;
-    view->skip_wait = 1;
 
     tb = elm_table_add(win);
     evas_object_size_hint_weight_set(tb, EXPAND, EXPAND);
@@ -546,11 +923,34 @@ evisum_ui_disk_win_add(Evisum_Ui *ui) {
     elm_table_pack(graph_tb, lay, 0, 0, 1, 1);
     evas_object_show(lay);
 
+    hbx = elm_box_add(win);
+    elm_box_horizontal_set(hbx, EINA_TRUE);
+    evas_object_size_hint_weight_set(hbx, EVAS_HINT_EXPAND, 0.0);
+    evas_object_size_hint_align_set(hbx, EVAS_HINT_FILL, 0.0);
+    elm_table_pack(tb, hbx, 0, 1, 1, 1);
+    evas_object_show(hbx);
+
+    const char *modes[] = { _("Usage"), _("Throughput"), _("IOPS"), _("Utilisation") };
+    radio_group = NULL;
+    for (int i = 0; i < (int) EINA_C_ARRAY_LENGTH(modes); i++) {
+        radio = elm_radio_add(hbx);
+        elm_object_text_set(radio, modes[i]);
+        elm_radio_state_value_set(radio, i);
+        if (radio_group) elm_radio_group_add(radio, radio_group);
+        else radio_group = radio;
+        evas_object_size_hint_weight_set(radio, EXPAND, EXPAND);
+        evas_object_size_hint_align_set(radio, FILL, FILL);
+        evas_object_smart_callback_add(radio, "changed", _evisum_ui_disk_mode_changed_cb, view);
+        elm_box_pack_end(hbx, radio);
+        evas_object_show(radio);
+    }
+    elm_radio_value_set(radio_group, DISK_GRAPH_USAGE);
+
     legend_fr = elm_frame_add(win);
     elm_object_text_set(legend_fr, _("Mounts"));
     evas_object_size_hint_weight_set(legend_fr, EVAS_HINT_EXPAND, 0.0);
     evas_object_size_hint_align_set(legend_fr, EVAS_HINT_FILL, 0.0);
-    elm_table_pack(tb, legend_fr, 0, 1, 1, 1);
+    elm_table_pack(tb, legend_fr, 0, 2, 1, 1);
     evas_object_show(legend_fr);
 
     view->legend_tb = elm_table_add(legend_fr);
@@ -560,6 +960,20 @@ evisum_ui_disk_win_add(Evisum_Ui *ui) {
     elm_object_content_set(legend_fr, view->legend_tb);
     evas_object_show(view->legend_tb);
 
+    device_fr = elm_frame_add(win);
+    elm_object_text_set(device_fr, _("Devices"));
+    evas_object_size_hint_weight_set(device_fr, EVAS_HINT_EXPAND, 0.0);
+    evas_object_size_hint_align_set(device_fr, EVAS_HINT_FILL, 0.0);
+    elm_table_pack(tb, device_fr, 0, 3, 1, 1);
+    evas_object_show(device_fr);
+
+    view->device_tb = elm_table_add(device_fr);
+    elm_table_padding_set(view->device_tb, 8 * elm_config_scale_get(), 2 * elm_config_scale_get());
+    evas_object_size_hint_weight_set(view->device_tb, EVAS_HINT_EXPAND, 0.0);
+    evas_object_size_hint_align_set(view->device_tb, EVAS_HINT_FILL, 0.0);
+    elm_object_content_set(device_fr, view->device_tb);
+    evas_object_show(view->device_tb);
+
     elm_object_content_set(win, tb);
 
     if ((ui->disk.width > 0) && (ui->disk.height > 0)) evas_object_resize(win, ui->disk.width, ui->disk.height);
@@ -577,6 +991,9 @@ evisum_ui_disk_win_add(Evisum_Ui *ui) {
     evas_object_event_callback_add(tb, EVAS_CALLBACK_KEY_DOWN, _evisum_ui_disk_win_key_down_cb, view);
     evas_object_show(win);
 
-    view->thread = ecore_thread_feedback_run(_evisum_ui_disk_disks_poll, _evisum_ui_disk_disks_poll_feedback_cb, NULL,
-                                             NULL, view, 1);
+    // Quiet devices log nothing, the graph still needs a sample a second.
+    view->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_FILE_SYSTEMS | EVISUM_ENGINE_FAMILY_BLOCK_DEVICES, 1.0,
+                                        _evisum_ui_disk_disks_poll, _evisum_ui_disk_disks_poll_feedback_cb,
+                                        _evisum_ui_disk_update_free, view);
+    evisum_engine_subscription_refresh(view->sub);
 }
@@ -91,6 +91,23 @@ _sample_x_pos(int sample_idx, int sample_count, int graph_w) {
     return (int) lround(((double) sample_idx / (double) (sample_count - 1)) * (double) (graph_w - 1));
 }
 
+static double
+_series_x_pos(const Evisum_Ui_Graph_Series *line, int count, int i, int sample_count, int view_x, int view_w) {
+    double span, pos;
+
+    if ((line->history_span <= 0.0) || (count < 2))
+        return (double) view_x + (double) _sample_x_pos(sample_count - count + i, sample_count, view_w);
+
+    span = line->history_span;
+    if (span > (double) sample_count) span = (double) sample_count;
+    if (span < 2.0) span = 2.0;
+
+    pos = (double) (sample_count - 1) - ((double) (count - 1 - i) * (span - 1.0)) / (double) (count - 1);
+    if (pos < 0.0) pos = 0.0;
+
+    return (double) view_x + (pos / (double) (sample_count - 1)) * (double) (view_w - 1);
+}
+
 static void
 _square_grid_viewport_calc(int graph_w, int graph_h, int sample_count, int x_grid_step_samples, int y_grid_step_percent,
                            int *out_x, int *out_y, int *out_w, int *out_h) {
@@ -200,17 +217,31 @@ evisum_ui_graph_draw(Evas_Object *graph_bg, Evas_Object *graph_vg, int sample_co
 
         count = line->history_count;
         start = 0;
-        if (count > sample_count) {
+        if ((line->history_span <= 0.0) && (count > sample_count)) {
             start = count - sample_count;
             count = sample_count;
         }
 
+        if (line->history_min && line->history_max) {
+            shape = _shape_stroke_add(root, line->color_r / 4, line->color_g / 4, line->color_b / 4, 64, 1.0);
+            for (int i = 0; shape && (i < count); i++) {
+                double x, y0, y1;
+
+                if (line->history_max[start + i] <= line->history_min[start + i]) continue;
+
+                x = _series_x_pos(line, count, i, sample_count, view_x, view_w);
+                y0 = _sample_y_pos(line->history_max[start + i], y_max, view_y, view_h);
+                y1 = _sample_y_pos(line->history_min[start + i], y_max, view_y, view_h);
+                evas_vg_shape_append_move_to(shape, x, y0);
+                evas_vg_shape_append_line_to(shape, x, y1);
+            }
+        }
+
         for (int j = 0; j < layer_count; j++) {
             uint8_t alpha = _alpha_to_u8(layers[j].alpha);
             uint8_t pr, pg, pb;
             double min_y = (double) view_y;
             double max_y = (double) (view_y + view_h - 1);
-            int idx;
             double x0, y0;
 
             if (!alpha) continue;
@@ -221,8 +252,7 @@ evisum_ui_graph_draw(Evas_Object *graph_bg, Evas_Object *graph_vg, int sample_co
             shape = _shape_stroke_add(root, pr, pg, pb, alpha, GRAPH_LINE_STROKE_WIDTH);
             if (!shape) continue;
 
-            idx = sample_count - count;
-            x0 = (double) view_x + (double) _sample_x_pos(idx, sample_count, view_w);
+            x0 = _series_x_pos(line, count, 0, sample_count, view_x, view_w);
             y0 = _sample_y_pos(line->history[start], y_max, view_y, view_h) + layers[j].offset;
             y0 = _clamp_double(y0, min_y, max_y);
             evas_vg_shape_append_move_to(shape, x0, y0);
@@ -230,8 +260,7 @@ evisum_ui_graph_draw(Evas_Object *graph_bg, Evas_Object *graph_vg, int sample_co
             for (int i = 1; i < count; i++) {
                 double x1, y1;
 
-                idx = sample_count - count + i;
-                x1 = (double) view_x + (double) _sample_x_pos(idx, sample_count, view_w);
+                x1 = _series_x_pos(line, count, i, sample_count, view_x, view_w);
                 y1 = _sample_y_pos(line->history[start + i], y_max, view_y, view_h) + layers[j].offset;
                 y1 = _clamp_double(y1, min_y, max_y);
                 evas_vg_shape_append_line_to(shape, x1, y1);
@@ -6,6 +6,12 @@
 typedef struct _Evisum_Ui_Graph_Series {
     const double *history;
     int history_count;
+    /* Optional per point range, drawn as a faint band behind the line. */
+    const double *history_min;
+    const double *history_max;
+    /* Samples the points cover, spread right-aligned over that many sample
+     * slots. Zero means one point per sample. */
+    double history_span;
     uint8_t color_r;
     uint8_t color_g;
     uint8_t color_b;
@@ -0,0 +1,297 @@
+#include "evisum_ui_graph_lod.h"
+
+#define LOD_LEVELS 12
+
+typedef struct {
+    double min;
+    double max;
+    double sum;
+    uint32_t n;
+} Lod_Bucket;
+
+typedef struct {
+    Lod_Bucket *ring;
+    int head;
+    int count;
+    Lod_Bucket pending;
+    int pending_children;
+} Lod_Level;
+
+struct _Evisum_Ui_Graph_Lod {
+    int capacity;
+    uint64_t total;
+    Lod_Level levels[LOD_LEVELS];
+
+    double *avg;
+    double *min;
+    double *max;
+    int points_size;
+};
+
+static void
+_lod_bucket_merge(Lod_Bucket *dst, const Lod_Bucket *src) {
+    if (!src->n) return;
+
+    if (!dst->n) {
+        *dst = *src;
+        return;
+    }
+
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+    dst->sum += src->sum;
+    dst->n += src->n;
+}
+
+static void
+_lod_level_append(Evisum_Ui_Graph_Lod *lod, int k, const Lod_Bucket *bucket) {
+    Lod_Level *level = &lod->levels[k];
+    Lod_Level *up;
+    Lod_Bucket done;
+
+    // Rings above level 0 are only allocated once a sample reaches them.
+    if (!level->ring) {
+        level->ring = calloc(lod->capacity, sizeof(Lod_Bucket));
+        if (!level->ring) return;
+    }
+
+    level->ring[level->head] = *bucket;
+    level->head = (level->head + 1) % lod->capacity;
+    if (level->count < lod->capacity) level->count++;
+
+    if ((k + 1) >= LOD_LEVELS) return;
+
+    up = &lod->levels[k + 1];
+    _lod_bucket_merge(&up->pending, bucket);
+    if (++up->pending_children < 2) return;
+
+    done = up->pending;
+    memset(&up->pending, 0, sizeof(Lod_Bucket));
+    up->pending_children = 0;
+    _lod_level_append(lod, k + 1, &done);
+}
+
+static Eina_Bool
+_lod_points_reserve(Evisum_Ui_Graph_Lod *lod, int count) {
+    double *avg, *min, *max;
+
+    if (count <= lod->points_size) return 1;
+
+    avg = realloc(lod->avg, count * sizeof(double));
+    if (avg) lod->avg = avg;
+    min = realloc(lod->min, count * sizeof(double));
+    if (min) lod->min = min;
+    max = realloc(lod->max, count * sizeof(double));
+    if (max) lod->max = max;
+    if (!avg || !min || !max) return 0;
+
+    lod->points_size = count;
+    return 1;
+}
+
+Evisum_Ui_Graph_Lod *
+evisum_ui_graph_lod_new(int capacity) {
+    Evisum_Ui_Graph_Lod *lod;
+
+    if (capacity < 2) return NULL;
+
+    lod = calloc(1, sizeof(Evisum_Ui_Graph_Lod));
+    if (!lod) return NULL;
+
+    lod->capacity = capacity;
+
+    return lod;
+}
+
+void
+evisum_ui_graph_lod_clear(Evisum_Ui_Graph_Lod *lod) {
+    if (!lod) return;
+
+    for (int k = 0; k < LOD_LEVELS; k++) {
+        free(lod->levels[k].ring);
+        memset(&lod->levels[k], 0, sizeof(Lod_Level));
+    }
+    lod->total = 0;
+}
+
+void
+evisum_ui_graph_lod_free(Evisum_Ui_Graph_Lod *lod) {
+    if (!lod) return;
+
+    evisum_ui_graph_lod_clear(lod);
+    free(lod->avg);
+    free(lod->min);
+    free(lod->max);
+    free(lod);
+}
+
+void
+evisum_ui_graph_lod_push(Evisum_Ui_Graph_Lod *lod, double value) {
+    Lod_Bucket bucket = { value, value, value, 1 };
+
+    if (!lod) return;
+
+    _lod_level_append(lod, 0, &bucket);
+    lod->total++;
+}
+
+uint64_t
+evisum_ui_graph_lod_count(const Evisum_Ui_Graph_Lod *lod) {
+    return lod ? lod->total : 0;
+}
+
+int
+evisum_ui_graph_lod_series_get(Evisum_Ui_Graph_Lod *lod, int span, int width, Evisum_Ui_Graph_Series *series) {
+    Lod_Level *level;
+    Lod_Bucket partial, *b;
+    uint64_t covered = 0;
+    int k, n, avail, idx, out;
+
+    if (!series) return 0;
+
+    series->history = series->history_min = series->history_max = NULL;
+    series->history_count = 0;
+    series->history_span = 0.0;
+
+    if (!lod || !lod->total || (span < 1) || (width < 1)) return 0;
+    if ((uint64_t) span > lod->total) span = (int) lod->total;
+
+    // Coarsest detail we can get away with: the finest level whose buckets
+    // for the span fit both the widget and the ring.
+    for (k = 0; k < (LOD_LEVELS - 1); k++) {
+        n = (span + (1 << k) - 1) >> k;
+        if ((n <= width) && (n <= lod->capacity)) break;
+    }
+    n = (span + (1 << k) - 1) >> k;
+
+    // Samples newer than the last complete bucket at this level sit in the
+    // pending buckets of the levels at and below it.
+    memset(&partial, 0, sizeof(Lod_Bucket));
+    for (int j = 1; j <= k; j++)
+        _lod_bucket_merge(&partial, &lod->levels[j].pending);
+
+    level = &lod->levels[k];
+    avail = level->count + (partial.n ? 1 : 0);
+    if (n > avail) n = avail;
+    if ((n < 1) || !_lod_points_reserve(lod, n)) return 0;
+
+    out = n - 1;
+    if (partial.n) {
+        lod->avg[out] = partial.sum / partial.n;
+        lod->min[out] = partial.min;
+        lod->max[out] = partial.max;
+        covered += partial.n;
+        out--;
+    }
+
+    idx = level->head;
+    for (; out >= 0; out--) {
+        idx = (idx + lod->capacity - 1) % lod->capacity;
+        b = &level->ring[idx];
+        lod->avg[out] = b->sum / b->n;
+        lod->min[out] = b->min;
+        lod->max[out] = b->max;
+        covered += b->n;
+    }
+
+    series->history = lod->avg;
+    series->history_count = n;
+    if (k) {
+        series->history_min = lod->min;
+        series->history_max = lod->max;
+    }
+    series->history_span = (double) covered;
+
+    return n;
+}
+
+typedef struct {
+    double *values;
+    int count;
+    int size;
+} Backfill_Series;
+
+struct _Evisum_Ui_Graph_Backfill {
+    Eina_Hash *series;
+};
+
+static void
+_backfill_series_free(void *data) {
+    Backfill_Series *bs = data;
+
+    free(bs->values);
+    free(bs);
+}
+
+Evisum_Ui_Graph_Backfill *
+evisum_ui_graph_backfill_new(void) {
+    Evisum_Ui_Graph_Backfill *bf;
+
+    bf = calloc(1, sizeof(Evisum_Ui_Graph_Backfill));
+    if (!bf) return NULL;
+
+    bf->series = eina_hash_string_superfast_new(_backfill_series_free);
+    if (!bf->series) {
+        free(bf);
+        return NULL;
+    }
+
+    return bf;
+}
+
+void
+evisum_ui_graph_backfill_free(Evisum_Ui_Graph_Backfill *bf) {
+    if (!bf) return;
+
+    eina_hash_free(bf->series);
+    free(bf);
+}
+
+void
+evisum_ui_graph_backfill_add(Evisum_Ui_Graph_Backfill *bf, const char *key, double value) {
+    Backfill_Series *bs;
+    double *values;
+
+    if (!bf || !key) return;
+
+    bs = eina_hash_find(bf->series, key);
+    if (!bs) {
+        bs = calloc(1, sizeof(Backfill_Series));
+        if (!bs) return;
+        if (!eina_hash_add(bf->series, key, bs)) {
+            free(bs);
+            return;
+        }
+    }
+
+    if (bs->count == bs->size) {
+        values = realloc(bs->values, (bs->size ? bs->size * 2 : 128) * sizeof(double));
+        if (!values) return;
+        bs->values = values;
+        bs->size = bs->size ? bs->size * 2 : 128;
+    }
+
+    bs->values[bs->count++] = value;
+}
+
+Evisum_Ui_Graph_Lod *
+evisum_ui_graph_backfill_lod_new(Evisum_Ui_Graph_Backfill *bf, const char *key, double *peak) {
+    Evisum_Ui_Graph_Lod *lod;
+    Backfill_Series *bs;
+
+    if (peak) *peak = 0.0;
+
+    lod = evisum_ui_graph_lod_new(EVISUM_UI_GRAPH_LOD_CAPACITY);
+    if (!lod || !bf || !key) return lod;
+
+    bs = eina_hash_find(bf->series, key);
+    if (!bs) return lod;
+
+    for (int i = 0; i < bs->count; i++) {
+        evisum_ui_graph_lod_push(lod, bs->values[i]);
+        if (peak && (bs->values[i] > *peak)) *peak = bs->values[i];
+    }
+    eina_hash_del_by_key(bf->series, key);
+
+    return lod;
+}
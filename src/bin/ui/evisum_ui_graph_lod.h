@@ -0,0 +1,50 @@
+#ifndef __EVISUM_UI_GRAPH_LOD_H__
+#define __EVISUM_UI_GRAPH_LOD_H__
+
+#include "evisum_ui_graph.h"
+
+/* A min/max/avg pyramid over a stream of samples. Level 0 holds the raw
+ * samples, every level above merges pairs from the one below, each level
+ * is a ring of the same capacity. A graph asks for a span of recent samples
+ * at a pixel width and gets back at most one point per pixel, taken from
+ * the coarsest level that still resolves the span, so drawing cost follows
+ * the widget width rather than the length of the range.
+ */
+
+#define EVISUM_UI_GRAPH_LOD_CAPACITY 512
+
+typedef struct _Evisum_Ui_Graph_Lod Evisum_Ui_Graph_Lod;
+
+Evisum_Ui_Graph_Lod *evisum_ui_graph_lod_new(int capacity);
+
+void evisum_ui_graph_lod_free(Evisum_Ui_Graph_Lod *lod);
+
+void evisum_ui_graph_lod_clear(Evisum_Ui_Graph_Lod *lod);
+
+void evisum_ui_graph_lod_push(Evisum_Ui_Graph_Lod *lod, double value);
+
+uint64_t evisum_ui_graph_lod_count(const Evisum_Ui_Graph_Lod *lod);
+
+/* Fill series history, min, max and span with the newest span samples
+ * reduced to no more than width points. The arrays belong to the pyramid
+ * and stay valid until its next push or fetch. Returns the point count.
+ */
+int evisum_ui_graph_lod_series_get(Evisum_Ui_Graph_Lod *lod, int span, int width, Evisum_Ui_Graph_Series *series);
+
+/* Samples recovered from the history log for a window as it opens, kept
+ * by series key until the series first appears and takes them.
+ */
+typedef struct _Evisum_Ui_Graph_Backfill Evisum_Ui_Graph_Backfill;
+
+Evisum_Ui_Graph_Backfill *evisum_ui_graph_backfill_new(void);
+
+void evisum_ui_graph_backfill_free(Evisum_Ui_Graph_Backfill *bf);
+
+void evisum_ui_graph_backfill_add(Evisum_Ui_Graph_Backfill *bf, const char *key, double value);
+
+/* A new pyramid holding whatever was recorded for key, oldest first. The
+ * backfill forgets the key. Peak, when given, is set to the largest value.
+ */
+Evisum_Ui_Graph_Lod *evisum_ui_graph_backfill_lod_new(Evisum_Ui_Graph_Backfill *bf, const char *key, double *peak);
+
+#endif
@@ -1,8 +1,8 @@
 #include "evisum_ui_memory.h"
 #include "evisum_ui_graph.h"
+#include "evisum_ui_graph_lod.h"
 #include "evisum_ui_colors.h"
 #include "../engine/evisum_engine.h"
-#include "../background/evisum_background.h"
 #include "config.h"
 
 #include <Elementary.h>
@@ -17,8 +17,7 @@ typedef struct {
     uint8_t color_g;
     uint8_t color_b;
 
-    double history[120];
-    int history_count;
+    Evisum_Ui_Graph_Lod *lod;
 
     uint64_t used;
     uint64_t total;
@@ -35,7 +34,7 @@ typedef struct {
 } Memory_Series;
 
 struct _Win_Data {
-    Ecore_Thread *thread;
+    Evisum_Engine_Subscription *sub;
     Evas_Object *win;
     Evas_Object *main_menu;
     Elm_Layout *btn_menu;
@@ -46,6 +45,7 @@ struct _Win_Data {
 
     Memory_Series series[5 + MEM_VIDEO_CARD_MAX];
     int series_count;
+    Evisum_Ui_Graph_Backfill *backfill;
 
     Evisum_Ui *ui;
 };
@@ -122,11 +122,8 @@ _evisum_ui_memory_legend_repack(Evisum_Ui_Memory_View *view) {
 
 static void
 _evisum_ui_memory_series_history_add(Memory_Series *entry, double value) {
-    if (entry->history_count < MEM_GRAPH_SAMPLES) entry->history[entry->history_count++] = value;
-    else {
-        memmove(&entry->history[0], &entry->history[1], sizeof(double) * (MEM_GRAPH_SAMPLES - 1));
-        entry->history[MEM_GRAPH_SAMPLES - 1] = value;
-    }
+    if (!entry->lod) entry->lod = evisum_ui_graph_backfill_lod_new(entry->view->backfill, entry->key, NULL);
+    evisum_ui_graph_lod_push(entry->lod, value);
 }
 
 static void
@@ -206,17 +203,18 @@ _evisum_ui_memory_series_legend_update(Memory_Series *entry) {
 static void
 _evisum_ui_memory_graph_redraw(Evisum_Ui_Memory_View *view) {
     Evisum_Ui_Graph_Series series[5 + MEM_VIDEO_CARD_MAX];
-    int nseries = 0;
+    int nseries = 0, w;
 
     if (!_evisum_ui_memory_graph_objects_valid(view)) return;
 
+    evas_object_geometry_get(view->graph_bg, NULL, NULL, &w, NULL);
+
     for (int i = 0; i < view->series_count; i++) {
         Memory_Series *entry = &view->series[i];
 
-        if (!entry->enabled || !entry->visible || (entry->history_count < 2)) continue;
+        if (!entry->enabled || !entry->visible) continue;
+        if (evisum_ui_graph_lod_series_get(entry->lod, MEM_GRAPH_SAMPLES, w, &series[nseries]) < 2) continue;
 
-        series[nseries].history = entry->history;
-        series[nseries].history_count = entry->history_count;
         series[nseries].color_r = entry->color_r;
         series[nseries].color_g = entry->color_g;
         series[nseries].color_b = entry->color_b;
@@ -276,11 +274,24 @@ _evisum_ui_memory_series_init(Evisum_Ui_Memory_View *view) {
     }
 }
 
+static double
+_evisum_ui_memory_percent(uint64_t used, uint64_t total) {
+    double used_percent;
+
+    if (!total) return 0.0;
+
+    used_percent = ((double) used / (double) total) * 100.0;
+    if (used_percent < 0.0) used_percent = 0.0;
+    if (used_percent > 100.0) used_percent = 100.0;
+
+    return used_percent;
+}
+
 static void
 _evisum_ui_memory_series_usage_set(Evisum_Ui_Memory_View *view, int idx, uint64_t used, uint64_t total,
                                    Eina_Bool enabled) {
     Memory_Series *entry = &view->series[idx];
-    double used_percent = 0.0;
+    double used_percent;
 
     if (entry->sampled) return;
     entry->sampled = EINA_TRUE;
@@ -291,12 +302,7 @@ _evisum_ui_memory_series_usage_set(Evisum_Ui_Memory_View *view, int idx, uint64_
 
     if (!enabled) return;
 
-    if (total) {
-        used_percent = ((double) used / (double) total) * 100.0;
-        if (used_percent < 0.0) used_percent = 0.0;
-        if (used_percent > 100.0) used_percent = 100.0;
-    }
-
+    used_percent = _evisum_ui_memory_percent(used, total);
     _evisum_ui_memory_series_history_add(entry, used_percent);
     _evisum_ui_memory_series_legend_add(view, entry);
     _evisum_ui_memory_series_legend_update(entry);
@@ -329,25 +335,51 @@ _evisum_ui_memory_series_update_from_memory(Evisum_Ui_Memory_View *view, Meminfo
 }
 
 static void
-_evisum_ui_memory_mem_usage_main(void *data, Ecore_Thread *thread) {
+_evisum_ui_memory_backfill_cb(const Evisum_Engine_History_Sample *sample, void *data) {
+    Evisum_Ui_Memory_View *view = data;
+    const Meminfo *memory = sample->memory;
+    uint64_t used = memory->used;
+
+    if (!memory->total) return;
+    if (view->ui->mem.zfs_mounted) used += memory->zfs_arc_used;
+
+    evisum_ui_graph_backfill_add(view->backfill, view->series[SERIES_USED].key,
+                                 _evisum_ui_memory_percent(used, memory->total));
+    evisum_ui_graph_backfill_add(view->backfill, view->series[SERIES_CACHED].key,
+                                 _evisum_ui_memory_percent(memory->cached, memory->total));
+    evisum_ui_graph_backfill_add(view->backfill, view->series[SERIES_BUFFERED].key,
+                                 _evisum_ui_memory_percent(memory->buffered, memory->total));
+    evisum_ui_graph_backfill_add(view->backfill, view->series[SERIES_SHARED].key,
+                                 _evisum_ui_memory_percent(memory->shared, memory->total));
+    if (memory->swap_total)
+        evisum_ui_graph_backfill_add(view->backfill, view->series[SERIES_SWAP].key,
+                                     _evisum_ui_memory_percent(memory->swap_used, memory->swap_total));
+
+    for (unsigned int i = 0; (i < memory->video_count) && (i < MEM_VIDEO_CARD_MAX); i++) {
+        if (!memory->video[i].total) continue;
+        evisum_ui_graph_backfill_add(view->backfill, view->series[SERIES_VIDEO_BASE + i].key,
+                                     _evisum_ui_memory_percent(memory->video[i].used, memory->video[i].total));
+    }
+}
+
+static void
+_evisum_ui_memory_mem_usage_main(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
     Evisum_Ui_Memory_View *view = data;
     static Meminfo memory;
-    uint64_t seq = 0;
-    int ticks = 9;
 
-    ecore_thread_name_set(thread, "memory");
+    // Fill the graph from the log before the first live sample is posted,
+    // the feedback callbacks only ever see the finished backfill.
+    if (!view->backfill) {
+        view->backfill = evisum_ui_graph_backfill_new();
+        evisum_engine_history_samples_get(MEM_GRAPH_SAMPLES, 1, EVISUM_ENGINE_HISTORY_MEMORY,
+                                          _evisum_ui_memory_backfill_cb, view);
+    }
 
-    while (!ecore_thread_check(thread)) {
-        if (!evisum_background_update_wait(&seq)) continue;
-        ticks++;
-        if (ticks < 10) continue;
-        ticks = 0;
-        memset(&memory, 0, sizeof(memory));
-        system_memory_usage_get(&memory);
-        if (view->ui->mem.zfs_mounted) memory.used += memory.zfs_arc_used;
+    memset(&memory, 0, sizeof(memory));
+    system_memory_usage_get(&memory);
+    if (view->ui->mem.zfs_mounted) memory.used += memory.zfs_arc_used;
 
-        ecore_thread_feedback(thread, &memory);
-    }
+    ecore_thread_feedback(thread, &memory);
 }
 
 static void
@@ -437,12 +469,14 @@ _evisum_ui_memory_win_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj E
     Evisum_Ui *ui = view->ui;
 
     evisum_ui_config_save(ui);
-    ecore_thread_cancel(view->thread);
-    ecore_thread_wait(view->thread, 0.5);
+    evisum_engine_unsubscribe(view->sub, EINA_TRUE);
+    view->sub = NULL;
 
     if (view->main_menu) evas_object_del(view->main_menu);
 
     for (int i = 0; i < view->series_count; i++) {
+        evisum_ui_graph_lod_free(view->series[i].lod);
+        view->series[i].lod = NULL;
         view->series[i].view = NULL;
         view->series[i].legend_row = NULL;
         view->series[i].legend_btn = NULL;
@@ -451,6 +485,8 @@ _evisum_ui_memory_win_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj E
         view->series[i].legend_pb = NULL;
     }
 
+    evisum_ui_graph_backfill_free(view->backfill);
+
     ui->mem.win = NULL;
     free(view);
 }
@@ -469,6 +505,7 @@ evisum_ui_mem_win_add(Evisum_Ui *ui) {
 
     ui->mem.win = win = elm_win_util_standard_add("evisum", _("Memory Usage"));
     elm_win_autodel_set(win, 1);
+    evisum_ui_win_visibility_track(win);
     evas_object_size_hint_weight_set(win, EXPAND, EXPAND);
     evas_object_size_hint_align_set(win, FILL, FILL);
     evas = evas_object_evas_get(win);
@@ -560,6 +597,8 @@ evisum_ui_mem_win_add(Evisum_Ui *ui) {
     evas_object_event_callback_add(tb, EVAS_CALLBACK_KEY_DOWN, _evisum_ui_memory_win_key_down_cb, view);
     evas_object_show(win);
 
-    view->thread = ecore_thread_feedback_run(_evisum_ui_memory_mem_usage_main, _evisum_ui_memory_mem_usage_feedback_cb,
-                                             NULL, NULL, view, 1);
+    // One graph sample per second, moved or not.
+    // The posted Meminfo is static, there is nothing to free.
+    view->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_MEMORY, 1.0, _evisum_ui_memory_mem_usage_main,
+                                        _evisum_ui_memory_mem_usage_feedback_cb, NULL, view);
 }
@@ -1,7 +1,7 @@
 #include "evisum_ui_network.h"
 #include "evisum_ui_graph.h"
+#include "evisum_ui_graph_lod.h"
 #include "../engine/evisum_engine.h"
-#include "../background/evisum_background.h"
 #include "evisum_ui_colors.h"
 #include "config.h"
 
@@ -10,7 +10,7 @@
 */
 
 typedef struct {
-    Ecore_Thread *thread;
+    Evisum_Engine_Subscription *sub;
     Evas_Object *win;
     Evas_Object *menu;
     Evas_Object *graph_bg;
@@ -21,6 +21,7 @@ typedef struct {
 
     Eina_List *interfaces;
     double graph_peak;
+    Evisum_Ui_Graph_Backfill *backfill;
 
     Evisum_Ui *ui;
 } Evisum_Ui_Network_View;
@@ -45,8 +46,7 @@ typedef struct {
     uint64_t in;
     uint64_t out;
 
-    double history[NETWORK_GRAPH_SAMPLES];
-    int history_count;
+    Evisum_Ui_Graph_Lod *lod;
 
     uint8_t color_r;
     uint8_t color_g;
@@ -69,6 +69,12 @@ typedef struct {
     uint64_t total_out;
 } Network_Update_Sample;
 
+typedef struct {
+    Evisum_Ui_Graph_Backfill *backfill;
+    Eina_Hash *last;
+    uint32_t last_time;
+} Network_Backfill;
+
 static void _evisum_ui_network_graph_redraw(Evisum_Ui_Network_View *view, Eina_List *interfaces);
 static const Evisum_Ui_Graph_Layer _network_layers[] = {
     { -0.6, 0.28 },
@@ -231,12 +237,20 @@ _evisum_ui_network_iface_legend_update(Network_View_Interface *iface) {
 }
 
 static void
-_evisum_ui_network_iface_history_add(Network_View_Interface *iface, double value) {
-    if (iface->history_count < NETWORK_GRAPH_SAMPLES) iface->history[iface->history_count++] = value;
-    else {
-        memmove(&iface->history[0], &iface->history[1], sizeof(double) * (NETWORK_GRAPH_SAMPLES - 1));
-        iface->history[NETWORK_GRAPH_SAMPLES - 1] = value;
+_evisum_ui_network_iface_history_add(Evisum_Ui_Network_View *view, Network_View_Interface *iface, double value) {
+    double peak;
+
+    if (!iface->lod) {
+        iface->lod = evisum_ui_graph_backfill_lod_new(view->backfill, iface->name, &peak);
+        if (peak > view->graph_peak) view->graph_peak = peak;
     }
+    evisum_ui_graph_lod_push(iface->lod, value);
+}
+
+static void
+_evisum_ui_network_iface_free(Network_View_Interface *iface) {
+    evisum_ui_graph_lod_free(iface->lod);
+    free(iface);
 }
 
 static void
@@ -245,13 +259,13 @@ _evisum_ui_network_histories_reset(Eina_List *interfaces) {
     Network_View_Interface *iface;
 
     EINA_LIST_FOREACH(interfaces, l, iface) {
-        iface->history_count = 0;
-        memset(iface->history, 0, sizeof(iface->history));
+        evisum_ui_graph_lod_clear(iface->lod);
     }
 }
 
 static void
-_evisum_ui_network_update_samples_free(Eina_List *samples) {
+_evisum_ui_network_update_samples_free(void *data) {
+    Eina_List *samples = data;
     Network_Update_Sample *s;
     EINA_LIST_FREE(samples, s) free(s);
 }
@@ -272,11 +286,13 @@ _evisum_ui_network_graph_redraw(Evisum_Ui_Network_View *view, Eina_List *interfa
     Eina_List *l;
     Network_View_Interface *iface;
     double peak;
-    int total, nseries;
+    int total, nseries, w;
     Evisum_Ui_Graph_Series *series;
 
     if (!_evisum_ui_network_graph_objects_valid(view)) return;
 
+    evas_object_geometry_get(view->graph_bg, NULL, NULL, &w, NULL);
+
     peak = view->graph_peak;
     if (peak < 1.0) peak = 1.0;
 
@@ -286,9 +302,8 @@ _evisum_ui_network_graph_redraw(Evisum_Ui_Network_View *view, Eina_List *interfa
     if ((total > 0) && (!series)) return;
 
     EINA_LIST_FOREACH(interfaces, l, iface) {
-        if (iface->delete_me || !iface->enabled || (iface->history_count < 2)) continue;
-        series[nseries].history = iface->history;
-        series[nseries].history_count = iface->history_count;
+        if (iface->delete_me || !iface->enabled) continue;
+        if (evisum_ui_graph_lod_series_get(iface->lod, NETWORK_GRAPH_SAMPLES, w, &series[nseries]) < 2) continue;
         series[nseries].color_r = iface->color_r;
         series[nseries].color_g = iface->color_g;
         series[nseries].color_b = iface->color_b;
@@ -310,40 +325,80 @@ _evisum_ui_network_graph_bg_resize_cb(void *data, Evas *e EINA_UNUSED, Evas_Obje
 }
 
 static void
-_evisum_ui_network_update(void *data EINA_UNUSED, Ecore_Thread *thread) {
-    uint64_t seq = 0;
-    int ticks = 9;
-
-    ecore_thread_name_set(thread, "network");
-
-    while (!ecore_thread_check(thread)) {
-        Eina_List *samples = NULL;
-
-        if (!evisum_background_update_wait(&seq)) continue;
-        ticks++;
-        if (ticks < 10) continue;
-        ticks = 0;
-        int n;
-        Network_Interface *nwif, **ifaces = system_network_ifaces_get(&n);
-        if (!ifaces) continue;
-
-        for (int i = 0; i < n; i++) {
-            Network_Update_Sample *s;
-
-            nwif = ifaces[i];
-            s = calloc(1, sizeof(*s));
-            if (s) {
-                snprintf(s->name, sizeof(s->name), "%s", nwif->name);
-                s->total_in = nwif->total_in;
-                s->total_out = nwif->total_out;
-                samples = eina_list_append(samples, s);
+_evisum_ui_network_backfill_cb(const Evisum_Engine_History_Sample *sample, void *data) {
+    Network_Backfill *nb = data;
+    Network_Update_Sample *last;
+    Network_Interface *nwif;
+    Eina_List *l;
+    uint32_t elapsed = 0;
+
+    if (nb->last_time && (sample->time > nb->last_time)) elapsed = sample->time - nb->last_time;
+    nb->last_time = sample->time;
+
+    EINA_LIST_FOREACH(sample->network_interfaces, l, nwif) {
+        last = eina_hash_find(nb->last, nwif->name);
+        if (!last) {
+            last = calloc(1, sizeof(Network_Update_Sample));
+            if (!last) continue;
+            snprintf(last->name, sizeof(last->name), "%s", nwif->name);
+            if (!eina_hash_add(nb->last, last->name, last)) {
+                free(last);
+                continue;
             }
+        } else if (elapsed) {
+            double rate = 0.0;
 
+            if ((nwif->total_in >= last->total_in) && (nwif->total_out >= last->total_out))
+                rate = (double) ((nwif->total_in - last->total_in) + (nwif->total_out - last->total_out)) / elapsed;
+            evisum_ui_graph_backfill_add(nb->backfill, nwif->name, rate);
         }
+        last->total_in = nwif->total_in;
+        last->total_out = nwif->total_out;
+    }
+}
+
+static Evisum_Ui_Graph_Backfill *
+_evisum_ui_network_backfill(void) {
+    Network_Backfill nb = { 0 };
+
+    nb.backfill = evisum_ui_graph_backfill_new();
+    nb.last = eina_hash_string_superfast_new(free);
+    if (nb.backfill && nb.last)
+        evisum_engine_history_samples_get(NETWORK_GRAPH_SAMPLES + 1, 1, EVISUM_ENGINE_HISTORY_NETWORK,
+                                          _evisum_ui_network_backfill_cb, &nb);
+    if (nb.last) eina_hash_free(nb.last);
 
-        free(ifaces);
-        if (samples) ecore_thread_feedback(thread, samples);
+    return nb.backfill;
+}
+
+static void
+_evisum_ui_network_update(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
+    Evisum_Ui_Network_View *view = data;
+    Eina_List *samples = NULL;
+    Network_Interface *nwif, **ifaces;
+    int n;
+
+    // Recorded rates for the window, ready before the first live sample.
+    if (!view->backfill) view->backfill = _evisum_ui_network_backfill();
+
+    ifaces = system_network_ifaces_get(&n);
+    if (!ifaces) return;
+
+    for (int i = 0; i < n; i++) {
+        Network_Update_Sample *s;
+
+        nwif = ifaces[i];
+        s = calloc(1, sizeof(*s));
+        if (s) {
+            snprintf(s->name, sizeof(s->name), "%s", nwif->name);
+            s->total_in = nwif->total_in;
+            s->total_out = nwif->total_out;
+            samples = eina_list_append(samples, s);
+        }
     }
+
+    free(ifaces);
+    if (samples) ecore_thread_feedback(thread, samples);
 }
 
 static void
@@ -394,7 +449,7 @@ _evisum_ui_network_update_feedback_cb(void *data, Ecore_Thread *thread EINA_UNUS
     EINA_LIST_FOREACH_SAFE(view->interfaces, l, l2, iface) {
         if (!iface->delete_me) continue;
         _evisum_ui_network_iface_legend_del(iface);
-        free(iface);
+        _evisum_ui_network_iface_free(iface);
         view->interfaces = eina_list_remove_list(view->interfaces, l);
     }
 
@@ -410,7 +465,7 @@ _evisum_ui_network_update_feedback_cb(void *data, Ecore_Thread *thread EINA_UNUS
             _evisum_ui_network_iface_color_apply(iface);
             _evisum_ui_network_iface_legend_add(view, iface);
         }
-        _evisum_ui_network_iface_history_add(iface, rate);
+        _evisum_ui_network_iface_history_add(view, iface, rate);
         if (rate > view->graph_peak) view->graph_peak = rate;
         _evisum_ui_network_iface_legend_update(iface);
     }
@@ -455,21 +510,20 @@ _evisum_ui_network_win_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj
     if (view->menu) evas_object_del(view->menu);
 
     evisum_ui_config_save(ui);
-    if (view->thread) {
-        ecore_thread_cancel(view->thread);
-        ecore_thread_wait(view->thread, 1.0);
-        view->thread = NULL;
-    }
+    evisum_engine_unsubscribe(view->sub, EINA_TRUE);
+    view->sub = NULL;
 
     if (view->interfaces) {
         Network_View_Interface *iface;
         EINA_LIST_FREE(view->interfaces, iface) {
             _evisum_ui_network_iface_legend_del(iface);
-            free(iface);
+            _evisum_ui_network_iface_free(iface);
         }
         view->interfaces = NULL;
     }
 
+    evisum_ui_graph_backfill_free(view->backfill);
+
     ui->network.win = NULL;
     free(view);
 }
@@ -493,6 +547,7 @@ evisum_ui_network_win_add(Evisum_Ui *ui) {
 
     ui->network.win = view->win = win = elm_win_util_standard_add("evisum", _("Network"));
     elm_win_autodel_set(win, 1);
+    evisum_ui_win_visibility_track(win);
     evas_object_size_hint_weight_set(win, EXPAND, EXPAND);
     evas_object_size_hint_align_set(win, FILL, FILL);
     evas_object_event_callback_add(win, EVAS_CALLBACK_DEL, _evisum_ui_network_win_del_cb, view);
@@ -590,6 +645,8 @@ evisum_ui_network_win_add(Evisum_Ui *ui) {
     evas_object_show(win);
     evas_object_event_callback_add(root_bx, EVAS_CALLBACK_MOUSE_MOVE, _evisum_ui_network_win_mouse_move_cb, view);
 
-    view->thread = ecore_thread_feedback_run(_evisum_ui_network_update, _evisum_ui_network_update_feedback_cb, NULL,
-                                             NULL, view, 1);
+    // Idle links log nothing but still plot a zero rate every second.
+    view->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_NETWORK, 1.0, _evisum_ui_network_update,
+                                        _evisum_ui_network_update_feedback_cb, _evisum_ui_network_update_samples_free,
+                                        view);
 }
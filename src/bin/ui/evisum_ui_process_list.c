@@ -4,8 +4,9 @@
 #include "evisum_ui.h"
 #include "evisum_ui_widget_exel.h"
 #include "ui/evisum_ui_process_list.h"
+#include "ui/evisum_ui_process_sort.h"
+#include "ui/evisum_ui_process_search.h"
 #include "ui/evisum_ui_process_view.h"
-#include "../background/evisum_background.h"
 
 #include <stdio.h>
 #define __STDC_FORMAT_MACROS
@@ -21,13 +22,19 @@
 extern int EVISUM_EVENT_CONFIG_CHANGED;
 
 typedef struct {
-    Ecore_Thread *thread;
+    Evisum_Engine_Subscription *sub;
+    Ecore_Timer *start_timer;
     Eina_Hash *icon_cache;
     Ecore_Event_Handler *handler;
-    Eina_Hash *proc_usage_cache;
+    Evisum_Ui_Process_Sort *sorter;
+    int sort_visible_last;
+    unsigned int sort_exact;
+    Eina_Bool first_run;
     Eina_Bool skip_wait;
     Eina_Bool skip_update;
     Eina_Bool update_every_item;
+    Proc_Info **procs;
+    unsigned int procs_count;
     pid_t selected_pid;
     pid_t enigmatic_pid;
     int poll_count;
@@ -47,6 +54,7 @@ typedef struct {
         Evas_Object *entry;
         Eina_Bool visible;
         double keytime;
+        Evisum_Ui_Process_Search *index;
     } search;
 
     struct {
@@ -58,7 +66,6 @@ typedef struct {
 
     Evas_Object *tb_main;
 
-    Elm_Genlist_Item_Class itc;
     Evas_Object *btn_menu;
     Evisum_Ui_Widget_Exel *widget_exel;
 
@@ -98,15 +105,10 @@ typedef struct {
 #define PROC_COL_RESIZE_HIT_WIDTH 8
 #define PROC_COL_MIN_WIDTH        48
 
-typedef struct {
-    int64_t pid;
-    int64_t start;
-    uint32_t sample_time;
-    uint64_t net_in;
-    uint64_t net_out;
-    uint64_t disk_read;
-    uint64_t disk_write;
-} Proc_Usage_Cache;
+// Long lists only order the rows up to the bottom of the visible page, plus
+// some slack, exactly.
+#define PROC_SORT_TOP_MIN   1024
+#define PROC_SORT_TOP_SLACK 64
 
 typedef struct {
     const char *name;
@@ -124,6 +126,24 @@ typedef struct {
     uint32_t end_time;
 } History_Bounds_Request;
 
+// Skip the rest of the poll delay and list processes now.
+static void
+_evisum_ui_process_list_refresh_now(Evisum_Ui_Process_List_View *view) {
+    view->skip_wait = 1;
+    evisum_engine_subscription_refresh(view->sub);
+}
+
+static double
+_evisum_ui_process_list_poll_delay_get(Evisum_Ui_Process_List_View *view) {
+    int delay_secs = view->ui->proc.poll_delay;
+
+    if (delay_secs < 1) delay_secs = 1;
+    else if (delay_secs > 10)
+        delay_secs = 10;
+
+    return delay_secs;
+}
+
 static const Proc_Field_Info _proc_field_info[PROC_FIELD_MAX] = {
     [PROC_FIELD_CMD] =        { N_("COMMAND"), N_("Command"),         PROC_SORT_BY_CMD,        proc_sort_by_cmd        },
     [PROC_FIELD_UID] =        { N_("USER"),    N_("User"),            PROC_SORT_BY_UID,        proc_sort_by_uid        },
@@ -288,14 +308,12 @@ _evisum_ui_process_list_cmd_width_sync(Evisum_Ui_Process_List_View *view, Evas_C
 static void
 _evisum_ui_process_list_fields_update_deferred_cb(void *data) {
     Evisum_Ui_Process_List_View *view = data;
-    view->skip_wait = 1;
+    _evisum_ui_process_list_refresh_now(view);
     view->skip_update = 0;
 }
 
 static void
-_evisum_ui_process_list_fields_cache_reset_done_cb(void *data) {
-    Evisum_Ui_Process_List_View *view = data;
-
+_evisum_ui_process_list_fields_update_schedule(Evisum_Ui_Process_List_View *view) {
     evisum_ui_widget_exel_deferred_call_schedule(view->widget_exel, 1.0,
                                                  _evisum_ui_process_list_fields_update_deferred_cb, view);
 }
@@ -337,11 +355,11 @@ _evisum_ui_process_list_content_reset(Evisum_Ui_Process_List_View *view) {
     elm_table_clear(view->tb_main, 0);
     elm_table_pack(view->tb_main, view->btn_menu, j++, 0, 1, 1);
     j = evisum_ui_widget_exel_fields_pack_visible(view->widget_exel, view->tb_main, j);
-    elm_table_pack(view->tb_main, evisum_ui_widget_exel_genlist_obj_get(view->widget_exel), 0, 1, j, 1);
+    elm_table_pack(view->tb_main, evisum_ui_widget_exel_virtual_obj_get(view->widget_exel), 0, 1, j, 1);
     elm_table_pack(view->tb_main, view->summary.fr, 0, 2, j, 1);
     evas_object_show(view->summary.fr);
-    evisum_ui_widget_exel_genlist_clear(view->widget_exel);
-    evisum_ui_widget_exel_item_cache_reset(view->widget_exel, _evisum_ui_process_list_fields_cache_reset_done_cb, view);
+    evisum_ui_widget_exel_virtual_rows_reset(view->widget_exel);
+    _evisum_ui_process_list_fields_update_schedule(view);
 }
 
 static void
@@ -356,12 +374,6 @@ _evisum_ui_process_list_fields_applied_cb(void *data, Eina_Bool changed) {
     _evisum_ui_process_list_content_reset(view);
 }
 
-static void
-_evisum_ui_process_list_fields_resize_live_cb(void *data) {
-    Evisum_Ui_Process_List_View *view = data;
-    evisum_ui_widget_exel_genlist_realized_items_update(view->widget_exel);
-}
-
 static void
 _evisum_ui_process_list_fields_resize_done_cb(void *data) {
     Evisum_Ui_Process_List_View *view = data;
@@ -413,7 +425,7 @@ _evisum_ui_process_list_btn_clicked_cb(void *data, Evas_Object *obj, void *event
 
     ui->proc.sort_type = type;
     view->skip_update = 0;
-    view->skip_wait = 1;
+    _evisum_ui_process_list_refresh_now(view);
 }
 
 static Evas_Object *
@@ -442,7 +454,7 @@ _evisum_ui_process_list_fields_init(Evisum_Ui_Process_List_View *view) {
     evisum_ui_widget_exel_callbacks_set(
             view->widget_exel, _evisum_ui_process_list_fields_reference_mask_get_cb,
             _evisum_ui_process_list_fields_changed_cb, _evisum_ui_process_list_fields_applied_cb,
-            _evisum_ui_process_list_fields_resize_live_cb, _evisum_ui_process_list_fields_resize_done_cb,
+            NULL, _evisum_ui_process_list_fields_resize_done_cb,
             _evisum_ui_process_list_fields_reordered_cb, view);
 
     for (int i = PROC_FIELD_CMD; i < PROC_FIELD_MAX; i++) {
@@ -475,12 +487,6 @@ _evisum_ui_process_list_fields_init(Evisum_Ui_Process_List_View *view) {
     }
 }
 
-static void
-_evisum_ui_process_list_item_del(void *data, Evas_Object *obj EINA_UNUSED) {
-    Proc_Info *proc = data;
-    proc_info_free(proc);
-}
-
 static void
 _evisum_ui_process_list_run_time_set(char *buf, size_t n, int64_t secs) {
     int rem;
@@ -511,152 +517,279 @@ _evisum_ui_process_list_net_rate_set(char *buf, size_t n, uint64_t rate) {
     snprintf(buf, n, "%.2f %s", value, unit);
 }
 
-static Evas_Object *
-_evisum_ui_process_list_content_get(void *data, Evas_Object *obj, const char *source) {
-    Proc_Info *proc;
+#define PROC_ROW_DIRTY(field) (1u << (field))
+#define PROC_ROW_DIRTY_ALL    (~0u)
+
+/* What a row object currently shows, kept on the row so a refresh only
+ * touches the cells whose text would change. */
+typedef struct {
+    Proc_Info shown;
+    char *command;
+} Proc_Row_State;
+
+static void
+_evisum_ui_process_list_row_state_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                         void *event_info EINA_UNUSED) {
+    Proc_Row_State *state = data;
+
+    free(state->command);
+    free(state);
+}
+
+static Proc_Row_State *
+_evisum_ui_process_list_row_state_get(Evas_Object *row) {
+    Proc_Row_State *state;
+
+    state = evas_object_data_get(row, "proc_row");
+    if (state) return state;
+
+    state = calloc(1, sizeof(Proc_Row_State));
+    if (!state) return NULL;
+
+    state->shown.pid = -1;
+    evas_object_data_set(row, "proc_row", state);
+    evas_object_event_callback_add(row, EVAS_CALLBACK_DEL, _evisum_ui_process_list_row_state_del_cb, state);
+
+    return state;
+}
+
+static void
+_evisum_ui_process_list_row_state_set(Proc_Row_State *state, const Proc_Info *proc, unsigned int dirty) {
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_CMD)) {
+        free(state->command);
+        state->command = strdup(proc->command ?: "");
+    }
+
+    state->shown = *proc;
+    state->shown.command = state->shown.arguments = state->shown.thread_name = NULL;
+    state->shown.fds = state->shown.threads = state->shown.children = NULL;
+}
+
+/* Rows are identified by (pid, start). The same process compares field by
+ * field, anything else is redrawn whole. */
+static unsigned int
+_evisum_ui_process_list_row_dirty_get(const Proc_Row_State *state, const Proc_Info *proc) {
+    const Proc_Info *shown = &state->shown;
+    unsigned int dirty = 0;
+
+    if ((shown->pid != proc->pid) || (shown->start != proc->start) || (shown->is_kernel != proc->is_kernel))
+        return PROC_ROW_DIRTY_ALL;
+
+    if (!state->command || strcmp(state->command, proc->command ?: "")) dirty |= PROC_ROW_DIRTY(PROC_FIELD_CMD);
+    if (shown->uid != proc->uid) dirty |= PROC_ROW_DIRTY(PROC_FIELD_UID);
+    if (shown->numthreads != proc->numthreads) dirty |= PROC_ROW_DIRTY(PROC_FIELD_THREADS);
+    if (shown->cpu_id != proc->cpu_id) dirty |= PROC_ROW_DIRTY(PROC_FIELD_CPU);
+    if (shown->priority != proc->priority) dirty |= PROC_ROW_DIRTY(PROC_FIELD_PRI);
+    if (shown->nice != proc->nice) dirty |= PROC_ROW_DIRTY(PROC_FIELD_NICE);
+    if (shown->numfiles != proc->numfiles) dirty |= PROC_ROW_DIRTY(PROC_FIELD_FILES);
+    if (shown->mem_size != proc->mem_size) dirty |= PROC_ROW_DIRTY(PROC_FIELD_SIZE);
+    if (shown->mem_virt != proc->mem_virt) dirty |= PROC_ROW_DIRTY(PROC_FIELD_VIRT);
+    if (shown->mem_rss != proc->mem_rss) dirty |= PROC_ROW_DIRTY(PROC_FIELD_RSS);
+    if (shown->mem_shared != proc->mem_shared) dirty |= PROC_ROW_DIRTY(PROC_FIELD_SHARED);
+    if (strcmp(shown->state, proc->state) || strcmp(shown->wchan, proc->wchan))
+        dirty |= PROC_ROW_DIRTY(PROC_FIELD_STATE);
+    if (shown->run_time != proc->run_time) dirty |= PROC_ROW_DIRTY(PROC_FIELD_TIME);
+    if (!EINA_DBL_EQ(shown->cpu_usage, proc->cpu_usage)) dirty |= PROC_ROW_DIRTY(PROC_FIELD_CPU_USAGE);
+    if (shown->net_in_rate != proc->net_in_rate) dirty |= PROC_ROW_DIRTY(PROC_FIELD_NET_IN);
+    if (shown->net_out_rate != proc->net_out_rate) dirty |= PROC_ROW_DIRTY(PROC_FIELD_NET_OUT);
+    if (shown->disk_read_rate != proc->disk_read_rate) dirty |= PROC_ROW_DIRTY(PROC_FIELD_DISK_READ);
+    if (shown->disk_write_rate != proc->disk_write_rate) dirty |= PROC_ROW_DIRTY(PROC_FIELD_DISK_WRITE);
+
+    return dirty;
+}
+
+static void
+_evisum_ui_process_list_row_fill(Evisum_Ui_Process_List_View *view, Evas_Object *row, Proc_Info *proc,
+                                 Eina_Bool all) {
+    Proc_Row_State *state;
     struct passwd *pwd_entry;
     Evas_Object *cell, *o;
     char buf[128];
     Evas_Coord w, ow, bw;
     Evisum_Ui *ui;
-    Evisum_Ui_Process_List_View *view;
     const char *icon_name, *icon_old, *icon_new;
+    unsigned int dirty;
 
-    view = evas_object_data_get(obj, "widget_exel_data");
-    if (!view) return NULL;
     ui = view->ui;
-    proc = (void *) data;
 
-    if (!source || strcmp(source, "elm.swallow.content")) return NULL;
-    if (!proc) return NULL;
+    state = _evisum_ui_process_list_row_state_get(row);
+    dirty = (all || !state) ? PROC_ROW_DIRTY_ALL : _evisum_ui_process_list_row_dirty_get(state, proc);
+    if (!dirty) return;
 
-    Evas_Object *row = evisum_ui_widget_exel_item_cache_object_get(view->widget_exel);
-    if (!row) return NULL;
-
-    evas_object_geometry_get(view->btn_menu, NULL, NULL, &bw, NULL);
-    w = evisum_ui_widget_exel_field_width_get(view->widget_exel, PROC_FIELD_CMD);
-    w += bw;
-
-    snprintf(buf, sizeof(buf), "%s", proc->command ?: "");
-    cell = evisum_ui_widget_exel_item_object_get(row, "cmd");
-    evisum_ui_widget_exel_item_text_object_if_changed_set(cell, buf);
-    evas_object_geometry_get(cell, NULL, NULL, &ow, NULL);
-    ow += bw;
-    _evisum_ui_process_list_cmd_width_sync(view, ow);
-
-    icon_name = evisum_icon_cache_find(view->icon_cache, proc);
-    icon_new = evisum_ui_icon_name_get(icon_name);
-    icon_old = NULL;
-    o = evisum_ui_widget_exel_item_object_get(row, "icon");
-    elm_image_file_get(o, &icon_old, NULL);
-    if ((!icon_old) || strcmp(icon_old, icon_new)) evisum_ui_icon_set(o, icon_name);
-    evisum_ui_widget_exel_item_column_width_apply(
-            o, w, evisum_ui_widget_exel_field_is_last_visible(view->widget_exel, PROC_FIELD_CMD));
-    evas_object_show(o);
-
-    cell = evisum_ui_widget_exel_item_field_cell_get(view->widget_exel, row, PROC_FIELD_UID, "uid");
-    if (cell) {
-        pwd_entry = getpwuid(proc->uid);
-        if (pwd_entry) snprintf(buf, sizeof(buf), "%s", pwd_entry->pw_name);
-        else snprintf(buf, sizeof(buf), "%i", proc->uid);
-        evisum_ui_widget_exel_item_text_object_if_changed_set(cell, buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_CMD)) {
+        evas_object_geometry_get(view->btn_menu, NULL, NULL, &bw, NULL);
+        w = evisum_ui_widget_exel_field_width_get(view->widget_exel, PROC_FIELD_CMD);
+        w += bw;
 
+        snprintf(buf, sizeof(buf), "%s", proc->command ?: "");
+        cell = evisum_ui_widget_exel_item_object_get(row, "cmd");
+        evisum_ui_widget_exel_item_text_object_if_changed_set(cell, buf);
         evas_object_geometry_get(cell, NULL, NULL, &ow, NULL);
-        w = evisum_ui_widget_exel_field_width_get(view->widget_exel, PROC_FIELD_UID);
-        if (ow > w) {
-            evisum_ui_widget_exel_field_min_width_set(view->widget_exel, PROC_FIELD_UID, ow);
-            _evisum_ui_process_list_content_update_all(view);
+        ow += bw;
+        _evisum_ui_process_list_cmd_width_sync(view, ow);
+
+        icon_name = evisum_icon_cache_find(view->icon_cache, proc);
+        icon_new = evisum_ui_icon_name_get(icon_name);
+        icon_old = NULL;
+        o = evisum_ui_widget_exel_item_object_get(row, "icon");
+        elm_image_file_get(o, &icon_old, NULL);
+        if ((!icon_old) || strcmp(icon_old, icon_new)) evisum_ui_icon_set(o, icon_name);
+        evisum_ui_widget_exel_item_column_width_apply(
+                o, w, evisum_ui_widget_exel_field_is_last_visible(view->widget_exel, PROC_FIELD_CMD));
+        evas_object_show(o);
+    }
+
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_UID)) {
+        cell = evisum_ui_widget_exel_item_field_cell_get(view->widget_exel, row, PROC_FIELD_UID, "uid");
+        if (cell) {
+            pwd_entry = getpwuid(proc->uid);
+            if (pwd_entry) snprintf(buf, sizeof(buf), "%s", pwd_entry->pw_name);
+            else snprintf(buf, sizeof(buf), "%i", proc->uid);
+            evisum_ui_widget_exel_item_text_object_if_changed_set(cell, buf);
+
+            evas_object_geometry_get(cell, NULL, NULL, &ow, NULL);
+            w = evisum_ui_widget_exel_field_width_get(view->widget_exel, PROC_FIELD_UID);
+            if (ow > w) {
+                evisum_ui_widget_exel_field_min_width_set(view->widget_exel, PROC_FIELD_UID, ow);
+                _evisum_ui_process_list_content_update_all(view);
+            }
         }
     }
 
-    snprintf(buf, sizeof(buf), "%d", proc->pid);
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_PID, "pid", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_PID)) {
+        snprintf(buf, sizeof(buf), "%d", proc->pid);
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_PID, "pid", buf);
+    }
 
-    snprintf(buf, sizeof(buf), "%d", proc->numthreads);
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_THREADS, "thr", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_THREADS)) {
+        snprintf(buf, sizeof(buf), "%d", proc->numthreads);
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_THREADS, "thr", buf);
+    }
 
-    snprintf(buf, sizeof(buf), "%d", proc->cpu_id);
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_CPU, "cpu", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_CPU)) {
+        snprintf(buf, sizeof(buf), "%d", proc->cpu_id);
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_CPU, "cpu", buf);
+    }
 
-    snprintf(buf, sizeof(buf), "%d", proc->priority);
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_PRI, "prio", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_PRI)) {
+        snprintf(buf, sizeof(buf), "%d", proc->priority);
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_PRI, "prio", buf);
+    }
 
-    snprintf(buf, sizeof(buf), "%d", proc->nice);
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_NICE, "nice", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_NICE)) {
+        snprintf(buf, sizeof(buf), "%d", proc->nice);
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_NICE, "nice", buf);
+    }
 
-    snprintf(buf, sizeof(buf), "%d", proc->numfiles);
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_FILES, "files", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_FILES)) {
+        snprintf(buf, sizeof(buf), "%d", proc->numfiles);
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_FILES, "files", buf);
+    }
 
-    if (!proc->is_kernel) snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_size, 1));
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_SIZE)) {
+        if (!proc->is_kernel) snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_size, 1));
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_SIZE, "size", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_SIZE, "size", buf);
 
-    if (!proc->is_kernel) snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_virt, 1));
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_VIRT)) {
+        if (!proc->is_kernel) snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_virt, 1));
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_VIRT, "virt", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_VIRT, "virt", buf);
 
-    if ((!proc->is_kernel) || (ui->kthreads_has_rss))
-        snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_rss, 1));
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_RSS)) {
+        if ((!proc->is_kernel) || (ui->kthreads_has_rss))
+            snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_rss, 1));
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_RSS, "rss", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_RSS, "rss", buf);
 
-    if (!proc->is_kernel) snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_shared, 1));
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_SHARED)) {
+        if (!proc->is_kernel) snprintf(buf, sizeof(buf), "%s", evisum_size_format(proc->mem_shared, 1));
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_SHARED, "share", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_SHARED, "share", buf);
 
-    if ((ui->proc.has_wchan) && (proc->state[0] == 's' && proc->state[1] == 'l'))
-        snprintf(buf, sizeof(buf), "%s", proc->wchan ?: _("-"));
-    else snprintf(buf, sizeof(buf), "%s", proc->state ?: _("-"));
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_STATE, "state", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_STATE)) {
+        if ((ui->proc.has_wchan) && (proc->state[0] == 's' && proc->state[1] == 'l'))
+            snprintf(buf, sizeof(buf), "%s", proc->wchan ?: _("-"));
+        else snprintf(buf, sizeof(buf), "%s", proc->state ?: _("-"));
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_STATE, "state", buf);
+    }
 
-    _evisum_ui_process_list_run_time_set(buf, sizeof(buf), proc->run_time);
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_TIME, "time", buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_TIME)) {
+        _evisum_ui_process_list_run_time_set(buf, sizeof(buf), proc->run_time);
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_TIME, "time", buf);
+    }
 
-    snprintf(buf, sizeof(buf), _("%1.0f %%"), proc->cpu_usage);
-    evisum_ui_widget_exel_item_field_progress_set(view->widget_exel, row, PROC_FIELD_CPU_USAGE, "cpu_u",
-                                                  proc->cpu_usage / 100.0, buf);
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_CPU_USAGE)) {
+        snprintf(buf, sizeof(buf), _("%1.0f %%"), proc->cpu_usage);
+        evisum_ui_widget_exel_item_field_progress_set(view->widget_exel, row, PROC_FIELD_CPU_USAGE, "cpu_u",
+                                                      proc->cpu_usage / 100.0, buf);
+    }
 
-    if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->net_in);
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_NET_IN)) {
+        if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->net_in_rate);
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_NET_IN, "net_in", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_NET_IN, "net_in", buf);
 
-    if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->net_out);
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_NET_OUT)) {
+        if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->net_out_rate);
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_NET_OUT, "net_out", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_NET_OUT, "net_out", buf);
 
-    if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->disk_read);
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_DISK_READ)) {
+        if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->disk_read_rate);
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_DISK_READ, "disk_read", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_DISK_READ, "disk_read", buf);
 
-    if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->disk_write);
-    else {
-        buf[0] = '-';
-        buf[1] = '\0';
+    if (dirty & PROC_ROW_DIRTY(PROC_FIELD_DISK_WRITE)) {
+        if (!proc->is_kernel) _evisum_ui_process_list_net_rate_set(buf, sizeof(buf), proc->disk_write_rate);
+        else {
+            buf[0] = '-';
+            buf[1] = '\0';
+        }
+        evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_DISK_WRITE, "disk_write", buf);
     }
-    evisum_ui_widget_exel_item_field_text_set(view->widget_exel, row, PROC_FIELD_DISK_WRITE, "disk_write", buf);
 
-    return row;
+    if (state) _evisum_ui_process_list_row_state_set(state, proc, dirty);
+}
+
+/* Rows of the table are realised only for the viewport and keep their
+ * object while scrolling; a row showing the same process again only has the
+ * cells that changed rewritten. */
+static void
+_evisum_ui_process_list_row_fill_cb(void *data, Evas_Object *row, unsigned int index, Eina_Bool full) {
+    Evisum_Ui_Process_List_View *view = data;
+
+    if (index >= view->procs_count) return;
+
+    _evisum_ui_process_list_row_fill(view, row, view->procs[index], full);
 }
 
 static void
@@ -799,7 +932,7 @@ _evisum_ui_process_list_history_apply_timer_cb(void *data) {
 
     /* Snapshot loading happens on the process-list worker; this callback only
      * marks the most recent requested time as ready to be loaded. */
-    view->skip_wait = 1;
+    _evisum_ui_process_list_refresh_now(view);
     view->skip_update = 0;
     view->history.apply_timer = NULL;
     _evisum_ui_process_list_loader_show(view);
@@ -1157,7 +1290,7 @@ _evisum_ui_process_list_history_live_clicked_cb(void *data, Evas_Object *obj EIN
 
     elm_object_disabled_set(view->summary.history_live_btn, 1);
     _evisum_ui_process_list_loader_hide(view);
-    view->skip_wait = 1;
+    _evisum_ui_process_list_refresh_now(view);
     view->skip_update = 0;
     _evisum_ui_process_list_history_bounds_update(view);
 }
@@ -1280,11 +1413,21 @@ _evisum_ui_process_list_summary_add(Evisum_Ui_Process_List_View *view) {
 static Eina_List *
 _evisum_ui_process_list_sort(Eina_List *list, Evisum_Ui_Process_List_View *view) {
     Evisum_Ui *ui;
+    unsigned int top = 0, exact = 0;
+
     ui = view->ui;
 
-    list = eina_list_sort(list, eina_list_count(list), _proc_field_info[ui->proc.sort_type].sort_cb);
+    if (eina_list_count(list) >= PROC_SORT_TOP_MIN) top = view->sort_visible_last + 1 + PROC_SORT_TOP_SLACK;
+
+    if (view->sorter)
+        list = evisum_ui_process_sort_list(view->sorter, list, ui->proc.sort_type, ui->proc.sort_reverse, top, &exact);
 
-    if (ui->proc.sort_reverse) list = eina_list_reverse(list);
+    if (!exact) {
+        list = eina_list_sort(list, eina_list_count(list), _proc_field_info[ui->proc.sort_type].sort_cb);
+        if (ui->proc.sort_reverse) list = eina_list_reverse(list);
+        exact = eina_list_count(list);
+    }
+    view->sort_exact = exact;
 
     return list;
 }
@@ -1304,23 +1447,8 @@ _evisum_ui_process_list_uid_trim(Eina_List *list, uid_t uid) {
     return list;
 }
 
-static void
-_evisum_ui_process_list_usage_cache_free_cb(void *data) {
-    Proc_Usage_Cache *cache = data;
-    free(cache);
-}
-
-static uint32_t
-_evisum_ui_process_list_sample_time_get(void) {
-    uint32_t sample_time;
-
-    sample_time = evisum_engine_history_time_get();
-    if (!sample_time) sample_time = evisum_engine_live_time_get();
-    return sample_time;
-}
-
 static Eina_Bool
-_evisum_ui_process_list_process_ignore(Evisum_Ui_Process_List_View *view, Proc_Info *proc) {
+_evisum_ui_process_list_process_ignore(Evisum_Ui_Process_List_View *view, Proc_Info *proc, Eina_Bool indexed) {
     Evisum_Ui *ui = view->ui;
     const char *command;
 
@@ -1329,7 +1457,9 @@ _evisum_ui_process_list_process_ignore(Evisum_Ui_Process_List_View *view, Proc_I
         if (view->enigmatic_pid && (proc->pid == view->enigmatic_pid)) return 1;
     }
 
-    if (!view->search.text || !view->search.len) return 0;
+    if (indexed) return !evisum_ui_process_search_match(view->search.index, proc->pid);
+
+    if (!view->search.text || !view->search.len || !strcmp(view->search.text, "^")) return 0;
 
     command = proc->command;
     if (!command || !command[0]) return 1;
@@ -1341,112 +1471,30 @@ _evisum_ui_process_list_process_ignore(Evisum_Ui_Process_List_View *view, Proc_I
 }
 
 static Eina_List *
-_evisum_ui_process_list_search_trim_cache(Eina_List *list, Evisum_Ui_Process_List_View *view) {
+_evisum_ui_process_list_search_trim(Eina_List *list, Evisum_Ui_Process_List_View *view) {
     Eina_List *l, *l_next;
-    Eina_List *purge = NULL;
     Proc_Info *proc;
-    Proc_Usage_Cache *cache;
-    Eina_Hash *active_pids;
-    uint32_t sample_time;
-    void *d = NULL;
+    const char *text = view->search.text;
+    Eina_Bool indexed = EINA_FALSE;
 
-    sample_time = _evisum_ui_process_list_sample_time_get();
-    active_pids = eina_hash_int64_new(NULL);
+    // The index follows every refresh, so the first keystroke finds it warm.
+    if (view->search.index) evisum_ui_process_search_update(view->search.index, list);
 
-    EINA_LIST_FOREACH_SAFE(list, l, l_next, proc) {
-        int64_t id = proc->pid;
+    // A leading ^ anchors the search to the start of the command or path.
+    if (view->search.index && text && text[0] && strcmp(text, "^")) {
+        Eina_Bool prefix = text[0] == '^';
 
-        if (active_pids)
-            eina_hash_add(active_pids, &id, proc);
+        evisum_ui_process_search_query(view->search.index, prefix ? text + 1 : text, prefix);
+        indexed = EINA_TRUE;
+    }
 
-        if (_evisum_ui_process_list_process_ignore(view, proc)) {
+    EINA_LIST_FOREACH_SAFE(list, l, l_next, proc) {
+        if (_evisum_ui_process_list_process_ignore(view, proc, indexed)) {
             proc_info_free(proc);
             list = eina_list_remove_list(list, l);
-        } else {
-            if ((cache = eina_hash_find(view->proc_usage_cache, &id))) {
-                uint64_t net_in_abs = proc->net_in;
-                uint64_t net_out_abs = proc->net_out;
-                uint64_t disk_read_abs = proc->disk_read;
-                uint64_t disk_write_abs = proc->disk_write;
-                int elapsed = 1;
-
-                if (sample_time && cache->sample_time && (sample_time > cache->sample_time))
-                    elapsed = sample_time - cache->sample_time;
-
-                if (cache->start != proc->start) {
-                    cache->start = proc->start;
-                    cache->sample_time = sample_time;
-                    cache->net_in = net_in_abs;
-                    cache->net_out = net_out_abs;
-                    cache->disk_read = proc->disk_read;
-                    cache->disk_write = proc->disk_write;
-                    proc->net_in = 0;
-                    proc->net_out = 0;
-                    proc->disk_read = 0;
-                    proc->disk_write = 0;
-                    continue;
-                }
-
-                if (cache->net_in && net_in_abs >= cache->net_in) proc->net_in = (net_in_abs - cache->net_in) / elapsed;
-                else proc->net_in = 0;
-
-                if (cache->net_out && net_out_abs >= cache->net_out)
-                    proc->net_out = (net_out_abs - cache->net_out) / elapsed;
-                else proc->net_out = 0;
-
-                if (cache->disk_read && disk_read_abs >= cache->disk_read)
-                    proc->disk_read = (disk_read_abs - cache->disk_read) / elapsed;
-                else proc->disk_read = 0;
-
-                if (cache->disk_write && disk_write_abs >= cache->disk_write)
-                    proc->disk_write = (disk_write_abs - cache->disk_write) / elapsed;
-                else proc->disk_write = 0;
-
-                cache->net_in = net_in_abs;
-                cache->net_out = net_out_abs;
-                cache->disk_read = disk_read_abs;
-                cache->disk_write = disk_write_abs;
-                cache->sample_time = sample_time;
-            } else {
-                cache = calloc(1, sizeof(Proc_Usage_Cache));
-                if (cache) {
-                    uint64_t net_in_abs = proc->net_in;
-                    uint64_t net_out_abs = proc->net_out;
-                    cache->pid = id;
-                    cache->start = proc->start;
-                    cache->sample_time = sample_time;
-                    cache->net_in = net_in_abs;
-                    cache->net_out = net_out_abs;
-                    cache->disk_read = proc->disk_read;
-                    cache->disk_write = proc->disk_write;
-                    proc->net_in = 0;
-                    proc->net_out = 0;
-                    proc->disk_read = 0;
-                    proc->disk_write = 0;
-                    if (!eina_hash_add(view->proc_usage_cache, &id, cache))
-                        free(cache);
-                }
-            }
         }
     }
 
-    if (active_pids) {
-        Eina_Iterator *it = eina_hash_iterator_data_new(view->proc_usage_cache);
-        while (eina_iterator_next(it, &d)) {
-            cache = d;
-            if (!eina_hash_find(active_pids, &cache->pid))
-                purge = eina_list_prepend(purge, cache);
-        }
-        eina_iterator_free(it);
-
-        EINA_LIST_FREE(purge, cache) {
-            int64_t id = cache->pid;
-            eina_hash_del(view->proc_usage_cache, &id, NULL);
-        }
-
-        eina_hash_free(active_pids);
-    }
-
     return list;
 }
 
@@ -1463,98 +1511,68 @@ _evisum_ui_process_list_get(Evisum_Ui_Process_List_View *view) {
 
     if (ui->proc.show_user) list = _evisum_ui_process_list_uid_trim(list, getuid());
 
-    list = _evisum_ui_process_list_search_trim_cache(list, view);
+    list = _evisum_ui_process_list_search_trim(list, view);
     list = _evisum_ui_process_list_sort(list, view);
 
     return list;
 }
 
 static void
-_evisum_ui_process_list_process_list(void *data, Ecore_Thread *thread) {
+_evisum_ui_process_list_process_list(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
     Evisum_Ui_Process_List_View *view;
     Eina_List *list;
     Proc_Info *proc;
-    int ticks = 0;
-    uint64_t seq = 0;
-    Eina_Bool first_run = EINA_TRUE;
+    Eina_Bool history_live, history_pending;
+    Eina_Bool history_loaded = EINA_FALSE;
+    uint32_t history_time;
 
     view = data;
 
-    ecore_thread_name_set(thread, "process_list");
-    /* Allow time for initial sizing calculations, we obtain our data
-     * instantaneously using enigmatic, launch can be problematic.
-     *
-     * For reference macOS Activity Monitor waits 3 seconds, this is
-     * not painful and is visually pleasing.
-     */
-    usleep(1000000);
-
-    while (!ecore_thread_check(thread)) {
-        Eina_Bool history_live, history_pending;
-        Eina_Bool history_loaded = EINA_FALSE;
-        uint32_t history_time;
-
-        _evisum_ui_process_list_history_state_get(view, &history_live, &history_pending, &history_time);
-        if (!history_live) {
-            /* In history mode the worker sleeps until the UI debounce marks a
-             * timestamp pending. This keeps slider previews cheap. */
-            if (!history_pending && !first_run && !view->skip_wait) {
-                usleep(50000);
-                continue;
-            }
-            if (history_time) {
-                Eina_Bool live_now;
-
-                /* A missing timestamp means the log range changed underneath
-                 * us. Return to live mode and let the UI refresh its bounds. */
-                if (!evisum_engine_history_time_set(history_time)) {
-                    evisum_engine_history_live_set();
-                    _evisum_ui_process_list_history_live_state_set(view);
-                    view->skip_wait = 1;
-                    ecore_thread_feedback(thread, NULL);
-                    continue;
-                }
-                _evisum_ui_process_list_history_state_get(view, &live_now, NULL, NULL);
-                if (live_now) evisum_engine_history_live_set();
-                else {
-                    _evisum_ui_process_list_history_pending_clear(view, history_time);
-                    history_loaded = EINA_TRUE;
-                    /* Snapshot rows can keep the same item count while every
-                     * field changes, so refresh all item content after a load. */
-                    view->update_every_item = 1;
-                }
+    _evisum_ui_process_list_history_state_get(view, &history_live, &history_pending, &history_time);
+    if (!history_live) {
+        /* In history mode periodic runs do nothing, the UI debounce marks a
+         * timestamp pending and asks for a run. This keeps slider previews
+         * cheap. */
+        if (!history_pending && !view->first_run && !view->skip_wait) return;
+        if (history_time) {
+            Eina_Bool live_now;
+
+            /* A missing timestamp means the log range changed underneath
+             * us. Return to live mode and let the UI refresh its bounds. */
+            if (!evisum_engine_history_time_set(history_time)) {
+                evisum_engine_history_live_set();
+                _evisum_ui_process_list_history_live_state_set(view);
+                view->skip_wait = 1;
+                ecore_thread_feedback(thread, NULL);
+                return;
             }
-        } else if (!first_run && !view->skip_wait) {
-            int delay_secs = view->ui->proc.poll_delay;
-            int target_ticks;
-            if (delay_secs < 1) delay_secs = 1;
-            else if (delay_secs > 10)
-                delay_secs = 10;
-            target_ticks = delay_secs * 10;
-            if (!evisum_background_update_wait(&seq)) continue;
-            ticks++;
-            if (ticks < target_ticks) continue;
-        }
-        view->skip_wait = 0;
-        ticks = 0;
-        list = _evisum_ui_process_list_get(view);
-        if (!list) {
-            if (!history_live) ecore_thread_feedback(thread, NULL);
-            if (first_run) {
-                if (!evisum_background_update_wait(&seq)) continue;
+            _evisum_ui_process_list_history_state_get(view, &live_now, NULL, NULL);
+            if (live_now) evisum_engine_history_live_set();
+            else {
+                _evisum_ui_process_list_history_pending_clear(view, history_time);
+                history_loaded = EINA_TRUE;
+                /* Snapshot rows can keep the same item count while every
+                 * field changes, so refresh all item content after a load. */
+                view->update_every_item = 1;
             }
-            continue;
         }
-        first_run = EINA_FALSE;
-        /* Snapshot loads bypass skip_update so the loaded historical state is
-         * always pushed to the UI even during rapid scrubbing. */
-        if (history_loaded || !view->skip_update) ecore_thread_feedback(thread, list);
-        else {
-            EINA_LIST_FREE(list, proc)
-            proc_info_free(proc);
-        }
-        view->skip_update = 0;
     }
+    view->skip_wait = 0;
+    list = _evisum_ui_process_list_get(view);
+    if (!list) {
+        // The first list is retried on the next snapshot.
+        if (!history_live || view->first_run) ecore_thread_feedback(thread, NULL);
+        return;
+    }
+    view->first_run = EINA_FALSE;
+    /* Snapshot loads bypass skip_update so the loaded historical state is
+     * always pushed to the UI even during rapid scrubbing. */
+    if (history_loaded || !view->skip_update) ecore_thread_feedback(thread, list);
+    else {
+        EINA_LIST_FREE(list, proc)
+        proc_info_free(proc);
+    }
+    view->skip_update = 0;
 }
 
 static void
@@ -1564,18 +1582,41 @@ _evisum_ui_process_list_indicator(Evisum_Ui_Process_List_View *view) {
     }
 }
 
+static void
+_evisum_ui_process_list_procs_clear(Evisum_Ui_Process_List_View *view) {
+    for (unsigned int i = 0; i < view->procs_count; i++) proc_info_free(view->procs[i]);
+    free(view->procs);
+    view->procs = NULL;
+    view->procs_count = 0;
+}
+
+static void
+_evisum_ui_process_list_feedback_free(void *msg) {
+    Eina_List *list = msg;
+    Proc_Info *proc;
+
+    EINA_LIST_FREE(list, proc) proc_info_free(proc);
+}
+
 static void
 _evisum_ui_process_list_feedback_cb(void *data, Ecore_Thread *thread EINA_UNUSED, void *msg EINA_UNUSED) {
     Evisum_Ui_Process_List_View *view;
     Eina_List *list;
-    Proc_Info *proc;
-    Elm_Object_Item *it;
+    Proc_Info *proc, **procs;
     unsigned int n;
 
     view = data;
     list = msg;
-    if (!view || !view->widget_exel) return;
+    if (!view || !view->widget_exel) {
+        _evisum_ui_process_list_feedback_free(list);
+        return;
+    }
     if (!list) {
+        if (view->skip_wait) evisum_engine_subscription_refresh(view->sub);
+        else if (view->first_run) {
+            evisum_engine_subscription_expire(view->sub);
+            return;
+        }
         _evisum_ui_process_list_loader_hide(view);
         _evisum_ui_process_list_summary_update(view);
         return;
@@ -1583,24 +1624,23 @@ _evisum_ui_process_list_feedback_cb(void *data, Ecore_Thread *thread EINA_UNUSED
 
     n = eina_list_count(list);
 
-    evisum_ui_widget_exel_genlist_items_ensure(view->widget_exel, n, &view->itc);
-
-    it = evisum_ui_widget_exel_genlist_first_item_get(view->widget_exel);
-    EINA_LIST_FREE(list, proc) {
-        if (!it) {
-            proc_info_free(proc);
-            continue;
-        }
-        Proc_Info *prev = evisum_ui_widget_exel_object_item_data_get(it);
-        if (prev) proc_info_free(prev);
+    procs = malloc(n * sizeof(Proc_Info *));
+    if (!procs) {
+        EINA_LIST_FREE(list, proc) proc_info_free(proc);
+        return;
+    }
 
-        evisum_ui_widget_exel_object_item_data_set(it, proc);
-        if (view->update_every_item) evisum_ui_widget_exel_genlist_item_update(it);
+    n = 0;
+    EINA_LIST_FREE(list, proc) procs[n++] = proc;
 
-        it = evisum_ui_widget_exel_genlist_item_next_get(it);
-    }
+    // Rows still hold a copy of what they show, so the old entries can go
+    // before the table is filled from the new ones.
+    _evisum_ui_process_list_procs_clear(view);
+    view->procs = procs;
+    view->procs_count = n;
 
-    if (!view->update_every_item) evisum_ui_widget_exel_genlist_realized_items_update(view->widget_exel);
+    evisum_ui_widget_exel_virtual_count_set(view->widget_exel, n);
+    evisum_ui_widget_exel_virtual_rows_update(view->widget_exel, view->update_every_item);
     view->update_every_item = 0;
 
     _evisum_ui_process_list_summary_update(view);
@@ -1614,12 +1654,7 @@ _evisum_ui_process_list_feedback_cb(void *data, Ecore_Thread *thread EINA_UNUSED
         }
     }
 
-    Eina_List *real = evisum_ui_widget_exel_genlist_realized_items_get(view->widget_exel);
-    n = evisum_ui_widget_exel_item_cache_active_count_get(view->widget_exel);
-    if (n > eina_list_count(real) * 2) {
-        evisum_ui_widget_exel_item_cache_steal(view->widget_exel, real);
-    }
-    eina_list_free(real);
+    evisum_ui_widget_exel_genlist_realized_range_get(view->widget_exel, NULL, &view->sort_visible_last);
 
 
     view->poll_count++;
@@ -1814,8 +1849,8 @@ _evisum_ui_process_list_item_pid_secondary_clicked_cb(void *data, Evas *e EINA_U
     Evas_Object *menu;
     Evas_Event_Mouse_Up *ev;
     Evisum_Ui_Process_List_View *view;
-    Elm_Object_Item *it;
     Proc_Info *proc;
+    int index;
 
     ev = event_info;
     if (!ev) return;
@@ -1823,10 +1858,9 @@ _evisum_ui_process_list_item_pid_secondary_clicked_cb(void *data, Evas *e EINA_U
     view = data;
 
     (void) obj;
-    it = evisum_ui_widget_exel_genlist_at_xy_item_get(view->widget_exel, ev->output.x, ev->output.y, NULL);
-    if (!it) return;
-    proc = evisum_ui_widget_exel_object_item_data_get(it);
-    if (!proc) return;
+    index = evisum_ui_widget_exel_virtual_index_at_xy(view->widget_exel, ev->canvas.x, ev->canvas.y);
+    if ((index < 0) || ((unsigned int) index >= view->procs_count)) return;
+    proc = view->procs[index];
 
     menu = _evisum_ui_process_list_item_menu_create(view, proc);
     if (!menu) return;
@@ -1836,20 +1870,15 @@ _evisum_ui_process_list_item_pid_secondary_clicked_cb(void *data, Evas *e EINA_U
 }
 
 static void
-_evisum_ui_process_list_item_pid_clicked_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info) {
-    Elm_Object_Item *it;
+_evisum_ui_process_list_item_pid_clicked_cb(void *data, unsigned int index) {
     Proc_Info *proc;
     Evisum_Ui_Process_List_View *view;
 
     view = data;
-    it = event_info;
-    if (!it) return;
-
-    evisum_ui_widget_exel_genlist_item_selected_set(it, 0);
     if (view->menu) return;
+    if (index >= view->procs_count) return;
 
-    proc = evisum_ui_widget_exel_object_item_data_get(it);
-    if (!proc) return;
+    proc = view->procs[index];
 
     view->selected_pid = proc->pid;
     evisum_ui_process_view_win_add(view->ui, proc->pid, PROC_VIEW_DEFAULT);
@@ -1873,11 +1902,11 @@ _evisum_ui_process_list_glist_scroll_stopped_cb(void *data, Evas_Object *obj EIN
     view = data;
 
     evisum_ui_widget_exel_genlist_region_get(view->widget_exel, NULL, &oy, NULL, NULL);
+    evisum_ui_widget_exel_genlist_realized_range_get(view->widget_exel, NULL, &view->sort_visible_last);
 
     if (oy != prev_oy) {
-        view->skip_wait = 1;
+        _evisum_ui_process_list_refresh_now(view);
         view->skip_update = 0;
-        evisum_ui_widget_exel_genlist_realized_items_update(view->widget_exel);
     }
     prev_oy = oy;
 }
@@ -1942,16 +1971,9 @@ _evisum_ui_process_list_content_add(Evisum_Ui_Process_List_View *view, Evas_Obje
     _evisum_ui_process_list_fields_init(view);
     if (!view->widget_exel) return scr;
 
-    evisum_ui_widget_exel_genlist_add(view->widget_exel, parent);
-    glist = evisum_ui_widget_exel_genlist_obj_get(view->widget_exel);
-
-    view->itc.item_style = "full";
-    view->itc.func.text_get = NULL;
-    view->itc.func.content_get = _evisum_ui_process_list_content_get;
-    view->itc.func.filter_get = NULL;
-    view->itc.func.del = _evisum_ui_process_list_item_del;
+    glist = evisum_ui_widget_exel_virtual_add(view->widget_exel, parent, _evisum_ui_process_list_row_fill_cb,
+                                              _evisum_ui_process_list_item_pid_clicked_cb, view);
 
-    evas_object_smart_callback_add(glist, "selected", _evisum_ui_process_list_item_pid_clicked_cb, view);
     evisum_ui_widget_exel_genlist_event_callback_add(view->widget_exel, EVAS_CALLBACK_MOUSE_UP,
                                                      _evisum_ui_process_list_item_pid_secondary_clicked_cb, view);
     evas_object_smart_callback_add(glist, "scroll", _evisum_ui_process_list_glist_scrolled_cb, view);
@@ -1985,13 +2007,13 @@ _evisum_ui_process_list_search_empty_cb(void *data) {
         view->search.visible = 0;
         view->search.timer = NULL;
         view->skip_update = 0;
-        view->skip_wait = 1;
+        _evisum_ui_process_list_refresh_now(view);
         return 0;
     }
 
     if (view->search.keytime && ((ecore_loop_time_get() - view->search.keytime) > 0.2)) {
         view->skip_update = 0;
-        view->skip_wait = 1;
+        _evisum_ui_process_list_refresh_now(view);
         view->search.keytime = 0;
     }
 
@@ -2146,7 +2168,7 @@ _evisum_ui_process_list_history_key_step(Evisum_Ui_Process_List_View *view, Evas
     }
 
     _evisum_ui_process_list_history_preview_set(view, t);
-    if (_evisum_ui_process_list_history_request_deferred(view, t)) view->skip_wait = 1;
+    if (_evisum_ui_process_list_history_request_deferred(view, t)) _evisum_ui_process_list_refresh_now(view);
     return EINA_TRUE;
 }
 
@@ -2176,7 +2198,7 @@ _evisum_ui_process_list_win_key_down_cb(void *data, Evas *e, Evas_Object *obj, v
         evisum_ui_widget_exel_genlist_region_bring_in(view->widget_exel, x, y + 512, w, h);
     else _evisum_ui_process_list_win_key_down_search(view, ev);
 
-    view->skip_wait = 1;
+    _evisum_ui_process_list_refresh_now(view);
 }
 
 static Eina_Bool
@@ -2197,9 +2219,9 @@ _evisum_ui_process_list_win_resize_cb(void *data, Evas *e, Evas_Object *obj, voi
     view = data;
     ui = view->ui;
 
-    evisum_ui_widget_exel_genlist_realized_items_update(view->widget_exel);
+    evisum_ui_widget_exel_virtual_rows_update(view->widget_exel, EINA_TRUE);
 
-    view->skip_wait = 1;
+    _evisum_ui_process_list_refresh_now(view);
 
     if (view->resize_timer) ecore_timer_reset(view->resize_timer);
     else view->resize_timer = ecore_timer_add(0.2, _evisum_ui_process_list_resize_cb, view);
@@ -2255,28 +2277,15 @@ _evisum_ui_process_list_win_alpha_set(Evisum_Ui_Process_List_View *view) {
 
 static Eina_Bool
 _evisum_ui_process_list_config_changed_cb(void *data, int type EINA_UNUSED, void *event EINA_UNUSED) {
-    Eina_Iterator *it;
     Evisum_Ui *ui;
     Evisum_Ui_Process_List_View *view;
-    void *d = NULL;
 
     view = data;
     ui = view->ui;
 
-    it = eina_hash_iterator_data_new(view->proc_usage_cache);
-    while (eina_iterator_next(it, &d)) {
-        Proc_Usage_Cache *cache = d;
-        cache->start = 0;
-        cache->net_in = 0;
-        cache->net_out = 0;
-        cache->disk_read = 0;
-        cache->disk_write = 0;
-        cache->sample_time = 0;
-    }
-    eina_iterator_free(it);
-
     evisum_ui_widget_exel_genlist_policy_set(view->widget_exel, ELM_SCROLLER_POLICY_OFF, ELM_SCROLLER_POLICY_AUTO);
-    view->skip_wait = 1;
+    evisum_engine_subscription_period_set(view->sub, _evisum_ui_process_list_poll_delay_get(view));
+    _evisum_ui_process_list_refresh_now(view);
 
     if (view->summary.visible && (view->history.whole != ui->proc.history_whole)) {
         uint32_t since = 0, history_time;
@@ -2372,23 +2381,24 @@ _evisum_ui_process_list_win_del_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED,
     if (view->menu) evas_object_del(view->menu);
     if (view->main_menu) evas_object_del(view->main_menu);
 
-    if (view->thread) ecore_thread_cancel(view->thread);
-
-    if (view->thread) ecore_thread_wait(view->thread, 0.5);
+    if (view->start_timer) ecore_timer_del(view->start_timer);
+    evisum_engine_unsubscribe(view->sub, EINA_TRUE);
+    view->sub = NULL;
 
     evisum_engine_history_live_set();
 
     if (view->handler) ecore_event_handler_del(view->handler);
     if (view->icon_cache) evisum_icon_cache_del(view->icon_cache);
 
-    view->thread = NULL;
     ui->proc.win = NULL;
 
     free(view->search.text);
 
     if (view->widget_exel) evisum_ui_widget_exel_free(view->widget_exel);
+    _evisum_ui_process_list_procs_clear(view);
 
-    if (view->proc_usage_cache) eina_hash_free(view->proc_usage_cache);
+    evisum_ui_process_sort_free(view->sorter);
+    evisum_ui_process_search_free(view->search.index);
     if (view->history.lock_init) eina_lock_free(&view->history.lock);
 
     free(view);
@@ -2417,6 +2427,19 @@ _evisum_ui_process_list_effects_add(Evisum_Ui_Process_List_View *view, Evas_Obje
     evas_object_show(win);
 }
 
+static Eina_Bool
+_evisum_ui_process_list_start_cb(void *data) {
+    Evisum_Ui_Process_List_View *view = data;
+
+    view->start_timer = NULL;
+    view->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_PROCESSES, _evisum_ui_process_list_poll_delay_get(view),
+                                        _evisum_ui_process_list_process_list, _evisum_ui_process_list_feedback_cb,
+                                        _evisum_ui_process_list_feedback_free, view);
+    evisum_engine_subscription_refresh(view->sub);
+
+    return 0;
+}
+
 void
 evisum_ui_process_list_win_add(Evisum_Ui *ui) {
     Evas_Object *win, *icon;
@@ -2442,6 +2465,7 @@ evisum_ui_process_list_win_add(Evisum_Ui *ui) {
 
     ui->proc.win = view->win = win = elm_win_add(NULL, "evisum", ELM_WIN_BASIC);
     elm_win_autodel_set(win, 1);
+    evisum_ui_win_visibility_track(win);
     elm_win_title_set(win, _("Evisum"));
     icon = elm_icon_add(win);
     elm_icon_standard_set(icon, "evisum");
@@ -2459,7 +2483,8 @@ evisum_ui_process_list_win_add(Evisum_Ui *ui) {
     elm_object_content_set(win, content);
 
     view->icon_cache = evisum_icon_cache_new();
-    view->proc_usage_cache = eina_hash_int64_new(_evisum_ui_process_list_usage_cache_free_cb);
+    view->sorter = evisum_ui_process_sort_new();
+    view->search.index = evisum_ui_process_search_new();
 
     evas_object_event_callback_add(win, EVAS_CALLBACK_DEL, _evisum_ui_process_list_win_del_cb, view);
     evas_object_event_callback_add(win, EVAS_CALLBACK_RESIZE, _evisum_ui_process_list_win_resize_cb, view);
@@ -2474,6 +2499,12 @@ evisum_ui_process_list_win_add(Evisum_Ui *ui) {
     _evisum_ui_process_list_content_reset(view);
     _evisum_ui_process_list_summary_add(view);
 
-    view->thread = ecore_thread_feedback_run(_evisum_ui_process_list_process_list, _evisum_ui_process_list_feedback_cb,
-                                             NULL, NULL, view, 0);
+    /* Allow time for initial sizing calculations, we obtain our data
+     * instantaneously using enigmatic, launch can be problematic.
+     *
+     * For reference macOS Activity Monitor waits 3 seconds, this is
+     * not painful and is visually pleasing.
+     */
+    view->first_run = EINA_TRUE;
+    view->start_timer = ecore_timer_add(1.0, _evisum_ui_process_list_start_cb, view);
 }
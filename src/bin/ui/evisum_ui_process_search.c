@@ -0,0 +1,428 @@
+#include "evisum_ui_process_search.h"
+
+#include <ctype.h>
+
+#define SEARCH_TRIGRAM(a, b, c) (((uint32_t) (a) << 16) | ((uint32_t) (b) << 8) | (uint32_t) (c))
+
+typedef struct {
+    pid_t pid;
+    int64_t start;
+    char *text;
+    uint32_t hash;
+    uint32_t trigrams;
+    uint32_t tick;
+    uint32_t match;
+    Eina_Bool live;
+} Search_Doc;
+
+typedef struct {
+    uint32_t *ids;
+    uint32_t count;
+    uint32_t size;
+} Search_Posting;
+
+struct _Evisum_Ui_Process_Search {
+    Search_Doc *docs;
+    uint32_t docs_count;
+    uint32_t docs_size;
+    uint32_t *free_slots;
+    uint32_t free_count;
+    Eina_Hash *pids;
+
+    // Trigram to posting, open addressed on trigram + 1.
+    uint32_t *tri_keys;
+    uint32_t *tri_vals;
+    uint32_t tri_mask;
+    uint32_t tri_used;
+
+    Search_Posting *postings;
+    uint32_t postings_count;
+    uint32_t postings_size;
+
+    // Postings are never pruned as documents go, a dropped document's ids
+    // linger until they outnumber the live ones and the lot is reposted.
+    uint64_t posted;
+    uint64_t stale;
+
+    uint32_t *scratch;
+    uint32_t scratch_size;
+
+    uint32_t tick;
+    uint32_t serial;
+};
+
+static inline uint32_t
+_search_hash(uint32_t key) {
+    key *= 2654435761u;
+    return key ^ (key >> 16);
+}
+
+static Eina_Bool
+_search_tri_grow(Evisum_Ui_Process_Search *ps) {
+    uint32_t *keys, *vals, size, h;
+    uint32_t old_size = ps->tri_keys ? ps->tri_mask + 1 : 0;
+
+    size = old_size ? old_size * 2 : 4096;
+    keys = calloc(size, sizeof(uint32_t));
+    vals = malloc(size * sizeof(uint32_t));
+    if (!keys || !vals) {
+        free(keys);
+        free(vals);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < old_size; i++) {
+        if (!ps->tri_keys[i]) continue;
+        for (h = _search_hash(ps->tri_keys[i]) & (size - 1); keys[h]; h = (h + 1) & (size - 1));
+        keys[h] = ps->tri_keys[i];
+        vals[h] = ps->tri_vals[i];
+    }
+
+    free(ps->tri_keys);
+    free(ps->tri_vals);
+    ps->tri_keys = keys;
+    ps->tri_vals = vals;
+    ps->tri_mask = size - 1;
+
+    return 1;
+}
+
+static Search_Posting *
+_search_posting_find(const Evisum_Ui_Process_Search *ps, uint32_t trigram) {
+    uint32_t key = trigram + 1, h;
+
+    if (!ps->tri_keys) return NULL;
+
+    for (h = _search_hash(key) & ps->tri_mask; ps->tri_keys[h]; h = (h + 1) & ps->tri_mask) {
+        if (ps->tri_keys[h] == key) return &ps->postings[ps->tri_vals[h]];
+    }
+
+    return NULL;
+}
+
+static Search_Posting *
+_search_posting_get(Evisum_Ui_Process_Search *ps, uint32_t trigram) {
+    Search_Posting *postings;
+    uint32_t key = trigram + 1, h;
+
+    if ((!ps->tri_keys || ((ps->tri_used + 1) * 2 > ps->tri_mask + 1)) && !_search_tri_grow(ps)) return NULL;
+
+    for (h = _search_hash(key) & ps->tri_mask; ps->tri_keys[h]; h = (h + 1) & ps->tri_mask) {
+        if (ps->tri_keys[h] == key) return &ps->postings[ps->tri_vals[h]];
+    }
+
+    if (ps->postings_count == ps->postings_size) {
+        postings = realloc(ps->postings, (ps->postings_size ? ps->postings_size * 2 : 1024) * sizeof(Search_Posting));
+        if (!postings) return NULL;
+        ps->postings = postings;
+        ps->postings_size = ps->postings_size ? ps->postings_size * 2 : 1024;
+    }
+
+    memset(&ps->postings[ps->postings_count], 0, sizeof(Search_Posting));
+    ps->tri_keys[h] = key;
+    ps->tri_vals[h] = ps->postings_count;
+    ps->tri_used++;
+
+    return &ps->postings[ps->postings_count++];
+}
+
+static void
+_search_posting_add(Search_Posting *posting, uint32_t id) {
+    uint32_t *ids;
+
+    if (posting->count == posting->size) {
+        ids = realloc(posting->ids, (posting->size ? posting->size * 2 : 8) * sizeof(uint32_t));
+        if (!ids) return;
+        posting->ids = ids;
+        posting->size = posting->size ? posting->size * 2 : 8;
+    }
+    posting->ids[posting->count++] = id;
+}
+
+static int
+_search_trigram_cmp(const void *p1, const void *p2) {
+    uint32_t a = *(const uint32_t *) p1, b = *(const uint32_t *) p2;
+
+    return (a > b) - (a < b);
+}
+
+static void
+_search_doc_post(Evisum_Ui_Process_Search *ps, uint32_t id) {
+    Search_Doc *doc = &ps->docs[id];
+    Search_Posting *posting;
+    const unsigned char *s = (const unsigned char *) doc->text;
+    size_t len = strlen(doc->text);
+    uint32_t n = 0, *scratch;
+
+    doc->trigrams = 0;
+    if (len < 3) return;
+
+    if (ps->scratch_size < len) {
+        scratch = realloc(ps->scratch, len * sizeof(uint32_t));
+        if (!scratch) return;
+        ps->scratch = scratch;
+        ps->scratch_size = len;
+    }
+
+    for (size_t i = 0; (i + 2) < len; i++) ps->scratch[n++] = SEARCH_TRIGRAM(s[i], s[i + 1], s[i + 2]);
+
+    // Post each distinct trigram once.
+    qsort(ps->scratch, n, sizeof(uint32_t), _search_trigram_cmp);
+    for (uint32_t i = 0; i < n; i++) {
+        if (i && (ps->scratch[i] == ps->scratch[i - 1])) continue;
+        posting = _search_posting_get(ps, ps->scratch[i]);
+        if (!posting) continue;
+        _search_posting_add(posting, id);
+        doc->trigrams++;
+    }
+    ps->posted += doc->trigrams;
+}
+
+// FNV-1a over the folded bytes.
+static uint32_t
+_search_text_hash(const char *s, uint32_t hash) {
+    for (; s && *s; s++) {
+        hash ^= (uint32_t) tolower((unsigned char) *s);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static char *
+_search_fold(const char *command, const char *arguments) {
+    size_t clen = command ? strlen(command) : 0;
+    size_t alen = arguments ? strlen(arguments) : 0;
+    char *text;
+
+    text = malloc(clen + 1 + alen + 1);
+    if (!text) return NULL;
+
+    for (size_t i = 0; i < clen; i++) text[i] = tolower((unsigned char) command[i]);
+    text[clen] = '\n';
+    for (size_t i = 0; i < alen; i++) text[clen + 1 + i] = tolower((unsigned char) arguments[i]);
+    text[clen + 1 + alen] = '\0';
+
+    return text;
+}
+
+static void
+_search_doc_add(Evisum_Ui_Process_Search *ps, const Proc_Info *proc) {
+    Search_Doc *doc, *docs;
+    uint32_t id;
+
+    if (ps->free_count) id = ps->free_slots[--ps->free_count];
+    else {
+        if (ps->docs_count == ps->docs_size) {
+            uint32_t size = ps->docs_size ? ps->docs_size * 2 : 512;
+            uint32_t *slots;
+
+            docs = realloc(ps->docs, size * sizeof(Search_Doc));
+            if (!docs) return;
+            ps->docs = docs;
+            slots = realloc(ps->free_slots, size * sizeof(uint32_t));
+            if (!slots) return;
+            ps->free_slots = slots;
+            ps->docs_size = size;
+        }
+        id = ps->docs_count++;
+    }
+
+    doc = &ps->docs[id];
+    memset(doc, 0, sizeof(Search_Doc));
+    doc->pid = proc->pid;
+    doc->start = proc->start;
+    doc->tick = ps->tick;
+    doc->text = _search_fold(proc->command, proc->arguments);
+    if (!doc->text) {
+        ps->free_slots[ps->free_count++] = id;
+        return;
+    }
+    doc->hash = _search_text_hash(doc->text, 2166136261u);
+    doc->live = 1;
+
+    eina_hash_add(ps->pids, &doc->pid, (void *) (uintptr_t) (id + 1));
+    _search_doc_post(ps, id);
+}
+
+static void
+_search_doc_del(Evisum_Ui_Process_Search *ps, uint32_t id) {
+    Search_Doc *doc = &ps->docs[id];
+
+    eina_hash_del_by_key(ps->pids, &doc->pid);
+    free(doc->text);
+    doc->text = NULL;
+    doc->live = 0;
+    ps->stale += doc->trigrams;
+    ps->posted -= doc->trigrams;
+    ps->free_slots[ps->free_count++] = id;
+}
+
+static void
+_search_repost(Evisum_Ui_Process_Search *ps) {
+    for (uint32_t i = 0; i < ps->postings_count; i++) ps->postings[i].count = 0;
+
+    ps->posted = ps->stale = 0;
+    for (uint32_t id = 0; id < ps->docs_count; id++) {
+        if (ps->docs[id].live) _search_doc_post(ps, id);
+    }
+}
+
+// Same pid and start but different text means the process exec'd or
+// rewrote its title, hash what _search_fold would index without folding.
+static Eina_Bool
+_search_doc_current(const Search_Doc *doc, const Proc_Info *proc) {
+    uint32_t hash;
+
+    if (doc->start != proc->start) return 0;
+
+    hash = _search_text_hash(proc->command, 2166136261u);
+    hash = _search_text_hash("\n", hash);
+    hash = _search_text_hash(proc->arguments, hash);
+
+    return hash == doc->hash;
+}
+
+Evisum_Ui_Process_Search *
+evisum_ui_process_search_new(void) {
+    Evisum_Ui_Process_Search *ps;
+
+    ps = calloc(1, sizeof(Evisum_Ui_Process_Search));
+    if (!ps) return NULL;
+
+    ps->pids = eina_hash_int32_new(NULL);
+    if (!ps->pids) {
+        free(ps);
+        return NULL;
+    }
+
+    return ps;
+}
+
+void
+evisum_ui_process_search_free(Evisum_Ui_Process_Search *ps) {
+    if (!ps) return;
+
+    for (uint32_t i = 0; i < ps->docs_count; i++) free(ps->docs[i].text);
+    for (uint32_t i = 0; i < ps->postings_count; i++) free(ps->postings[i].ids);
+
+    eina_hash_free(ps->pids);
+    free(ps->docs);
+    free(ps->free_slots);
+    free(ps->tri_keys);
+    free(ps->tri_vals);
+    free(ps->postings);
+    free(ps->scratch);
+    free(ps);
+}
+
+void
+evisum_ui_process_search_update(Evisum_Ui_Process_Search *ps, Eina_List *procs) {
+    Eina_List *l;
+    Proc_Info *proc;
+    Search_Doc *doc;
+    uintptr_t slot;
+
+    if (!ps) return;
+
+    ps->tick++;
+
+    EINA_LIST_FOREACH(procs, l, proc) {
+        slot = (uintptr_t) eina_hash_find(ps->pids, &proc->pid);
+        if (slot) {
+            doc = &ps->docs[slot - 1];
+            if (_search_doc_current(doc, proc)) {
+                doc->tick = ps->tick;
+                continue;
+            }
+            _search_doc_del(ps, slot - 1);
+        }
+        _search_doc_add(ps, proc);
+    }
+
+    for (uint32_t id = 0; id < ps->docs_count; id++) {
+        doc = &ps->docs[id];
+        if (doc->live && (doc->tick != ps->tick)) _search_doc_del(ps, id);
+    }
+
+    if ((ps->stale > 65536) && (ps->stale > ps->posted)) _search_repost(ps);
+}
+
+static Eina_Bool
+_search_doc_has(const Search_Doc *doc, const char *needle, Eina_Bool prefix) {
+    const char *p = doc->text;
+
+    while ((p = strstr(p, needle))) {
+        if (!prefix || (p == doc->text) || (p[-1] == '\n')) return 1;
+        p++;
+    }
+
+    return 0;
+}
+
+unsigned int
+evisum_ui_process_search_query(Evisum_Ui_Process_Search *ps, const char *text, Eina_Bool prefix) {
+    Search_Posting *posting, *best = NULL;
+    Search_Doc *doc;
+    char *needle;
+    size_t len;
+    unsigned int matches = 0;
+
+    if (!ps) return 0;
+
+    ps->serial++;
+
+    if (!text || !text[0]) return 0;
+
+    len = strlen(text);
+    needle = malloc(len + 1);
+    if (!needle) return 0;
+    for (size_t i = 0; i <= len; i++) needle[i] = tolower((unsigned char) text[i]);
+
+    if (len < 3) {
+        for (uint32_t id = 0; id < ps->docs_count; id++) {
+            doc = &ps->docs[id];
+            if (!doc->live || !_search_doc_has(doc, needle, prefix)) continue;
+            doc->match = ps->serial;
+            matches++;
+        }
+        free(needle);
+        return matches;
+    }
+
+    // Every match is posted under every trigram of the needle, so the
+    // shortest posting is the smallest candidate set. A trigram nobody has
+    // means nothing matches.
+    for (size_t i = 0; (i + 2) < len; i++) {
+        const unsigned char *s = (const unsigned char *) needle + i;
+        posting = _search_posting_find(ps, SEARCH_TRIGRAM(s[0], s[1], s[2]));
+        if (!posting || !posting->count) {
+            best = NULL;
+            break;
+        }
+        if (!best || (posting->count < best->count)) best = posting;
+    }
+
+    for (uint32_t i = 0; best && (i < best->count); i++) {
+        doc = &ps->docs[best->ids[i]];
+        if (!doc->live || (doc->match == ps->serial)) continue;
+        if (!_search_doc_has(doc, needle, prefix)) continue;
+        doc->match = ps->serial;
+        matches++;
+    }
+
+    free(needle);
+
+    return matches;
+}
+
+Eina_Bool
+evisum_ui_process_search_match(const Evisum_Ui_Process_Search *ps, pid_t pid) {
+    uintptr_t slot;
+
+    if (!ps) return 0;
+
+    slot = (uintptr_t) eina_hash_find(ps->pids, &pid);
+    if (!slot) return 0;
+
+    return ps->docs[slot - 1].match == ps->serial;
+}
@@ -0,0 +1,34 @@
+#ifndef __EVISUM_UI_PROCESS_SEARCH_H__
+#define __EVISUM_UI_PROCESS_SEARCH_H__
+
+#include "evisum_ui.h"
+
+/* A trigram index over each process' command line, kept across refreshes.
+ * Every process is one document holding its command and arguments (the
+ * executable path is the first argument) folded to lower case. Updating
+ * only indexes processes which appeared or whose text changed, and drops
+ * those which went away.
+ * A query takes the rarest trigram of the search text and verifies just
+ * the processes posted under it, texts shorter than a trigram fall back to
+ * scanning the folded documents.
+ */
+
+typedef struct _Evisum_Ui_Process_Search Evisum_Ui_Process_Search;
+
+Evisum_Ui_Process_Search *evisum_ui_process_search_new(void);
+
+void evisum_ui_process_search_free(Evisum_Ui_Process_Search *ps);
+
+/* Reconcile the index with the current process list. */
+void evisum_ui_process_search_update(Evisum_Ui_Process_Search *ps, Eina_List *procs);
+
+/* Match text case-insensitively anywhere in a command line or, with prefix,
+ * only at the start of the command or of its path. Returns the number of
+ * matching processes, which stay marked until the next query.
+ */
+unsigned int evisum_ui_process_search_query(Evisum_Ui_Process_Search *ps, const char *text, Eina_Bool prefix);
+
+/* Whether pid matched the last query. */
+Eina_Bool evisum_ui_process_search_match(const Evisum_Ui_Process_Search *ps, pid_t pid);
+
+#endif
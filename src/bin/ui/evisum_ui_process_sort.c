@@ -0,0 +1,398 @@
+#include "evisum_ui_process_sort.h"
+
+typedef struct {
+    uint64_t key;
+    uint32_t tie;
+    uint32_t idx;
+} Sort_Entry;
+
+struct _Evisum_Ui_Process_Sort {
+    Proc_Info **procs;
+    Sort_Entry *entries;
+    Sort_Entry *tmp;
+    uint32_t *runs;
+    uint32_t *slots;
+    uint8_t *chosen;
+    unsigned int size;
+
+    // Where each pid landed last time, open addressed on pid + 1.
+    uint32_t *rank_pid;
+    uint32_t *rank_pos;
+    unsigned int rank_mask;
+    unsigned int rank_count;
+
+    Proc_Sort type;
+    Eina_Bool reverse;
+    Eina_Bool strings;
+};
+
+static inline uint64_t
+_sort_key_signed(int64_t value) {
+    return (uint64_t) value ^ 0x8000000000000000ULL;
+}
+
+static inline uint64_t
+_sort_key_double(double value) {
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    // Negative values order backwards by their bits, positive ones only need
+    // the sign flipped to sort above them.
+    if (bits & 0x8000000000000000ULL) return ~bits;
+
+    return bits | 0x8000000000000000ULL;
+}
+
+static inline uint64_t
+_sort_key_string(const char *s) {
+    uint64_t key = 0;
+
+    // The first eight bytes big-endian, which orders as strcmp() does. Only
+    // rows with an equal prefix go on to compare the strings.
+    for (int i = 0; s && (i < 8) && s[i]; i++)
+        key |= (uint64_t) (unsigned char) s[i] << (56 - (i * 8));
+
+    return key;
+}
+
+static uint64_t
+_sort_key(Proc_Sort type, const Proc_Info *proc) {
+    switch (type) {
+        case PROC_SORT_BY_CMD:
+            return _sort_key_string(proc->command);
+        case PROC_SORT_BY_STATE:
+            return _sort_key_string(proc->state);
+        case PROC_SORT_BY_UID:
+            return proc->uid;
+        case PROC_SORT_BY_PID:
+            return _sort_key_signed(proc->pid);
+        case PROC_SORT_BY_THREADS:
+            return _sort_key_signed(proc->numthreads);
+        case PROC_SORT_BY_CPU:
+            return _sort_key_signed(proc->cpu_id);
+        case PROC_SORT_BY_PRI:
+            return _sort_key_signed(proc->priority);
+        case PROC_SORT_BY_NICE:
+            return _sort_key_signed(proc->nice);
+        case PROC_SORT_BY_FILES:
+            return _sort_key_signed(proc->numfiles);
+        case PROC_SORT_BY_SIZE:
+            return proc->mem_size;
+        case PROC_SORT_BY_VIRT:
+            return proc->mem_virt;
+        case PROC_SORT_BY_RSS:
+            return proc->mem_rss;
+        case PROC_SORT_BY_SHARED:
+            return proc->mem_shared;
+        case PROC_SORT_BY_DISK_WRITE:
+            return proc->disk_write_rate;
+        case PROC_SORT_BY_DISK_READ:
+            return proc->disk_read_rate;
+        case PROC_SORT_BY_NET_IN:
+            return proc->net_in_rate;
+        case PROC_SORT_BY_NET_OUT:
+            return proc->net_out_rate;
+        case PROC_SORT_BY_TIME:
+            return _sort_key_signed(proc->cpu_time);
+        case PROC_SORT_BY_CPU_USAGE:
+            return _sort_key_double(proc->cpu_usage);
+        default:
+            return 0;
+    }
+}
+
+static inline const char *
+_sort_string(const Evisum_Ui_Process_Sort *ps, uint32_t idx) {
+    const Proc_Info *proc = ps->procs[idx];
+
+    if (ps->type == PROC_FIELD_STATE) return proc->state;
+
+    return proc->command ? proc->command : "";
+}
+
+static inline int
+_sort_cmp(const Evisum_Ui_Process_Sort *ps, const Sort_Entry *a, const Sort_Entry *b) {
+    int r;
+
+    if (a->key != b->key) return a->key < b->key ? -1 : 1;
+
+    if (ps->strings) {
+        r = strcmp(_sort_string(ps, a->idx), _sort_string(ps, b->idx));
+        if (r) return ps->reverse ? -r : r;
+    }
+
+    if (a->tie != b->tie) return a->tie < b->tie ? -1 : 1;
+
+    return 0;
+}
+
+static inline uint32_t
+_sort_rank_hash(const Evisum_Ui_Process_Sort *ps, uint32_t key) {
+    key *= 2654435761u;
+    return (key ^ (key >> 16)) & ps->rank_mask;
+}
+
+static int64_t
+_sort_rank_find(const Evisum_Ui_Process_Sort *ps, pid_t pid) {
+    uint32_t key = (uint32_t) pid + 1;
+    uint32_t h;
+
+    if (!ps->rank_count) return -1;
+
+    for (h = _sort_rank_hash(ps, key); ps->rank_pid[h]; h = (h + 1) & ps->rank_mask) {
+        if (ps->rank_pid[h] == key) return ps->rank_pos[h];
+    }
+
+    return -1;
+}
+
+static void
+_sort_rank_store(Evisum_Ui_Process_Sort *ps, unsigned int n) {
+    uint32_t key, h;
+
+    memset(ps->rank_pid, 0, (ps->rank_mask + 1) * sizeof(uint32_t));
+
+    for (unsigned int i = 0; i < n; i++) {
+        key = (uint32_t) ps->procs[ps->entries[i].idx]->pid + 1;
+        for (h = _sort_rank_hash(ps, key); ps->rank_pid[h]; h = (h + 1) & ps->rank_mask) {
+            if (ps->rank_pid[h] == key) break;
+        }
+        if (ps->rank_pid[h]) continue;
+        ps->rank_pid[h] = key;
+        ps->rank_pos[h] = i;
+    }
+    ps->rank_count = n;
+}
+
+#define SORT_GROW(ptr, count)                                         \
+    do {                                                              \
+        void *p = realloc((ptr), (count) * sizeof(*(ptr)));           \
+        if (!p) return 0;                                             \
+        (ptr) = p;                                                    \
+    } while (0)
+
+static Eina_Bool
+_sort_reserve(Evisum_Ui_Process_Sort *ps, unsigned int n) {
+    unsigned int size, slots;
+
+    if (n <= ps->size) return 1;
+
+    size = ps->size ? ps->size : 256;
+    while (size < n) size *= 2;
+
+    SORT_GROW(ps->procs, size);
+    SORT_GROW(ps->entries, size);
+    SORT_GROW(ps->tmp, size);
+    SORT_GROW(ps->runs, size + 1);
+    SORT_GROW(ps->slots, size);
+    SORT_GROW(ps->chosen, size);
+
+    // The rank table is kept at most half full so probes stay short. Growing
+    // it drops the previous order, which only costs the next sort its head
+    // start.
+    slots = size * 2;
+    SORT_GROW(ps->rank_pid, slots);
+    SORT_GROW(ps->rank_pos, slots);
+    memset(ps->rank_pid, 0, slots * sizeof(uint32_t));
+    ps->rank_mask = slots - 1;
+    ps->rank_count = 0;
+
+    ps->size = size;
+
+    return 1;
+}
+
+static void
+_sort_entries_reverse(Sort_Entry *a, unsigned int n) {
+    Sort_Entry t;
+
+    for (unsigned int i = 0, j = n - 1; i < j; i++, j--) {
+        t = a[i];
+        a[i] = a[j];
+        a[j] = t;
+    }
+}
+
+static void
+_sort_merge(Evisum_Ui_Process_Sort *ps, Sort_Entry *a, unsigned int lo, unsigned int mid, unsigned int hi) {
+    Sort_Entry *t = ps->tmp;
+    unsigned int i = 0, j = mid, k = lo, n = mid - lo;
+
+    if (_sort_cmp(ps, &a[mid - 1], &a[mid]) <= 0) return;
+
+    memcpy(t, a + lo, n * sizeof(Sort_Entry));
+
+    while ((i < n) && (j < hi)) {
+        if (_sort_cmp(ps, &a[j], &t[i]) < 0) a[k++] = a[j++];
+        else a[k++] = t[i++];
+    }
+    while (i < n) a[k++] = t[i++];
+}
+
+// Natural merge sort: split into the runs already present, turning strictly
+// descending ones around, then merge neighbours until one run is left. A
+// nearly ordered array is a handful of runs and a few linear passes.
+static void
+_sort_runs(Evisum_Ui_Process_Sort *ps, Sort_Entry *a, unsigned int n) {
+    uint32_t *runs = ps->runs;
+    unsigned int i = 0, start, count = 0, out, r;
+
+    while (i < n) {
+        start = i++;
+        if ((i < n) && (_sort_cmp(ps, &a[i - 1], &a[i]) > 0)) {
+            while ((i < n) && (_sort_cmp(ps, &a[i - 1], &a[i]) > 0)) i++;
+            _sort_entries_reverse(a + start, i - start);
+        } else {
+            while ((i < n) && (_sort_cmp(ps, &a[i - 1], &a[i]) <= 0)) i++;
+        }
+        runs[count++] = start;
+    }
+    runs[count] = n;
+
+    while (count > 1) {
+        for (r = out = 0; (r + 1) < count; r += 2) {
+            _sort_merge(ps, a, runs[r], runs[r + 1], runs[r + 2]);
+            runs[out++] = runs[r];
+        }
+        if (r < count) runs[out++] = runs[r];
+        runs[out] = n;
+        count = out;
+    }
+}
+
+static void
+_sort_heap_down(const Evisum_Ui_Process_Sort *ps, Sort_Entry *heap, unsigned int n, unsigned int i) {
+    Sort_Entry t = heap[i];
+    unsigned int c;
+
+    while ((c = (i * 2) + 1) < n) {
+        if (((c + 1) < n) && (_sort_cmp(ps, &heap[c + 1], &heap[c]) > 0)) c++;
+        if (_sort_cmp(ps, &heap[c], &t) <= 0) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = t;
+}
+
+// Select the k smallest entries with a bounded max-heap, then lay them out
+// sorted ahead of the rest. In the previous order the rows which belong on
+// top are nearly all already in the first k, so most of the tail is turned
+// away by a single comparison with the heap root.
+static void
+_sort_top(Evisum_Ui_Process_Sort *ps, Sort_Entry *a, unsigned int n, unsigned int k) {
+    Sort_Entry *heap = ps->tmp;
+    unsigned int i, w;
+
+    memcpy(heap, a, k * sizeof(Sort_Entry));
+    memset(ps->chosen, 0, n);
+    for (i = 0; i < k; i++) ps->chosen[heap[i].idx] = 1;
+
+    for (i = k / 2; i-- > 0;) _sort_heap_down(ps, heap, k, i);
+
+    for (i = k; i < n; i++) {
+        if (_sort_cmp(ps, &a[i], &heap[0]) >= 0) continue;
+        ps->chosen[heap[0].idx] = 0;
+        ps->chosen[a[i].idx] = 1;
+        heap[0] = a[i];
+        _sort_heap_down(ps, heap, k, 0);
+    }
+
+    // Close up the tail from the back, writes never pass unread entries.
+    for (i = w = n; i-- > 0;) {
+        if (!ps->chosen[a[i].idx]) a[--w] = a[i];
+    }
+
+    memcpy(a, heap, k * sizeof(Sort_Entry));
+    _sort_runs(ps, a, k);
+}
+
+Evisum_Ui_Process_Sort *
+evisum_ui_process_sort_new(void) {
+    return calloc(1, sizeof(Evisum_Ui_Process_Sort));
+}
+
+void
+evisum_ui_process_sort_free(Evisum_Ui_Process_Sort *ps) {
+    if (!ps) return;
+
+    free(ps->procs);
+    free(ps->entries);
+    free(ps->tmp);
+    free(ps->runs);
+    free(ps->slots);
+    free(ps->chosen);
+    free(ps->rank_pid);
+    free(ps->rank_pos);
+    free(ps);
+}
+
+Eina_List *
+evisum_ui_process_sort_list(Evisum_Ui_Process_Sort *ps, Eina_List *list, Proc_Sort type, Eina_Bool reverse,
+                            unsigned int top, unsigned int *sorted) {
+    Eina_List *l;
+    Sort_Entry *e;
+    Proc_Info *proc;
+    unsigned int n, i, placed, fresh;
+    int64_t rank;
+
+    if (sorted) *sorted = 0;
+
+    n = eina_list_count(list);
+
+    if ((type < PROC_FIELD_CMD) || (type >= PROC_FIELD_MAX)) {
+        if (reverse) list = eina_list_reverse(list);
+        if (sorted) *sorted = n;
+        return list;
+    }
+
+    if (!ps || (n < 2) || !_sort_reserve(ps, n)) {
+        if (sorted && (n < 2)) *sorted = n;
+        return list;
+    }
+
+    ps->type = type;
+    ps->reverse = reverse;
+    ps->strings = (type == PROC_FIELD_CMD) || (type == PROC_FIELD_STATE);
+
+    i = 0;
+    EINA_LIST_FOREACH(list, l, proc) ps->procs[i++] = proc;
+
+    // Lay the rows out in last time's order, anything new goes at the end.
+    memset(ps->slots, 0, ps->rank_count * sizeof(uint32_t));
+    for (i = fresh = 0; i < n; i++) {
+        rank = _sort_rank_find(ps, ps->procs[i]->pid);
+        if ((rank >= 0) && !ps->slots[rank]) ps->slots[rank] = i + 1;
+        else ps->tmp[fresh++].idx = i;
+    }
+    for (i = placed = 0; i < ps->rank_count; i++) {
+        if (ps->slots[i]) ps->entries[placed++].idx = ps->slots[i] - 1;
+    }
+    for (i = 0; i < fresh; i++) ps->entries[placed++].idx = ps->tmp[i].idx;
+
+    for (i = 0; i < n; i++) {
+        e = &ps->entries[i];
+        proc = ps->procs[e->idx];
+        e->key = _sort_key(type, proc);
+        e->tie = (uint32_t) proc->pid ^ 0x80000000u;
+        if (reverse) {
+            e->key = ~e->key;
+            e->tie = ~e->tie;
+        }
+    }
+
+    if (top && (top < n)) _sort_top(ps, ps->entries, n, top);
+    else {
+        _sort_runs(ps, ps->entries, n);
+        top = n;
+    }
+
+    i = 0;
+    for (l = list; l; l = eina_list_next(l)) eina_list_data_set(l, ps->procs[ps->entries[i++].idx]);
+
+    _sort_rank_store(ps, n);
+
+    if (sorted) *sorted = top;
+
+    return list;
+}
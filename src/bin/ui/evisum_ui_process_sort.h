@@ -0,0 +1,28 @@
+#ifndef __EVISUM_UI_PROCESS_SORT_H__
+#define __EVISUM_UI_PROCESS_SORT_H__
+
+#include "evisum_ui_process_list.h"
+
+/* Orders the process list by a column. Each row is reduced to a flat
+ * (key, pid, index) entry with the column folded into an unsigned key, so
+ * comparisons never touch the Proc_Info itself and descending order is just
+ * an inverted key. Entries are laid out in the order of the previous call
+ * before sorting and merged by natural runs, so a list whose ranks barely
+ * moved between refreshes costs little more than one pass.
+ */
+
+typedef struct _Evisum_Ui_Process_Sort Evisum_Ui_Process_Sort;
+
+Evisum_Ui_Process_Sort *evisum_ui_process_sort_new(void);
+
+void evisum_ui_process_sort_free(Evisum_Ui_Process_Sort *ps);
+
+/* Reorder list in place and return it. With top non-zero and smaller than
+ * the list only the first top rows are exact, every row after them ranks
+ * below them but keeps its previous relative order. Returns the number of
+ * leading rows which are in exact order through sorted, when given.
+ */
+Eina_List *evisum_ui_process_sort_list(Evisum_Ui_Process_Sort *ps, Eina_List *list, Proc_Sort type, Eina_Bool reverse,
+                                       unsigned int top, unsigned int *sorted);
+
+#endif
@@ -1,10 +1,17 @@
 #include "evisum_ui_process_view.h"
 #include "evisum_ui_widget_exel.h"
+#include "evisum_ui_graph.h"
+#include "evisum_ui_colors.h"
 #include "../engine/evisum_engine.h"
-#include "../background/evisum_background.h"
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 
+#define PROC_HISTORY_SAMPLES       120
+#define PROC_HISTORY_SECONDS       600
+#define PROC_HISTORY_REFRESH       0.5
+#define PROC_HISTORY_GRID_X_STEP   10
+#define PROC_HISTORY_GRID_Y_STEP   10
+
 typedef struct {
     Evisum_Ui *ui;
     Evas_Object *win;
@@ -12,10 +19,12 @@ typedef struct {
     Evas_Object *tab_general;
     Evas_Object *tab_children;
     Evas_Object *tab_manual;
+    Evas_Object *tab_history;
 
     Evas_Object *general_view;
     Evas_Object *children_view;
     Evas_Object *manual_view;
+    Evas_Object *history_view;
 
     Evas_Object *current_view;
 
@@ -23,13 +32,12 @@ typedef struct {
     char *selected_cmd;
     pid_t selected_pid;
 
-    Ecore_Thread *thread;
+    Evisum_Engine_Subscription *sub;
 
     Eina_Bool kthreads_has_rss;
     Eina_Bool ignore_initial_resize;
 
     Eina_Hash *icon_cache;
-    Eina_Hash *proc_usage_cache;
 
     struct {
         Evas_Object *entry_cmd;
@@ -73,24 +81,33 @@ typedef struct {
         Eina_Bool init;
     } manual;
 
+    struct {
+        Evas_Object *graph_bg;
+        Evas_Object *graph_img;
+        Evas_Object *label;
+        Evisum_Engine_Subscription *sub;
+        double cpu[PROC_HISTORY_SAMPLES];
+        double rss[PROC_HISTORY_SAMPLES];
+        int count;
+        uint8_t cpu_r, cpu_g, cpu_b;
+        uint8_t rss_r, rss_g, rss_b;
+    } history;
+
 } Evisum_Ui_Process_View;
 
 typedef struct {
-    int64_t start;
-    uint32_t sample_time;
-    int64_t cpu_time;
-    double cpu_usage;
-#if defined(__linux__)
-    uint64_t net_in;
-    uint64_t net_out;
-    uint64_t disk_read;
-    uint64_t disk_write;
-    uint64_t net_in_rate;
-    uint64_t net_out_rate;
-    uint64_t disk_read_rate;
-    uint64_t disk_write_rate;
-#endif
-} Proc_Usage_Cache;
+    double cpu[PROC_HISTORY_SAMPLES];
+    double rss[PROC_HISTORY_SAMPLES];
+    int count;
+    double cpu_peak;
+    uint64_t rss_peak;
+} Proc_History;
+
+static const Evisum_Ui_Graph_Layer _history_layers[] = {
+    { -0.6, 0.24 },
+    { 0.6,  0.24 },
+    { 0.0,  0.92 },
+};
 
 static uint64_t _evisum_ui_process_view_mem_total_get(Evisum_Ui_Process_View *view);
 static void _evisum_ui_process_view_progressbar_unset(Evas_Object *pb);
@@ -118,20 +135,6 @@ _evisum_ui_process_view_exe_response(const char *command) {
     return lines;
 }
 
-static void
-_evisum_ui_process_view_usage_cache_free_cb(void *data) {
-    Proc_Usage_Cache *cache = data;
-    free(cache);
-}
-
-static uint32_t
-_evisum_ui_process_view_sample_time_get(void) {
-    uint32_t sample_time;
-
-    sample_time = evisum_engine_live_time_get();
-    return sample_time;
-}
-
 static void
 _evisum_ui_process_view_btn_ppid_clicked_cb(void *data, Evas_Object *obj, void *event_info) {
     Evisum_Ui_Process_View *view;
@@ -264,18 +267,13 @@ _evisum_ui_process_view_children_view_update(void *data) {
 }
 
 static void
-_evisum_ui_process_view_proc_info_main(void *data, Ecore_Thread *thread) {
+_evisum_ui_process_view_proc_info_main(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
     Evisum_Ui_Process_View *view = data;
-    uint64_t seq = 0;
-
-    ecore_thread_name_set(thread, "process_view");
+    Proc_Info *proc;
 
-    while (!ecore_thread_check(thread)) {
-        if (!evisum_background_update_wait(&seq)) continue;
-        Proc_Info *proc = proc_info_by_pid(view->selected_pid);
-        if (!proc) continue;
-        ecore_thread_feedback(thread, proc);
-    }
+    proc = proc_info_by_pid(view->selected_pid);
+    if (!proc) return;
+    ecore_thread_feedback(thread, proc);
 }
 
 static char *
@@ -385,6 +383,132 @@ _evisum_ui_process_view_manual_init(Evisum_Ui_Process_View *view) {
                               NULL, NULL, view, 1);
 }
 
+static void
+_evisum_ui_process_view_history_redraw(Evisum_Ui_Process_View *view) {
+    Evisum_Ui_Graph_Series series[2];
+    int nseries = 0;
+
+    if (!view->history.graph_bg || !view->history.graph_img) return;
+
+    memset(series, 0, sizeof(series));
+    if (view->history.count >= 2) {
+        series[nseries].history = view->history.rss;
+        series[nseries].history_count = view->history.count;
+        series[nseries].color_r = view->history.rss_r;
+        series[nseries].color_g = view->history.rss_g;
+        series[nseries].color_b = view->history.rss_b;
+        nseries++;
+        series[nseries].history = view->history.cpu;
+        series[nseries].history_count = view->history.count;
+        series[nseries].color_r = view->history.cpu_r;
+        series[nseries].color_g = view->history.cpu_g;
+        series[nseries].color_b = view->history.cpu_b;
+        nseries++;
+    }
+
+    evisum_ui_graph_draw(view->history.graph_bg, view->history.graph_img, PROC_HISTORY_SAMPLES,
+                         PROC_HISTORY_GRID_X_STEP, PROC_HISTORY_GRID_Y_STEP, 100.0, series, nseries, _history_layers,
+                         EINA_C_ARRAY_LENGTH(_history_layers));
+}
+
+static void
+_evisum_ui_process_view_history_bg_resize_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                             void *event_info EINA_UNUSED) {
+    _evisum_ui_process_view_history_redraw(data);
+}
+
+// Bucket the pid's recorded samples into fixed slots across the window,
+// keeping the peak of each slot so short spikes survive the downsampling.
+static Proc_History *
+_evisum_ui_process_view_history_build(Proc_Info_Series *series) {
+    Proc_History *hist;
+    uint32_t first, span;
+    double cpu, rss;
+    int slot, last = -1;
+
+    hist = calloc(1, sizeof(Proc_History));
+    if (!hist) return NULL;
+    if (!series || !series->count) return hist;
+
+    for (uint32_t i = 0; i < series->count; i++) {
+        if (series->mem_rss[i] > hist->rss_peak) hist->rss_peak = series->mem_rss[i];
+        if (series->cpu_usage[i] > hist->cpu_peak) hist->cpu_peak = series->cpu_usage[i];
+    }
+
+    first = series->time[0];
+    span = series->time[series->count - 1] - first;
+    if (span < PROC_HISTORY_SECONDS) span = PROC_HISTORY_SECONDS;
+
+    for (uint32_t i = 0; i < series->count; i++) {
+        slot = (int) (((uint64_t) (series->time[i] - first) * (PROC_HISTORY_SAMPLES - 1)) / span);
+        cpu = series->cpu_usage[i] > 100.0 ? 100.0 : series->cpu_usage[i];
+        rss = hist->rss_peak ? (series->mem_rss[i] * 100.0) / hist->rss_peak : 0.0;
+        if (slot != last) {
+            // Carry the previous value across slots without samples.
+            for (int j = last + 1; (last >= 0) && (j < slot); j++) {
+                hist->cpu[j] = hist->cpu[last];
+                hist->rss[j] = hist->rss[last];
+            }
+            hist->cpu[slot] = cpu;
+            hist->rss[slot] = rss;
+            last = slot;
+        } else {
+            if (cpu > hist->cpu[slot]) hist->cpu[slot] = cpu;
+            if (rss > hist->rss[slot]) hist->rss[slot] = rss;
+        }
+    }
+    hist->count = last + 1;
+
+    return hist;
+}
+
+static void
+_evisum_ui_process_view_history_main(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
+    Evisum_Ui_Process_View *view = data;
+    Proc_Info_Series *series;
+    Proc_History *hist;
+
+    series = proc_info_series_get(view->selected_pid, view->start, PROC_HISTORY_SECONDS);
+    hist = _evisum_ui_process_view_history_build(series);
+    proc_info_series_free(series);
+    if (hist) ecore_thread_feedback(thread, hist);
+}
+
+static void
+_evisum_ui_process_view_history_feedback_cb(void *data, Ecore_Thread *thread, void *msg) {
+    Evisum_Ui_Process_View *view = data;
+    Proc_History *hist = msg;
+
+    if (ecore_thread_check(thread)) {
+        free(hist);
+        return;
+    }
+
+    memcpy(view->history.cpu, hist->cpu, sizeof(view->history.cpu));
+    memcpy(view->history.rss, hist->rss, sizeof(view->history.rss));
+    view->history.count = hist->count;
+
+    if (!hist->count) elm_object_text_set(view->history.label, _("No recorded history"));
+    else
+        elm_object_text_set(view->history.label,
+                            eina_slstr_printf(_("Last %d minutes: CPU peak %1.1f%%, RSS peak %s"),
+                                              PROC_HISTORY_SECONDS / 60, hist->cpu_peak,
+                                              evisum_size_format(hist->rss_peak, 0)));
+    free(hist);
+
+    _evisum_ui_process_view_history_redraw(view);
+}
+
+static void
+_evisum_ui_process_view_history_init(Evisum_Ui_Process_View *view) {
+    if (view->history.sub) return;
+
+    view->history.sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_PROCESSES, PROC_HISTORY_REFRESH,
+                                                _evisum_ui_process_view_history_main,
+                                                _evisum_ui_process_view_history_feedback_cb, free, view);
+    evisum_engine_subscription_refresh(view->history.sub);
+}
+
 static void
 _evisum_ui_process_view_general_view_update(Evisum_Ui_Process_View *view, Proc_Info *proc) {
     struct passwd *pwd_entry;
@@ -449,25 +573,25 @@ _evisum_ui_process_view_general_view_update(Evisum_Ui_Process_View *view, Proc_I
 
 #if defined(__linux__)
     if (!proc->is_kernel) {
-        s = _evisum_ui_process_view_rate_string(proc->net_in);
+        s = _evisum_ui_process_view_rate_string(proc->net_in_rate);
         if (s) {
             elm_object_text_set(view->general.entry_net_in, s);
             free(s);
         }
 
-        s = _evisum_ui_process_view_rate_string(proc->net_out);
+        s = _evisum_ui_process_view_rate_string(proc->net_out_rate);
         if (s) {
             elm_object_text_set(view->general.entry_net_out, s);
             free(s);
         }
 
-        s = _evisum_ui_process_view_rate_string(proc->disk_read);
+        s = _evisum_ui_process_view_rate_string(proc->disk_read_rate);
         if (s) {
             elm_object_text_set(view->general.entry_disk_read, s);
             free(s);
         }
 
-        s = _evisum_ui_process_view_rate_string(proc->disk_write);
+        s = _evisum_ui_process_view_rate_string(proc->disk_write_rate);
         if (s) {
             elm_object_text_set(view->general.entry_disk_write, s);
             free(s);
@@ -491,29 +615,22 @@ _evisum_ui_process_view_proc_gone(Evisum_Ui_Process_View *view) {
     elm_object_disabled_set(view->general.btn_stop, 1);
     elm_object_disabled_set(view->general.btn_kill, 1);
 
-    if (!ecore_thread_check(view->thread)) ecore_thread_cancel(view->thread);
-    view->thread = NULL;
+    evisum_engine_unsubscribe(view->sub, EINA_FALSE);
+    view->sub = NULL;
+}
+
+static void
+_evisum_ui_process_view_proc_info_free(void *msg) {
+    proc_info_free(msg);
 }
 
 static void
 _evisum_ui_process_view_proc_info_feedback_cb(void *data, Ecore_Thread *thread, void *msg) {
     Evisum_Ui_Process_View *view;
     Proc_Info *proc;
-    Proc_Usage_Cache *cache;
-    int64_t id;
-    int elapsed;
-    uint32_t sample_time;
-#if defined(__linux__)
-    uint64_t net_in_abs = 0;
-    uint64_t net_out_abs = 0;
-    uint64_t disk_read_abs = 0;
-    uint64_t disk_write_abs = 0;
-#endif
 
     view = data;
     proc = msg;
-    elapsed = 1;
-    sample_time = _evisum_ui_process_view_sample_time_get();
 
     if (!proc || (view->start && (proc->start != view->start))) {
         if (proc) proc_info_free(proc);
@@ -526,104 +643,6 @@ _evisum_ui_process_view_proc_info_feedback_cb(void *data, Ecore_Thread *thread,
         return;
     }
 
-    if (!view->proc_usage_cache)
-        view->proc_usage_cache = eina_hash_int64_new(_evisum_ui_process_view_usage_cache_free_cb);
-
-    id = proc->pid;
-    cache = view->proc_usage_cache ? eina_hash_find(view->proc_usage_cache, &id) : NULL;
-#if defined(__linux__)
-    disk_read_abs = proc->disk_read;
-    disk_write_abs = proc->disk_write;
-    net_in_abs = proc->net_in;
-    net_out_abs = proc->net_out;
-#endif
-    if (!cache) {
-        cache = calloc(1, sizeof(Proc_Usage_Cache));
-        if (cache) {
-            cache->start = proc->start;
-            cache->sample_time = sample_time;
-            cache->cpu_time = proc->cpu_time;
-#if defined(__linux__)
-            cache->net_in = net_in_abs;
-            cache->net_out = net_out_abs;
-            cache->disk_read = disk_read_abs;
-            cache->disk_write = disk_write_abs;
-            proc->net_in = 0;
-            proc->net_out = 0;
-            proc->disk_read = 0;
-            proc->disk_write = 0;
-#endif
-            proc->cpu_usage = 0.0;
-            if (!view->proc_usage_cache || !eina_hash_add(view->proc_usage_cache, &id, cache))
-                free(cache);
-        } else {
-            proc->cpu_usage = 0.0;
-#if defined(__linux__)
-            proc->net_in = 0;
-            proc->net_out = 0;
-            proc->disk_read = 0;
-            proc->disk_write = 0;
-#endif
-        }
-    } else if (cache->start != proc->start) {
-        cache->start = proc->start;
-        cache->sample_time = sample_time;
-        cache->cpu_time = proc->cpu_time;
-#if defined(__linux__)
-        cache->net_in = net_in_abs;
-        cache->net_out = net_out_abs;
-        cache->disk_read = disk_read_abs;
-        cache->disk_write = disk_write_abs;
-        proc->net_in = 0;
-        proc->net_out = 0;
-        proc->disk_read = 0;
-        proc->disk_write = 0;
-#endif
-        proc->cpu_usage = 0.0;
-    } else if (sample_time <= cache->sample_time) {
-        proc->cpu_usage = cache->cpu_usage;
-#if defined(__linux__)
-        proc->net_in = cache->net_in_rate;
-        proc->net_out = cache->net_out_rate;
-        proc->disk_read = cache->disk_read_rate;
-        proc->disk_write = cache->disk_write_rate;
-#endif
-    } else {
-        if (sample_time && cache->sample_time && (sample_time > cache->sample_time))
-            elapsed = sample_time - cache->sample_time;
-
-        if (proc->cpu_time >= cache->cpu_time)
-            proc->cpu_usage = (double) (proc->cpu_time - cache->cpu_time) / elapsed;
-        else proc->cpu_usage = 0.0;
-        cache->cpu_usage = proc->cpu_usage;
-        cache->cpu_time = proc->cpu_time;
-        cache->sample_time = sample_time;
-#if defined(__linux__)
-        if (net_in_abs >= cache->net_in) proc->net_in = (net_in_abs - cache->net_in) / elapsed;
-        else proc->net_in = 0;
-
-        if (net_out_abs >= cache->net_out) proc->net_out = (net_out_abs - cache->net_out) / elapsed;
-        else proc->net_out = 0;
-
-        if (disk_read_abs >= cache->disk_read)
-            proc->disk_read = (disk_read_abs - cache->disk_read) / elapsed;
-        else proc->disk_read = 0;
-
-        if (disk_write_abs >= cache->disk_write)
-            proc->disk_write = (disk_write_abs - cache->disk_write) / elapsed;
-        else proc->disk_write = 0;
-
-        cache->net_in_rate = proc->net_in;
-        cache->net_out_rate = proc->net_out;
-        cache->disk_read_rate = proc->disk_read;
-        cache->disk_write_rate = proc->disk_write;
-        cache->net_in = net_in_abs;
-        cache->net_out = net_out_abs;
-        cache->disk_read = disk_read_abs;
-        cache->disk_write = disk_write_abs;
-#endif
-    }
-
     _evisum_ui_process_view_general_view_update(view, proc);
 
     proc_info_free(proc);
@@ -1013,14 +1032,70 @@ _evisum_ui_process_view_manual_tab_add(Evas_Object *parent, Evisum_Ui_Process_Vi
     return fr;
 }
 
+static Evas_Object *
+_evisum_ui_process_view_history_tab_add(Evas_Object *parent, Evisum_Ui_Process_View *view) {
+    Evas_Object *fr, *bx, *tb, *lb;
+    Evas *evas;
+
+    fr = elm_frame_add(parent);
+    evas_object_size_hint_weight_set(fr, EXPAND, EXPAND);
+    evas_object_size_hint_align_set(fr, FILL, FILL);
+    elm_object_style_set(fr, "pad_small");
+
+    bx = elm_box_add(parent);
+    evas_object_size_hint_weight_set(bx, EXPAND, EXPAND);
+    evas_object_size_hint_align_set(bx, FILL, FILL);
+    evas_object_show(bx);
+    elm_object_content_set(fr, bx);
+
+    tb = elm_table_add(bx);
+    evas_object_size_hint_weight_set(tb, EXPAND, EXPAND);
+    evas_object_size_hint_align_set(tb, FILL, FILL);
+    evas_object_show(tb);
+    elm_box_pack_end(bx, tb);
+
+    evas = evas_object_evas_get(parent);
+
+    view->history.graph_bg = evas_object_rectangle_add(evas);
+    evisum_ui_graph_bg_set(view->history.graph_bg);
+    evas_object_size_hint_weight_set(view->history.graph_bg, EXPAND, EXPAND);
+    evas_object_size_hint_align_set(view->history.graph_bg, FILL, FILL);
+    elm_table_pack(tb, view->history.graph_bg, 0, 0, 1, 1);
+    evas_object_show(view->history.graph_bg);
+    evas_object_event_callback_add(view->history.graph_bg, EVAS_CALLBACK_RESIZE,
+                                   _evisum_ui_process_view_history_bg_resize_cb, view);
+    evas_object_event_callback_add(view->history.graph_bg, EVAS_CALLBACK_MOVE,
+                                   _evisum_ui_process_view_history_bg_resize_cb, view);
+
+    view->history.graph_img = evas_object_vg_add(evas);
+    evas_object_size_hint_weight_set(view->history.graph_img, EXPAND, EXPAND);
+    evas_object_size_hint_align_set(view->history.graph_img, FILL, FILL);
+    elm_table_pack(tb, view->history.graph_img, 0, 0, 1, 1);
+    evas_object_show(view->history.graph_img);
+    evas_object_stack_above(view->history.graph_img, view->history.graph_bg);
+
+    evisum_graph_color_get("proc_history_cpu", &view->history.cpu_r, &view->history.cpu_g, &view->history.cpu_b);
+    evisum_graph_color_get("proc_history_rss", &view->history.rss_r, &view->history.rss_g, &view->history.rss_b);
+
+    lb = _evisum_ui_process_view_lb_add(bx, _("CPU % and RSS (relative to peak)"));
+    elm_box_pack_end(bx, lb);
+
+    view->history.label = lb = _evisum_ui_process_view_lb_add(bx, "");
+    elm_box_pack_end(bx, lb);
+
+    return fr;
+}
+
 static void
 _evisum_ui_process_view_tab_change(Evisum_Ui_Process_View *view, Evas_Object *page, Evas_Object *obj) {
     elm_object_disabled_set(view->tab_general, 0);
     elm_object_disabled_set(view->tab_children, 0);
     elm_object_disabled_set(view->tab_manual, 0);
+    elm_object_disabled_set(view->tab_history, 0);
     evas_object_hide(view->general_view);
     evas_object_hide(view->children_view);
     evas_object_hide(view->manual_view);
+    evas_object_hide(view->history_view);
 
     view->current_view = page;
     evas_object_show(page);
@@ -1051,10 +1126,20 @@ _evisum_ui_process_view_tab_manual_clicked_cb(void *data, Evas_Object *obj EINA_
     Evisum_Ui_Process_View *view = data;
 
     _evisum_ui_process_view_tab_change(view, view->manual_view, obj);
-    elm_object_focus_set(view->tab_general, 1);
+    elm_object_focus_set(view->tab_history, 1);
     _evisum_ui_process_view_manual_init(view);
 }
 
+static void
+_evisum_ui_process_view_tab_history_clicked_cb(void *data, Evas_Object *obj EINA_UNUSED,
+                                               void *event_info EINA_UNUSED) {
+    Evisum_Ui_Process_View *view = data;
+
+    _evisum_ui_process_view_tab_change(view, view->history_view, obj);
+    elm_object_focus_set(view->tab_general, 1);
+    _evisum_ui_process_view_history_init(view);
+}
+
 static Evas_Object *
 _evisum_ui_process_view_tabs_add(Evas_Object *parent, Evisum_Ui_Process_View *view) {
     Evas_Object *hbx, *pad, *btn;
@@ -1105,6 +1190,17 @@ _evisum_ui_process_view_tabs_add(Evas_Object *parent, Evisum_Ui_Process_View *vi
     elm_object_content_set(pad, btn);
     elm_box_pack_end(hbx, pad);
 
+    pad = elm_frame_add(parent);
+    elm_object_style_set(pad, "pad_small");
+    evas_object_size_hint_weight_set(pad, 0.0, EXPAND);
+    evas_object_size_hint_align_set(pad, FILL, FILL);
+    evas_object_show(pad);
+
+    btn = evisum_ui_tab_add(parent, &view->tab_history, _("History"), _evisum_ui_process_view_tab_history_clicked_cb,
+                            view);
+    elm_object_content_set(pad, btn);
+    elm_box_pack_end(hbx, pad);
+
     pad = elm_frame_add(parent);
     elm_object_style_set(pad, "pad_medium");
     evas_object_size_hint_weight_set(pad, EXPAND, EXPAND);
@@ -1124,14 +1220,11 @@ _evisum_ui_process_view_win_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object
     view = data;
     win = obj;
 
-    if (view->thread) {
-        ecore_thread_cancel(view->thread);
-        ecore_thread_wait(view->thread, 0.5);
-    }
+    evisum_engine_unsubscribe(view->sub, EINA_TRUE);
+    evisum_engine_unsubscribe(view->history.sub, EINA_TRUE);
 
     evisum_ui_config_save(view->ui);
 
-    if (view->proc_usage_cache) eina_hash_free(view->proc_usage_cache);
     free(view->selected_cmd);
     if (view->children.widget_exel) evisum_ui_widget_exel_free(view->children.widget_exel);
 
@@ -1192,6 +1285,10 @@ _evisum_ui_process_view_activate(Evisum_Ui_Process_View *view, Evisum_Proc_Actio
             view->current_view = view->manual_view;
             _evisum_ui_process_view_tab_manual_clicked_cb(view, view->tab_manual, NULL);
             break;
+        case PROC_VIEW_HISTORY:
+            view->current_view = view->history_view;
+            _evisum_ui_process_view_tab_history_clicked_cb(view, view->tab_history, NULL);
+            break;
     }
     evas_object_show(view->current_view);
 }
@@ -1220,6 +1317,7 @@ evisum_ui_process_view_win_add(Evisum_Ui *ui, pid_t pid, Evisum_Proc_Action acti
 
     view->win = win = elm_win_util_standard_add("evisum", "evisum");
     elm_win_autodel_set(win, 1);
+    evisum_ui_win_visibility_track(win);
     ic = elm_icon_add(win);
     elm_icon_standard_set(ic, "evisum");
     elm_win_icon_object_set(win, ic);
@@ -1256,10 +1354,12 @@ evisum_ui_process_view_win_add(Evisum_Ui *ui, pid_t pid, Evisum_Proc_Action acti
     view->general_view = _evisum_ui_process_view_general_tab_add(tabs, view);
     view->children_view = _evisum_ui_process_view_children_tab_add(tabs, view);
     view->manual_view = _evisum_ui_process_view_manual_tab_add(tabs, view);
+    view->history_view = _evisum_ui_process_view_history_tab_add(tabs, view);
 
     elm_table_pack(tb, view->general_view, 0, 0, 1, 1);
     elm_table_pack(tb, view->children_view, 0, 0, 1, 1);
     elm_table_pack(tb, view->manual_view, 0, 0, 1, 1);
+    elm_table_pack(tb, view->history_view, 0, 0, 1, 1);
 
     elm_box_pack_end(bx, tb);
     elm_object_content_set(win, bx);
@@ -1283,6 +1383,7 @@ evisum_ui_process_view_win_add(Evisum_Ui *ui, pid_t pid, Evisum_Proc_Action acti
     view->kthreads_has_rss = 1;
 #endif
 
-    view->thread = ecore_thread_feedback_run(_evisum_ui_process_view_proc_info_main,
-                                             _evisum_ui_process_view_proc_info_feedback_cb, NULL, NULL, view, 0);
+    view->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_PROCESSES, 0.0, _evisum_ui_process_view_proc_info_main,
+                                        _evisum_ui_process_view_proc_info_feedback_cb,
+                                        _evisum_ui_process_view_proc_info_free, view);
 }
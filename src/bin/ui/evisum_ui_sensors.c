@@ -1,8 +1,8 @@
 #include "evisum_ui_sensors.h"
 #include "evisum_ui_graph.h"
+#include "evisum_ui_graph_lod.h"
 #include "evisum_ui_colors.h"
 #include "../engine/evisum_engine.h"
-#include "../background/evisum_background.h"
 #include "config.h"
 
 typedef struct {
@@ -12,10 +12,10 @@ typedef struct {
     Evas_Object *graph_bg;
     Evas_Object *graph_img;
     Evas_Object *legend_tb;
-    Ecore_Thread *thread;
+    Evisum_Engine_Subscription *sub;
     Eina_List *history;
+    Evisum_Ui_Graph_Backfill *backfill;
     Eina_Bool btn_visible;
-    Eina_Bool skip_wait;
 
     Evisum_Ui *ui;
     int n_sensors;
@@ -27,8 +27,7 @@ typedef struct {
     uint8_t color_r;
     uint8_t color_g;
     uint8_t color_b;
-    double history[120];
-    int history_count;
+    Evisum_Ui_Graph_Lod *lod;
     double current_temp;
     Eina_Bool seen;
     Eina_Bool enabled;
@@ -136,6 +135,16 @@ _evisum_ui_sensors_sensor_name_set(char *buf, size_t len, Sensor *s) {
     }
 }
 
+static double
+_evisum_ui_sensors_temp_get(const Sensor *s) {
+    double temp = s->value;
+
+    if (temp < 0.0) temp = 0.0;
+    if (temp > 100.0) temp = 100.0;
+
+    return temp;
+}
+
 static void
 _evisum_ui_sensors_history_legend_repack(Evisum_Ui_Sensors_View *view) {
     Eina_List *l;
@@ -157,12 +166,9 @@ _evisum_ui_sensors_history_legend_repack(Evisum_Ui_Sensors_View *view) {
 }
 
 static void
-_evisum_ui_sensors_history_add_sample(Sensor_History *entry, double value) {
-    if (entry->history_count < SENSOR_GRAPH_SAMPLES) entry->history[entry->history_count++] = value;
-    else {
-        memmove(&entry->history[0], &entry->history[1], sizeof(double) * (SENSOR_GRAPH_SAMPLES - 1));
-        entry->history[SENSOR_GRAPH_SAMPLES - 1] = value;
-    }
+_evisum_ui_sensors_history_add_sample(Evisum_Ui_Sensors_View *view, Sensor_History *entry, double value) {
+    if (!entry->lod) entry->lod = evisum_ui_graph_backfill_lod_new(view->backfill, entry->key, NULL);
+    evisum_ui_graph_lod_push(entry->lod, value);
 }
 
 static void
@@ -285,6 +291,7 @@ _evisum_ui_sensors_history_compact(Evisum_Ui_Sensors_View *view) {
         if (entry->seen) continue;
         view->history = eina_list_remove_list(view->history, l);
         _evisum_ui_sensors_history_legend_del(entry);
+        evisum_ui_graph_lod_free(entry->lod);
         free(entry->name);
         free(entry->key);
         free(entry);
@@ -298,31 +305,34 @@ _evisum_ui_sensors_graph_redraw(Evisum_Ui_Sensors_View *view) {
     Eina_List *l;
     Sensor_History *entry;
     Evisum_Ui_Graph_Series *series;
-    int total, nseries;
+    int total, nseries, w;
     double y_max = 0.0;
 
     if (!_evisum_ui_sensors_graph_objects_valid(view)) return;
 
+    evas_object_geometry_get(view->graph_bg, NULL, NULL, &w, NULL);
+
     total = eina_list_count(view->history);
     nseries = 0;
     series = calloc(total, sizeof(Evisum_Ui_Graph_Series));
     if ((total > 0) && (!series)) return;
 
     EINA_LIST_FOREACH(view->history, l, entry) {
+        Evisum_Ui_Graph_Series *line = &series[nseries];
+        const double *values;
         int j;
 
-        if (entry->history_count < 2) continue;
         if (!entry->enabled) continue;
+        if (evisum_ui_graph_lod_series_get(entry->lod, SENSOR_GRAPH_SAMPLES, w, line) < 2) continue;
 
-        series[nseries].history = entry->history;
-        series[nseries].history_count = entry->history_count;
-        series[nseries].color_r = entry->color_r;
-        series[nseries].color_g = entry->color_g;
-        series[nseries].color_b = entry->color_b;
+        line->color_r = entry->color_r;
+        line->color_g = entry->color_g;
+        line->color_b = entry->color_b;
         nseries++;
 
-        for (j = 0; j < entry->history_count; j++) {
-            if (entry->history[j] > y_max) y_max = entry->history[j];
+        values = line->history_max ? line->history_max : line->history;
+        for (j = 0; j < line->history_count; j++) {
+            if (values[j] > y_max) y_max = values[j];
         }
     }
 
@@ -343,28 +353,47 @@ _evisum_ui_sensors_graph_bg_resize_cb(void *data, Evas *e EINA_UNUSED, Evas_Obje
 }
 
 static void
-_evisum_ui_sensors_poll(void *data, Ecore_Thread *thread) {
-    Sensor **sensors;
+_evisum_ui_sensors_backfill_cb(const Evisum_Engine_History_Sample *sample, void *data) {
     Evisum_Ui_Sensors_View *view = data;
-    uint64_t seq = 0;
-    int ticks = 9;
+    Eina_Hash *seen;
+    Eina_List *l;
+    Sensor *s;
+    char namebuf[256];
 
-    ecore_thread_name_set(thread, "sensors");
+    seen = eina_hash_string_superfast_new(NULL);
+    if (!seen) return;
 
-    while (!ecore_thread_check(thread)) {
-        if (view->skip_wait) {
-            view->skip_wait = 0;
-            ticks = 9;
-        } else if (!evisum_background_update_wait(&seq)) continue;
-        ticks++;
-        if (ticks < 10) continue;
-        ticks = 0;
+    EINA_LIST_FOREACH(sample->sensors, l, s) {
+        if ((s->type != THERMAL) || !s->name[0]) continue;
 
-        sensors = system_sensors_thermal_get(&view->n_sensors);
-        if (!sensors) continue;
+        // Keyed and clamped as the live entries are, one value per name.
+        _evisum_ui_sensors_sensor_name_set(namebuf, sizeof(namebuf), s);
+        if (eina_hash_find(seen, namebuf)) continue;
+        eina_hash_add(seen, namebuf, view);
 
-        ecore_thread_feedback(thread, sensors);
+        evisum_ui_graph_backfill_add(view->backfill, namebuf, _evisum_ui_sensors_temp_get(s));
     }
+
+    eina_hash_free(seen);
+}
+
+static void
+_evisum_ui_sensors_poll(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
+    Sensor **sensors;
+    Evisum_Ui_Sensors_View *view = data;
+
+    // Recorded temperatures for the window, ready before the first live
+    // sample is posted.
+    if (!view->backfill) {
+        view->backfill = evisum_ui_graph_backfill_new();
+        evisum_engine_history_samples_get(SENSOR_GRAPH_SAMPLES, 1, EVISUM_ENGINE_HISTORY_SENSORS,
+                                          _evisum_ui_sensors_backfill_cb, view);
+    }
+
+    sensors = system_sensors_thermal_get(&view->n_sensors);
+    if (!sensors) return;
+
+    ecore_thread_feedback(thread, sensors);
 }
 
 static void
@@ -389,16 +418,14 @@ _evisum_ui_sensors_poll_feedback_cb(void *data, Ecore_Thread *thread EINA_UNUSED
             s = sensors[i];
             if (!s) continue;
 
-            temp = s->value;
-            if (temp < 0.0) temp = 0.0;
-            if (temp > 100.0) temp = 100.0;
+            temp = _evisum_ui_sensors_temp_get(s);
 
             entry = _evisum_ui_sensors_history_find_or_create(view, s);
             if (!entry) continue;
             if (entry->seen) continue;
 
             entry->current_temp = temp;
-            _evisum_ui_sensors_history_add_sample(entry, temp);
+            _evisum_ui_sensors_history_add_sample(view, entry, temp);
             _evisum_ui_sensors_history_legend_add(view, entry);
             _evisum_ui_sensors_history_legend_update(entry, temp);
             entry->seen = EINA_TRUE;
@@ -493,20 +520,21 @@ _evisum_ui_sensors_win_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj
     Evisum_Ui *ui = view->ui;
 
     evisum_ui_config_save(ui);
-    if (view->thread) {
-        ecore_thread_cancel(view->thread);
-        ecore_thread_wait(view->thread, 0.5);
-    }
+    evisum_engine_unsubscribe(view->sub, EINA_TRUE);
+    view->sub = NULL;
 
     if (view->main_menu) evas_object_del(view->main_menu);
 
     EINA_LIST_FREE(view->history, entry) {
         _evisum_ui_sensors_history_legend_del(entry);
+        evisum_ui_graph_lod_free(entry->lod);
         free(entry->name);
         free(entry->key);
         free(entry);
     }
 
+    evisum_ui_graph_backfill_free(view->backfill);
+
     ui->sensors.win = NULL;
     free(view);
 }
@@ -525,6 +553,7 @@ evisum_ui_sensors_win_add(Evisum_Ui *ui) {
 
     ui->sensors.win = win = elm_win_util_standard_add("evisum", _("Sensors"));
     elm_win_autodel_set(win, 1);
+    evisum_ui_win_visibility_track(win);
     evas_object_size_hint_weight_set(win, EXPAND, EXPAND);
     evas_object_size_hint_align_set(win, FILL, FILL);
     evas = evas_object_evas_get(win);
@@ -537,7 +566,6 @@ evisum_ui_sensors_win_add(Evisum_Ui *ui) {
     }
     view->win = win;
     view->ui = ui;
-    view->skip_wait = 1;
 
     tb = elm_table_add(win);
     evas_object_size_hint_weight_set(tb, EXPAND, EXPAND);
@@ -627,6 +655,8 @@ evisum_ui_sensors_win_add(Evisum_Ui *ui) {
 
     evas_object_show(win);
 
-    view->thread = ecore_thread_feedback_run(_evisum_ui_sensors_poll, _evisum_ui_sensors_poll_feedback_cb, NULL, NULL,
-                                             view, 1);
+    // Steady temperatures log nothing, the graph still wants a sample a second.
+    view->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_SENSORS, 1.0, _evisum_ui_sensors_poll,
+                                        _evisum_ui_sensors_poll_feedback_cb, free, view);
+    evisum_engine_subscription_refresh(view->sub);
 }
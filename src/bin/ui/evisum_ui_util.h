@@ -40,6 +40,8 @@ const char *evisum_image_path_get(const char *name);
 
 Evas_Object *evisum_ui_background_add(Evas_Object *win);
 
+void evisum_ui_win_visibility_track(Evas_Object *win);
+
 int evisum_ui_textblock_font_size_get(Evas_Object *tb);
 
 void evisum_ui_textblock_font_size_set(Evas_Object *tb, int new_size);
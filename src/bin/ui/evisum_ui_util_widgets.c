@@ -99,6 +99,38 @@ evisum_ui_background_add(Evas_Object *win) {
     return bg;
 }
 
+static void
+_evisum_ui_win_visibility_update(Evas_Object *win) {
+    evisum_engine_visible_set(win, evas_object_visible_get(win) && !elm_win_iconified_get(win));
+}
+
+static void
+_evisum_ui_win_visibility_smart_cb(void *data EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED) {
+    _evisum_ui_win_visibility_update(obj);
+}
+
+static void
+_evisum_ui_win_visibility_event_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED, Evas_Object *obj,
+                                   void *event_info EINA_UNUSED) {
+    _evisum_ui_win_visibility_update(obj);
+}
+
+static void
+_evisum_ui_win_visibility_del_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED, Evas_Object *obj,
+                                 void *event_info EINA_UNUSED) {
+    evisum_engine_visible_set(obj, 0);
+}
+
+// The daemon only samples quickly while something is on screen to show it.
+void
+evisum_ui_win_visibility_track(Evas_Object *win) {
+    evas_object_smart_callback_add(win, "iconified", _evisum_ui_win_visibility_smart_cb, NULL);
+    evas_object_smart_callback_add(win, "normal", _evisum_ui_win_visibility_smart_cb, NULL);
+    evas_object_event_callback_add(win, EVAS_CALLBACK_SHOW, _evisum_ui_win_visibility_event_cb, NULL);
+    evas_object_event_callback_add(win, EVAS_CALLBACK_HIDE, _evisum_ui_win_visibility_event_cb, NULL);
+    evas_object_event_callback_add(win, EVAS_CALLBACK_DEL, _evisum_ui_win_visibility_del_cb, NULL);
+}
+
 void
 evisum_ui_icon_size_set(Evas_Object *ic, int size) {
     evas_object_size_hint_min_set(ic, size, size);
@@ -12,6 +12,7 @@
 #define EVISUM_UI_WIDGET_EXEL_DEFAULT_CACHE_SIZE  30
 #define EVISUM_UI_WIDGET_EXEL_DRAG_THRESHOLD      6
 #define EVISUM_UI_WIDGET_EXEL_CURSOR_RESIZE_H     "sb_h_double_arrow"
+#define EVISUM_UI_WIDGET_EXEL_VIRTUAL_ROW_H       24
 
 typedef struct {
     int id;
@@ -54,6 +55,22 @@ struct _Evisum_Ui_Widget_Exel {
     Evas_Object *header_tb;
     Evas_Object *glist;
 
+    struct {
+        Evas_Object *scroller;
+        Evas_Object *box;
+        Evas_Object *pad_top;
+        Evas_Object *pad_bottom;
+        Evas_Object **rows;
+        unsigned int rows_used;
+        unsigned int rows_size;
+        unsigned int count;
+        unsigned int first;
+        Evas_Coord row_h;
+        Evisum_Ui_Widget_Exel_Virtual_Fill_Cb fill_cb;
+        Evisum_Ui_Widget_Exel_Virtual_Selected_Cb selected_cb;
+        void *data;
+    } virt;
+
     Evas_Object *fields_menu;
     Evas_Object *resize_btn;
     Ecore_Timer *deferred_timer;
@@ -283,6 +300,7 @@ _evisum_ui_widget_exel_fields_menu_apply_clicked_cb(void *data, Evas_Object *obj
         evisum_ui_widget_exel_fields_apply(wx);
         if (wx->cache) evisum_ui_item_cache_reset(wx->cache, NULL, NULL);
         if (wx->glist) elm_genlist_realized_items_update(wx->glist);
+        evisum_ui_widget_exel_virtual_rows_reset(wx);
     }
 
     if (wx->p.fields_applied_cb) wx->p.fields_applied_cb(wx->p.data, changed);
@@ -613,6 +631,9 @@ _evisum_ui_widget_exel_win_mouse_out_cb(void *data, Evas *e EINA_UNUSED, Evas_Ob
 static void
 _evisum_ui_widget_exel_genlist_unrealized_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info);
 
+static void
+_evisum_ui_widget_exel_virtual_detach(Evisum_Ui_Widget_Exel *wx);
+
 Evisum_Ui_Widget_Exel *
 evisum_ui_widget_exel_create(Evas_Object *parent) {
     Evisum_Ui_Widget_Exel_Params p;
@@ -829,6 +850,7 @@ evisum_ui_widget_exel_free(Evisum_Ui_Widget_Exel *wx) {
     evisum_ui_widget_exel_fields_menu_dismiss(wx);
     evisum_ui_widget_exel_deferred_call_cancel(wx);
     _evisum_ui_widget_exel_drag_proxy_del(wx);
+    _evisum_ui_widget_exel_virtual_detach(wx);
     if (wx->cache) evisum_ui_item_cache_free(wx->cache);
     if (wx->root) evas_object_del(wx->root);
     wx->header_tb = NULL;
@@ -1036,6 +1058,7 @@ _evisum_ui_widget_exel_field_resize_mouse_move(Evisum_Ui_Widget_Exel *wx, Evas_E
     wx->p.field_widths[wx->resize_field] = width;
     evisum_ui_widget_exel_field_proportions_apply(wx);
     if (wx->glist) elm_genlist_realized_items_update(wx->glist);
+    evisum_ui_widget_exel_virtual_rows_update(wx, EINA_TRUE);
 
     if (wx->p.resize_live_cb) wx->p.resize_live_cb(wx->p.data);
 }
@@ -1089,6 +1112,7 @@ evisum_ui_widget_exel_field_resize_mouse_up(Evisum_Ui_Widget_Exel *wx, Evas_Even
     wx->p.field_widths[wx->resize_field] = w;
     evisum_ui_widget_exel_field_proportions_apply(wx);
     if (wx->glist) elm_genlist_realized_items_update(wx->glist);
+    evisum_ui_widget_exel_virtual_rows_update(wx, EINA_TRUE);
 
     wx->resizing = 0;
     wx->resize_btn = NULL;
@@ -1632,11 +1656,14 @@ evisum_ui_widget_exel_item_cache_active_count_get(const Evisum_Ui_Widget_Exel *w
 static void
 _evisum_ui_widget_exel_genlist_unrealized_release_enable(Evisum_Ui_Widget_Exel *wx, Eina_Bool delete_unhandled);
 
+static Evas_Object *
+_evisum_ui_widget_exel_scroller_get(const Evisum_Ui_Widget_Exel *wx);
+
 Evas_Object *
 evisum_ui_widget_exel_genlist_add(Evisum_Ui_Widget_Exel *wx, Evas_Object *parent) {
     Evas_Object *glist;
 
-    if (!wx || !parent) return NULL;
+    if (!wx || !parent || wx->virt.scroller) return NULL;
 
     glist = elm_genlist_add(parent);
     elm_genlist_homogeneous_set(glist, EINA_TRUE);
@@ -1665,8 +1692,8 @@ evisum_ui_widget_exel_genlist_obj_get(const Evisum_Ui_Widget_Exel *wx) {
 void
 evisum_ui_widget_exel_genlist_event_callback_add(Evisum_Ui_Widget_Exel *wx, Evas_Callback_Type type,
                                                  Evas_Object_Event_Cb cb, const void *data) {
-    if (!wx || !wx->glist || !cb) return;
-    evas_object_event_callback_add(wx->glist, type, cb, data);
+    if (!_evisum_ui_widget_exel_scroller_get(wx) || !cb) return;
+    evas_object_event_callback_add(_evisum_ui_widget_exel_scroller_get(wx), type, cb, data);
 }
 
 void
@@ -1689,7 +1716,9 @@ evisum_ui_widget_exel_genlist_first_item_get(const Evisum_Ui_Widget_Exel *wx) {
 
 void
 evisum_ui_widget_exel_genlist_realized_items_update(Evisum_Ui_Widget_Exel *wx) {
-    if (!wx || !wx->glist) return;
+    if (!wx) return;
+    if (wx->virt.scroller) evisum_ui_widget_exel_virtual_rows_update(wx, EINA_TRUE);
+    if (!wx->glist) return;
     elm_genlist_realized_items_update(wx->glist);
 }
 
@@ -1699,31 +1728,61 @@ evisum_ui_widget_exel_genlist_realized_items_get(const Evisum_Ui_Widget_Exel *wx
     return elm_genlist_realized_items_get(wx->glist);
 }
 
+Eina_Bool
+evisum_ui_widget_exel_genlist_realized_range_get(const Evisum_Ui_Widget_Exel *wx, int *first, int *last) {
+    Eina_List *real;
+    Elm_Object_Item *it;
+    int idx, lo = -1, hi = -1;
+
+    if (!wx) return EINA_FALSE;
+    if (wx->virt.scroller) {
+        if (!wx->virt.rows_used) return EINA_FALSE;
+        if (first) *first = wx->virt.first;
+        if (last) *last = wx->virt.first + wx->virt.rows_used - 1;
+        return EINA_TRUE;
+    }
+    if (!wx->glist) return EINA_FALSE;
+
+    real = elm_genlist_realized_items_get(wx->glist);
+    EINA_LIST_FREE(real, it) {
+        idx = elm_genlist_item_index_get(it);
+        if (idx < 0) continue;
+        if ((lo < 0) || (idx < lo)) lo = idx;
+        if (idx > hi) hi = idx;
+    }
+
+    if (lo < 0) return EINA_FALSE;
+    if (first) *first = lo;
+    if (last) *last = hi;
+
+    return EINA_TRUE;
+}
+
 void
 evisum_ui_widget_exel_genlist_page_bring_in(Evisum_Ui_Widget_Exel *wx, int h_pagenumber, int v_pagenumber) {
-    if (!wx || !wx->glist) return;
-    elm_scroller_page_bring_in(wx->glist, h_pagenumber, v_pagenumber);
+    if (!_evisum_ui_widget_exel_scroller_get(wx)) return;
+    elm_scroller_page_bring_in(_evisum_ui_widget_exel_scroller_get(wx), h_pagenumber, v_pagenumber);
 }
 
 void
 evisum_ui_widget_exel_genlist_region_get(const Evisum_Ui_Widget_Exel *wx, Evas_Coord *x, Evas_Coord *y, Evas_Coord *w,
                                          Evas_Coord *h) {
-    if (!wx || !wx->glist) return;
-    elm_scroller_region_get(wx->glist, x, y, w, h);
+    if (!_evisum_ui_widget_exel_scroller_get(wx)) return;
+    elm_scroller_region_get(_evisum_ui_widget_exel_scroller_get(wx), x, y, w, h);
 }
 
 void
 evisum_ui_widget_exel_genlist_region_bring_in(Evisum_Ui_Widget_Exel *wx, Evas_Coord x, Evas_Coord y, Evas_Coord w,
                                               Evas_Coord h) {
-    if (!wx || !wx->glist) return;
-    elm_scroller_region_bring_in(wx->glist, x, y, w, h);
+    if (!_evisum_ui_widget_exel_scroller_get(wx)) return;
+    elm_scroller_region_bring_in(_evisum_ui_widget_exel_scroller_get(wx), x, y, w, h);
 }
 
 void
 evisum_ui_widget_exel_genlist_policy_set(Evisum_Ui_Widget_Exel *wx, Elm_Scroller_Policy policy_h,
                                          Elm_Scroller_Policy policy_v) {
-    if (!wx || !wx->glist) return;
-    elm_scroller_policy_set(wx->glist, policy_h, policy_v);
+    if (!_evisum_ui_widget_exel_scroller_get(wx)) return;
+    elm_scroller_policy_set(_evisum_ui_widget_exel_scroller_get(wx), policy_h, policy_v);
 }
 
 Elm_Object_Item *
@@ -1802,6 +1861,341 @@ evisum_ui_widget_exel_object_item_data_set(Elm_Object_Item *it, void *data) {
     elm_object_item_data_set(it, data);
 }
 
+Evas_Object *
+evisum_ui_widget_exel_object_item_row_get(Elm_Object_Item *it) {
+    if (!it) return NULL;
+    return elm_object_item_part_content_get(it, "elm.swallow.content");
+}
+
+static Evas_Object *
+_evisum_ui_widget_exel_scroller_get(const Evisum_Ui_Widget_Exel *wx) {
+    if (!wx) return NULL;
+    return wx->glist ? wx->glist : wx->virt.scroller;
+}
+
+static void
+_evisum_ui_widget_exel_virtual_pad_set(Evas_Object *pad, unsigned int rows, Evas_Coord row_h) {
+    evas_object_size_hint_min_set(pad, 0, (Evas_Coord) rows * row_h);
+}
+
+static Evas_Object *
+_evisum_ui_widget_exel_virtual_row_get(Evisum_Ui_Widget_Exel *wx) {
+    Evas_Object **rows, *row;
+    unsigned int size;
+
+    // Rows beyond rows_used are kept hidden for reuse.
+    if (wx->virt.rows_used < wx->virt.rows_size) {
+        row = wx->virt.rows[wx->virt.rows_used];
+        if (row) return row;
+    } else {
+        size = wx->virt.rows_size ? wx->virt.rows_size * 2 : 64;
+        rows = realloc(wx->virt.rows, size * sizeof(Evas_Object *));
+        if (!rows) return NULL;
+        memset(rows + wx->virt.rows_size, 0, (size - wx->virt.rows_size) * sizeof(Evas_Object *));
+        wx->virt.rows = rows;
+        wx->virt.rows_size = size;
+    }
+
+    row = _evisum_ui_widget_exel_item_create_from_fields(wx->virt.box);
+    if (!row) return NULL;
+
+    evas_object_data_set(row, "exel_virtual_fresh", (void *) 1);
+    wx->virt.rows[wx->virt.rows_used] = row;
+
+    return row;
+}
+
+static void
+_evisum_ui_widget_exel_virtual_rows_clear(Evisum_Ui_Widget_Exel *wx) {
+    for (unsigned int i = 0; i < wx->virt.rows_size; i++) {
+        if (wx->virt.rows[i]) evas_object_del(wx->virt.rows[i]);
+    }
+    free(wx->virt.rows);
+    wx->virt.rows = NULL;
+    wx->virt.rows_used = wx->virt.rows_size = 0;
+    wx->virt.first = 0;
+    wx->virt.row_h = 0;
+}
+
+static Eina_Bool
+_evisum_ui_widget_exel_virtual_rows_ensure(Evisum_Ui_Widget_Exel *wx, unsigned int n) {
+    Evas_Object *row;
+
+    while (wx->virt.rows_used < n) {
+        row = _evisum_ui_widget_exel_virtual_row_get(wx);
+        if (!row) return EINA_FALSE;
+        if (wx->virt.row_h) evas_object_size_hint_min_set(row, 0, wx->virt.row_h);
+        elm_box_pack_before(wx->virt.box, row, wx->virt.pad_bottom);
+        evas_object_show(row);
+        wx->virt.rows_used++;
+    }
+
+    while (wx->virt.rows_used > n) {
+        row = wx->virt.rows[--wx->virt.rows_used];
+        elm_box_unpack(wx->virt.box, row);
+        evas_object_hide(row);
+    }
+
+    return EINA_TRUE;
+}
+
+// Rows that stay on screen keep their object, so a scroll of a few rows only
+// moves those leaving one edge to the other before they are filled.
+static void
+_evisum_ui_widget_exel_virtual_rows_rotate(Evisum_Ui_Widget_Exel *wx, unsigned int first) {
+    Evas_Object **rows = wx->virt.rows, *row;
+    unsigned int used = wx->virt.rows_used, n;
+
+    if (first > wx->virt.first) {
+        n = first - wx->virt.first;
+        if (n >= used) return;
+        for (unsigned int i = 0; i < n; i++) {
+            row = rows[0];
+            memmove(rows, rows + 1, (used - 1) * sizeof(Evas_Object *));
+            rows[used - 1] = row;
+            elm_box_unpack(wx->virt.box, row);
+            elm_box_pack_before(wx->virt.box, row, wx->virt.pad_bottom);
+        }
+    } else if (first < wx->virt.first) {
+        n = wx->virt.first - first;
+        if (n >= used) return;
+        for (unsigned int i = 0; i < n; i++) {
+            row = rows[used - 1];
+            memmove(rows + 1, rows, (used - 1) * sizeof(Evas_Object *));
+            rows[0] = row;
+            elm_box_unpack(wx->virt.box, row);
+            elm_box_pack_after(wx->virt.box, row, wx->virt.pad_top);
+        }
+    }
+}
+
+static void
+_evisum_ui_widget_exel_virtual_row_height_measure(Evisum_Ui_Widget_Exel *wx) {
+    Evas_Object *row;
+    Evas_Coord h = 0;
+
+    if (!_evisum_ui_widget_exel_virtual_rows_ensure(wx, 1)) return;
+
+    row = wx->virt.rows[0];
+    evas_object_data_del(row, "exel_virtual_fresh");
+    wx->virt.fill_cb(wx->virt.data, row, 0, EINA_TRUE);
+    evas_object_smart_calculate(row);
+    evas_object_size_hint_min_get(row, NULL, &h);
+    if (h < ELM_SCALE_SIZE(EVISUM_UI_WIDGET_EXEL_VIRTUAL_ROW_H)) h = ELM_SCALE_SIZE(EVISUM_UI_WIDGET_EXEL_VIRTUAL_ROW_H);
+
+    wx->virt.row_h = h;
+    evas_object_size_hint_min_set(row, 0, h);
+}
+
+/* Realise only the rows under the viewport. Every row has the same height,
+ * so the first visible index is the scroll offset over the row height and
+ * the padding above and below keeps the content as tall as all count rows. */
+static void
+_evisum_ui_widget_exel_virtual_layout(Evisum_Ui_Widget_Exel *wx, Eina_Bool full) {
+    Evas_Object *row;
+    Evas_Coord oy = 0, vh = 0;
+    unsigned int first, visible;
+    Eina_Bool fresh;
+
+    if (!wx || !wx->virt.scroller || !wx->virt.fill_cb) return;
+
+    if (!wx->virt.count) {
+        _evisum_ui_widget_exel_virtual_rows_ensure(wx, 0);
+        wx->virt.first = 0;
+        _evisum_ui_widget_exel_virtual_pad_set(wx->virt.pad_top, 0, 0);
+        _evisum_ui_widget_exel_virtual_pad_set(wx->virt.pad_bottom, 0, 0);
+        return;
+    }
+
+    if (!wx->virt.row_h) {
+        _evisum_ui_widget_exel_virtual_row_height_measure(wx);
+        if (!wx->virt.row_h) return;
+    }
+
+    elm_scroller_region_get(wx->virt.scroller, NULL, &oy, NULL, &vh);
+    if (vh <= 0) evas_object_geometry_get(wx->virt.scroller, NULL, NULL, NULL, &vh);
+    if (oy < 0) oy = 0;
+
+    visible = (vh / wx->virt.row_h) + 2;
+    if (visible > wx->virt.count) visible = wx->virt.count;
+
+    first = oy / wx->virt.row_h;
+    if (first > (wx->virt.count - visible)) first = wx->virt.count - visible;
+
+    _evisum_ui_widget_exel_virtual_rows_rotate(wx, first);
+    if (!_evisum_ui_widget_exel_virtual_rows_ensure(wx, visible)) return;
+    wx->virt.first = first;
+
+    _evisum_ui_widget_exel_virtual_pad_set(wx->virt.pad_top, first, wx->virt.row_h);
+    _evisum_ui_widget_exel_virtual_pad_set(wx->virt.pad_bottom, wx->virt.count - first - wx->virt.rows_used,
+                                           wx->virt.row_h);
+
+    for (unsigned int i = 0; i < wx->virt.rows_used; i++) {
+        row = wx->virt.rows[i];
+        fresh = evas_object_data_get(row, "exel_virtual_fresh") != NULL;
+        if (fresh) evas_object_data_del(row, "exel_virtual_fresh");
+        wx->virt.fill_cb(wx->virt.data, row, first + i, full || fresh);
+    }
+}
+
+static void
+_evisum_ui_widget_exel_virtual_scroll_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED) {
+    _evisum_ui_widget_exel_virtual_layout(data, EINA_FALSE);
+}
+
+static void
+_evisum_ui_widget_exel_virtual_resize_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                         void *event_info EINA_UNUSED) {
+    _evisum_ui_widget_exel_virtual_layout(data, EINA_FALSE);
+}
+
+static void
+_evisum_ui_widget_exel_virtual_mouse_up_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                           void *event_info) {
+    Evisum_Ui_Widget_Exel *wx = data;
+    Evas_Event_Mouse_Up *ev = event_info;
+    int index;
+
+    if (!wx || !ev || (ev->button != 1)) return;
+    // Set once the press turned into a scroll.
+    if (ev->event_flags & EVAS_EVENT_FLAG_ON_HOLD) return;
+    if (!wx->virt.selected_cb) return;
+
+    index = evisum_ui_widget_exel_virtual_index_at_xy(wx, ev->canvas.x, ev->canvas.y);
+    if (index < 0) return;
+
+    wx->virt.selected_cb(wx->virt.data, index);
+}
+
+static void
+_evisum_ui_widget_exel_virtual_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                      void *event_info EINA_UNUSED) {
+    Evisum_Ui_Widget_Exel *wx = data;
+
+    // Unpacked rows are not children of the box any more, drop them all here.
+    _evisum_ui_widget_exel_virtual_rows_clear(wx);
+    memset(&wx->virt, 0, sizeof(wx->virt));
+}
+
+static void
+_evisum_ui_widget_exel_virtual_detach(Evisum_Ui_Widget_Exel *wx) {
+    if (!wx->virt.scroller) return;
+
+    evas_object_smart_callback_del_full(wx->virt.scroller, "scroll", _evisum_ui_widget_exel_virtual_scroll_cb, wx);
+    evas_object_event_callback_del_full(wx->virt.scroller, EVAS_CALLBACK_RESIZE,
+                                        _evisum_ui_widget_exel_virtual_resize_cb, wx);
+    evas_object_event_callback_del_full(wx->virt.box, EVAS_CALLBACK_MOUSE_UP, _evisum_ui_widget_exel_virtual_mouse_up_cb,
+                                        wx);
+    evas_object_event_callback_del_full(wx->virt.scroller, EVAS_CALLBACK_DEL, _evisum_ui_widget_exel_virtual_del_cb,
+                                        wx);
+    _evisum_ui_widget_exel_virtual_rows_clear(wx);
+    memset(&wx->virt, 0, sizeof(wx->virt));
+}
+
+Evas_Object *
+evisum_ui_widget_exel_virtual_add(Evisum_Ui_Widget_Exel *wx, Evas_Object *parent,
+                                  Evisum_Ui_Widget_Exel_Virtual_Fill_Cb fill_cb,
+                                  Evisum_Ui_Widget_Exel_Virtual_Selected_Cb selected_cb, void *data) {
+    Evas_Object *scr, *bx, *pad;
+
+    if (!wx || !parent || !fill_cb || wx->glist || wx->virt.scroller) return NULL;
+
+    scr = elm_scroller_add(parent);
+    elm_scroller_bounce_set(scr, EINA_FALSE, EINA_FALSE);
+    elm_object_focus_allow_set(scr, EINA_TRUE);
+    elm_scroller_policy_set(scr, ELM_SCROLLER_POLICY_AUTO, ELM_SCROLLER_POLICY_AUTO);
+    evas_object_size_hint_weight_set(scr, EXPAND, EXPAND);
+    evas_object_size_hint_align_set(scr, FILL, FILL);
+    evas_object_data_set(scr, "widget_exel", wx);
+    if (wx->p.data) evas_object_data_set(scr, "widget_exel_data", wx->p.data);
+    evas_object_show(scr);
+
+    bx = elm_box_add(scr);
+    elm_box_horizontal_set(bx, EINA_FALSE);
+    elm_box_align_set(bx, 0.5, 0.0);
+    evas_object_size_hint_weight_set(bx, EXPAND, 0);
+    evas_object_size_hint_align_set(bx, FILL, 0.0);
+    evas_object_data_set(bx, "widget_exel", wx);
+    if (wx->p.data) evas_object_data_set(bx, "widget_exel_data", wx->p.data);
+    evas_object_show(bx);
+    elm_object_content_set(scr, bx);
+
+    for (int i = 0; i < 2; i++) {
+        pad = evas_object_rectangle_add(evas_object_evas_get(bx));
+        evas_object_color_set(pad, 0, 0, 0, 0);
+        evas_object_size_hint_weight_set(pad, EXPAND, 0);
+        evas_object_size_hint_align_set(pad, FILL, 0.0);
+        evas_object_pass_events_set(pad, EINA_TRUE);
+        elm_box_pack_end(bx, pad);
+        evas_object_show(pad);
+        if (!i) wx->virt.pad_top = pad;
+        else wx->virt.pad_bottom = pad;
+    }
+
+    wx->virt.scroller = scr;
+    wx->virt.box = bx;
+    wx->virt.fill_cb = fill_cb;
+    wx->virt.selected_cb = selected_cb;
+    wx->virt.data = data;
+
+    evas_object_smart_callback_add(scr, "scroll", _evisum_ui_widget_exel_virtual_scroll_cb, wx);
+    evas_object_event_callback_add(scr, EVAS_CALLBACK_RESIZE, _evisum_ui_widget_exel_virtual_resize_cb, wx);
+    evas_object_event_callback_add(bx, EVAS_CALLBACK_MOUSE_UP, _evisum_ui_widget_exel_virtual_mouse_up_cb, wx);
+    evas_object_event_callback_add(scr, EVAS_CALLBACK_DEL, _evisum_ui_widget_exel_virtual_del_cb, wx);
+
+    return scr;
+}
+
+Evas_Object *
+evisum_ui_widget_exel_virtual_obj_get(const Evisum_Ui_Widget_Exel *wx) {
+    if (!wx) return NULL;
+    return wx->virt.scroller;
+}
+
+void
+evisum_ui_widget_exel_virtual_count_set(Evisum_Ui_Widget_Exel *wx, unsigned int count) {
+    if (!wx || !wx->virt.scroller) return;
+    wx->virt.count = count;
+}
+
+unsigned int
+evisum_ui_widget_exel_virtual_count_get(const Evisum_Ui_Widget_Exel *wx) {
+    if (!wx) return 0;
+    return wx->virt.count;
+}
+
+void
+evisum_ui_widget_exel_virtual_rows_update(Evisum_Ui_Widget_Exel *wx, Eina_Bool full) {
+    _evisum_ui_widget_exel_virtual_layout(wx, full);
+}
+
+void
+evisum_ui_widget_exel_virtual_rows_reset(Evisum_Ui_Widget_Exel *wx) {
+    if (!wx || !wx->virt.scroller) return;
+
+    _evisum_ui_widget_exel_virtual_rows_clear(wx);
+    _evisum_ui_widget_exel_virtual_layout(wx, EINA_TRUE);
+}
+
+int
+evisum_ui_widget_exel_virtual_index_at_xy(const Evisum_Ui_Widget_Exel *wx, Evas_Coord x, Evas_Coord y) {
+    Evas_Coord sx, sy, sw, sh, by;
+    Evas_Coord index;
+
+    if (!wx || !wx->virt.scroller || !wx->virt.row_h) return -1;
+
+    evas_object_geometry_get(wx->virt.scroller, &sx, &sy, &sw, &sh);
+    if ((x < sx) || (x >= (sx + sw)) || (y < sy) || (y >= (sy + sh))) return -1;
+
+    evas_object_geometry_get(wx->virt.box, NULL, &by, NULL, NULL);
+    if (y < by) return -1;
+
+    index = (y - by) / wx->virt.row_h;
+    if (index >= (Evas_Coord) wx->virt.count) return -1;
+
+    return index;
+}
+
 void
 evisum_ui_widget_exel_deferred_call_schedule(Evisum_Ui_Widget_Exel *wx, double delay_seconds, void (*cb)(void *data),
                                              void *data) {
@@ -41,6 +41,8 @@ typedef void (*Evisum_Ui_Widget_Exel_Fields_Applied_Cb)(void *data, Eina_Bool ch
 typedef void (*Evisum_Ui_Widget_Exel_Resize_Live_Cb)(void *data);
 typedef void (*Evisum_Ui_Widget_Exel_Resize_Done_Cb)(void *data);
 typedef void (*Evisum_Ui_Widget_Exel_Fields_Reordered_Cb)(void *data);
+typedef void (*Evisum_Ui_Widget_Exel_Virtual_Fill_Cb)(void *data, Evas_Object *row, unsigned int index, Eina_Bool full);
+typedef void (*Evisum_Ui_Widget_Exel_Virtual_Selected_Cb)(void *data, unsigned int index);
 
 typedef struct {
     int id;
@@ -313,6 +315,10 @@ void evisum_ui_widget_exel_genlist_realized_items_update(Evisum_Ui_Widget_Exel *
  * The returned list should be freed by the caller after use. */
 Eina_List *evisum_ui_widget_exel_genlist_realized_items_get(const Evisum_Ui_Widget_Exel *wx);
 
+/* Get the index range of the currently realized items in the widget-owned genlist.
+ * Returns EINA_FALSE when nothing is realized; either output may be NULL. */
+Eina_Bool evisum_ui_widget_exel_genlist_realized_range_get(const Evisum_Ui_Widget_Exel *wx, int *first, int *last);
+
 /* Scroll the widget-owned genlist to a page location.
  * Use this to reset list position after sort changes. */
 void evisum_ui_widget_exel_genlist_page_bring_in(Evisum_Ui_Widget_Exel *wx, int h_pagenumber, int v_pagenumber);
@@ -363,6 +369,40 @@ void *evisum_ui_widget_exel_object_item_data_get(Elm_Object_Item *it);
  * Use this when replacing payloads during periodic list updates in the same way as `elm_object_item_data_set`. */
 void evisum_ui_widget_exel_object_item_data_set(Elm_Object_Item *it, void *data);
 
+/* Get the row object currently swallowed by a realized genlist item, NULL when unrealized.
+ * Use this to patch the cells of a visible row in place instead of re-realizing the item. */
+Evas_Object *evisum_ui_widget_exel_object_item_row_get(Elm_Object_Item *it);
+
+/* Create and own a virtual table instead of a genlist: a row count plus a fill callback, with row objects kept
+ * only for the viewport. Rows share one height, measured from the first row, so scroll offsets map to indexes
+ * directly. Returns the scroller to pack; the genlist scroller helpers apply to it as well. */
+Evas_Object *evisum_ui_widget_exel_virtual_add(Evisum_Ui_Widget_Exel *wx, Evas_Object *parent,
+                                               Evisum_Ui_Widget_Exel_Virtual_Fill_Cb fill_cb,
+                                               Evisum_Ui_Widget_Exel_Virtual_Selected_Cb selected_cb, void *data);
+
+/* Return the widget-owned virtual table scroller, or NULL if none was created yet.
+ * Use this only when another container API requires the object for packing. */
+Evas_Object *evisum_ui_widget_exel_virtual_obj_get(const Evisum_Ui_Widget_Exel *wx);
+
+/* Set the number of rows in the virtual table.
+ * Takes effect on the next rows update. */
+void evisum_ui_widget_exel_virtual_count_set(Evisum_Ui_Widget_Exel *wx, unsigned int count);
+
+/* Return the number of rows in the virtual table. */
+unsigned int evisum_ui_widget_exel_virtual_count_get(const Evisum_Ui_Widget_Exel *wx);
+
+/* Fill every visible row again through the fill callback.
+ * With `full` the callback should rewrite all cells, e.g. after column widths changed. */
+void evisum_ui_widget_exel_virtual_rows_update(Evisum_Ui_Widget_Exel *wx, Eina_Bool full);
+
+/* Drop the row objects and build them again from the current fields.
+ * Call this when visible fields or their order change. */
+void evisum_ui_widget_exel_virtual_rows_reset(Evisum_Ui_Widget_Exel *wx);
+
+/* Return the row index at the given canvas coordinates in the virtual table, or -1.
+ * Use this for context-menu hit-testing. */
+int evisum_ui_widget_exel_virtual_index_at_xy(const Evisum_Ui_Widget_Exel *wx, Evas_Coord x, Evas_Coord y);
+
 /* Schedule a one-shot deferred callback owned by the widget and replace any pending one.
  * Use this for field-layout settling timers so consumer files no longer manage timer objects directly. */
 void evisum_ui_widget_exel_deferred_call_schedule(Evisum_Ui_Widget_Exel *wx, double delay_seconds,
@@ -1,5 +1,4 @@
 #include "cpu_bars.h"
-#include "../../background/evisum_background.h"
 #include "ui/evisum_ui_graph.h"
 
 #define BAR_WIDTH 16
@@ -52,33 +51,27 @@ _cpu_percent_colors_fill(Evas_Object *colors) {
 }
 
 static void
-_core_times_main_cb(void *data, Ecore_Thread *thread) {
+_core_times_main_cb(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
     int ncpu;
-    uint64_t seq = 0;
     Evisum_Ui_Cpu_Visual_Data *pd = data;
     Ext *ext = pd->ext;
 
-    ecore_thread_name_set(thread, "cpu");
-
-    while (!ecore_thread_check(thread)) {
-        if (!evisum_background_update_wait(&seq)) continue;
-        Cpu_Core **cores = system_cpu_state_get(&ncpu);
-        if (!cores || ncpu <= 0) continue;
-        Core *cores_out = calloc(ext->cpu_count, sizeof(Core));
-
-        if (cores_out) {
-            for (int n = 0; n < ext->cpu_count; n++) {
-                int id = ext->cpu_order[n];
-                if ((id < 0) || (id >= ncpu)) id = n;
-                if (id >= ncpu) continue;
-                Core *core = &(cores_out[n]);
-                core->id = id;
-                core->percent = cores[id]->percent;
-            }
-            ecore_thread_feedback(thread, cores_out);
+    Cpu_Core **cores = system_cpu_state_get(&ncpu);
+    if (!cores || ncpu <= 0) return;
+    Core *cores_out = calloc(ext->cpu_count, sizeof(Core));
+
+    if (cores_out) {
+        for (int n = 0; n < ext->cpu_count; n++) {
+            int id = ext->cpu_order[n];
+            if ((id < 0) || (id >= ncpu)) id = n;
+            if (id >= ncpu) continue;
+            Core *core = &(cores_out[n]);
+            core->id = id;
+            core->percent = cores[id]->percent;
         }
-        free(cores);
+        ecore_thread_feedback(thread, cores_out);
     }
+    free(cores);
 }
 
 static void
@@ -254,6 +247,7 @@ evisum_ui_cpu_visual_bars(Evas_Object *parent_bx) {
     elm_object_content_set(desc_fr, lb);
     evas_object_show(lb);
 
-    pd->thread = ecore_thread_feedback_run(_core_times_main_cb, _core_times_feedback_cb, NULL, NULL, pd, 1);
+    pd->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_CPU, 0.0, _core_times_main_cb, _core_times_feedback_cb, free,
+                                      pd);
     return pd;
 }
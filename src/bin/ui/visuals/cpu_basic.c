@@ -1,5 +1,4 @@
 #include "cpu_basic.h"
-#include "../../background/evisum_background.h"
 #include "ui/evisum_ui_graph.h"
 
 #define CORE_TILE_SIZE  128
@@ -16,41 +15,39 @@ typedef struct {
     int cols;
     int rows;
     Eina_Bool cpu_freq;
+    Eina_Bool probed;
     int freq_min;
     int freq_max;
 } Ext;
 
 static void
-_core_times_main_cb(void *data, Ecore_Thread *thread) {
+_core_times_main_cb(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
     int ncpu;
-    uint64_t seq = 0;
     Evisum_Ui_Cpu_Visual_Data *pd = data;
     Ext *ext = pd->ext;
 
-    if (!system_cpu_frequency_min_max_get(&ext->freq_min, &ext->freq_max)) ext->cpu_freq = 1;
-
-    ecore_thread_name_set(thread, "cpu");
-
-    while (!ecore_thread_check(thread)) {
-        if (!evisum_background_update_wait(&seq)) continue;
-        Cpu_Core **cores = system_cpu_state_get(&ncpu);
-        if (!cores || ncpu <= 0) continue;
-        Core *cores_out = calloc(ext->cpu_count, sizeof(Core));
-
-        if (cores_out) {
-            for (int n = 0; n < ext->cpu_count; n++) {
-                int id = ext->cpu_order[n];
-                if ((id < 0) || (id >= ncpu)) id = n;
-                if (id >= ncpu) continue;
-                Core *core = &(cores_out[n]);
-                core->id = id;
-                core->percent = cores[id]->percent;
-                if (ext->cpu_freq) core->freq = cores[id]->freq;
-            }
-            ecore_thread_feedback(thread, cores_out);
+    if (!ext->probed) {
+        if (!system_cpu_frequency_min_max_get(&ext->freq_min, &ext->freq_max)) ext->cpu_freq = 1;
+        ext->probed = 1;
+    }
+
+    Cpu_Core **cores = system_cpu_state_get(&ncpu);
+    if (!cores || ncpu <= 0) return;
+    Core *cores_out = calloc(ext->cpu_count, sizeof(Core));
+
+    if (cores_out) {
+        for (int n = 0; n < ext->cpu_count; n++) {
+            int id = ext->cpu_order[n];
+            if ((id < 0) || (id >= ncpu)) id = n;
+            if (id >= ncpu) continue;
+            Core *core = &(cores_out[n]);
+            core->id = id;
+            core->percent = cores[id]->percent;
+            if (ext->cpu_freq) core->freq = cores[id]->freq;
         }
-        free(cores);
+        ecore_thread_feedback(thread, cores_out);
     }
+    free(cores);
 }
 
 static void
@@ -289,6 +286,7 @@ evisum_ui_cpu_visual_basic(Evas_Object *parent_bx) {
     elm_object_content_set(desc_fr, lb);
     evas_object_show(lb);
 
-    pd->thread = ecore_thread_feedback_run(_core_times_main_cb, _core_times_feedback_cb, NULL, NULL, pd, 1);
+    pd->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_CPU, 0.0, _core_times_main_cb, _core_times_feedback_cb, free,
+                                      pd);
     return pd;
 }
@@ -1,5 +1,4 @@
 #include "cpu_default.h"
-#include "../../background/evisum_background.h"
 
 #define BAR_HEIGHT    3
 #define COLORS_HEIGHT 32
@@ -14,6 +13,7 @@ typedef struct {
     Eina_Bool show_cpufreq;
     // Have cpu scaling
     Eina_Bool cpu_freq;
+    Eina_Bool probed;
     int freq_min;
     int freq_max;
 
@@ -45,40 +45,37 @@ typedef struct {
 } Ext;
 
 static void
-_core_times_main_cb(void *data, Ecore_Thread *thread) {
+_core_times_main_cb(void *data, Ecore_Thread *thread, unsigned int changed EINA_UNUSED) {
     Evisum_Ui_Cpu_Visual_Data *pd = data;
     int ncpu;
-    uint64_t seq = 0;
     Ext *ext = pd->ext;
 
-    if (!system_cpu_frequency_min_max_get(&ext->freq_min, &ext->freq_max)) ext->cpu_freq = 1;
+    if (!ext->probed) {
+        if (!system_cpu_frequency_min_max_get(&ext->freq_min, &ext->freq_max)) ext->cpu_freq = 1;
 
-    system_cpu_temperature_min_max_get(&ext->temp_min, &ext->temp_max);
-    if ((system_cpu_n_temperature_get(0)) != -1) ext->cpu_temp = 1;
+        system_cpu_temperature_min_max_get(&ext->temp_min, &ext->temp_max);
+        if ((system_cpu_n_temperature_get(0)) != -1) ext->cpu_temp = 1;
+        ext->probed = 1;
+    }
 
-    ecore_thread_name_set(thread, "cpu");
-
-    while (!ecore_thread_check(thread)) {
-        if (!evisum_background_update_wait(&seq)) continue;
-        Cpu_Core **cores = system_cpu_state_get(&ncpu);
-        if (!cores || ncpu <= 0) continue;
-        Core *cores_out = calloc(ext->cpu_count, sizeof(Core));
-
-        if (cores_out) {
-            for (int n = 0; n < ext->cpu_count; n++) {
-                int id = ext->cpu_order[n];
-                if ((id < 0) || (id >= ncpu)) id = n;
-                if (id >= ncpu) continue;
-                Core *core = &(cores_out[n]);
-                core->id = id;
-                core->percent = cores[id]->percent;
-                if (ext->cpu_freq) core->freq = cores[id]->freq;
-                if (ext->cpu_temp) core->temp = cores[id]->temp;
-            }
-            ecore_thread_feedback(thread, cores_out);
+    Cpu_Core **cores = system_cpu_state_get(&ncpu);
+    if (!cores || ncpu <= 0) return;
+    Core *cores_out = calloc(ext->cpu_count, sizeof(Core));
+
+    if (cores_out) {
+        for (int n = 0; n < ext->cpu_count; n++) {
+            int id = ext->cpu_order[n];
+            if ((id < 0) || (id >= ncpu)) id = n;
+            if (id >= ncpu) continue;
+            Core *core = &(cores_out[n]);
+            core->id = id;
+            core->percent = cores[id]->percent;
+            if (ext->cpu_freq) core->freq = cores[id]->freq;
+            if (ext->cpu_temp) core->temp = cores[id]->temp;
         }
-        free(cores);
+        ecore_thread_feedback(thread, cores_out);
     }
+    free(cores);
 }
 
 static void
@@ -585,7 +582,8 @@ evisum_ui_cpu_visual_default(Evas_Object *parent_box) {
     // min size of cpu color graph to show all cores.
     evas_object_size_hint_min_set(obj, 100, (BAR_HEIGHT * ext->cpu_count) * elm_config_scale_get());
 
-    // run a feedback thread that sends feedback to the mainloop
-    pd->thread = ecore_thread_feedback_run(_core_times_main_cb, _core_times_feedback_cb, NULL, NULL, pd, 1);
+    // sample on every CPU update, feedback lands on the mainloop
+    pd->sub = evisum_engine_subscribe(EVISUM_ENGINE_FAMILY_CPU, 0.0, _core_times_main_cb, _core_times_feedback_cb, free,
+                                      pd);
     return pd;
 }